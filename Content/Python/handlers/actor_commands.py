@@ -95,7 +95,7 @@ def handle_modify_object(command: Dict[str, Any]) -> Dict[str, Any]:
         log.log_error(f"Error modifying object: {str(e)}", include_traceback=True)
         return {"success": False, "error": str(e)}
 
-def handle_edit_component_property(command: Dict[str, Any]) -> str:  # Change return type to str
+def handle_edit_component_property(command: Dict[str, Any]) -> Dict[str, Any]:
     """
     Handle a command to edit a component property in a Blueprint or scene actor.
     
@@ -109,7 +109,7 @@ def handle_edit_component_property(command: Dict[str, Any]) -> str:  # Change re
             - actor_name: Name of the scene actor (required if is_scene_actor is True)
                 
     Returns:
-        JSON string with success/failure status, message, and optional suggestions
+        Response dictionary with success/failure status, message, and optional suggestions
     """
     try:
         blueprint_path = command.get("blueprint_path", "")
@@ -121,11 +121,11 @@ def handle_edit_component_property(command: Dict[str, Any]) -> str:  # Change re
 
         if not component_name or not property_name or not value:
             log.log_error("Missing required parameters for edit_component_property")
-            return json.dumps({"success": False, "error": "Missing required parameters"})
+            return {"success": False, "error": "Missing required parameters"}
 
         if is_scene_actor and not actor_name:
             log.log_error("Actor name required for scene actor editing")
-            return json.dumps({"success": False, "error": "Actor name required for scene actor"})
+            return {"success": False, "error": "Actor name required for scene actor"}
 
         log.log_command("edit_component_property", f"Blueprint: {blueprint_path}, Component: {component_name}, Property: {property_name}, Value: {value}, SceneActor: {is_scene_actor}, Actor: {actor_name}")
 
@@ -134,11 +134,11 @@ def handle_edit_component_property(command: Dict[str, Any]) -> str:  # Change re
 
         parsed_result = json.loads(result)  # Assuming C++ returns a JSON string
         log.log_result("edit_component_property", parsed_result["success"], parsed_result.get("message", parsed_result.get("error", "No message")))
-        return json.dumps(parsed_result)  # Return as JSON string
+        return parsed_result
 
     except Exception as e:
         log.log_error(f"Error editing component property: {str(e)}", include_traceback=True)
-        return json.dumps({"success": False, "error": str(e)})
+        return {"success": False, "error": str(e)}
 
 
 
@@ -299,6 +299,68 @@ def handle_compile_blueprint(command: Dict[str, Any]) -> Dict[str, Any]:
         return {"success": False, "error": str(e)}
 
 
+def handle_compile_blueprints(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to compile several Blueprints in one pass, dependencies first
+
+    Args:
+        command: The command dictionary containing:
+            - blueprint_paths: Paths to the Blueprint assets
+            - sequential: Compile them one after the other in the given order instead (optional, default False)
+
+    Returns:
+        Response dictionary with the status, errors and warnings of every Blueprint
+    """
+    try:
+        blueprint_paths = command.get("blueprint_paths")
+
+        if not blueprint_paths:
+            log.log_error("Missing required parameters for compile_blueprints")
+            return {"success": False, "error": "Missing required parameters"}
+
+        sequential = command.get("sequential", False)
+        log.log_command("compile_blueprints", f"{len(blueprint_paths)} blueprints, sequential: {sequential}")
+        result = json.loads(unreal.GenBlueprintUtils.compile_blueprints(blueprint_paths, sequential))
+        log.log_result("compile_blueprints", result.get("success", False),
+                       f"{result.get('errors', 0)} errors, {result.get('warnings', 0)} warnings in {result.get('elapsed_ms', 0.0):.1f} ms")
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error compiling blueprints: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_validate_blueprint(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to check every graph of a Blueprint for broken links and unconnected nodes
+
+    Args:
+        command: The command dictionary containing:
+            - blueprint_path: Path to the Blueprint asset
+            - fix: Remove broken links and extra exec links (optional, default False)
+
+    Returns:
+        Response dictionary with the diagnostics
+    """
+    try:
+        blueprint_path = command.get("blueprint_path")
+
+        if not blueprint_path:
+            log.log_error("Missing required parameters for validate_blueprint")
+            return {"success": False, "error": "Missing required parameters"}
+
+        fix = command.get("fix", False)
+        log.log_command("validate_blueprint", f"Blueprint: {blueprint_path}, fix: {fix}")
+        result = json.loads(unreal.GenBlueprintUtils.validate_blueprint(blueprint_path, fix))
+        log.log_result("validate_blueprint", result.get("success", False),
+                       f"{result.get('errors', 0)} errors, {result.get('warnings', 0)} warnings, {result.get('fixed', 0)} fixed")
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error validating blueprint: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
 def handle_spawn_blueprint(command: Dict[str, Any]) -> Dict[str, Any]:
     """
     Handle a command to spawn a Blueprint actor in the level
@@ -568,8 +630,9 @@ def handle_get_node_suggestions(command: Dict[str, Any]) -> Dict[str, Any]:
         if suggestions_result:
             if suggestions_result.startswith("SUGGESTIONS:"):
                 suggestions = suggestions_result[len("SUGGESTIONS:"):].split(", ")
+                candidates = json.loads(node_creator.get_ranked_node_candidates(node_type, 10) or "[]")
                 log.log_result("get_node_suggestions", True, f"Retrieved {len(suggestions)} suggestions for {node_type}")
-                return {"success": True, "suggestions": suggestions}
+                return {"success": True, "suggestions": suggestions, "candidates": candidates}
             else:
                 log.log_error(f"Unexpected response format from get_node_suggestions: {suggestions_result}")
                 return {"success": False, "error": "Unexpected response format from Unreal"}
@@ -581,6 +644,60 @@ def handle_get_node_suggestions(command: Dict[str, Any]) -> Dict[str, Any]:
         log.log_error(f"Error getting node suggestions: {str(e)}", include_traceback=True)
         return {"success": False, "error": str(e)}
 
+def handle_benchmark_node_lookup(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to time node type lookups against the function index
+
+    Args:
+        command: The command dictionary containing:
+            - node_types: Node type names to look up
+            - expected_names: Optional "Class.Function" names parallel to node_types, adds recall to the result
+            - iterations: How often the list is looked up (default 100)
+
+    Returns:
+        Response dictionary with the index size, build time, lookup latency and recall
+    """
+    try:
+        node_types = command.get("node_types")
+        iterations = int(command.get("iterations", 100))
+
+        if not node_types:
+            log.log_error("Missing required parameter 'node_types' for benchmark_node_lookup")
+            return {"success": False, "error": "Missing required parameter 'node_types'"}
+
+        log.log_command("benchmark_node_lookup", f"{len(node_types)} node types, {iterations} iterations")
+
+        expected_names = command.get("expected_names", [])
+        result = json.loads(unreal.GenBlueprintNodeCreator.benchmark_node_lookup(node_types, expected_names, iterations))
+        result["success"] = True
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error benchmarking node lookup: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+def handle_reload_node_aliases(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to reload the node type aliases and recipes from Config/NodeTypeAliases.json
+
+    Args:
+        command: The command dictionary (no parameters)
+
+    Returns:
+        Response dictionary with the number of loaded recipes and aliases
+    """
+    try:
+        log.log_command("reload_node_aliases", "Reloading NodeTypeAliases.json")
+
+        result = json.loads(unreal.GenBlueprintNodeCreator.reload_node_type_aliases())
+        if not result.get("success"):
+            return {"success": False, "error": "Failed to load NodeTypeAliases.json, see the output log"}
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error reloading node aliases: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
 def handle_get_node_guid(command: Dict[str, Any]) -> Dict[str, Any]:
     """
     Handle a command to retrieve the GUID of a pre-existing node in a Blueprint graph.
@@ -624,4 +741,118 @@ def handle_get_node_guid(command: Dict[str, Any]) -> Dict[str, Any]:
 
     except Exception as e:
         log.log_error(f"Error getting node GUID: {str(e)}", include_traceback=True)
-        return {"success": False, "error": str(e)}
\ No newline at end of file
+        return {"success": False, "error": str(e)}
+
+
+def handle_execute_batch(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to run a list of operations as one transaction, see GenBlueprintUtils.execute_batch
+
+    Args:
+        command: The command dictionary containing:
+            - operations: Ordered list of commands, results of operations with an "id" can be referenced as "${id.field}"
+            - compile: Compile the touched Blueprints at the end (optional, default True)
+            - stop_on_error: Stop at the first failing operation (optional, default True)
+            - rollback_on_error: Undo the changes if an operation fails (optional, default False)
+
+    Returns:
+        Response dictionary with the result of every operation and of the final compiles
+    """
+    try:
+        operations = command.get("operations")
+        if not operations:
+            log.log_error("Missing operations for execute_batch")
+            return {"success": False, "error": "Missing required parameter 'operations'"}
+
+        log.log_command("execute_batch", f"{len(operations)} operations")
+
+        # The operations run through the native command handlers
+        gen_bp_utils = unreal.GenBlueprintUtils
+        result = json.loads(gen_bp_utils.execute_batch(json.dumps(command)))
+
+        log.log_result("execute_batch", result.get("success", False), f"Ran {len(result.get('results', []))}/{len(operations)} operations")
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error executing batch: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+
+def handle_begin_edit_session(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to start an edit session, compiles requested by the following edits are coalesced into one
+    per Blueprint when the session ends
+
+    Args:
+        command: The command dictionary (no parameters)
+
+    Returns:
+        Response dictionary with success status
+    """
+    try:
+        log.log_command("begin_edit_session", "Starting edit session")
+        unreal.GenBlueprintUtils.begin_edit_session()
+        return {"success": True}
+
+    except Exception as e:
+        log.log_error(f"Error starting edit session: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+def handle_end_edit_session(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to end the edit session and compile the edited Blueprints
+
+    Args:
+        command: The command dictionary (no parameters)
+
+    Returns:
+        Response dictionary with the compile metrics
+    """
+    try:
+        log.log_command("end_edit_session", "Ending edit session")
+        result = json.loads(unreal.GenBlueprintUtils.end_edit_session())
+        result["success"] = True
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error ending edit session: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+def handle_flush_compiles(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to apply the pending compiles right away
+
+    Args:
+        command: The command dictionary containing:
+            - blueprint_path: Blueprint to compile (optional, all pending Blueprints when missing)
+
+    Returns:
+        Response dictionary with the compile metrics
+    """
+    try:
+        blueprint_path = command.get("blueprint_path", "")
+        log.log_command("flush_compiles", f"Blueprint: {blueprint_path or 'all'}")
+        return json.loads(unreal.GenBlueprintUtils.flush_pending_compiles(blueprint_path))
+
+    except Exception as e:
+        log.log_error(f"Error flushing compiles: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
+
+def handle_get_compile_stats(command: Dict[str, Any]) -> Dict[str, Any]:
+    """
+    Handle a command to get the compile count and time of the MCP edits
+
+    Args:
+        command: The command dictionary (no parameters)
+
+    Returns:
+        Response dictionary with the compile metrics
+    """
+    try:
+        result = json.loads(unreal.GenBlueprintUtils.get_compile_stats())
+        result["success"] = True
+        return result
+
+    except Exception as e:
+        log.log_error(f"Error getting compile stats: {str(e)}", include_traceback=True)
+        return {"success": False, "error": str(e)}
@@ -4,6 +4,9 @@ import sys
 from mcp.server.fastmcp import FastMCP
 import re
 import os
+import time
+import threading
+from concurrent.futures import Future, ThreadPoolExecutor
 from pathlib import Path
 
 # THIS FILE WILL RUN OUTSIDE THE UNREAL ENGINE SCOPE, 
@@ -12,17 +15,95 @@ from pathlib import Path
 # Create an MCP server
 mcp = FastMCP("UnrealHandshake")
 
-# Function to send a message to Unreal Engine via socket
-def send_to_unreal(command):
-    with socket.socket(socket.AF_INET, socket.SOCK_STREAM) as s:
+# Set UNREAL_MCP_NATIVE=1 to talk to the native C++ command server instead of the Python socket server.
+USE_NATIVE_SERVER = os.environ.get("UNREAL_MCP_NATIVE", "0") == "1"
+UNREAL_HOST = os.environ.get("UNREAL_HOST", "localhost")
+UNREAL_PORT = int(os.environ.get("UNREAL_MCP_NATIVE_PORT", "9878")) if USE_NATIVE_SERVER else int(os.environ.get("UNREAL_PORT", "9877"))
+REQUEST_TIMEOUT = 60  # seconds
+
+
+class UnrealConnection:
+    """
+    Persistent connection to the editor. Every message is a 4-byte big-endian length followed by UTF-8 JSON.
+    Commands are tagged with a request_id, so any number of tool calls can be in flight at once and
+    responses of any size are matched back to their caller.
+    """
+    def __init__(self, host, port):
+        self.host = host
+        self.port = port
+        self.lock = threading.Lock()
+        self.send_lock = threading.Lock()
+        self.sock = None
+        self.pending = {}
+        self.next_request_id = 0
+
+    def _connect(self):
+        sock = socket.create_connection((self.host, self.port))
+        sock.setsockopt(socket.IPPROTO_TCP, socket.TCP_NODELAY, 1)
+        self.sock = sock
+        threading.Thread(target=self._read_responses, args=(sock,), daemon=True).start()
+
+    def _read_responses(self, sock):
+        buffer = bytearray()
         try:
-            s.connect(('localhost', 9877))  # Unreal listens on port 9877
-            s.sendall(json.dumps(command).encode())
-            response = s.recv(4096)  # Increased buffer size
-            return json.loads(response.decode())
+            while True:
+                chunk = sock.recv(65536)
+                if not chunk:
+                    raise ConnectionError("Connection closed by Unreal")
+                buffer.extend(chunk)
+                while len(buffer) >= 4:
+                    size = int.from_bytes(buffer[:4], 'big')
+                    if len(buffer) < 4 + size:
+                        break
+                    response = json.loads(buffer[4:4 + size].decode('utf-8'))
+                    del buffer[:4 + size]
+                    if "request_id" not in response:
+                        # The server could not tell which command this answers, so none of them can be trusted
+                        raise ConnectionError(f"Response without a request_id: {response.get('error', response)}")
+                    with self.lock:
+                        future = self.pending.pop(response.pop("request_id"), None)
+                    if future:
+                        future.set_result(response)
         except Exception as e:
-            print(f"Error sending to Unreal: {e}", file=sys.stderr)
-            return {"success": False, "error": str(e)}
+            with self.lock:
+                if self.sock is sock:
+                    self.sock = None
+                failed = list(self.pending.values())
+                self.pending.clear()
+            for future in failed:
+                future.set_exception(e)
+            sock.close()
+
+    def request(self, command, timeout=REQUEST_TIMEOUT):
+        future = Future()
+        with self.lock:
+            if self.sock is None:
+                self._connect()
+            sock = self.sock
+            request_id = self.next_request_id
+            self.next_request_id += 1
+            self.pending[request_id] = future
+
+        payload = json.dumps(dict(command, request_id=request_id)).encode('utf-8')
+        try:
+            with self.send_lock:
+                sock.sendall(len(payload).to_bytes(4, 'big') + payload)
+            return future.result(timeout)
+        finally:
+            with self.lock:
+                self.pending.pop(request_id, None)
+
+
+unreal_connection = UnrealConnection(UNREAL_HOST, UNREAL_PORT)
+
+
+# Function to send a message to Unreal Engine via socket
+def send_to_unreal(command):
+    try:
+        return unreal_connection.request(command)
+    except Exception as e:
+        print(f"Error sending to Unreal: {e}", file=sys.stderr)
+        return {"success": False, "error": str(e)}
 
 
 @mcp.tool()
@@ -220,7 +301,8 @@ def edit_component_property(blueprint_path: str, component_name: str, property_n
     response = send_to_unreal(command)
     try:
         import json
-        result = json.loads(response)
+        # Older editor servers return the result as a JSON string
+        result = response if isinstance(response, dict) else json.loads(response)
         if result.get("success"):
             return result.get("message", f"Set {property_name} of {component_name} to {value}")
         else:
@@ -231,6 +313,66 @@ def edit_component_property(blueprint_path: str, component_name: str, property_n
     except Exception as e:
         return f"Error parsing response: {str(e)}\nRaw response: {response}"
 
+@mcp.tool()
+def benchmark_command_pump(count: int = 100, concurrency: int = 1) -> str:
+    """
+    Measure how many commands per second make it through the bridge and the game-thread command pump.
+    Sends `count` lightweight get_command_stats commands with up to `concurrency` of them in flight on the
+    shared connection.
+
+    Args:
+        count: Number of commands to send
+        concurrency: Number of commands in flight at the same time
+    """
+    send_to_unreal({"type": "get_command_stats", "reset": True})
+
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=max(1, concurrency)) as pool:
+        responses = list(pool.map(lambda _: send_to_unreal({"type": "get_command_stats"}), range(count)))
+    elapsed = time.perf_counter() - start
+
+    failures = sum(1 for response in responses if not response.get("success"))
+    stats = send_to_unreal({"type": "get_command_stats"})
+    if not stats.get("success"):
+        return f"Failed to read command stats: {stats.get('error', 'Unknown error')}"
+
+    transport = "native" if USE_NATIVE_SERVER else "python"
+    return (f"{count - failures}/{count} commands over the {transport} bridge in {elapsed:.3f}s "
+            f"({count / elapsed if elapsed > 0 else 0.0:.1f} commands/s end to end)\n"
+            f"Pump: {stats['commands_per_second']:.1f} commands/s, peak queue depth {stats['peak_queue_depth']}, "
+            f"average wait {stats['average_wait_ms']:.2f} ms, max wait {stats['max_wait_ms']:.2f} ms, "
+            f"average execute {stats['average_execute_ms']:.3f} ms")
+
+
+@mcp.tool()
+def stress_test_bridge(count: int = 200, concurrency: int = 16, payload_kb: int = 256) -> str:
+    """
+    Stress test the persistent editor connection: `concurrency` threads share one connection and send
+    `count` handshakes carrying `payload_kb` KB each, every echoed response is checked against its request.
+
+    Args:
+        count: Number of requests
+        concurrency: Number of requests in flight at the same time
+        payload_kb: Size of every request and response in KB
+    """
+    payload = "x" * (payload_kb * 1024)
+
+    def round_trip(index):
+        message = f"{index}:{payload}"
+        response = send_to_unreal({"type": "handshake", "message": message})
+        return response.get("success") and response.get("message") == f"Received: {message}"
+
+    start = time.perf_counter()
+    with ThreadPoolExecutor(max_workers=max(1, concurrency)) as pool:
+        results = list(pool.map(round_trip, range(count)))
+    elapsed = time.perf_counter() - start
+
+    failures = results.count(False)
+    megabytes = 2 * count * payload_kb / 1024
+    return (f"{count - failures}/{count} responses matched their request in {elapsed:.3f}s "
+            f"({count / elapsed if elapsed > 0 else 0.0:.1f} requests/s, {megabytes / elapsed if elapsed > 0 else 0.0:.1f} MB/s)")
+
+
 @mcp.tool()
 def create_material(material_name: str, color: list) -> str:
     """
@@ -449,6 +591,10 @@ def get_node_suggestions(node_type: str) -> str:
     response = send_to_unreal(command)
     if response.get("success"):
         suggestions = response.get("suggestions", [])
+        candidates = response.get("candidates", [])
+        if candidates:
+            ranked = ", ".join(f"{candidate['name']} ({candidate['score']})" for candidate in candidates)
+            return f"Suggestions for '{node_type}' (score): {ranked}"
         if suggestions:
             return f"Suggestions for '{node_type}': {', '.join(suggestions)}"
         else:
@@ -457,6 +603,52 @@ def get_node_suggestions(node_type: str) -> str:
         error = response.get("error", "Unknown error")
         return f"Failed to get suggestions for '{node_type}': {error}"
 
+@mcp.tool()
+def benchmark_node_lookup(node_types: str = "", iterations: int = 100) -> str:
+    """
+    Measure how long resolving a node type against the indexed function catalog takes, and how often the
+    expected function is the best (recall@1) or among the top five (recall@5) candidates.
+
+    Args:
+        node_types: Comma separated node type names to look up, defaults to the corpus of LLM-issued node
+                    names with their expected functions in benchmarks/node_name_corpus.json
+        iterations: How often the whole list is looked up
+    """
+    if node_types:
+        names = [name.strip() for name in node_types.split(",") if name.strip()]
+        expected = []
+    else:
+        corpus_path = os.path.join(os.path.dirname(os.path.abspath(__file__)), "benchmarks", "node_name_corpus.json")
+        with open(corpus_path, "r") as corpus_file:
+            corpus = json.load(corpus_file)
+        names = [entry["node_type"] for entry in corpus]
+        expected = [entry["expected"] for entry in corpus]
+
+    response = send_to_unreal({"type": "benchmark_node_lookup", "iterations": iterations,
+                               "node_types": names, "expected_names": expected})
+    if not response.get("success"):
+        return f"Failed to benchmark node lookup: {response.get('error', 'Unknown error')}"
+    summary = (f"{response.get('lookups', 0)} lookups over {response.get('functions', 0)} functions - "
+               f"average {response.get('average_ms', 0.0) * 1000:.1f} us, max {response.get('max_ms', 0.0) * 1000:.1f} us "
+               f"(index build {response.get('build_ms', 0.0):.1f} ms)")
+    if "recall_at_1" in response:
+        summary += (f"\nRecall over {len(expected)} names: {response['recall_at_1']:.0%} at 1, "
+                    f"{response['recall_at_5']:.0%} at 5")
+        for miss in response.get("misses", []):
+            summary += f"\n  missed {miss['node_type']} (expected {miss['expected']}, best {miss['best'] or 'none'})"
+    return summary
+
+@mcp.tool()
+def reload_node_aliases() -> str:
+    """
+    Reload the node type aliases and node recipes from Config/NodeTypeAliases.json of the plugin (and
+    Config/GenerativeAISupport/NodeTypeAliases.json of the project). The editor also reloads them when the files change.
+    """
+    response = send_to_unreal({"type": "reload_node_aliases"})
+    if not response.get("success"):
+        return f"Failed to reload node aliases: {response.get('error', 'Unknown error')}"
+    return f"Loaded {response.get('recipes', 0)} node recipes and {response.get('aliases', 0)} aliases"
+
 @mcp.tool()
 def delete_node_from_blueprint(blueprint_path: str, function_id: str, node_id: str) -> str:
     """
@@ -553,6 +745,35 @@ def compile_blueprint(blueprint_path: str) -> str:
     else:
         return f"Failed to compile Blueprint: {response.get('error', 'Unknown error')}"
 
+@mcp.tool()
+def compile_blueprints(blueprint_paths: list, sequential: bool = False) -> str:
+    """
+    Compile several Blueprints at once. They are ordered so parent classes and used Blueprints come first and are
+    compiled in a single pass, which is faster than calling compile_blueprint for each of them.
+
+    Args:
+        blueprint_paths: Paths to the Blueprint assets
+        sequential: Compile them one after the other in the given order instead
+
+    Returns:
+        Status, errors and warnings of every Blueprint
+    """
+    response = send_to_unreal({"type": "compile_blueprints", "blueprint_paths": blueprint_paths, "sequential": sequential})
+    if "blueprints" not in response:
+        return f"Failed to compile Blueprints: {response.get('error', 'Unknown error')}"
+
+    lines = [f"Compiled {len(response['blueprints'])} Blueprints in {response.get('elapsed_ms', 0.0):.1f} ms "
+             f"({response.get('errors', 0)} errors, {response.get('warnings', 0)} warnings)"]
+    for result in response["blueprints"]:
+        lines.append(f"{result['blueprint_path']}: {result['status']}")
+        for severity in ("errors", "warnings"):
+            for message in result.get(severity, []):
+                location = f" [{message['graph']} / {message['node']} {message['node_guid']}]" if "node_guid" in message else ""
+                lines.append(f"  {severity[:-1]}: {message['message']}{location}")
+    if response.get("missing"):
+        lines.append(f"Could not load: {', '.join(response['missing'])}")
+    return "\n".join(lines)
+
 @mcp.tool()
 def spawn_blueprint_actor(blueprint_path: str, location: list = [0, 0, 0],
                           rotation: list = [0, 0, 0], scale: list = [1, 1, 1],
@@ -669,7 +890,7 @@ def add_component_with_events(blueprint_path: str, component_name: str, componen
     response = send_to_unreal(command)
     try:
         import json
-        result = json.loads(response)
+        result = response if isinstance(response, dict) else json.loads(response)
         if result.get("success"):
             msg = result.get("message", f"Added component {component_name}")
             if "events" in result:
@@ -764,6 +985,279 @@ def get_blueprint_node_guid(blueprint_path: str, graph_type: str = "EventGraph",
     else:
         return f"Failed to get node GUID: {response.get('error', 'Unknown error')}"
 
+def format_compile_stats(response: dict) -> str:
+    return (f"{response.get('compiles', 0)} compiles, {response.get('compile_ms_total', 0.0):.1f} ms total, "
+            f"{response.get('compile_ms_max', 0.0):.1f} ms max, {response.get('coalesced_requests', 0)} coalesced requests, "
+            f"{response.get('pending', 0)} Blueprints pending")
+
+@mcp.tool()
+def begin_blueprint_edit_session() -> str:
+    """
+    Start an edit session before many Blueprint edits. Compiles and structural updates requested by the edits are
+    coalesced into one compile per Blueprint when end_blueprint_edit_session is called (or after a minute without edits).
+    """
+    response = send_to_unreal({"type": "begin_edit_session"})
+    if response.get("success"):
+        return "Edit session started"
+    return f"Failed to start edit session: {response.get('error', 'Unknown error')}"
+
+@mcp.tool()
+def end_blueprint_edit_session() -> str:
+    """
+    End the edit session and compile every Blueprint edited during it once.
+    """
+    response = send_to_unreal({"type": "end_edit_session"})
+    if response.get("success"):
+        return f"Edit session ended: {format_compile_stats(response)}"
+    return f"Failed to end edit session: {response.get('error', 'Unknown error')}"
+
+@mcp.tool()
+def flush_blueprint_compiles(blueprint_path: str = "") -> str:
+    """
+    Compile the Blueprints whose compile is still pending right away.
+
+    Args:
+        blueprint_path: Blueprint to compile, all pending Blueprints when empty
+    """
+    response = send_to_unreal({"type": "flush_compiles", "blueprint_path": blueprint_path})
+    if response.get("success"):
+        return f"Flushed {response.get('flushed_compiles', 0)} compiles: {format_compile_stats(response)}"
+    return f"Failed to flush compiles: {response.get('error', 'Unknown error')}"
+
+@mcp.tool()
+def get_blueprint_compile_stats() -> str:
+    """
+    Get how many Blueprint compiles the MCP edits caused, how long they took and how many requests were coalesced.
+    """
+    response = send_to_unreal({"type": "get_compile_stats"})
+    if response.get("success"):
+        return format_compile_stats(response)
+    return f"Failed to get compile stats: {response.get('error', 'Unknown error')}"
+
+@mcp.tool()
+def execute_blueprint_batch(operations: list, compile: bool = True, stop_on_error: bool = True,
+                            rollback_on_error: bool = False) -> str:
+    """
+    Run many Blueprint operations in one round-trip, as one undoable transaction, compiling every touched Blueprint once at the end.
+    Prefer this over separate create_blueprint / add_variable / add_function / add_nodes_bulk / connect_nodes_bulk / compile calls.
+
+    Args:
+        operations: Ordered list of commands, each with a "type" (create_blueprint, add_variable, add_function, add_node,
+                    add_nodes_bulk, connect_nodes, connect_nodes_bulk, add_component, compile_blueprint, ...) and the same
+                    fields as the single command. Give an operation an "id" to use its result later: a string that is
+                    exactly "${bp.blueprint_path}", "${fn.function_id}" or "${nodes.nodes.<ref_id>}" is replaced by that result field.
+        compile: Compile the touched Blueprints at the end
+        stop_on_error: Stop at the first failing operation
+        rollback_on_error: Undo the batch's changes if an operation fails (created assets are kept)
+
+    Example:
+        [{"id": "bp", "type": "create_blueprint", "blueprint_name": "BP_Door"},
+         {"type": "add_variable", "blueprint_path": "${bp.blueprint_path}", "variable_name": "Speed", "variable_type": "float", "default_value": 1.0},
+         {"id": "fn", "type": "add_function", "blueprint_path": "${bp.blueprint_path}", "function_name": "Open"},
+         {"id": "nodes", "type": "add_nodes_bulk", "blueprint_path": "${bp.blueprint_path}", "function_id": "${fn.function_id}",
+          "nodes": [{"id": "print", "node_type": "PrintString", "node_position": [300, 0]}]}]
+    """
+    command = {
+        "type": "execute_batch",
+        "operations": operations,
+        "compile": compile,
+        "stop_on_error": stop_on_error,
+        "rollback_on_error": rollback_on_error
+    }
+
+    response = send_to_unreal(command)
+    results = response.get("results", [])
+    lines = []
+    for index, result in enumerate(results):
+        if result.get("success"):
+            details = {k: v for k, v in result.items() if k != "success"}
+            lines.append(f"{index}: ok {json.dumps(details) if details else ''}".rstrip())
+        else:
+            lines.append(f"{index}: failed - {result.get('error', 'Unknown error')}")
+    for compiled in response.get("compiled", []):
+        lines.append(f"compile {compiled.get('blueprint_path')}: {'ok' if compiled.get('success') else 'failed'}")
+
+    summary = "Batch succeeded" if response.get("success") else f"Batch failed: {response.get('error', 'Unknown error')}"
+    if response.get("rolled_back"):
+        summary += " (changes were rolled back)"
+    return summary + f" in {response.get('elapsed_ms', 0.0):.1f} ms\n" + "\n".join(lines)
+
+
+@mcp.tool()
+def benchmark_batch_vs_sequential(variable_count: int = 10, save_path: str = "/Game/Benchmarks") -> str:
+    """
+    Compare the wall time of building the same Blueprint (variables, a function, a compile) with one command per
+    step against a single execute_batch command. Creates two Blueprints under save_path.
+
+    Args:
+        variable_count: Number of variables added to each Blueprint
+        save_path: Folder for the benchmark Blueprints
+    """
+    suffix = time.strftime("%H%M%S")
+
+    def operations(blueprint_name, blueprint_path):
+        ops = [{"id": "bp", "type": "create_blueprint", "blueprint_name": blueprint_name, "save_path": save_path}]
+        for index in range(variable_count):
+            ops.append({"type": "add_variable", "blueprint_path": blueprint_path, "variable_name": f"Value{index}",
+                        "variable_type": "float", "default_value": float(index)})
+        ops.append({"type": "add_function", "blueprint_path": blueprint_path, "function_name": "Benchmark"})
+        ops.append({"type": "compile_blueprint", "blueprint_path": blueprint_path})
+        return ops
+
+    sequential_name = f"BP_SequentialBench_{suffix}"
+    start = time.perf_counter()
+    for operation in operations(sequential_name, f"{save_path}/{sequential_name}"):
+        response = send_to_unreal({k: v for k, v in operation.items() if k != "id"})
+        if not response.get("success"):
+            return f"Sequential path failed at {operation['type']}: {response.get('error', 'Unknown error')}"
+    sequential = time.perf_counter() - start
+
+    batch_name = f"BP_BatchBench_{suffix}"
+    start = time.perf_counter()
+    response = send_to_unreal({"type": "execute_batch", "operations": operations(batch_name, "${bp.blueprint_path}")})
+    batch = time.perf_counter() - start
+    if not response.get("success"):
+        return f"Batch path failed: {response.get('error', 'Unknown error')}"
+
+    steps = variable_count + 3
+    return (f"{steps} steps - sequential: {sequential * 1000:.1f} ms, batch: {batch * 1000:.1f} ms "
+            f"({sequential / batch if batch > 0 else 0.0:.1f}x)")
+
+
+@mcp.tool()
+def benchmark_add_nodes_bulk(batch_sizes: str = "10,100,1000", save_path: str = "/Game/Benchmarks") -> str:
+    """
+    Measure add_nodes_bulk throughput in nodes/sec. Creates one Blueprint per batch size under save_path and adds
+    that many nodes to its EventGraph in a single command.
+
+    Args:
+        batch_sizes: Comma separated node counts per batch
+        save_path: Folder for the benchmark Blueprints
+    """
+    suffix = time.strftime("%H%M%S")
+    node_types = ["Branch", "Sequence", "Add_FloatFloat", "Multiply_FloatFloat"]
+    lines = []
+    for size in [int(value) for value in batch_sizes.split(",") if value.strip()]:
+        blueprint_name = f"BP_NodesBench_{size}_{suffix}"
+        response = send_to_unreal({"type": "create_blueprint", "blueprint_name": blueprint_name, "save_path": save_path})
+        if not response.get("success"):
+            return f"Failed to create {blueprint_name}: {response.get('error', 'Unknown error')}"
+
+        nodes = [{"id": f"n{index}", "node_type": node_types[index % len(node_types)],
+                  "node_position": [(index % 20) * 300, (index // 20) * 200]} for index in range(size)]
+        start = time.perf_counter()
+        response = send_to_unreal({"type": "add_nodes_bulk", "blueprint_path": f"{save_path}/{blueprint_name}",
+                                   "function_id": "EventGraph", "nodes": nodes})
+        elapsed = time.perf_counter() - start
+        if not response.get("success"):
+            return f"Batch of {size} failed: {response.get('error', 'Unknown error')}"
+
+        added = len(response.get("nodes", {}))
+        lines.append(f"{size} nodes: {added} added in {elapsed * 1000:.1f} ms "
+                     f"({added / elapsed if elapsed > 0 else 0.0:.0f} nodes/s)")
+    return "\n".join(lines)
+
+@mcp.tool()
+def benchmark_connect_nodes_bulk(node_counts: str = "100,1000,2000", save_path: str = "/Game/Benchmarks") -> str:
+    """
+    Measure connect_nodes_bulk on large graphs. Creates one Blueprint per node count under save_path, adds a chain of
+    PrintString nodes to its EventGraph and wires every node's exec output to the next one in a single command.
+
+    Args:
+        node_counts: Comma separated node counts per graph
+        save_path: Folder for the benchmark Blueprints
+    """
+    suffix = time.strftime("%H%M%S")
+    lines = []
+    per_connection_us = {}
+    for count in [int(value) for value in node_counts.split(",") if value.strip()]:
+        blueprint_name = f"BP_WiringBench_{count}_{suffix}"
+        blueprint_path = f"{save_path}/{blueprint_name}"
+        response = send_to_unreal({"type": "create_blueprint", "blueprint_name": blueprint_name, "save_path": save_path})
+        if not response.get("success"):
+            return f"Failed to create {blueprint_name}: {response.get('error', 'Unknown error')}"
+
+        nodes = [{"id": f"n{index}", "node_type": "PrintString",
+                  "node_position": [(index % 20) * 300, (index // 20) * 200]} for index in range(count)]
+        response = send_to_unreal({"type": "add_nodes_bulk", "blueprint_path": blueprint_path,
+                                   "function_id": "EventGraph", "nodes": nodes})
+        if not response.get("success"):
+            return f"Adding {count} nodes failed: {response.get('error', 'Unknown error')}"
+
+        guids = response.get("nodes", {})
+        connections = [{"source_node_id": guids[f"n{index}"], "source_pin": "then",
+                        "target_node_id": guids[f"n{index + 1}"], "target_pin": "execute"}
+                       for index in range(count - 1) if f"n{index}" in guids and f"n{index + 1}" in guids]
+        start = time.perf_counter()
+        response = send_to_unreal({"type": "connect_nodes_bulk", "blueprint_path": blueprint_path,
+                                   "function_id": "EventGraph", "connections": connections})
+        elapsed = time.perf_counter() - start
+
+        connected = response.get("successful_connections", 0)
+        per_connection_us[count] = response.get("average_connection_ms", 0.0) * 1000
+        lines.append(f"{count} nodes: {connected}/{len(connections)} connections in {elapsed * 1000:.1f} ms round trip, "
+                     f"{response.get('elapsed_ms', 0.0):.1f} ms in the editor "
+                     f"({response.get('average_connection_ms', 0.0) * 1000:.0f} us per connection, "
+                     f"{response.get('max_connection_ms', 0.0) * 1000:.0f} us max)")
+
+    # Linear wiring keeps the cost per connection flat, a graph scan per lookup grows it with the node count
+    smallest, largest = min(per_connection_us, default=0), max(per_connection_us, default=0)
+    if largest > smallest and per_connection_us[smallest] > 0:
+        lines.append(f"Cost per connection grows {per_connection_us[largest] / per_connection_us[smallest]:.2f}x from "
+                     f"{smallest} to {largest} nodes (1.00x is linear scaling, {largest / smallest:.0f}x would be quadratic)")
+    return "\n".join(lines)
+
+
+@mcp.tool()
+def validate_blueprint(blueprint_path: str, fix: bool = False) -> str:
+    """
+    Check every graph of a Blueprint before compiling it. Reports broken or one-sided links, links between
+    incompatible pins, exec outputs with several links, nodes nothing executes and nodes connected to nothing,
+    each with its graph, node GUID and pin so they can all be fixed in one go.
+
+    Args:
+        blueprint_path: Path to the Blueprint asset
+        fix: Remove the broken links and keep only the first link of exec outputs
+
+    Returns:
+        One line per diagnostic
+    """
+    response = send_to_unreal({"type": "validate_blueprint", "blueprint_path": blueprint_path, "fix": fix})
+    if "diagnostics" not in response:
+        return f"Failed to validate Blueprint: {response.get('error', 'Unknown error')}"
+
+    lines = [f"{response.get('nodes', 0)} nodes, {response.get('links', 0)} links in {response.get('graphs', 0)} graphs: "
+             f"{response.get('errors', 0)} errors, {response.get('warnings', 0)} warnings, {response.get('fixed', 0)} fixed "
+             f"({response.get('elapsed_ms', 0.0):.1f} ms)"]
+    for diagnostic in response["diagnostics"]:
+        pin = f" pin {diagnostic['pin']}" if "pin" in diagnostic else ""
+        linked = f" -> {diagnostic['linked_node_guid']} {diagnostic.get('linked_pin', '')}" if "linked_node_guid" in diagnostic else ""
+        fixed = " (fixed)" if diagnostic.get("fixed") else ""
+        lines.append(f"{diagnostic['severity']} {diagnostic['code']}: {diagnostic['message']} "
+                     f"[{diagnostic['graph']} / {diagnostic['node']} {diagnostic['node_guid']}{pin}{linked}]{fixed}")
+    return "\n".join(lines)
+
+@mcp.tool()
+def benchmark_compile_blueprints(blueprint_paths: list) -> str:
+    """
+    Compare compiling the Blueprints one by one in the given order (as separate compile calls do) with the batched,
+    dependency ordered compile of compile_blueprints.
+
+    Args:
+        blueprint_paths: Paths to the Blueprint assets
+    """
+    timings = {}
+    for mode, sequential in (("sequential", True), ("batched", False)):
+        response = send_to_unreal({"type": "compile_blueprints", "blueprint_paths": blueprint_paths, "sequential": sequential})
+        if "blueprints" not in response:
+            return f"{mode} compile failed: {response.get('error', 'Unknown error')}"
+        timings[mode] = response.get("elapsed_ms", 0.0)
+
+    speedup = timings["sequential"] / timings["batched"] if timings["batched"] > 0 else 0.0
+    return (f"{len(blueprint_paths)} Blueprints: sequential {timings['sequential']:.1f} ms, "
+            f"batched {timings['batched']:.1f} ms ({speedup:.2f}x)")
+
+
 # Safety check for potentially destructive actions
 def is_potentially_destructive(script: str) -> bool:
     """
@@ -3,6 +3,9 @@ import json
 import unreal
 import threading
 import time
+import queue
+import re
+from collections import deque
 from typing import Dict, Any, Tuple, List, Optional
 
 # Import handlers
@@ -10,8 +13,72 @@ from handlers import basic_commands, actor_commands, blueprint_commands, python_
 from utils import logging as log
 
 # Global queues and state
-command_queue = []
-response_dict = {}
+# Entries are (command, received_time, on_complete), on_complete is called on the main thread with the response
+command_queue = deque()
+
+# Frames above this size are treated as a protocol error and the connection is closed
+MAX_FRAME_SIZE = 64 * 1024 * 1024
+
+# Time per frame spent draining the command queue, at least one command runs every frame
+COMMAND_FRAME_BUDGET_SECONDS = 0.008
+
+
+class CommandStats:
+    """
+    Queue depth, wait time and throughput of the command pump
+    """
+    def __init__(self):
+        self.reset()
+
+    def reset(self):
+        self.peak_queue_depth = len(command_queue)
+        self.commands_executed = 0
+        self.total_wait = 0.0
+        self.max_wait = 0.0
+        self.total_execute = 0.0
+        self.window_start = 0.0
+        self.window_commands = 0
+        self.last_execute = 0.0
+        self.commands_per_second = 0.0
+
+    def record(self, wait, execute):
+        self.commands_executed += 1
+        self.total_wait += wait
+        self.max_wait = max(self.max_wait, wait)
+        self.total_execute += execute
+
+    def end_frame(self, frame_start, executed):
+        # Throughput is measured over windows of at most one second, a window also ends once the queue stays idle
+        now = time.perf_counter()
+        if executed:
+            if self.window_commands == 0:
+                self.window_start = frame_start
+            self.window_commands += executed
+            self.last_execute = now
+        window_full = now - self.window_start >= 1.0
+        window_idle = not executed and now - self.last_execute >= 0.25
+        if self.window_commands and (window_full or window_idle):
+            self.commands_per_second = self.current_rate()
+            self.window_commands = 0
+
+    def current_rate(self):
+        return self.window_commands / max(self.last_execute - self.window_start, 0.001)
+
+    def to_dict(self):
+        executed = self.commands_executed
+        return {
+            "success": True,
+            "queue_depth": len(command_queue),
+            "peak_queue_depth": self.peak_queue_depth,
+            "commands_executed": executed,
+            "average_wait_ms": self.total_wait * 1000.0 / executed if executed else 0.0,
+            "max_wait_ms": self.max_wait * 1000.0,
+            "average_execute_ms": self.total_execute * 1000.0 / executed if executed else 0.0,
+            "commands_per_second": self.current_rate() if self.window_commands else self.commands_per_second
+        }
+
+
+command_stats = CommandStats()
 
 
 class CommandDispatcher:
@@ -22,6 +89,7 @@ class CommandDispatcher:
         # Register command handlers
         self.handlers = {
             "handshake": self._handle_handshake,
+            "get_command_stats": self._handle_command_stats,
 
             # Basic object commands
             "spawn": basic_commands.handle_spawn,
@@ -36,6 +104,8 @@ class CommandDispatcher:
             "add_node": blueprint_commands.handle_add_node,
             "connect_nodes": blueprint_commands.handle_connect_nodes,
             "compile_blueprint": blueprint_commands.handle_compile_blueprint,
+            "compile_blueprints": blueprint_commands.handle_compile_blueprints,
+            "validate_blueprint": blueprint_commands.handle_validate_blueprint,
             "spawn_blueprint": blueprint_commands.handle_spawn_blueprint,
             "delete_node": blueprint_commands.handle_delete_node,
             
@@ -43,11 +113,20 @@ class CommandDispatcher:
             "get_node_guid": blueprint_commands.handle_get_node_guid,
             "get_all_nodes": blueprint_commands.handle_get_all_nodes,
             "get_node_suggestions": blueprint_commands.handle_get_node_suggestions,
+            "benchmark_node_lookup": blueprint_commands.handle_benchmark_node_lookup,
+            "reload_node_aliases": blueprint_commands.handle_reload_node_aliases,
             
             
             # Bulk commands
             "add_nodes_bulk": blueprint_commands.handle_add_nodes_bulk,      # Add this line
             "connect_nodes_bulk": blueprint_commands.handle_connect_nodes_bulk,
+            "execute_batch": blueprint_commands.handle_execute_batch,
+
+            # Edit sessions
+            "begin_edit_session": blueprint_commands.handle_begin_edit_session,
+            "end_edit_session": blueprint_commands.handle_end_edit_session,
+            "flush_compiles": blueprint_commands.handle_flush_compiles,
+            "get_compile_stats": blueprint_commands.handle_get_compile_stats,
             
             # Python and console
             "execute_python": python_commands.handle_execute_python,
@@ -85,68 +164,180 @@ class CommandDispatcher:
         log.log_info(f"Handshake received: {message}")
         return {"success": True, "message": f"Received: {message}"}
 
+    def _handle_command_stats(self, command: Dict[str, Any]) -> Dict[str, Any]:
+        """Command pump metrics, "reset": true starts a new measurement after reading them"""
+        stats = command_stats.to_dict()
+        if command.get("reset"):
+            command_stats.reset()
+        return stats
+
 
 # Create global dispatcher instance
 dispatcher = CommandDispatcher()
 
 
 def process_commands(delta_time=None):
-    """Process commands on the main thread"""
-    if not command_queue:
+    """Process queued commands on the main thread until the frame budget is used up"""
+    frame_start = time.perf_counter()
+    command_stats.peak_queue_depth = max(command_stats.peak_queue_depth, len(command_queue))
+
+    executed = 0
+    while command_queue and (executed == 0 or time.perf_counter() - frame_start < COMMAND_FRAME_BUDGET_SECONDS):
+        command, received_time, on_complete = command_queue.popleft()
+        log.log_info(f"Processing command on main thread: {command}")
+
+        dispatch_start = time.perf_counter()
+        try:
+            response = dispatcher.dispatch(command)
+        except Exception as e:
+            log.log_error(f"Error processing command: {str(e)}", include_traceback=True)
+            response = {"success": False, "error": str(e)}
+        command_stats.record(dispatch_start - received_time, time.perf_counter() - dispatch_start)
+        executed += 1
+
+        on_complete(response)
+
+    command_stats.end_frame(frame_start, executed)
+
+
+REQUEST_ID_PATTERN = re.compile(rb'"request_id"\s*:\s*(-?\d+|"(?:[^"\\]|\\.)*")')
+
+
+def find_request_id(payload):
+    """request_id of a command that is not valid JSON, read from its last "request_id" field when that part is intact"""
+    matches = REQUEST_ID_PATTERN.findall(payload)
+    if not matches:
+        return None
+    try:
+        return json.loads(matches[-1].decode('utf-8'))
+    except ValueError:
+        return None
+
+
+def _recv_exact(conn, size, buffer=b""):
+    data = bytearray(buffer)
+    while len(data) < size:
+        chunk = conn.recv(max(size - len(data), 65536))
+        if not chunk:
+            raise ConnectionError("Connection closed by client")
+        data.extend(chunk)
+    return bytes(data[:size]), bytes(data[size:])
+
+
+def serve_single_command(conn, data):
+    """Legacy protocol: one raw JSON command per connection, answered with one raw JSON response"""
+    command = json.loads(data.decode())
+    log.log_info(f"Received command: {command}")
+
+    # For handshake, we can respond directly from the thread
+    if command.get("type") == "handshake":
+        conn.sendall(json.dumps(dispatcher.dispatch(command)).encode())
         return
 
-    command_id, command = command_queue.pop(0)
-    log.log_info(f"Processing command on main thread: {command}")
+    # For other commands, queue them for main thread execution
+    done = threading.Event()
+    result = []
+
+    def on_complete(response):
+        result.append(response)
+        done.set()
+
+    command_queue.append((command, time.perf_counter(), on_complete))
+
+    # Wait for the response with a timeout, the main thread signals as soon as it is ready
+    timeout = 10  # seconds
+    if done.wait(timeout):
+        conn.sendall(json.dumps(result[0]).encode())
+    else:
+        conn.sendall(json.dumps({"success": False, "error": "Command timed out"}).encode())
+
+
+def serve_framed_client(conn, buffer):
+    """
+    Persistent protocol: every message is a 4-byte big-endian length followed by a UTF-8 JSON command.
+    Commands are queued as they arrive, so many can be in flight, and responses carry the command's
+    request_id since they can complete in any order.
+    """
+    outgoing = queue.Queue()
+
+    def writer():
+        while True:
+            payload = outgoing.get()
+            if payload is None:
+                return
+            try:
+                conn.sendall(len(payload).to_bytes(4, 'big') + payload)
+            except OSError:
+                return
+
+    writer_thread = threading.Thread(target=writer, daemon=True)
+    writer_thread.start()
+
+    def reply(request_id, response):
+        if request_id is not None:
+            response = dict(response, request_id=request_id)
+        outgoing.put(json.dumps(response).encode('utf-8'))
 
     try:
-        response = dispatcher.dispatch(command)
-        response_dict[command_id] = response
+        while True:
+            header, buffer = _recv_exact(conn, 4, buffer)
+            size = int.from_bytes(header, 'big')
+            if size > MAX_FRAME_SIZE:
+                log.log_error(f"Received a {size} byte frame, closing connection")
+                return
+            payload, buffer = _recv_exact(conn, size, buffer)
+
+            try:
+                command = json.loads(payload.decode('utf-8'))
+            except ValueError:
+                # Without an id the client cannot tell which request failed, closing the connection fails all of them
+                request_id = find_request_id(payload)
+                if request_id is None:
+                    log.log_error("Received invalid JSON without a request_id, closing connection")
+                    return
+                reply(request_id, {"success": False, "error": "Invalid JSON format"})
+                continue
+
+            request_id = command.get("request_id")
+            if command.get("type") == "handshake":
+                reply(request_id, dispatcher.dispatch(command))
+            else:
+                command_queue.append((command, time.perf_counter(),
+                                      lambda response, request_id=request_id: reply(request_id, response)))
+    except ConnectionError:
+        pass
+    finally:
+        outgoing.put(None)
+        writer_thread.join()
+
+
+def client_thread(conn):
+    """Serves one client, raw JSON (legacy) and length-prefixed connections are told apart by the first byte"""
+    try:
+        data = conn.recv(4096)
+        if data:
+            if data.lstrip()[:1] == b"{":
+                serve_single_command(conn, data)
+            else:
+                serve_framed_client(conn, data)
     except Exception as e:
-        log.log_error(f"Error processing command: {str(e)}", include_traceback=True)
-        response_dict[command_id] = {"success": False, "error": str(e)}
+        log.log_error(f"Error in socket server: {str(e)}", include_traceback=True)
+    finally:
+        conn.close()
 
 
 def socket_server_thread():
-    """Socket server running in a separate thread"""
+    """Socket server running in a separate thread, every client gets its own thread"""
     server_socket = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
     server_socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
     server_socket.bind(('localhost', 9877))
-    server_socket.listen(1)
+    server_socket.listen(16)
     log.log_info("Unreal Engine socket server started on port 9877")
 
-    command_counter = 0
-
     while True:
         try:
             conn, addr = server_socket.accept()
-            data = conn.recv(4096)
-            if data:
-                command = json.loads(data.decode())
-                log.log_info(f"Received command: {command}")
-
-                # For handshake, we can respond directly from the thread
-                if command.get("type") == "handshake":
-                    response = dispatcher.dispatch(command)
-                    conn.sendall(json.dumps(response).encode())
-                else:
-                    # For other commands, queue them for main thread execution
-                    command_id = command_counter
-                    command_counter += 1
-                    command_queue.append((command_id, command))
-
-                    # Wait for the response with a timeout
-                    timeout = 10  # seconds
-                    start_time = time.time()
-                    while command_id not in response_dict and time.time() - start_time < timeout:
-                        time.sleep(0.1)
-
-                    if command_id in response_dict:
-                        response = response_dict.pop(command_id)
-                        conn.sendall(json.dumps(response).encode())
-                    else:
-                        error_response = {"success": False, "error": "Command timed out"}
-                        conn.sendall(json.dumps(error_response).encode())
-            conn.close()
+            threading.Thread(target=client_thread, args=(conn,), daemon=True).start()
         except Exception as e:
             log.log_error(f"Error in socket server: {str(e)}", include_traceback=True)
 
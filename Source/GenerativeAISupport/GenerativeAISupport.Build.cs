@@ -46,13 +46,20 @@ public class GenerativeAISupport : ModuleRules
 				"Slate",
 				"SlateCore",
 				"Json",
+				"JsonUtilities",
 				"HTTP",
+				"HTTPServer",
+				"Sockets",
+				"Networking",
+				"ImageWrapper",
 				"EditorScriptingUtilities",
 				"Blutility",
 				"UnrealEd",
 				"MaterialEditor",
 				"MaterialUtilities",
 				"BlueprintGraph",
+				"Kismet",
+				"Projects",
 				"FunctionalTesting"
 				// ... add private dependencies that you statically link with here ...	
 			}
@@ -64,7 +71,8 @@ public class GenerativeAISupport : ModuleRules
 				new string[]
 				{
 					// Your existing dependencies...
-					"Settings"
+					"Settings",
+					"DirectoryWatcher"
 					// PythonScriptPlugin is no longer needed here
 				}
 			);
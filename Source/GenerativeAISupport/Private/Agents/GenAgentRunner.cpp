@@ -0,0 +1,394 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Agents/GenAgentRunner.h"
+
+#include "Http.h"
+#include "Data/GenAIOrgs.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	using FCondensedJsonWriterFactory = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>;
+
+	EGenToolFormat GetToolFormat(EGenAgentProvider Provider)
+	{
+		return Provider == EGenAgentProvider::Anthropic ? EGenToolFormat::Anthropic : EGenToolFormat::OpenAI;
+	}
+
+	double ElapsedMs(double StartTime)
+	{
+		return (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	}
+}
+
+UGenAgentRunner* UGenAgentRunner::RunAgent(const FGenAgentSettings& AgentSettings, const FOnAgentComplete& OnComplete,
+                                           const FOnAgentStep& OnStep)
+{
+	UGenAgentRunner* Runner = NewObject<UGenAgentRunner>();
+	Runner->AgentSettings = AgentSettings;
+	Runner->NativeOnComplete = OnComplete;
+	Runner->NativeOnStep = OnStep;
+
+	// Not owned by a Blueprint graph, so it is kept alive until the run finishes
+	Runner->AddToRoot();
+	Runner->bRootedNative = true;
+	Runner->Activate();
+	return Runner;
+}
+
+UGenAgentRunner* UGenAgentRunner::RunGenAgent(UObject* WorldContextObject, const FGenAgentSettings& AgentSettings)
+{
+	UGenAgentRunner* Runner = NewObject<UGenAgentRunner>();
+	Runner->AgentSettings = AgentSettings;
+	return Runner;
+}
+
+void UGenAgentRunner::Activate()
+{
+	if (bStarted)
+	{
+		return;
+	}
+	bStarted = true;
+	RunStartTime = FPlatformTime::Seconds();
+
+	BuildPayloadPrefix();
+	SendStep();
+}
+
+void UGenAgentRunner::Cancel()
+{
+	if (bFinished)
+	{
+		Super::Cancel();
+		return;
+	}
+
+	if (CurrentRequest.IsValid())
+	{
+		CurrentRequest->OnProcessRequestComplete().Unbind();
+		CurrentRequest->CancelRequest();
+		CurrentRequest.Reset();
+	}
+	Finish(LastText, TEXT("Cancelled"), false);
+}
+
+void UGenAgentRunner::SendStep()
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	if (Steps.Num() >= AgentSettings.MaxSteps)
+	{
+		Finish(LastText, TEXT("Max steps reached"), false);
+		return;
+	}
+	if (AgentSettings.MaxTotalTokens > 0 && TotalTokens >= AgentSettings.MaxTotalTokens)
+	{
+		Finish(LastText, TEXT("Token budget exhausted"), false);
+		return;
+	}
+
+	EGenAIOrgs Org = EGenAIOrgs::OpenAI;
+	FString URL = TEXT("https://api.openai.com/v1/chat/completions");
+	if (AgentSettings.Provider == EGenAgentProvider::DeepSeek)
+	{
+		Org = EGenAIOrgs::DeepSeek;
+		URL = TEXT("https://api.deepseek.com/chat/completions");
+	}
+	else if (AgentSettings.Provider == EGenAgentProvider::Anthropic)
+	{
+		Org = EGenAIOrgs::Anthropic;
+		URL = TEXT("https://api.anthropic.com/v1/messages");
+	}
+
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(Org);
+	if (ApiKey.IsEmpty() && AgentSettings.EndpointOverride.IsEmpty())
+	{
+		Finish(TEXT(""), TEXT("API key not set"), false);
+		return;
+	}
+
+	CurrentStep = FGenAgentStepInfo();
+	CurrentStep.StepIndex = Steps.Num();
+
+	const double EncodeStartTime = FPlatformTime::Seconds();
+	EncodeNewMessages();
+	const FString PayloadString = PayloadPrefix + TEXT("\"messages\":[") + EncodedHistory + TEXT("]}");
+	CurrentStep.EncodeMs = ElapsedMs(EncodeStartTime);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(AgentSettings.EndpointOverride.IsEmpty() ? URL : AgentSettings.EndpointOverride);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	if (AgentSettings.Provider == EGenAgentProvider::Anthropic)
+	{
+		HttpRequest->SetHeader(TEXT("x-api-key"), ApiKey);
+		HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));
+	}
+	else
+	{
+		HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	}
+
+	const TWeakObjectPtr<UGenAgentRunner> WeakThis(this);
+	const double RequestStartTime = FPlatformTime::Seconds();
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[WeakThis, Org, RequestStartTime](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(Org, Request, Response);
+			UGenAgentRunner* Runner = WeakThis.Get();
+			if (!Runner || Runner->bFinished)
+			{
+				return;
+			}
+
+			Runner->CurrentRequest.Reset();
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Agent request failed, Response code: %d"),
+				       Response.IsValid() ? Response->GetResponseCode() : -1);
+				Runner->Finish(Runner->LastText, TEXT("Request failed"), false);
+				return;
+			}
+			Runner->HandleResponse(Response->GetContentAsString(), RequestStartTime);
+		});
+
+	CurrentRequest = HttpRequest;
+	if (EncodedImages->Num() > 0)
+	{
+		FGenImageUtils::ProcessRequestWithImages(HttpRequest, PayloadString, EncodedImages, [WeakThis](const FString& Error)
+		{
+			if (UGenAgentRunner* Runner = WeakThis.Get())
+			{
+				Runner->CurrentRequest.Reset();
+				Runner->Finish(Runner->LastText, Error, false);
+			}
+		});
+	}
+	else
+	{
+		HttpRequest->SetContentAsString(PayloadString);
+		HttpRequest->ProcessRequest();
+	}
+}
+
+void UGenAgentRunner::HandleResponse(const FString& ResponseStr, double RequestStartTime)
+{
+	FString Text;
+	FString Error;
+	TArray<FGenToolCall> Calls;
+	int32 Tokens = 0;
+	if (!ParseResponse(ResponseStr, AgentSettings.Provider, Text, Calls, Tokens, Error))
+	{
+		UE_LOG(LogGenAI, Error, TEXT("Agent step %d failed: %s"), CurrentStep.StepIndex, *Error);
+		Finish(LastText, Error, false);
+		return;
+	}
+
+	CurrentStep.RequestMs = ElapsedMs(RequestStartTime);
+	CurrentStep.TotalTokens = Tokens;
+	CurrentStep.NumToolCalls = Calls.Num();
+	TotalTokens += Tokens;
+	if (!Text.IsEmpty())
+	{
+		LastText = Text;
+	}
+
+	if (Calls.Num() == 0)
+	{
+		CompleteStep();
+		Finish(Text, TEXT(""), true);
+		return;
+	}
+
+	const TWeakObjectPtr<UGenAgentRunner> WeakThis(this);
+	const double ToolStartTime = FPlatformTime::Seconds();
+	FGenToolRegistry::Get().ExecuteToolCalls(Calls, [WeakThis, Calls, Text, ToolStartTime](const TArray<FGenToolResult>& Results)
+	{
+		if (UGenAgentRunner* Runner = WeakThis.Get())
+		{
+			Runner->HandleToolResults(Calls, Text, Results, ToolStartTime);
+		}
+	});
+}
+
+void UGenAgentRunner::HandleToolResults(const TArray<FGenToolCall>& Calls, const FString& AssistantText,
+                                        const TArray<FGenToolResult>& Results, double ToolStartTime)
+{
+	if (bFinished)
+	{
+		return;
+	}
+
+	CurrentStep.ToolMs = ElapsedMs(ToolStartTime);
+	FGenToolCallCodec::AppendToolRound(AgentSettings.Messages, AssistantText, Calls, Results);
+	CompleteStep();
+	SendStep();
+}
+
+void UGenAgentRunner::CompleteStep()
+{
+	UE_LOG(LogGenPerformance, Display, TEXT("Agent step %d: encode %.3f ms, request %.1f ms, tools %.1f ms, %d tool calls, %d tokens"),
+	       CurrentStep.StepIndex, CurrentStep.EncodeMs, CurrentStep.RequestMs, CurrentStep.ToolMs,
+	       CurrentStep.NumToolCalls, CurrentStep.TotalTokens);
+
+	Steps.Add(CurrentStep);
+	NativeOnStep.ExecuteIfBound(CurrentStep);
+	OnStep.Broadcast(CurrentStep);
+}
+
+void UGenAgentRunner::Finish(const FString& Response, const FString& Error, bool bSuccess)
+{
+	if (bFinished)
+	{
+		return;
+	}
+	bFinished = true;
+
+	LOG_TIME_ELAPSED(RunStartTime, *FString::Printf(TEXT("Agent run with %d steps"), Steps.Num()));
+
+	NativeOnComplete.ExecuteIfBound(Response, Error, bSuccess);
+	OnComplete.Broadcast(Response, Error, bSuccess);
+
+	if (bRootedNative)
+	{
+		RemoveFromRoot();
+		bRootedNative = false;
+	}
+	Super::Cancel();
+}
+
+void UGenAgentRunner::BuildPayloadPrefix()
+{
+	const EGenToolFormat Format = GetToolFormat(AgentSettings.Provider);
+
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+	JsonPayload->SetStringField(TEXT("model"), AgentSettings.Model);
+	JsonPayload->SetNumberField(AgentSettings.Provider == EGenAgentProvider::OpenAI ? TEXT("max_completion_tokens") : TEXT("max_tokens"),
+	                            AgentSettings.MaxTokensPerStep);
+
+	// Anthropic takes the system prompt as a top-level field instead of a message
+	if (AgentSettings.Provider == EGenAgentProvider::Anthropic)
+	{
+		FString SystemPrompt;
+		for (const FGenChatMessage& Message : AgentSettings.Messages)
+		{
+			if (Message.Role == TEXT("system"))
+			{
+				SystemPrompt += SystemPrompt.IsEmpty() ? Message.Content : TEXT("\n") + Message.Content;
+			}
+		}
+		if (!SystemPrompt.IsEmpty())
+		{
+			JsonPayload->SetStringField(TEXT("system"), SystemPrompt);
+		}
+	}
+
+	FGenToolCallCodec::WriteTools(JsonPayload, AgentSettings.Tools, AgentSettings.ToolChoice, Format);
+
+	FString PayloadString;
+	const auto Writer = FCondensedJsonWriterFactory::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+
+	// Drop the closing brace, the messages array is appended for every request
+	PayloadPrefix = PayloadString.LeftChop(1) + TEXT(",");
+}
+
+void UGenAgentRunner::EncodeNewMessages()
+{
+	const bool bAnthropic = AgentSettings.Provider == EGenAgentProvider::Anthropic;
+
+	TArray<FGenChatMessage> NewMessages;
+	for (int32 Index = EncodedMessageCount; Index < AgentSettings.Messages.Num(); ++Index)
+	{
+		if (!bAnthropic || AgentSettings.Messages[Index].Role != TEXT("system"))
+		{
+			NewMessages.Add(AgentSettings.Messages[Index]);
+		}
+	}
+	EncodedMessageCount = AgentSettings.Messages.Num();
+
+	// Appended messages always form whole tool rounds, so they can be encoded on their own.
+	// Their images are added to the attachments of the earlier steps.
+	for (const TSharedPtr<FJsonValue>& MessageValue : FGenToolCallCodec::WriteMessages(NewMessages, GetToolFormat(AgentSettings.Provider), &EncodedImages.Get()))
+	{
+		FString EncodedMessage;
+		const auto Writer = FCondensedJsonWriterFactory::Create(&EncodedMessage);
+		FJsonSerializer::Serialize(MessageValue->AsObject().ToSharedRef(), Writer);
+
+		if (!EncodedHistory.IsEmpty())
+		{
+			EncodedHistory.AppendChar(TEXT(','));
+		}
+		EncodedHistory.Append(EncodedMessage);
+	}
+}
+
+bool UGenAgentRunner::ParseResponse(const FString& ResponseStr, EGenAgentProvider Provider, FString& OutText,
+                                    TArray<FGenToolCall>& OutCalls, int32& OutTokens, FString& OutError)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		OutError = TEXT("Failed to parse JSON");
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* ErrorObject;
+	if (JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
+	{
+		if (!(*ErrorObject)->TryGetStringField(TEXT("message"), OutError))
+		{
+			OutError = TEXT("Unknown error");
+		}
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* UsageObject;
+	const bool bHasUsage = JsonObject->TryGetObjectField(TEXT("usage"), UsageObject);
+
+	if (Provider == EGenAgentProvider::Anthropic)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* ContentArray;
+		if (!JsonObject->TryGetArrayField(TEXT("content"), ContentArray))
+		{
+			OutError = TEXT("Unexpected JSON structure");
+			return false;
+		}
+		FGenToolCallCodec::ReadAnthropicContent(*ContentArray, OutText, OutCalls);
+
+		if (bHasUsage)
+		{
+			OutTokens = (*UsageObject)->GetIntegerField(TEXT("input_tokens")) + (*UsageObject)->GetIntegerField(TEXT("output_tokens"));
+		}
+		return true;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Choices;
+	const TSharedPtr<FJsonObject>* MessageObject;
+	if (!JsonObject->TryGetArrayField(TEXT("choices"), Choices) || Choices->Num() == 0 ||
+		!(*Choices)[0]->AsObject()->TryGetObjectField(TEXT("message"), MessageObject))
+	{
+		OutError = TEXT("Unexpected JSON structure");
+		return false;
+	}
+
+	(*MessageObject)->TryGetStringField(TEXT("content"), OutText);
+	FGenToolCallCodec::ReadOpenAIToolCalls(*MessageObject, OutCalls);
+
+	if (bHasUsage)
+	{
+		OutTokens = (*UsageObject)->GetIntegerField(TEXT("total_tokens"));
+	}
+	return true;
+}
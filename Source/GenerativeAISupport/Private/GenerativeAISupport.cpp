@@ -5,6 +5,13 @@
 #include "ISettingsModule.h"
 #endif
 #include "GenerativeAISupportSettings.h"
+#include "MCP/GenCommandExecutor.h"
+#include "MCP/GenCommandServer.h"
+#include "MCP/GenEditSession.h"
+#include "MCP/GenFunctionIndex.h"
+#include "MCP/GenNodeGuidIndex.h"
+#include "MCP/GenNodeTypeRegistry.h"
+#include "Secure/GenSecureKey.h"
 #include "ISettingsSection.h"
 
 #define LOCTEXT_NAMESPACE "FGenerativeAISupportModule"
@@ -16,10 +23,35 @@ void FGenerativeAISupportModule::StartupModule()
 
     // Register project settings
     RegisterSettings();
+
+    // Resolve the API keys once, requests read them from the cache
+    UGenSecureKey::RefreshApiKeys();
+
+#if WITH_EDITOR
+    const UGenerativeAISupportSettings* Settings = GetDefault<UGenerativeAISupportSettings>();
+    if (Settings->AutoStartNativeCommandServer)
+    {
+        FGenCommandServer::Get().Start(Settings->NativeCommandServerPort);
+    }
+
+    // Catalog of the callable functions node types are resolved against, loaded from its cache and refreshed in the background
+    FGenFunctionIndex::Get().Start();
+
+    // Node type aliases and recipes, reloaded whenever Config/NodeTypeAliases.json changes
+    FGenNodeTypeRegistry::Get().Reload();
+    FGenNodeTypeRegistry::Get().StartWatching();
+#endif
 }
 
 void FGenerativeAISupportModule::ShutdownModule()
 {
+    FGenCommandServer::Get().Shutdown();
+    FGenCommandExecutor::Get().Shutdown();
+    FGenFunctionIndex::Get().Shutdown();
+    FGenNodeGuidIndex::Get().Shutdown();
+    FGenEditSession::Get().Shutdown();
+    FGenNodeTypeRegistry::Get().StopWatching();
+
     // Unregister settings
     UnregisterSettings();
 }
@@ -0,0 +1,231 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenBlueprintCompiler.h"
+
+#include "BlueprintCompilationManager.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Logging/TokenizedMessage.h"
+#include "MCP/GenEditSession.h"
+#include "MCP/GenGraphValidator.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	const TCHAR* GetStatusName(const EBlueprintStatus Status)
+	{
+		switch (Status)
+		{
+		case BS_Dirty: return TEXT("dirty");
+		case BS_Error: return TEXT("error");
+		case BS_UpToDate: return TEXT("up_to_date");
+		case BS_UpToDateWithWarnings: return TEXT("up_to_date_with_warnings");
+		case BS_BeingCreated: return TEXT("being_created");
+		default: return TEXT("unknown");
+		}
+	}
+}
+
+TSharedPtr<FJsonObject> FGenBlueprintCompiler::Compile(const TArray<UBlueprint*>& Blueprints, bool bSequential)
+{
+	TArray<UBlueprint*> Ordered;
+	if (bSequential)
+	{
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			if (Blueprint)
+			{
+				Ordered.AddUnique(Blueprint);
+			}
+		}
+	}
+	else
+	{
+		Ordered = SortByDependencies(Blueprints);
+	}
+
+	// Same link repair as a single compile, done before timing so both modes compile the same graphs
+	TMap<UBlueprint*, int32> FixedLinks;
+	for (UBlueprint* Blueprint : Ordered)
+	{
+		FixedLinks.Add(Blueprint, static_cast<int32>(FGenGraphValidator::Validate(Blueprint, EGenGraphFix::ExecLinks)->GetNumberField(TEXT("fixed"))));
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	if (bSequential)
+	{
+		for (UBlueprint* Blueprint : Ordered)
+		{
+			FKismetEditorUtilities::CompileBlueprint(Blueprint);
+		}
+	}
+	else if (Ordered.Num() > 0)
+	{
+		for (UBlueprint* Blueprint : Ordered)
+		{
+			FBlueprintCompilationManager::QueueForCompilation(Blueprint);
+		}
+		FBlueprintCompilationManager::FlushCompilationQueueAndReinstance();
+	}
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	FGenEditSession::Get().RecordCompiles(Ordered, ElapsedMs);
+
+	UE_LOG(LogGenPerformance, Display, TEXT("Compiling %d blueprints (%s) took: %f ms"), Ordered.Num(),
+	       bSequential ? TEXT("sequential") : TEXT("batched"), ElapsedMs);
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	int32 ErrorCount = 0;
+	int32 WarningCount = 0;
+	bool bSuccess = true;
+	for (UBlueprint* Blueprint : Ordered)
+	{
+		const TSharedPtr<FJsonObject> Result = MakeBlueprintResult(Blueprint);
+		Result->SetNumberField(TEXT("fixed_links"), FixedLinks.FindRef(Blueprint));
+		ErrorCount += Result->GetArrayField(TEXT("errors")).Num();
+		WarningCount += Result->GetArrayField(TEXT("warnings")).Num();
+		bSuccess &= Result->GetBoolField(TEXT("success"));
+		Results.Add(MakeShareable(new FJsonValueObject(Result)));
+	}
+
+	const TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+	Response->SetBoolField(TEXT("success"), bSuccess);
+	Response->SetStringField(TEXT("mode"), bSequential ? TEXT("sequential") : TEXT("batched"));
+	Response->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+	Response->SetNumberField(TEXT("errors"), ErrorCount);
+	Response->SetNumberField(TEXT("warnings"), WarningCount);
+	Response->SetArrayField(TEXT("blueprints"), Results);
+	return Response;
+}
+
+TArray<UBlueprint*> FGenBlueprintCompiler::SortByDependencies(const TArray<UBlueprint*>& Blueprints)
+{
+	TArray<UBlueprint*> Unique;
+	TMap<UBlueprint*, int32> Indices;
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		if (Blueprint && !Indices.Contains(Blueprint))
+		{
+			Indices.Add(Blueprint, Unique.Add(Blueprint));
+		}
+	}
+
+	// Edges from a Blueprint to the Blueprints of the set that need it compiled first
+	TArray<TArray<int32>> Dependents;
+	TArray<int32> DependencyCounts;
+	Dependents.SetNum(Unique.Num());
+	DependencyCounts.SetNumZeroed(Unique.Num());
+	for (int32 Index = 0; Index < Unique.Num(); ++Index)
+	{
+		UBlueprint* Blueprint = Unique[Index];
+		TSet<int32> DependencyIndices;
+		for (UClass* Class = Blueprint->ParentClass; Class; Class = Class->GetSuperClass())
+		{
+			if (const int32* ParentIndex = Indices.Find(UBlueprint::GetBlueprintFromClass(Class)))
+			{
+				DependencyIndices.Add(*ParentIndex);
+			}
+		}
+
+		TSet<TWeakObjectPtr<UBlueprint>> Dependencies;
+		TSet<TWeakObjectPtr<UStruct>> StructDependencies;
+		FBlueprintEditorUtils::GatherDependencies(Blueprint, Dependencies, StructDependencies);
+		for (const TWeakObjectPtr<UBlueprint>& Dependency : Dependencies)
+		{
+			if (const int32* DependencyIndex = Indices.Find(Dependency.Get()))
+			{
+				DependencyIndices.Add(*DependencyIndex);
+			}
+		}
+
+		DependencyIndices.Remove(Index);
+		for (const int32 DependencyIndex : DependencyIndices)
+		{
+			Dependents[DependencyIndex].Add(Index);
+		}
+		DependencyCounts[Index] = DependencyIndices.Num();
+	}
+
+	// Kahn's algorithm, Blueprints become ready in the given order
+	TArray<UBlueprint*> Ordered;
+	Ordered.Reserve(Unique.Num());
+	TArray<int32> Ready;
+	for (int32 Index = 0; Index < Unique.Num(); ++Index)
+	{
+		if (DependencyCounts[Index] == 0)
+		{
+			Ready.Add(Index);
+		}
+	}
+	for (int32 ReadyIndex = 0; ReadyIndex < Ready.Num(); ++ReadyIndex)
+	{
+		const int32 Index = Ready[ReadyIndex];
+		Ordered.Add(Unique[Index]);
+		for (const int32 Dependent : Dependents[Index])
+		{
+			if (--DependencyCounts[Dependent] == 0)
+			{
+				Ready.Add(Dependent);
+			}
+		}
+	}
+
+	// The compilation manager compiles a cycle in the same pass, so its members just keep their order
+	if (Ordered.Num() < Unique.Num())
+	{
+		for (int32 Index = 0; Index < Unique.Num(); ++Index)
+		{
+			if (DependencyCounts[Index] > 0)
+			{
+				Ordered.Add(Unique[Index]);
+			}
+		}
+	}
+	return Ordered;
+}
+
+TSharedPtr<FJsonObject> FGenBlueprintCompiler::MakeBlueprintResult(UBlueprint* Blueprint)
+{
+	TArray<TSharedPtr<FJsonValue>> Errors;
+	TArray<TSharedPtr<FJsonValue>> Warnings;
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+	for (const UEdGraph* Graph : Graphs)
+	{
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node || !Node->bHasCompilerMessage || Node->ErrorType > EMessageSeverity::Warning)
+			{
+				continue;
+			}
+
+			const TSharedPtr<FJsonObject> Message = MakeShareable(new FJsonObject());
+			Message->SetStringField(TEXT("message"), Node->ErrorMsg);
+			Message->SetStringField(TEXT("graph"), Graph->GetName());
+			Message->SetStringField(TEXT("node"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			Message->SetStringField(TEXT("node_guid"), Node->NodeGuid.ToString());
+			(Node->ErrorType <= EMessageSeverity::Error ? Errors : Warnings).Add(MakeShareable(new FJsonValueObject(Message)));
+		}
+	}
+
+	// Failures outside of the graphs (e.g. a missing parent class) leave no node message
+	if (Blueprint->Status == BS_Error && Errors.Num() == 0)
+	{
+		const TSharedPtr<FJsonObject> Message = MakeShareable(new FJsonObject());
+		Message->SetStringField(TEXT("message"), TEXT("Blueprint failed to compile, see the compiler results in the editor"));
+		Errors.Add(MakeShareable(new FJsonValueObject(Message)));
+	}
+
+	const TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+	Result->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
+	Result->SetBoolField(TEXT("success"), Blueprint->Status != BS_Error);
+	Result->SetStringField(TEXT("status"), GetStatusName(Blueprint->Status));
+	Result->SetArrayField(TEXT("errors"), Errors);
+	Result->SetArrayField(TEXT("warnings"), Warnings);
+	return Result;
+}
@@ -3,6 +3,10 @@
 // source tree or http://opensource.org/licenses/MIT.
 
 #include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenEditSession.h"
+#include "MCP/GenFunctionIndex.h"
+#include "MCP/GenNodeGuidIndex.h"
+#include "MCP/GenNodeTypeRegistry.h"
 #include "K2Node_CallFunction.h"
 #include "K2Node_ExecutionSequence.h"
 #include "K2Node_IfThenElse.h"
@@ -28,9 +32,9 @@
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "UObject/UnrealTypePrivate.h"
+#include "Utilities/GenGlobalDefinitions.h"
 
 
-TMap<FString, FString> UGenBlueprintNodeCreator::NodeTypeMap;
 bool IsBlueprintDirty = false;
 
 
@@ -53,106 +57,34 @@ FString UGenBlueprintNodeCreator::AddNode(const FString& BlueprintPath, const FS
 		return TEXT("");
 	}
 
+	// Function and variable nodes read their pins from the skeleton class, it has to include edits still waiting to compile
+	FGenEditSession::Get().UpdateSkeleton(Blueprint);
+
 	if (bFinalizeChanges)
 		IsBlueprintDirty = false;
 
-	UK2Node* NewNode = nullptr;
-	TArray<FString> Suggestions;
-
-	if (TryCreateKnownNodeType(FunctionGraph, NodeType, NewNode, PropertiesJson))
-	{
-		// Node created successfully, make sure:
-		if (!NewNode)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Node creation failed for type: %s"), *NodeType);
-			return TEXT("");
-		}
-	}
-	else
-	{
-		FString Result = TryCreateNodeFromLibraries(FunctionGraph, NodeType, NewNode, Suggestions);
-		if (!Result.IsEmpty() && Result.StartsWith(TEXT("SUGGESTIONS:")))
-		{
-			return Result; // Return suggestions directly to caller
-		}
-		else if (!NewNode)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to create node type: %s"), *NodeType);
-			return TEXT("");
-		}
-	}
-
-	FunctionGraph->AddNode(NewNode, false, false);
-	NewNode->NodePosX = NodeX;
-	NewNode->NodePosY = NodeY;
-	NewNode->AllocateDefaultPins();
-
+	TSharedPtr<FJsonObject> Properties;
 	if (!PropertiesJson.IsEmpty())
 	{
-		TSharedPtr<FJsonObject> JsonObject;
 		TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-		if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-		{
-			for (auto& Prop : JsonObject->Values)
-			{
-				const FString& PropName = Prop.Key;
-				TSharedPtr<FJsonValue> PropValue = Prop.Value;
-				UEdGraphPin* Pin = NewNode->FindPin(FName(*PropName));
-				if (Pin)
-				{
-					if (PropValue->Type == EJson::String) Pin->DefaultValue = PropValue->AsString();
-					else if (PropValue->Type == EJson::Number)
-						Pin->DefaultValue = FString::SanitizeFloat(
-							PropValue->AsNumber());
-					else if (PropValue->Type == EJson::Boolean)
-						Pin->DefaultValue = PropValue->AsBool()
-							                    ? TEXT("true")
-							                    : TEXT("false");
-				}
+		FJsonSerializer::Deserialize(Reader, Properties);
+	}
 
-				if ((NodeType.Equals(TEXT("VariableGet"), ESearchCase::IgnoreCase) ||
-						NodeType.Equals(TEXT("VariableSet"), ESearchCase::IgnoreCase)) &&
-					PropName.Equals(TEXT("variable_name"), ESearchCase::IgnoreCase) && PropValue->Type == EJson::String)
-				{
-					FString VariableName = PropValue->AsString();
-					if (!VariableName.IsEmpty())
-					{
-						FMemberReference VarRef;
-						VarRef.SetSelfMember(FName(*VariableName));
-						if (UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(NewNode))
-							VarGet->VariableReference = VarRef;
-						else if (UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(NewNode))
-							VarSet->VariableReference = VarRef;
-					}
-				}
-			}
-		}
+	FString Error;
+	UK2Node* NewNode = CreateNode(FunctionGraph, NodeType, NodeX, NodeY, Properties, Error);
+	if (!NewNode)
+	{
+		return Error.StartsWith(TEXT("SUGGESTIONS:")) ? Error : TEXT(""); // Return suggestions directly to caller
 	}
 
 	NewNode->ReconstructNode();
+	FunctionGraph->NotifyGraphChanged();
 
 	if (bFinalizeChanges)
 	{
-		if (GEditor)
-		{
-			UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-			if (AssetEditorSubsystem)
-			{
-				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-				if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
-					FindEditorForAsset(Blueprint, false)))
-					BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph);
-			}
-		}
-		if (IsBlueprintDirty)
-		{
-			Blueprint->Modify();
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-		}
+		FinalizeGraphChanges(Blueprint, FunctionGraph);
 	}
 
-	if (!NewNode->NodeGuid.IsValid()) NewNode->NodeGuid = FGuid::NewGuid();
-
 	UE_LOG(LogTemp, Log, TEXT("Added node of type %s to blueprint %s with GUID %s"), *NodeType, *BlueprintPath,
 	       *NewNode->NodeGuid.ToString());
 	return NewNode->NodeGuid.ToString();
@@ -162,110 +94,228 @@ FString UGenBlueprintNodeCreator::AddNode(const FString& BlueprintPath, const FS
 FString UGenBlueprintNodeCreator::AddNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid,
                                                const FString& NodesJson)
 {
-	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
-	if (!Blueprint)
+	TArray<TSharedPtr<FJsonValue>> NodesArray;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(NodesJson);
+	if (!FJsonSerializer::Deserialize(Reader, NodesArray))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse nodes JSON"));
 		return TEXT("");
 	}
 
-	FGuid GraphGuid;
-	if (!FGuid::Parse(FunctionGuid, GraphGuid))
+	FString Error;
+	const TArray<TSharedPtr<FJsonValue>> ResultsArray = AddNodesToGraph(BlueprintPath, FunctionGuid, NodesArray, Error);
+	if (!Error.IsEmpty())
 	{
-		UE_LOG(LogTemp, Error, TEXT("Invalid GUID format: %s"), *FunctionGuid);
 		return TEXT("");
 	}
 
-	UEdGraph* FunctionGraph = nullptr;
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-		if (Graph->GraphGuid == GraphGuid)
-		{
-			FunctionGraph = Graph;
-			break;
-		}
-	if (!FunctionGraph)
-		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			if (Graph->GraphGuid == GraphGuid)
-			{
-				FunctionGraph = Graph;
-				break;
-			}
+	FString ResultsJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultsJson);
+	FJsonSerializer::Serialize(ResultsArray, Writer);
+	return ResultsJson;
+}
+
+
+TArray<TSharedPtr<FJsonValue>> UGenBlueprintNodeCreator::AddNodesToGraph(const FString& BlueprintPath, const FString& FunctionGuid,
+                                                                         const TArray<TSharedPtr<FJsonValue>>& Nodes, FString& OutError)
+{
+	TArray<TSharedPtr<FJsonValue>> ResultsArray;
+
+	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+	if (!Blueprint)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
+		OutError = FString::Printf(TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
+		return ResultsArray;
+	}
+
+	UEdGraph* FunctionGraph = GetGraphFromFunctionId(Blueprint, FunctionGuid);
 	if (!FunctionGraph)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Could not find function graph with GUID: %s"), *FunctionGuid);
-		return TEXT("");
+		OutError = FString::Printf(TEXT("Could not find function graph with GUID: %s"), *FunctionGuid);
+		return ResultsArray;
 	}
+	FGenEditSession::Get().UpdateSkeleton(Blueprint);
 
+	const double StartTime = FPlatformTime::Seconds();
 	IsBlueprintDirty = false;
 
-	TArray<TSharedPtr<FJsonValue>> NodesArray;
-	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(NodesJson);
-	if (!FJsonSerializer::Deserialize(Reader, NodesArray))
+	// Nodes are only created here, reconstruction and graph notifications run once for the whole batch.
+	// The graph is recorded in the transaction once, the nodes themselves are transactional so undo removes them
+	FunctionGraph->Modify();
+	TArray<UK2Node*> CreatedNodes;
+	CreatedNodes.Reserve(Nodes.Num());
+	for (const TSharedPtr<FJsonValue>& NodeValue : Nodes)
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to parse nodes JSON"));
-		return TEXT("");
+		const TSharedPtr<FJsonObject> NodeObject = NodeValue->AsObject();
+		if (!NodeObject.IsValid()) continue;
+
+		FString NodeType;
+		NodeObject->TryGetStringField(TEXT("node_type"), NodeType);
+		const TArray<TSharedPtr<FJsonValue>>* PositionArray = nullptr;
+		NodeObject->TryGetArrayField(TEXT("node_position"), PositionArray);
+		const double NodeX = PositionArray && PositionArray->Num() > 0 ? (*PositionArray)[0]->AsNumber() : 0.0;
+		const double NodeY = PositionArray && PositionArray->Num() > 1 ? (*PositionArray)[1]->AsNumber() : 0.0;
+
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		NodeObject->TryGetObjectField(TEXT("node_properties"), Properties);
+
+		FString NodeRefId;
+		NodeObject->TryGetStringField(TEXT("id"), NodeRefId);
+
+		FString Error;
+		UK2Node* NewNode = CreateNode(FunctionGraph, NodeType, NodeX, NodeY, Properties ? *Properties : nullptr, Error, false);
+		if (!NewNode)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Skipped node %s of type %s: %s"), *NodeRefId, *NodeType, *Error);
+			continue;
+		}
+		CreatedNodes.Add(NewNode);
+
+		TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject);
+		ResultObject->SetStringField(TEXT("node_guid"), NewNode->NodeGuid.ToString());
+		if (!NodeRefId.IsEmpty()) ResultObject->SetStringField(TEXT("ref_id"), NodeRefId);
+		ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
 	}
 
-	TSharedPtr<FJsonObject> ResultsObject = MakeShareable(new FJsonObject);
-	TArray<TSharedPtr<FJsonValue>> ResultsArray;
+	for (UK2Node* Node : CreatedNodes)
+	{
+		Node->ReconstructNode();
+	}
 
-	for (auto& NodeValue : NodesArray)
+	if (CreatedNodes.Num() > 0)
 	{
-		TSharedPtr<FJsonObject> NodeObject = NodeValue->AsObject();
-		if (!NodeObject.IsValid()) continue;
+		// One add notification carrying every node, the same listeners UEdGraph::AddNode would have reached
+		FEdGraphEditAction Action;
+		Action.Action = GRAPHACTION_AddNode;
+		Action.Graph = FunctionGraph;
+		for (UK2Node* Node : CreatedNodes)
+		{
+			Action.Nodes.Add(Node);
+		}
+		FunctionGraph->NotifyGraphChanged(Action);
+		FinalizeGraphChanges(Blueprint, FunctionGraph);
+	}
+
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogGenPerformance, Display, TEXT("Added %d/%d nodes to %s in %f ms (%.0f nodes/s)"), CreatedNodes.Num(), Nodes.Num(),
+	       *BlueprintPath, ElapsedSeconds * 1000.0, ElapsedSeconds > 0.0 ? CreatedNodes.Num() / ElapsedSeconds : 0.0);
+	return ResultsArray;
+}
 
-		FString NodeType = NodeObject->GetStringField(TEXT("node_type"));
-		TArray<TSharedPtr<FJsonValue>> PositionArray = NodeObject->GetArrayField(TEXT("node_position"));
-		double NodeX = PositionArray.Num() > 0 ? PositionArray[0]->AsNumber() : 0.0;
-		double NodeY = PositionArray.Num() > 1 ? PositionArray[1]->AsNumber() : 0.0;
 
-		FString PropertiesJson;
-		if (NodeObject->HasField(TEXT("node_properties")))
+UK2Node* UGenBlueprintNodeCreator::CreateNode(UEdGraph* Graph, const FString& NodeType, float NodeX, float NodeY,
+                                              const TSharedPtr<FJsonObject>& Properties, FString& OutError, bool bNotifyGraph)
+{
+	UK2Node* NewNode = nullptr;
+	TArray<FString> Suggestions;
+
+	if (TryCreateKnownNodeType(Graph, NodeType, NewNode, Properties))
+	{
+		// Node created successfully, make sure:
+		if (!NewNode)
 		{
-			TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PropertiesJson);
-			FJsonSerializer::Serialize(NodeObject->GetObjectField(TEXT("node_properties")).ToSharedRef(), Writer);
+			UE_LOG(LogTemp, Error, TEXT("Node creation failed for type: %s"), *NodeType);
+			OutError = FString::Printf(TEXT("Node creation failed for type: %s"), *NodeType);
+			return nullptr;
 		}
+	}
+	else
+	{
+		FString Result = TryCreateNodeFromLibraries(Graph, NodeType, NewNode, Suggestions);
+		if (!Result.IsEmpty() && Result.StartsWith(TEXT("SUGGESTIONS:")))
+		{
+			OutError = Result;
+			return nullptr;
+		}
+		else if (!NewNode)
+		{
+			UE_LOG(LogTemp, Error, TEXT("Failed to create node type: %s"), *NodeType);
+			OutError = FString::Printf(TEXT("Failed to create node type: %s"), *NodeType);
+			return nullptr;
+		}
+	}
 
-		FString NodeRefId;
-		if (NodeObject->HasField(TEXT("id"))) NodeRefId = NodeObject->GetStringField(TEXT("id"));
+	// The GUID is set before the node is added, graph listeners such as the GUID index read it from the notification
+	NewNode->NodePosX = NodeX;
+	NewNode->NodePosY = NodeY;
+	if (!NewNode->NodeGuid.IsValid()) NewNode->CreateNewGuid();
+	NewNode->AllocateDefaultPins();
 
-		FString NodeGuid = AddNode(BlueprintPath, FunctionGuid, NodeType, NodeX, NodeY, PropertiesJson, false);
-		if (!NodeGuid.IsEmpty())
+	// Entry nodes are reused rather than created, they are already part of the graph
+	if (!Cast<UK2Node_FunctionEntry>(NewNode) || !Graph->Nodes.Contains(NewNode))
+	{
+		NewNode->SetFlags(RF_Transactional);
+		if (bNotifyGraph)
+		{
+			Graph->Modify();
+			Graph->AddNode(NewNode, false, false);
+		}
+		else
 		{
-			TSharedPtr<FJsonObject> ResultObject = MakeShareable(new FJsonObject);
-			ResultObject->SetStringField(TEXT("node_guid"), NodeGuid);
-			if (!NodeRefId.IsEmpty()) ResultObject->SetStringField(TEXT("ref_id"), NodeRefId);
-			ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+			Graph->Nodes.Add(NewNode);
 		}
 	}
 
-	if (ResultsArray.Num() > 0)
+	if (Properties.IsValid())
 	{
-		if (GEditor)
+		for (auto& Prop : Properties->Values)
 		{
-			UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-			if (AssetEditorSubsystem)
+			const FString& PropName = Prop.Key;
+			TSharedPtr<FJsonValue> PropValue = Prop.Value;
+			UEdGraphPin* Pin = NewNode->FindPin(FName(*PropName));
+			if (Pin)
 			{
-				AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
-				if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
-					FindEditorForAsset(Blueprint, false)))
-					BlueprintEditor->OpenGraphAndBringToFront(FunctionGraph);
+				if (PropValue->Type == EJson::String) Pin->DefaultValue = PropValue->AsString();
+				else if (PropValue->Type == EJson::Number)
+					Pin->DefaultValue = FString::SanitizeFloat(
+						PropValue->AsNumber());
+				else if (PropValue->Type == EJson::Boolean)
+					Pin->DefaultValue = PropValue->AsBool()
+						                    ? TEXT("true")
+						                    : TEXT("false");
 			}
-		}
 
-		if (IsBlueprintDirty)
-		{
-			Blueprint->Modify();
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+			// Checked on the node so aliases of VariableGet/VariableSet get their reference too
+			if (PropName.Equals(TEXT("variable_name"), ESearchCase::IgnoreCase) && PropValue->Type == EJson::String)
+			{
+				FString VariableName = PropValue->AsString();
+				if (!VariableName.IsEmpty())
+				{
+					FMemberReference VarRef;
+					VarRef.SetSelfMember(FName(*VariableName));
+					if (UK2Node_VariableGet* VarGet = Cast<UK2Node_VariableGet>(NewNode))
+						VarGet->VariableReference = VarRef;
+					else if (UK2Node_VariableSet* VarSet = Cast<UK2Node_VariableSet>(NewNode))
+						VarSet->VariableReference = VarRef;
+				}
+			}
 		}
 	}
 
-	FString ResultsJson;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultsJson);
-	FJsonSerializer::Serialize(ResultsArray, Writer);
+	return NewNode;
+}
 
-	UE_LOG(LogTemp, Log, TEXT("Added %d nodes to blueprint %s"), ResultsArray.Num(), *BlueprintPath);
-	return ResultsJson;
+
+void UGenBlueprintNodeCreator::FinalizeGraphChanges(UBlueprint* Blueprint, UEdGraph* Graph)
+{
+	if (GEditor)
+	{
+		UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
+		if (AssetEditorSubsystem)
+		{
+			AssetEditorSubsystem->OpenEditorForAsset(Blueprint);
+			if (FBlueprintEditor* BlueprintEditor = static_cast<FBlueprintEditor*>(AssetEditorSubsystem->
+				FindEditorForAsset(Blueprint, false)))
+				BlueprintEditor->OpenGraphAndBringToFront(Graph);
+		}
+	}
+	if (IsBlueprintDirty)
+	{
+		Blueprint->Modify();
+		FGenEditSession::Get().RequestStructuralModification(Blueprint);
+	}
 }
 
 
@@ -315,25 +365,8 @@ bool UGenBlueprintNodeCreator::DeleteNode(const FString& BlueprintPath, const FS
 		return false;
 	}
 
-	// Log all nodes for debugging
-	UE_LOG(LogTemp, Log, TEXT("Looking for node with GUID: %s in graph with %d nodes"),
-	       *NodeGuidObj.ToString(), FunctionGraph->Nodes.Num());
-
-	UEdGraphNode* NodeToDelete = nullptr;
-	for (UEdGraphNode* Node : FunctionGraph->Nodes)
-	{
-		UE_LOG(LogTemp, Log, TEXT("  - Found node of type %s with GUID: %s"),
-		       *Node->GetClass()->GetName(), *Node->NodeGuid.ToString());
-
-		if (Node->NodeGuid == NodeGuidObj)
-		{
-			NodeToDelete = Node;
-			UE_LOG(LogTemp, Log, TEXT("  - MATCHED!"));
-			break;
-		}
-	}
-
-	if (!NodeToDelete)
+	UEdGraphNode* NodeToDelete = FGenNodeGuidIndex::Get().FindNode(Blueprint, NodeGuidObj);
+	if (!NodeToDelete || NodeToDelete->GetGraph() != FunctionGraph)
 	{
 		UE_LOG(LogTemp, Error, TEXT("No node found with GUID: %s"), *NodeGuidObj.ToString());
 		return false;
@@ -341,7 +374,7 @@ bool UGenBlueprintNodeCreator::DeleteNode(const FString& BlueprintPath, const FS
 
 	// Actually remove the node and mark blueprint as modified
 	FBlueprintEditorUtils::RemoveNode(Blueprint, NodeToDelete, true);
-	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+	FGenEditSession::Get().RequestStructuralModification(Blueprint);
 
 	UE_LOG(LogTemp, Log, TEXT("Successfully deleted node with GUID: %s"), *NodeGuid);
 	return true;
@@ -394,314 +427,86 @@ FString UGenBlueprintNodeCreator::GetAllNodesInGraph(const FString& BlueprintPat
 
 UEdGraph* UGenBlueprintNodeCreator::FindGraphByGuid(UBlueprint* Blueprint, const FGuid& GraphGuid)
 {
-	if (!Blueprint) return nullptr;
-
-	// Look in UbergraphPages
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	// Look in FunctionGraphs
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	// Look in MacroGraphs (if needed)
-	for (UEdGraph* Graph : Blueprint->MacroGraphs)
-	{
-		if (Graph && Graph->GraphGuid == GraphGuid)
-		{
-			return Graph;
-		}
-	}
-
-	return nullptr;
-}
-
-
-// Initialize the map with practical node type mappings based on actual failures
-void UGenBlueprintNodeCreator::InitNodeTypeMap()
-{
-	if (NodeTypeMap.Num() > 0)
-		return; // Already initialized
-
-	// Return node - this was the first failure in the test
-	NodeTypeMap.Add(TEXT("returnnode"), TEXT("K2Node_FunctionResult"));
-
-	// Math operation naming issues from the test
-	NodeTypeMap.Add(TEXT("floatplusfloat"), TEXT("Add_FloatFloat"));
-	NodeTypeMap.Add(TEXT("floatplus"), TEXT("Add_FloatFloat"));
-	NodeTypeMap.Add(TEXT("k2_addfloat"), TEXT("Add_FloatFloat"));
-
-	// Library prefix issues
-	NodeTypeMap.Add(TEXT("kismetmathlibrary.multiply_floatfloat"), TEXT("Multiply_FloatFloat"));
-	NodeTypeMap.Add(TEXT("kismetmathlibrary.add_floatfloat"), TEXT("Add_FloatFloat"));
-
-	// Common function name variations
-	NodeTypeMap.Add(TEXT("getlocation"), TEXT("GetActorLocation"));
-	NodeTypeMap.Add(TEXT("setlocation"), TEXT("SetActorLocation"));
-
-	// K2 prefix issues (sometimes needed, sometimes not)
-	NodeTypeMap.Add(TEXT("k2_getactorlocation"), TEXT("GetActorLocation"));
-	NodeTypeMap.Add(TEXT("k2_setactorlocation"), TEXT("SetActorLocation"));
-
-	// Extended mappings
-	NodeTypeMap.Add(TEXT("functionentry"), TEXT("K2Node_FunctionEntry"));
-	NodeTypeMap.Add(TEXT("gettime"), TEXT("GetTimeSeconds"));
-	NodeTypeMap.Add(TEXT("gettimeseconds"), TEXT("GetTimeSeconds"));
-	NodeTypeMap.Add(TEXT("sin"), TEXT("Sin"));
-	NodeTypeMap.Add(TEXT("cos"), TEXT("Cos"));
-	NodeTypeMap.Add(TEXT("makevector"), TEXT("MakeVector"));
-	NodeTypeMap.Add(TEXT("vector"), TEXT("MakeVector"));
-	NodeTypeMap.Add(TEXT("addvector"), TEXT("Add_VectorVector"));
-	NodeTypeMap.Add(TEXT("add_vectorvector"), TEXT("Add_VectorVector"));
-
-	// Event node mappings
-	NodeTypeMap.Add(TEXT("getvariable"), TEXT("VariableGet"));
-	NodeTypeMap.Add(TEXT("setvariable"), TEXT("VariableSet"));
-	NodeTypeMap.Add(TEXT("event beginplay"), TEXT("EventBeginPlay"));
-	NodeTypeMap.Add(TEXT("beginplay"), TEXT("EventBeginPlay"));
-	NodeTypeMap.Add(TEXT("receivebeginplay"), TEXT("EventBeginPlay"));
-	NodeTypeMap.Add(TEXT("eventtick"), TEXT("EventTick"));
-
-	// New mappings for InputAction
-	NodeTypeMap.Add(TEXT("inputaction"), TEXT("K2Node_InputAction"));
-	NodeTypeMap.Add(TEXT("input"), TEXT("K2Node_InputAction"));
-	NodeTypeMap.Add(TEXT("actionevent"), TEXT("K2Node_InputAction"));
-	NodeTypeMap.Add(TEXT("inputevent"), TEXT("K2Node_InputAction"));
+	return FGenNodeGuidIndex::Get().FindGraph(Blueprint, GraphGuid);
 }
 
 
 bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FString& NodeType, UK2Node*& OutNode,
-                                                      const FString& PropertiesJson)
+                                                      const TSharedPtr<FJsonObject>& Properties)
 {
-	InitNodeTypeMap();
-	FString ActualNodeType = NodeTypeMap.FindRef(NodeType.ToLower(), NodeType);
-
-	if (ActualNodeType.Equals(TEXT("EventBeginPlay"), ESearchCase::IgnoreCase) ||
-		ActualNodeType.Equals(TEXT("BeginPlay"), ESearchCase::IgnoreCase) ||
-		ActualNodeType.Equals(TEXT("ReceiveBeginPlay"), ESearchCase::IgnoreCase))
+	// Aliases and recipes come from Config/NodeTypeAliases.json, see FGenNodeTypeRegistry
+	FString ActualNodeType;
+	const FGenNodeRecipe* Recipe = FGenNodeTypeRegistry::Get().FindRecipe(NodeType, ActualNodeType);
+	if (Recipe)
 	{
-		UBlueprint* Blueprint = Cast<UBlueprint>(Graph->GetOuter());
-		if (!Blueprint || Blueprint->UbergraphPages.Num() == 0)
+		switch (Recipe->Kind)
 		{
-			UE_LOG(LogTemp, Error, TEXT("No valid Blueprint or UbergraphPages found for EventBeginPlay"));
-			return false;
-		}
+		case EGenNodeRecipeKind::CallFunction:
+			return CreateMathFunctionNode(Graph, Recipe->ClassName, Recipe->MemberName.ToString(), OutNode);
 
-		UEdGraph* DefaultEventGraph = Blueprint->UbergraphPages[0];
-		// Ensure we're adding to the default EventGraph
-		if (Graph != DefaultEventGraph)
-		{
-			UE_LOG(LogTemp, Warning,
-			       TEXT("EventBeginPlay can only be added to the default EventGraph, not a custom function graph"));
-			return false;
-		}
-
-		// Find and delete ALL existing BeginPlay nodes first
-		TArray<UK2Node_Event*> NodesToDelete;
-		for (UEdGraphNode* Node : DefaultEventGraph->Nodes)
-		{
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		case EGenNodeRecipeKind::NodeClass:
 			{
-				if (EventNode->EventReference.GetMemberName().ToString().Equals(TEXT("ReceiveBeginPlay")))
+				UClass* NodeClass = FindObject<UClass>(ANY_PACKAGE, *Recipe->ClassName);
+				if (!NodeClass || !NodeClass->IsChildOf(UK2Node::StaticClass()))
 				{
-					NodesToDelete.Add(EventNode);
-					UE_LOG(LogTemp, Warning, TEXT("Found BeginPlay node to delete with GUID %s"),
-					       *EventNode->NodeGuid.ToString());
+					UE_LOG(LogTemp, Error, TEXT("Node recipe %s refers to unknown node class %s"), *Recipe->Name.ToString(),
+					       *Recipe->ClassName);
+					return false;
 				}
+				OutNode = NewObject<UK2Node>(Graph, NodeClass);
+				IsBlueprintDirty = true;
+				return OutNode != nullptr;
 			}
-		}
 
-		// Delete all found BeginPlay nodes
-		for (UK2Node_Event* NodeToDelete : NodesToDelete)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Deleting BeginPlay node with GUID %s"),
-			       *NodeToDelete->NodeGuid.ToString());
-			FBlueprintEditorUtils::RemoveNode(Blueprint, NodeToDelete);
-		}
-
-		UK2Node_Event* NewEventNode = NewObject<UK2Node_Event>(DefaultEventGraph);
-		NewEventNode->EventReference.SetExternalMember(FName(TEXT("ReceiveBeginPlay")), AActor::StaticClass());
-		NewEventNode->bOverrideFunction = true;
-
-		if (!NewEventNode)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to create EventBeginPlay node using FKismetEditorUtilities"));
-			return false;
-		}
+		case EGenNodeRecipeKind::Event:
+			return CreateOverrideEventNode(Graph, *Recipe, OutNode);
 
-		OutNode = NewEventNode;
-		UE_LOG(LogTemp, Log, TEXT("Created new EventBeginPlay node in default EventGraph with GUID %s"),
-		       *NewEventNode->NodeGuid.ToString());
-
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("EventTick"), ESearchCase::IgnoreCase))
-	{
-		UBlueprint* Blueprint = Cast<UBlueprint>(Graph->GetOuter());
-		if (!Blueprint || Blueprint->UbergraphPages.Num() == 0)
-		{
-			UE_LOG(LogTemp, Error, TEXT("No valid Blueprint or UbergraphPages found for EventTick"));
-			return false;
-		}
-
-		UEdGraph* DefaultEventGraph = Blueprint->UbergraphPages[0];
-		if (Graph != DefaultEventGraph)
-		{
-			UE_LOG(LogTemp, Warning,
-			       TEXT("EventTick can only be added to the default EventGraph, not a custom function graph"));
-			return false;
-		}
-
-		// Find and delete ALL existing Tick nodes first
-		TArray<UK2Node_Event*> NodesToDelete;
-		for (UEdGraphNode* Node : DefaultEventGraph->Nodes)
-		{
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		case EGenNodeRecipeKind::FunctionEntry:
+			// Find the existing entry node rather than create a new one
+			for (UEdGraphNode* Node : Graph->Nodes)
 			{
-				if (EventNode->EventReference.GetMemberName().ToString().Equals(TEXT("ReceiveTick")))
+				UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node);
+				if (EntryNode)
 				{
-					NodesToDelete.Add(EventNode);
-					UE_LOG(LogTemp, Warning, TEXT("Found Tick node to delete with GUID %s"),
-					       *EventNode->NodeGuid.ToString());
+					OutNode = EntryNode;
+					return true;
 				}
 			}
-		}
-
-		// Delete all found Tick nodes
-		for (UK2Node_Event* NodeToDelete : NodesToDelete)
-		{
-			UE_LOG(LogTemp, Warning, TEXT("Deleting Tick node with GUID %s"),
-			       *NodeToDelete->NodeGuid.ToString());
-			FBlueprintEditorUtils::RemoveNode(Blueprint, NodeToDelete);
-		}
-
-		UK2Node_Event* NewEventNode = NewObject<UK2Node_Event>(DefaultEventGraph);
-		NewEventNode->EventReference.SetExternalMember(FName(TEXT("ReceiveTick")), AActor::StaticClass());
-		NewEventNode->bOverrideFunction = true;
-
-		if (!NewEventNode)
-		{
-			UE_LOG(LogTemp, Error, TEXT("Failed to create EventTick node"));
+			// Even If we don't find one, don't create a new one as it would be a duplicate
 			return false;
-		}
-
-		OutNode = NewEventNode;
-		UE_LOG(LogTemp, Log, TEXT("Created new EventTick node in default EventGraph with GUID %s"),
-		       *NewEventNode->NodeGuid.ToString());
-
-		IsBlueprintDirty = true;
-		return true;
-	}
-	auto NodeTypeLower = ActualNodeType.ToLower();
-	// Special handling for function entry nodes - find existing rather than create new
-	if (NodeTypeLower.Contains(TEXT("functionentry")) || NodeTypeLower.Contains(TEXT("entrynode")))
-	{
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node);
-			if (EntryNode)
-			{
-				OutNode = EntryNode;
-				return true;
-			}
-		}
-		// Even If we don't find one, don't create a new one as it would be a duplicate
-		return false;
-	}
 
-	// New handling for InputAction node
-	if (ActualNodeType.Equals(TEXT("K2Node_InputAction"), ESearchCase::IgnoreCase))
-	{
-		UK2Node_InputAction* InputNode = NewObject<UK2Node_InputAction>(Graph);
-		if (!PropertiesJson.IsEmpty())
-		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+		case EGenNodeRecipeKind::InputAction:
 			{
-				FString ActionName;
-				if (JsonObject->TryGetStringField(TEXT("action_name"), ActionName) && !ActionName.IsEmpty())
+				UK2Node_InputAction* InputNode = NewObject<UK2Node_InputAction>(Graph);
+				if (Properties.IsValid())
 				{
-					InputNode->InputActionName = FName(*ActionName);
-					UE_LOG(LogTemp, Log, TEXT("Created InputAction node for action '%s'"), *ActionName);
+					FString ActionName;
+					if (Properties->TryGetStringField(TEXT("action_name"), ActionName) && !ActionName.IsEmpty())
+					{
+						InputNode->InputActionName = FName(*ActionName);
+						UE_LOG(LogTemp, Log, TEXT("Created InputAction node for action '%s'"), *ActionName);
+					}
+					else
+					{
+						UE_LOG(LogTemp, Error, TEXT("InputAction node requires 'action_name' in PropertiesJson"));
+						return false;
+					}
 				}
 				else
 				{
-					UE_LOG(LogTemp, Error, TEXT("InputAction node requires 'action_name' in PropertiesJson"));
+					UE_LOG(LogTemp, Error, TEXT("InputAction node requires PropertiesJson with 'action_name'"));
 					return false;
 				}
+				OutNode = InputNode;
+				IsBlueprintDirty = true;
+				return true;
 			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("Failed to parse PropertiesJson for InputAction node"));
-				return false;
-			}
-		}
-		else
-		{
-			UE_LOG(LogTemp, Error, TEXT("InputAction node requires PropertiesJson with 'action_name'"));
-			return false;
-		}
-		OutNode = InputNode;
-		IsBlueprintDirty = true;
-		return true;
-	}
-	if (ActualNodeType.Equals(TEXT("Branch"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("IfThenElse"), ESearchCase::IgnoreCase))
-	{
-		OutNode = NewObject<UK2Node_IfThenElse>(Graph);
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("Sequence"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("ExecutionSequence"), ESearchCase::IgnoreCase))
-	{
-		OutNode = NewObject<UK2Node_ExecutionSequence>(Graph);
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("SwitchEnum"), ESearchCase::IgnoreCase))
-	{
-		OutNode = NewObject<UK2Node_SwitchEnum>(Graph);
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("SwitchInteger"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("SwitchInt"), ESearchCase::IgnoreCase))
-	{
-		OutNode = NewObject<UK2Node_SwitchInteger>(Graph);
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("SwitchString"), ESearchCase::IgnoreCase))
-	{
-		OutNode = NewObject<UK2Node_SwitchString>(Graph);
-		IsBlueprintDirty = true;
-		return true;
-	}
-	else if (ActualNodeType.Equals(TEXT("VariableGet"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Getter"), ESearchCase::IgnoreCase))
-	{
-		UK2Node_VariableGet* VarGet = NewObject<UK2Node_VariableGet>(Graph);
-		if (!PropertiesJson.IsEmpty())
-		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+
+		case EGenNodeRecipeKind::VariableGet:
 			{
+				UK2Node_VariableGet* VarGet = NewObject<UK2Node_VariableGet>(Graph);
 				FString VarName;
-				if (JsonObject->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
+				if (Properties.IsValid() && Properties->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
 				{
 					FMemberReference VarRef;
 					VarRef.SetSelfMember(FName(*VarName));
@@ -712,23 +517,15 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 					UE_LOG(LogTemp, Log, TEXT("Created VariableGet node for variable '%s'"), *VarName);
 					return true;
 				}
+				UE_LOG(LogTemp, Error, TEXT("VariableGet requires 'VariableName' in PropertiesJson"));
+				return false;
 			}
-		}
-		UE_LOG(LogTemp, Error, TEXT("VariableGet requires 'VariableName' in PropertiesJson"));
-		return false;
-	}
-	else if (ActualNodeType.Equals(TEXT("VariableSet"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Setter"), ESearchCase::IgnoreCase))
-	{
-		UK2Node_VariableSet* VarSet = NewObject<UK2Node_VariableSet>(Graph);
-		if (!PropertiesJson.IsEmpty())
-		{
-			TSharedPtr<FJsonObject> JsonObject;
-			TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(PropertiesJson);
-			if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+
+		case EGenNodeRecipeKind::VariableSet:
 			{
+				UK2Node_VariableSet* VarSet = NewObject<UK2Node_VariableSet>(Graph);
 				FString VarName;
-				if (JsonObject->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
+				if (Properties.IsValid() && Properties->TryGetStringField(TEXT("VariableName"), VarName) && !VarName.IsEmpty())
 				{
 					FMemberReference VarRef;
 					VarRef.SetSelfMember(FName(*VarName));
@@ -737,7 +534,7 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 
 					// Optionally set a default value if provided
 					FString Value;
-					if (JsonObject->TryGetStringField(TEXT("Value"), Value))
+					if (Properties->TryGetStringField(TEXT("Value"), Value))
 					{
 						UEdGraphPin* ValuePin = VarSet->FindPin(FName(TEXT("Value")));
 						if (ValuePin)
@@ -751,81 +548,84 @@ bool UGenBlueprintNodeCreator::TryCreateKnownNodeType(UEdGraph* Graph, const FSt
 					UE_LOG(LogTemp, Log, TEXT("Created VariableSet node for variable '%s'"), *VarName);
 					return true;
 				}
+				UE_LOG(LogTemp, Error, TEXT("VariableSet requires 'VariableName' in PropertiesJson"));
+				return false;
 			}
 		}
-		UE_LOG(LogTemp, Error, TEXT("VariableSet requires 'VariableName' in PropertiesJson"));
-		return false;
-	}
-	else if (ActualNodeType.Equals(TEXT("Multiply"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Multiply_Float"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Multiply_FloatFloat"), OutNode);
 	}
-	else if (ActualNodeType.Equals(TEXT("Add"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Add_Float"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Add_FloatFloat"), OutNode);
-	}
-	else if (ActualNodeType.Equals(TEXT("Subtract"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Subtract_Float"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Subtract_FloatFloat"), OutNode);
-	}
-	else if (ActualNodeType.Equals(TEXT("Divide"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("Divide_Float"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Divide_FloatFloat"), OutNode);
-	}
-	else if (ActualNodeType.Equals(TEXT("Print"), ESearchCase::IgnoreCase) || ActualNodeType.Equals(
-		TEXT("PrintString"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetSystemLibrary"), TEXT("PrintString"), OutNode);
-	}
-	else if (ActualNodeType.Equals(TEXT("Delay"), ESearchCase::IgnoreCase))
-	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetSystemLibrary"), TEXT("Delay"), OutNode);
-	}
-	else if (ActualNodeType.Equals(TEXT("GetActorLocation"), ESearchCase::IgnoreCase))
+
+	UClass* NodeClass = FindObject<UClass>(ANY_PACKAGE, *(TEXT("UK2Node_") + ActualNodeType));
+	if (!NodeClass || !NodeClass->IsChildOf(UK2Node::StaticClass()))
+		NodeClass = FindObject<UClass>(ANY_PACKAGE, *ActualNodeType);
+	if (NodeClass && NodeClass->IsChildOf(UK2Node::StaticClass()))
 	{
-		return CreateMathFunctionNode(Graph, TEXT("Actor"), TEXT("K2_GetActorLocation"), OutNode);
+		OutNode = NewObject<UK2Node>(Graph, NodeClass);
+		IsBlueprintDirty = true;
+		return OutNode != nullptr;
 	}
-	else if (ActualNodeType.Equals(TEXT("SetActorLocation"), ESearchCase::IgnoreCase))
+
+	return false;
+}
+
+bool UGenBlueprintNodeCreator::CreateOverrideEventNode(UEdGraph* Graph, const FGenNodeRecipe& Recipe, UK2Node*& OutNode)
+{
+	const FString EventName = Recipe.Name.ToString();
+	UBlueprint* Blueprint = Cast<UBlueprint>(Graph->GetOuter());
+	if (!Blueprint || Blueprint->UbergraphPages.Num() == 0)
 	{
-		return CreateMathFunctionNode(Graph, TEXT("Actor"), TEXT("K2_SetActorLocation"), OutNode);
+		UE_LOG(LogTemp, Error, TEXT("No valid Blueprint or UbergraphPages found for %s"), *EventName);
+		return false;
 	}
-	// Add conversion nodes
-	else if (NodeType.Equals(TEXT("FloatToDouble"), ESearchCase::IgnoreCase) ||
-		NodeType.Equals(TEXT("Conv_FloatToDouble"), ESearchCase::IgnoreCase))
+
+	UEdGraph* DefaultEventGraph = Blueprint->UbergraphPages[0];
+	// Ensure we're adding to the default EventGraph
+	if (Graph != DefaultEventGraph)
 	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Conv_FloatToDouble"), OutNode);
+		UE_LOG(LogTemp, Warning, TEXT("%s can only be added to the default EventGraph, not a custom function graph"), *EventName);
+		return false;
 	}
-	else if (NodeType.Equals(TEXT("FloatToInt"), ESearchCase::IgnoreCase) ||
-		NodeType.Equals(TEXT("Conv_FloatToInteger"), ESearchCase::IgnoreCase))
+
+	UClass* EventClass = FindObject<UClass>(ANY_PACKAGE, *Recipe.ClassName);
+	if (!EventClass || !EventClass->FindFunctionByName(Recipe.MemberName))
 	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Conv_FloatToInteger"), OutNode);
+		UE_LOG(LogTemp, Error, TEXT("Node recipe %s refers to unknown event %s.%s"), *EventName, *Recipe.ClassName,
+		       *Recipe.MemberName.ToString());
+		return false;
 	}
-	else if (NodeType.Equals(TEXT("IntToFloat"), ESearchCase::IgnoreCase) ||
-		NodeType.Equals(TEXT("Conv_IntToFloat"), ESearchCase::IgnoreCase))
+
+	// Find and delete ALL existing nodes of the event first, an override event may only exist once
+	TArray<UK2Node_Event*> NodesToDelete;
+	for (UEdGraphNode* Node : DefaultEventGraph->Nodes)
 	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Conv_IntToFloat"), OutNode);
+		if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			if (EventNode->EventReference.GetMemberName() == Recipe.MemberName)
+			{
+				NodesToDelete.Add(EventNode);
+			}
+		}
 	}
-	else if (NodeType.Equals(TEXT("DoubleToFloat"), ESearchCase::IgnoreCase) ||
-		NodeType.Equals(TEXT("Conv_DoubleToFloat"), ESearchCase::IgnoreCase))
+
+	for (UK2Node_Event* NodeToDelete : NodesToDelete)
 	{
-		return CreateMathFunctionNode(Graph, TEXT("KismetMathLibrary"), TEXT("Conv_DoubleToFloat"), OutNode);
+		UE_LOG(LogTemp, Warning, TEXT("Deleting %s node with GUID %s"), *EventName, *NodeToDelete->NodeGuid.ToString());
+		FBlueprintEditorUtils::RemoveNode(Blueprint, NodeToDelete);
 	}
 
-	UClass* NodeClass = FindObject<UClass>(ANY_PACKAGE, *(TEXT("UK2Node_") + ActualNodeType));
-	if (!NodeClass || !NodeClass->IsChildOf(UK2Node::StaticClass()))
-		NodeClass = FindObject<UClass>(ANY_PACKAGE, *ActualNodeType);
-	if (NodeClass && NodeClass->IsChildOf(UK2Node::StaticClass()))
+	UK2Node_Event* NewEventNode = NewObject<UK2Node_Event>(DefaultEventGraph);
+	if (!NewEventNode)
 	{
-		OutNode = NewObject<UK2Node>(Graph, NodeClass);
-		IsBlueprintDirty = true;
-		return OutNode != nullptr;
+		UE_LOG(LogTemp, Error, TEXT("Failed to create %s node"), *EventName);
+		return false;
 	}
+	NewEventNode->EventReference.SetExternalMember(Recipe.MemberName, EventClass);
+	NewEventNode->bOverrideFunction = true;
 
-	return false;
+	OutNode = NewEventNode;
+	UE_LOG(LogTemp, Log, TEXT("Created new %s node in default EventGraph"), *EventName);
+
+	IsBlueprintDirty = true;
+	return true;
 }
 
 UEdGraph* UGenBlueprintNodeCreator::GetGraphFromFunctionId(UBlueprint* Blueprint, const FString& FunctionGuid)
@@ -846,10 +646,7 @@ UEdGraph* UGenBlueprintNodeCreator::GetGraphFromFunctionId(UBlueprint* Blueprint
 	FGuid GraphGuid;
 	if (FGuid::Parse(FunctionGuid, GraphGuid))
 	{
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-			if (Graph->GraphGuid == GraphGuid) return Graph;
-		for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-			if (Graph->GraphGuid == GraphGuid) return Graph;
+		if (UEdGraph* Graph = FGenNodeGuidIndex::Get().FindGraph(Blueprint, GraphGuid)) return Graph;
 	}
 	UE_LOG(LogTemp, Error, TEXT("Could not resolve function ID %s to a graph"), *FunctionGuid);
 	return nullptr;
@@ -859,110 +656,39 @@ FString UGenBlueprintNodeCreator::TryCreateNodeFromLibraries(UEdGraph* Graph, co
                                                              UK2Node*& OutNode,
                                                              TArray<FString>& OutSuggestions)
 {
-	static const TArray<FString> CommonLibraries = {
-		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
-		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
-		TEXT("BlueprintFunctionLibrary"), TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
-	};
-
-	struct FFunctionMatch
-	{
-		FString LibraryName;
-		FString FunctionName;
-		FString DisplayName;
-		int32 Score;
-		UFunction* Function;
-		UClass* Class;
-	};
-
-	TArray<FFunctionMatch> Matches;
-	const FString NodeTypeLower = NodeType.ToLower();
-
-	auto SplitName = [](const FString& Name) -> TArray<FString>
-	{
-		TArray<FString> Parts;
-		Name.ParseIntoArray(Parts, TEXT("_"));
-		if (Parts.Num() == 1)
-		{
-			FString Temp = Name;
-			Parts.Empty();
-			for (int32 i = 0; i < Temp.Len(); ++i)
-			{
-				if (i > 0 && FChar::IsUpper(Temp[i]))
-				{
-					Parts.Add(Temp.Mid(0, i));
-					Temp = Temp.Mid(i);
-					i = 0;
-				}
-			}
-			if (!Temp.IsEmpty()) Parts.Add(Temp);
-		}
-		return Parts;
-	};
-
-	TArray<FString> NodeTypeParts = SplitName(NodeTypeLower);
-
-	for (const FString& LibraryName : CommonLibraries)
-	{
-		UClass* LibClass = FindObject<UClass>(ANY_PACKAGE, *LibraryName);
-		if (!LibClass) continue;
-
-		for (TFieldIterator<UFunction> FuncIt(LibClass); FuncIt; ++FuncIt)
-		{
-			UFunction* Function = *FuncIt;
-			FString FuncName = Function->GetName();
-			FString FuncNameLower = FuncName.ToLower();
-
-			if (Function->HasMetaData(TEXT("DeprecatedFunction")) || Function->HasMetaData(
-				TEXT("BlueprintInternalUseOnly")))
-				continue;
-
-			int32 Score = 0;
-			if (FuncNameLower == NodeTypeLower) Score = 120; // Exact match
-			else if (FuncNameLower.Contains(NodeTypeLower)) Score = 80; // Substring match
-
-			TArray<FString> FuncParts = SplitName(FuncNameLower);
-			for (const FString& Part : NodeTypeParts)
-				if (FuncParts.Contains(Part)) Score += 20;
-			if (FuncNameLower.StartsWith(NodeTypeLower)) Score += 10;
-			if (FuncNameLower.Len() > NodeTypeLower.Len() * 2) Score -= 15;
-
-			if (Score > 0)
-			{
-				FFunctionMatch Match;
-				Match.LibraryName = LibraryName;
-				Match.FunctionName = FuncName;
-				Match.DisplayName = FString::Printf(TEXT("%s.%s"), *LibraryName, *FuncName);
-				Match.Score = Score;
-				Match.Function = Function;
-				Match.Class = LibClass;
-				Matches.Add(Match);
-			}
-		}
-	}
+	FGenFunctionIndex& FunctionIndex = FGenFunctionIndex::Get();
+	TArray<FGenFunctionMatch> Matches;
+	FunctionIndex.FindMatches(NodeType, FGenFunctionIndex::CreationWeights, 10, Matches);
 
 	if (Matches.Num() == 0) return TEXT("");
 
-	Matches.Sort([](const FFunctionMatch& A, const FFunctionMatch& B) { return A.Score > B.Score; });
-	for (const FFunctionMatch& Match : Matches) OutSuggestions.Add(Match.DisplayName);
-
 	const int32 ScoreThreshold = 80; // Raised threshold for better precision
-	if (Matches[0].Score >= ScoreThreshold)
+	for (const FGenFunctionMatch& Match : Matches)
 	{
-		const FFunctionMatch& BestMatch = Matches[0];
+		if (Match.Score < ScoreThreshold) break;
+
+		// Entries from the cached catalog can refer to classes that are no longer loaded
+		UFunction* Function = FunctionIndex.GetFunction(Match.Index);
+		UClass* OwnerClass = FunctionIndex.GetOwnerClass(Match.Index);
+		if (!Function || !OwnerClass) continue;
+
 		UK2Node_CallFunction* FunctionNode = NewObject<UK2Node_CallFunction>(Graph);
 		IsBlueprintDirty = true;
 		if (FunctionNode)
 		{
-			FunctionNode->FunctionReference.SetExternalMember(BestMatch.Function->GetFName(), BestMatch.Class);
+			FunctionNode->FunctionReference.SetExternalMember(Function->GetFName(), OwnerClass);
 			OutNode = FunctionNode;
-			OutSuggestions.Empty(); // Clear suggestions on success
-			return BestMatch.DisplayName;
+			// Fallbacks further down the list and near misses are guesses, only a confident best match is learned
+			if (&Match == &Matches[0] && FGenFunctionIndex::IsConfidentResolution(Matches, FGenFunctionIndex::CreationWeights))
+			{
+				FunctionIndex.RecordResolution(NodeType, Match.Index);
+			}
+			return FunctionIndex.GetDisplayName(Match.Index);
 		}
 		return TEXT("");
 	}
 
-	while (OutSuggestions.Num() > 10) OutSuggestions.RemoveAt(OutSuggestions.Num() - 1); // More suggestions
+	for (const FGenFunctionMatch& Match : Matches) OutSuggestions.Add(FunctionIndex.GetDisplayName(Match.Index));
 	FString SuggestionStr = FString::Join(OutSuggestions, TEXT(", "));
 	return TEXT("SUGGESTIONS:") + SuggestionStr;
 }
@@ -992,98 +718,148 @@ bool UGenBlueprintNodeCreator::CreateMathFunctionNode(UEdGraph* Graph, const FSt
 
 FString UGenBlueprintNodeCreator::GetNodeSuggestions(const FString& NodeType)
 {
-	static const TArray<FString> CommonLibraries = {
-		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
-		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
-		TEXT("BlueprintFunctionLibrary"), TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
-	};
+	FGenFunctionIndex& FunctionIndex = FGenFunctionIndex::Get();
+	TArray<FGenFunctionMatch> Matches;
+	FunctionIndex.FindMatches(NodeType, FGenFunctionIndex::SuggestionWeights, 5, Matches);
 
-	struct FFunctionMatch
+	if (Matches.Num() == 0)
 	{
-		FString LibraryName;
-		FString FunctionName;
-		FString DisplayName;
-		int32 Score;
-	};
+		UE_LOG(LogTemp, Warning, TEXT("No suggestions found for node type: %s"), *NodeType);
+		return TEXT("");
+	}
 
-	TArray<FFunctionMatch> Matches;
-	const FString NodeTypeLower = NodeType.ToLower();
+	TArray<FString> Suggestions;
+	for (const FGenFunctionMatch& Match : Matches) Suggestions.Add(FunctionIndex.GetDisplayName(Match.Index));
 
-	auto SplitName = [](const FString& Name) -> TArray<FString>
-	{
-		TArray<FString> Parts;
-		Name.ParseIntoArray(Parts, TEXT("_"));
-		if (Parts.Num() == 1)
-		{
-			FString Temp = Name;
-			Parts.Empty();
-			for (int32 i = 0; i < Temp.Len(); ++i)
-			{
-				if (i > 0 && FChar::IsUpper(Temp[i]))
-				{
-					Parts.Add(Temp.Mid(0, i));
-					Temp = Temp.Mid(i);
-					i = 0;
-				}
-			}
-			if (!Temp.IsEmpty()) Parts.Add(Temp);
-		}
-		return Parts;
-	};
+	FString SuggestionStr = FString::Join(Suggestions, TEXT(", "));
+	UE_LOG(LogTemp, Log, TEXT("Suggestions for %s: %s"), *NodeType, *SuggestionStr);
+	return TEXT("SUGGESTIONS:") + SuggestionStr;
+}
 
-	TArray<FString> NodeTypeParts = SplitName(NodeTypeLower);
 
-	for (const FString& LibraryName : CommonLibraries)
+FString UGenBlueprintNodeCreator::GetRankedNodeCandidates(const FString& NodeType, int32 MaxResults)
+{
+	FGenFunctionIndex& FunctionIndex = FGenFunctionIndex::Get();
+	TArray<FGenFunctionMatch> Matches;
+	FunctionIndex.FindMatches(NodeType, FGenFunctionIndex::SuggestionWeights, MaxResults, Matches);
+
+	TArray<TSharedPtr<FJsonValue>> Candidates;
+	for (const FGenFunctionMatch& Match : Matches)
 	{
-		UClass* LibClass = FindObject<UClass>(ANY_PACKAGE, *LibraryName);
-		if (!LibClass) continue;
+		TSharedPtr<FJsonObject> Candidate = MakeShareable(new FJsonObject);
+		Candidate->SetStringField(TEXT("name"), FunctionIndex.GetDisplayName(Match.Index));
+		Candidate->SetNumberField(TEXT("score"), Match.Score);
+		Candidates.Add(MakeShareable(new FJsonValueObject(Candidate)));
+	}
+
+	FString CandidatesJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&CandidatesJson);
+	FJsonSerializer::Serialize(Candidates, Writer);
+	return CandidatesJson;
+}
 
-		for (TFieldIterator<UFunction> FuncIt(LibClass); FuncIt; ++FuncIt)
-		{
-			UFunction* Function = *FuncIt;
-			FString FuncName = Function->GetName();
-			FString FuncNameLower = FuncName.ToLower();
 
-			if (Function->HasMetaData(TEXT("DeprecatedFunction")) || Function->HasMetaData(
-				TEXT("BlueprintInternalUseOnly")))
-				continue;
+FString UGenBlueprintNodeCreator::BenchmarkNodeLookup(const TArray<FString>& NodeTypes, const TArray<FString>& ExpectedNames,
+                                                      int32 Iterations)
+{
+	FGenFunctionIndex& FunctionIndex = FGenFunctionIndex::Get();
+	Iterations = FMath::Max(Iterations, 1);
 
-			int32 Score = 0;
-			if (FuncNameLower == NodeTypeLower) Score = 100;
-			else if (FuncNameLower.Contains(NodeTypeLower)) Score = 50;
+	// Synchronous rebuild from the loaded classes, normally this happens in the background
+	double StartTime = FPlatformTime::Seconds();
+	FunctionIndex.Rebuild();
+	const int32 FunctionCount = FunctionIndex.Num();
+	const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
 
-			TArray<FString> FuncParts = SplitName(FuncNameLower);
-			for (const FString& Part : NodeTypeParts)
-				if (FuncParts.Contains(Part)) Score += 10;
+	TArray<FGenFunctionMatch> Matches;
+	double TotalMs = 0.0;
+	double MaxMs = 0.0;
+	int32 Lookups = 0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		for (const FString& NodeType : NodeTypes)
+		{
+			StartTime = FPlatformTime::Seconds();
+			FunctionIndex.FindMatches(NodeType, FGenFunctionIndex::SuggestionWeights, 5, Matches);
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+			TotalMs += ElapsedMs;
+			MaxMs = FMath::Max(MaxMs, ElapsedMs);
+			++Lookups;
+		}
+	}
 
-			if (FuncNameLower.StartsWith(NodeTypeLower)) Score += 5;
-			if (FuncNameLower.Len() > NodeTypeLower.Len() * 2) Score -= 10;
+	// Recall against the expected "Class.Function" names, a name without a class matches any class
+	int32 Expected = 0;
+	int32 HitsAt1 = 0;
+	int32 HitsAt5 = 0;
+	TArray<TSharedPtr<FJsonValue>> Misses;
+	for (int32 Index = 0; Index < NodeTypes.Num() && Index < ExpectedNames.Num(); ++Index)
+	{
+		if (ExpectedNames[Index].IsEmpty()) continue;
+		++Expected;
 
-			if (Score > 0)
+		FunctionIndex.FindMatches(NodeTypes[Index], FGenFunctionIndex::SuggestionWeights, 5, Matches);
+		int32 Rank = INDEX_NONE;
+		for (int32 MatchIndex = 0; MatchIndex < Matches.Num() && Rank == INDEX_NONE; ++MatchIndex)
+		{
+			const FString& Name = FunctionIndex.GetDisplayName(Matches[MatchIndex].Index);
+			if (Name.Equals(ExpectedNames[Index], ESearchCase::IgnoreCase) ||
+				(!ExpectedNames[Index].Contains(TEXT(".")) && Name.EndsWith(TEXT(".") + ExpectedNames[Index], ESearchCase::IgnoreCase)))
 			{
-				FFunctionMatch Match;
-				Match.LibraryName = LibraryName;
-				Match.FunctionName = FuncName;
-				Match.DisplayName = FString::Printf(TEXT("%s.%s"), *LibraryName, *FuncName);
-				Match.Score = Score;
-				Matches.Add(Match);
+				Rank = MatchIndex;
 			}
 		}
+
+		if (Rank == 0) ++HitsAt1;
+		if (Rank != INDEX_NONE) ++HitsAt5;
+		else
+		{
+			TSharedPtr<FJsonObject> Miss = MakeShareable(new FJsonObject);
+			Miss->SetStringField(TEXT("node_type"), NodeTypes[Index]);
+			Miss->SetStringField(TEXT("expected"), ExpectedNames[Index]);
+			Miss->SetStringField(TEXT("best"), Matches.Num() > 0 ? FunctionIndex.GetDisplayName(Matches[0].Index) : TEXT(""));
+			Misses.Add(MakeShareable(new FJsonValueObject(Miss)));
+		}
 	}
 
-	if (Matches.Num() == 0)
+	const double AverageMs = Lookups > 0 ? TotalMs / Lookups : 0.0;
+	UE_LOG(LogGenPerformance, Display, TEXT("Node lookup (%d lookups over %d functions) took: %f ms average, %f ms max"),
+	       Lookups, FunctionCount, AverageMs, MaxMs);
+
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	Result->SetNumberField(TEXT("functions"), FunctionCount);
+	Result->SetNumberField(TEXT("lookups"), Lookups);
+	Result->SetNumberField(TEXT("build_ms"), BuildMs);
+	Result->SetNumberField(TEXT("average_ms"), AverageMs);
+	Result->SetNumberField(TEXT("max_ms"), MaxMs);
+	if (Expected > 0)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("No suggestions found for node type: %s"), *NodeType);
-		return TEXT("");
+		UE_LOG(LogGenPerformance, Display, TEXT("Node lookup recall over %d names: %.2f at 1, %.2f at 5"), Expected,
+		       static_cast<double>(HitsAt1) / Expected, static_cast<double>(HitsAt5) / Expected);
+		Result->SetNumberField(TEXT("recall_at_1"), static_cast<double>(HitsAt1) / Expected);
+		Result->SetNumberField(TEXT("recall_at_5"), static_cast<double>(HitsAt5) / Expected);
+		Result->SetArrayField(TEXT("misses"), Misses);
 	}
 
-	Matches.Sort([](const FFunctionMatch& A, const FFunctionMatch& B) { return A.Score > B.Score; });
-	TArray<FString> Suggestions;
-	for (const FFunctionMatch& Match : Matches) Suggestions.Add(Match.DisplayName);
-	while (Suggestions.Num() > 5) Suggestions.RemoveAt(Suggestions.Num() - 1);
-
-	FString SuggestionStr = FString::Join(Suggestions, TEXT(", "));
-	UE_LOG(LogTemp, Log, TEXT("Suggestions for %s: %s"), *NodeType, *SuggestionStr);
-	return TEXT("SUGGESTIONS:") + SuggestionStr;
+	FString ResultJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+	return ResultJson;
 }
 
+
+FString UGenBlueprintNodeCreator::ReloadNodeTypeAliases()
+{
+	FGenNodeTypeRegistry& Registry = FGenNodeTypeRegistry::Get();
+	const bool bSuccess = Registry.Reload();
+
+	TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject);
+	Result->SetBoolField(TEXT("success"), bSuccess);
+	Result->SetNumberField(TEXT("recipes"), Registry.NumRecipes());
+	Result->SetNumberField(TEXT("aliases"), Registry.NumAliases());
+
+	FString ResultJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(Result.ToSharedRef(), Writer);
+	return ResultJson;
+}
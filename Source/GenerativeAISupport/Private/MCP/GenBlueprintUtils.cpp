@@ -10,6 +10,11 @@
 #include "Factories/BlueprintFactory.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
+#include "MCP/GenCommandBatch.h"
+#include "MCP/GenBlueprintCompiler.h"
+#include "MCP/GenEditSession.h"
+#include "MCP/GenGraphValidator.h"
+#include "MCP/GenNodeGuidIndex.h"
 #include "UObject/SavePackage.h"
 #include "Blueprint/BlueprintSupport.h"
 #include "K2Node_FunctionEntry.h"
@@ -23,6 +28,66 @@
 #include "Engine/SimpleConstructionScript.h"
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+void UGenBlueprintUtils::BeginEditSession()
+{
+	FGenEditSession::Get().BeginExternalSession();
+}
+
+FString UGenBlueprintUtils::EndEditSession()
+{
+	FGenEditSession& EditSession = FGenEditSession::Get();
+	EditSession.EndExternalSession();
+
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(EditSession.GetStats().ToSharedRef(), Writer);
+	return ResultJson;
+}
+
+FString UGenBlueprintUtils::FlushPendingCompiles(const FString& BlueprintPath)
+{
+	FGenEditSession& EditSession = FGenEditSession::Get();
+	UBlueprint* Blueprint = BlueprintPath.IsEmpty() ? nullptr : LoadBlueprintAsset(BlueprintPath);
+	if (!BlueprintPath.IsEmpty() && !Blueprint)
+	{
+		return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
+	}
+
+	const int32 Compiles = EditSession.Flush(Blueprint);
+	const TSharedPtr<FJsonObject> Stats = EditSession.GetStats();
+	Stats->SetBoolField(TEXT("success"), true);
+	Stats->SetNumberField(TEXT("flushed_compiles"), Compiles);
+
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(Stats.ToSharedRef(), Writer);
+	return ResultJson;
+}
+
+FString UGenBlueprintUtils::GetCompileStats()
+{
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(FGenEditSession::Get().GetStats().ToSharedRef(), Writer);
+	return ResultJson;
+}
+
+FString UGenBlueprintUtils::ExecuteBatch(const FString& BatchJson)
+{
+	TSharedPtr<FJsonObject> Batch;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(BatchJson);
+	if (!FJsonSerializer::Deserialize(Reader, Batch) || !Batch.IsValid())
+	{
+		return TEXT("{\"success\": false, \"error\": \"Invalid batch JSON\"}");
+	}
+
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(FGenCommandBatch::Execute(Batch).ToSharedRef(), Writer);
+	return ResultJson;
+}
 
 UBlueprint* UGenBlueprintUtils::CreateBlueprint(const FString& BlueprintName, const FString& ParentClassName,
                                                 const FString& SavePath)
@@ -142,7 +207,7 @@ bool UGenBlueprintUtils::AddComponent(const FString& BlueprintPath, const FStrin
 	Blueprint->Modify();
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FGenEditSession::Get().RequestCompile(Blueprint);
 
 	// Open the Blueprint editor
 	if (GEditor)
@@ -285,7 +350,7 @@ bool UGenBlueprintUtils::AddVariable(const FString& BlueprintPath, const FString
 	Blueprint->Modify();
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FGenEditSession::Get().RequestCompile(Blueprint);
 
 	// Open the Blueprint editor
 	if (GEditor)
@@ -481,7 +546,7 @@ FString UGenBlueprintUtils::AddFunction(const FString& BlueprintPath, const FStr
 	Blueprint->Modify();
 
 	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	FGenEditSession::Get().RequestCompile(Blueprint);
 
 	OpenBlueprintGraph(Blueprint, FunctionGraph);
 
@@ -490,145 +555,153 @@ FString UGenBlueprintUtils::AddFunction(const FString& BlueprintPath, const FStr
 	return FunctionGraph->GraphGuid.ToString();
 }
 
-FString UGenBlueprintUtils::ConnectNodes(const FString& BlueprintPath, const FString& FunctionGuid,
-                                         const FString& SourceNodeGuid, const FString& SourcePinName,
-                                         const FString& TargetNodeGuid, const FString& TargetPinName)
+UEdGraph* UGenBlueprintUtils::FindGraphById(UBlueprint* Blueprint, const FString& FunctionGuid, FString& OutError)
 {
-    UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
-    if (!Blueprint) return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
+	UEdGraph* FunctionGraph = nullptr;
 
 	// Special handling for EventGraph
-	UEdGraph* FunctionGraph = nullptr;
 	if (FunctionGuid.Equals(TEXT("EventGraph"), ESearchCase::IgnoreCase))
 	{
 		// Get the first UbergraphPage (EventGraph)
-		if (Blueprint->UbergraphPages.Num() > 0)
-		{
-			FunctionGraph = Blueprint->UbergraphPages[0];
-		}
+		FunctionGraph = Blueprint->UbergraphPages.Num() > 0 ? Blueprint->UbergraphPages[0] : nullptr;
 	}
 	else
 	{
-		// Original GUID-based lookup for function graphs
 		FGuid GraphGuid;
 		if (!FGuid::Parse(FunctionGuid, GraphGuid))
-			return TEXT("{\"success\": false, \"error\": \"Invalid function GUID\"}");
-
-		for (UEdGraph* Graph : Blueprint->UbergraphPages)
-			if (Graph->GraphGuid == GraphGuid) { FunctionGraph = Graph; break; }
-		if (!FunctionGraph)
-			for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-				if (Graph->GraphGuid == GraphGuid) { FunctionGraph = Graph; break; }
+		{
+			OutError = TEXT("Invalid function GUID");
+			return nullptr;
+		}
+		FunctionGraph = FGenNodeGuidIndex::Get().FindGraph(Blueprint, GraphGuid);
 	}
 
 	if (!FunctionGraph)
-		return TEXT("{\"success\": false, \"error\": \"Could not find function graph\"}");
+	{
+		OutError = TEXT("Could not find function graph");
+	}
+	return FunctionGraph;
+}
+
+TSharedPtr<FJsonObject> UGenBlueprintUtils::ConnectPins(UBlueprint* Blueprint, UEdGraph* FunctionGraph,
+                                                        const FString& SourceNodeGuid, const FString& SourcePinName,
+                                                        const FString& TargetNodeGuid, const FString& TargetPinName)
+{
+	TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
+	ResponseObject->SetBoolField(TEXT("success"), false);
 
 	FGuid SourceGuid, TargetGuid;
 	if (!FGuid::Parse(SourceNodeGuid, SourceGuid) || !FGuid::Parse(TargetNodeGuid, TargetGuid))
-		return TEXT("{\"success\": false, \"error\": \"Invalid node GUID\"}");
-
-    UK2Node* SourceNode = nullptr;
-    UK2Node* TargetNode = nullptr;
-    for (UEdGraphNode* Node : FunctionGraph->Nodes)
-    {
-        if (UK2Node* K2Node = Cast<UK2Node>(Node))
-        {
-            if (K2Node->NodeGuid == SourceGuid) SourceNode = K2Node;
-            else if (K2Node->NodeGuid == TargetGuid) TargetNode = K2Node;
-        }
-    }
+	{
+		ResponseObject->SetStringField(TEXT("error"), TEXT("Invalid node GUID"));
+		return ResponseObject;
+	}
 
-    if (!SourceNode || !TargetNode)
-        return TEXT("{\"success\": false, \"error\": \"Could not find source or target node\"}");
+	// Both nodes have to live in the requested graph
+	FGenNodeGuidIndex& NodeIndex = FGenNodeGuidIndex::Get();
+	UK2Node* SourceNode = Cast<UK2Node>(NodeIndex.FindNode(Blueprint, SourceGuid));
+	UK2Node* TargetNode = Cast<UK2Node>(NodeIndex.FindNode(Blueprint, TargetGuid));
+	if (!SourceNode || !TargetNode || SourceNode->GetGraph() != FunctionGraph || TargetNode->GetGraph() != FunctionGraph)
+	{
+		ResponseObject->SetStringField(TEXT("error"), TEXT("Could not find source or target node"));
+		return ResponseObject;
+	}
 
-    UEdGraphPin* SourcePin = SourceNode->FindPin(FName(*SourcePinName), EGPD_Output);
-    UEdGraphPin* TargetPin = TargetNode->FindPin(FName(*TargetPinName), EGPD_Input);
+	UEdGraphPin* SourcePin = SourceNode->FindPin(FName(*SourcePinName), EGPD_Output);
+	UEdGraphPin* TargetPin = TargetNode->FindPin(FName(*TargetPinName), EGPD_Input);
 
-    if (!SourcePin || !TargetPin)
-    {
-    	TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-    	ResponseObject->SetBoolField(TEXT("success"), false);
-        
-    	FString ErrorMessage = FString::Printf(
+	if (!SourcePin || !TargetPin)
+	{
+		FString ErrorMessage = FString::Printf(
 			TEXT("Pin not found. Source: %s (%s), Target: %s (%s)"),
 			*SourcePinName, SourcePin ? TEXT("found") : TEXT("not found"),
 			*TargetPinName, TargetPin ? TEXT("found") : TEXT("not found"));
-    	
-        ResponseObject->SetBoolField(TEXT("success"), false);
-        ResponseObject->SetStringField(TEXT("error"), ErrorMessage);
+		ResponseObject->SetStringField(TEXT("error"), ErrorMessage);
 
-        auto AddPins = [](UK2Node* Node, const FString& FieldName, TSharedPtr<FJsonObject> JsonObj, EEdGraphPinDirection Direction)
-        {
-            TArray<TSharedPtr<FJsonValue>> PinsArray;
-            for (UEdGraphPin* Pin : Node->Pins)
-            {
-                if (Pin->Direction == Direction)
-                {
-                    TSharedPtr<FJsonObject> PinObj = MakeShareable(new FJsonObject);
-                    PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-                    PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-                    PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
-                    if (Pin->PinType.PinSubCategory != NAME_None)
-                        PinObj->SetStringField(TEXT("subtype"), Pin->PinType.PinSubCategory.ToString());
-                    PinsArray.Add(MakeShareable(new FJsonValueObject(PinObj)));
-                }
-            }
-            JsonObj->SetArrayField(FieldName, PinsArray);
-        };
+		auto AddPins = [](UK2Node* Node, const FString& FieldName, TSharedPtr<FJsonObject> JsonObj, EEdGraphPinDirection Direction)
+		{
+			TArray<TSharedPtr<FJsonValue>> PinsArray;
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				if (Pin->Direction == Direction)
+				{
+					TSharedPtr<FJsonObject> PinObj = MakeShareable(new FJsonObject);
+					PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
+					PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+					PinObj->SetStringField(TEXT("type"), Pin->PinType.PinCategory.ToString());
+					if (Pin->PinType.PinSubCategory != NAME_None)
+						PinObj->SetStringField(TEXT("subtype"), Pin->PinType.PinSubCategory.ToString());
+					PinsArray.Add(MakeShareable(new FJsonValueObject(PinObj)));
+				}
+			}
+			JsonObj->SetArrayField(FieldName, PinsArray);
+		};
 
-        AddPins(SourceNode, TEXT("source_available_pins"), ResponseObject, EGPD_Output);
-        AddPins(TargetNode, TEXT("target_available_pins"), ResponseObject, EGPD_Input);
+		AddPins(SourceNode, TEXT("source_available_pins"), ResponseObject, EGPD_Output);
+		AddPins(TargetNode, TEXT("target_available_pins"), ResponseObject, EGPD_Input);
+		return ResponseObject;
+	}
 
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
-    }
+	// Attempt the connection directly, letting Unreal handle type conversion. Both nodes are recorded first so
+	// undoing the transaction, or rolling back a batch, also removes the link from both pins
+	SourceNode->Modify();
+	TargetNode->Modify();
+	SourcePin->MakeLinkTo(TargetPin);
+
+	// Verify if the connection was successful
+	if (SourcePin->LinkedTo.Contains(TargetPin) && TargetPin->LinkedTo.Contains(SourcePin))
+	{
+		ResponseObject->SetBoolField(TEXT("success"), true);
+		return ResponseObject;
+	}
 
-    // Attempt the connection directly, letting Unreal handle type conversion
-    SourcePin->MakeLinkTo(TargetPin);
+	// Connection failed, provide detailed feedback
+	ResponseObject->SetStringField(TEXT("error"), TEXT("Failed to connect pins - type mismatch or invalid connection"));
 
-    // Verify if the connection was successful
-    if (SourcePin->LinkedTo.Contains(TargetPin) && TargetPin->LinkedTo.Contains(SourcePin))
-    {
-        Blueprint->Modify();
-        FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-
-        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-        ResponseObject->SetBoolField(TEXT("success"), true);
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
-    }
-    else
-    {
-        // Connection failed, provide detailed feedback
-        TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-        ResponseObject->SetBoolField(TEXT("success"), false);
-        ResponseObject->SetStringField(TEXT("error"), TEXT("Failed to connect pins - type mismatch or invalid connection"));
-
-        TSharedPtr<FJsonObject> SourcePinInfo = MakeShareable(new FJsonObject);
-        SourcePinInfo->SetStringField(TEXT("name"), SourcePin->PinName.ToString());
-        SourcePinInfo->SetStringField(TEXT("type"), SourcePin->PinType.PinCategory.ToString());
-        if (SourcePin->PinType.PinSubCategory != NAME_None)
-            SourcePinInfo->SetStringField(TEXT("subtype"), SourcePin->PinType.PinSubCategory.ToString());
-
-        TSharedPtr<FJsonObject> TargetPinInfo = MakeShareable(new FJsonObject);
-        TargetPinInfo->SetStringField(TEXT("name"), TargetPin->PinName.ToString());
-        TargetPinInfo->SetStringField(TEXT("type"), TargetPin->PinType.PinCategory.ToString());
-        if (TargetPin->PinType.PinSubCategory != NAME_None)
-            TargetPinInfo->SetStringField(TEXT("subtype"), TargetPin->PinType.PinSubCategory.ToString());
-
-        ResponseObject->SetObjectField(TEXT("source_pin"), SourcePinInfo);
-        ResponseObject->SetObjectField(TEXT("target_pin"), TargetPinInfo);
-
-        FString ResultJson;
-        TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-        FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
-        return ResultJson;
-    }
+	TSharedPtr<FJsonObject> SourcePinInfo = MakeShareable(new FJsonObject);
+	SourcePinInfo->SetStringField(TEXT("name"), SourcePin->PinName.ToString());
+	SourcePinInfo->SetStringField(TEXT("type"), SourcePin->PinType.PinCategory.ToString());
+	if (SourcePin->PinType.PinSubCategory != NAME_None)
+		SourcePinInfo->SetStringField(TEXT("subtype"), SourcePin->PinType.PinSubCategory.ToString());
+
+	TSharedPtr<FJsonObject> TargetPinInfo = MakeShareable(new FJsonObject);
+	TargetPinInfo->SetStringField(TEXT("name"), TargetPin->PinName.ToString());
+	TargetPinInfo->SetStringField(TEXT("type"), TargetPin->PinType.PinCategory.ToString());
+	if (TargetPin->PinType.PinSubCategory != NAME_None)
+		TargetPinInfo->SetStringField(TEXT("subtype"), TargetPin->PinType.PinSubCategory.ToString());
+
+	ResponseObject->SetObjectField(TEXT("source_pin"), SourcePinInfo);
+	ResponseObject->SetObjectField(TEXT("target_pin"), TargetPinInfo);
+	return ResponseObject;
+}
+
+FString UGenBlueprintUtils::ConnectNodes(const FString& BlueprintPath, const FString& FunctionGuid,
+                                         const FString& SourceNodeGuid, const FString& SourcePinName,
+                                         const FString& TargetNodeGuid, const FString& TargetPinName)
+{
+	UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
+	if (!Blueprint) return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
+
+	FString GraphError;
+	UEdGraph* FunctionGraph = FindGraphById(Blueprint, FunctionGuid, GraphError);
+	if (!FunctionGraph)
+		return FString::Printf(TEXT("{\"success\": false, \"error\": \"%s\"}"), *GraphError);
+
+	// Keep the skeleton class in step with the pending edits, as node creation does
+	FGenEditSession::Get().UpdateSkeleton(Blueprint);
+
+	const TSharedPtr<FJsonObject> ResponseObject = ConnectPins(Blueprint, FunctionGraph, SourceNodeGuid, SourcePinName,
+	                                                           TargetNodeGuid, TargetPinName);
+	if (ResponseObject->GetBoolField(TEXT("success")))
+	{
+		Blueprint->Modify();
+		FGenEditSession::Get().RequestStructuralModification(Blueprint);
+	}
+
+	FString ResultJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
+	return ResultJson;
 }
 
 bool UGenBlueprintUtils::CompileBlueprint(const FString& BlueprintPath)
@@ -636,49 +709,63 @@ bool UGenBlueprintUtils::CompileBlueprint(const FString& BlueprintPath)
 	UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
 	if (!Blueprint) return false;
     
-	// Validate pin connections before compiling
-	TArray<FString> InvalidConnectionMessages;
-	bool HasInvalidConnections = false;
+	// Exec outputs linked more than once keep their first link, other problems are left to validate_blueprint
+	const TSharedPtr<FJsonObject> Validation = FGenGraphValidator::Validate(Blueprint, EGenGraphFix::ExecLinks);
+	const int32 FixedLinks = static_cast<int32>(Validation->GetNumberField(TEXT("fixed")));
+	if (FixedLinks > 0)
+	{
+		UE_LOG(LogTemp, Log, TEXT("Fixed %d invalid links in blueprint: %s"), FixedLinks, *BlueprintPath);
+	}
+    
+	// Now compile, this also takes care of compiles still pending from earlier edits
+	UE_LOG(LogTemp, Log, TEXT("Compiled blueprint: %s"), *BlueprintPath);
+	FGenEditSession::Get().CompileNow(Blueprint);
     
-	// Check all graphs
-	for (UEdGraph* Graph : Blueprint->FunctionGraphs)
+	return true;
+}
+
+FString UGenBlueprintUtils::CompileBlueprints(const TArray<FString>& BlueprintPaths, bool bSequential)
+{
+	TArray<UBlueprint*> Blueprints;
+	TArray<TSharedPtr<FJsonValue>> Missing;
+	for (const FString& BlueprintPath : BlueprintPaths)
 	{
-		for (UEdGraphNode* Node : Graph->Nodes)
+		if (UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath))
 		{
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				// Check for multiple connections to exec output pins (a common issue)
-				if (Pin->Direction == EGPD_Output && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec)
-				{
-					if (Pin->LinkedTo.Num() > 1)
-					{
-						HasInvalidConnections = true;
-						// Optionally fix by keeping only the first connection
-						while (Pin->LinkedTo.Num() > 1)
-						{
-							Pin->LinkedTo.RemoveAt(1);
-						}
-						FString Message = FString::Printf(TEXT("Fixed invalid multiple connections from pin %s on node %s"), 
-							*Pin->PinName.ToString(), *Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-						InvalidConnectionMessages.Add(Message);
-					}
-				}
-			}
+			Blueprints.AddUnique(Blueprint);
+		}
+		else
+		{
+			Missing.Add(MakeShareable(new FJsonValueString(BlueprintPath)));
 		}
 	}
-    
-	// If issues were found and fixed, mark blueprint modified
-	if (HasInvalidConnections)
+
+	const TSharedPtr<FJsonObject> Response = FGenBlueprintCompiler::Compile(Blueprints, bSequential);
+	if (Missing.Num() > 0)
 	{
-		Blueprint->Modify();
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		Response->SetBoolField(TEXT("success"), false);
+		Response->SetArrayField(TEXT("missing"), Missing);
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Could not load %d blueprints"), Missing.Num()));
 	}
-    
-	// Now compile
-	UE_LOG(LogTemp, Log, TEXT("Compiled blueprint: %s"), *BlueprintPath);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
-    
-	return true;
+
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+	return ResultJson;
+}
+
+FString UGenBlueprintUtils::ValidateBlueprint(const FString& BlueprintPath, bool bFix)
+{
+	UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
+	if (!Blueprint)
+	{
+		return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
+	}
+
+	FString ResultJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(FGenGraphValidator::Validate(Blueprint, bFix ? EGenGraphFix::All : EGenGraphFix::None).ToSharedRef(), Writer);
+	return ResultJson;
 }
 
 AActor* UGenBlueprintUtils::SpawnBlueprint(const FString& BlueprintPath, const FVector& Location,
@@ -693,7 +780,8 @@ AActor* UGenBlueprintUtils::SpawnBlueprint(const FString& BlueprintPath, const F
 		return nullptr;
 	}
 
-	// Make sure the blueprint has been compiled
+	// Apply edits still waiting for their compile, then make sure the blueprint has been compiled
+	FGenEditSession::Get().Flush(Blueprint);
 	if (!Blueprint->GeneratedClass)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Blueprint has not been compiled"));
@@ -770,98 +858,111 @@ UFunction* UGenBlueprintUtils::FindFunctionByName(UClass* Class, const FString&
 FString UGenBlueprintUtils::ConnectNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid,
                                              const FString& ConnectionsJson)
 {
-    // Load the blueprint asset
-    UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
-    if (!Blueprint)
-    {
-       UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
-       return TEXT("{\"success\": false, \"error\": \"Could not load blueprint\"}");
-    }
+	// Parse the connections array from JSON
+	TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
+	TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ConnectionsJson);
+	if (!FJsonSerializer::Deserialize(Reader, ConnectionsArray))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to parse connections JSON"));
+		return TEXT("{\"success\": false, \"error\": \"Failed to parse connections JSON\"}");
+	}
 
-    // Parse the connections array from JSON
-    TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ConnectionsJson);
+	FString ResultJson;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
+	FJsonSerializer::Serialize(ConnectNodesInGraph(BlueprintPath, FunctionGuid, ConnectionsArray).ToSharedRef(), Writer);
+	return ResultJson;
+}
 
-    if (!FJsonSerializer::Deserialize(Reader, ConnectionsArray))
-    {
-       UE_LOG(LogTemp, Error, TEXT("Failed to parse connections JSON"));
-       return TEXT("{\"success\": false, \"error\": \"Failed to parse connections JSON\"}");
-    }
+TSharedPtr<FJsonObject> UGenBlueprintUtils::ConnectNodesInGraph(const FString& BlueprintPath, const FString& FunctionGuid,
+                                                                const TArray<TSharedPtr<FJsonValue>>& Connections)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
 
-    // Create a response array to track all connection results
-    TArray<TSharedPtr<FJsonValue>> ResultsArray;
-    int SuccessfulConnections = 0;
-    bool HasErrors = false;
+	UBlueprint* Blueprint = LoadBlueprintAsset(BlueprintPath);
+	if (!Blueprint)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not load blueprint at path: %s"), *BlueprintPath);
+		ResponseObject->SetBoolField(TEXT("success"), false);
+		ResponseObject->SetStringField(TEXT("error"), TEXT("Could not load blueprint"));
+		return ResponseObject;
+	}
 
-    for (int32 i = 0; i < ConnectionsArray.Num(); i++)
-    {
-       TSharedPtr<FJsonObject> ConnectionObject = ConnectionsArray[i]->AsObject();
-       if (!ConnectionObject.IsValid()) continue;
-
-       // Extract connection details
-       FString SourceNodeGuid = ConnectionObject->GetStringField(TEXT("source_node_id"));
-       FString SourcePinName = ConnectionObject->GetStringField(TEXT("source_pin"));
-       FString TargetNodeGuid = ConnectionObject->GetStringField(TEXT("target_node_id"));
-       FString TargetPinName = ConnectionObject->GetStringField(TEXT("target_pin"));
-
-       // Connect the nodes - UNCOMMENTED THIS!
-       FString ConnectionResult = ConnectNodes(BlueprintPath, FunctionGuid, SourceNodeGuid, SourcePinName, 
-                                          TargetNodeGuid, TargetPinName);
-
-       // Parse the result
-       TSharedPtr<FJsonObject> ResultObject;
-       TSharedRef<TJsonReader<>> ResultReader = TJsonReaderFactory<>::Create(ConnectionResult);
-       
-       if (FJsonSerializer::Deserialize(ResultReader, ResultObject) && ResultObject.IsValid())
-       {
-           // Add connection index and source/target identifiers
-           ResultObject->SetNumberField(TEXT("connection_index"), i);
-           ResultObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
-           ResultObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
-           
-           // Check if successful
-           bool bSuccess = false;
-           if (ResultObject->TryGetBoolField(TEXT("success"), bSuccess) && bSuccess)
-           {
-               SuccessfulConnections++;
-           }
-           else
-           {
-               HasErrors = true;
-           }
-           
-           ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
-       }
-       else
-       {
-           // Couldn't parse result, create error object
-           TSharedPtr<FJsonObject> ErrorObject = MakeShareable(new FJsonObject);
-           ErrorObject->SetBoolField(TEXT("success"), false);
-           ErrorObject->SetStringField(TEXT("error"), TEXT("Failed to parse connection result"));
-           ErrorObject->SetNumberField(TEXT("connection_index"), i);
-           ErrorObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
-           ErrorObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
-           
-           ResultsArray.Add(MakeShareable(new FJsonValueObject(ErrorObject)));
-           HasErrors = true;
-       }
-    }
+	FString GraphError;
+	UEdGraph* FunctionGraph = FindGraphById(Blueprint, FunctionGuid, GraphError);
+	if (!FunctionGraph)
+	{
+		ResponseObject->SetBoolField(TEXT("success"), false);
+		ResponseObject->SetStringField(TEXT("error"), GraphError);
+		return ResponseObject;
+	}
+	FGenEditSession::Get().UpdateSkeleton(Blueprint);
 
-    // Create the final response
-    TSharedPtr<FJsonObject> ResponseObject = MakeShareable(new FJsonObject);
-    ResponseObject->SetBoolField(TEXT("success"), !HasErrors);
-    ResponseObject->SetNumberField(TEXT("total_connections"), ConnectionsArray.Num());
-    ResponseObject->SetNumberField(TEXT("successful_connections"), SuccessfulConnections);
-    ResponseObject->SetArrayField(TEXT("results"), ResultsArray);
+	// Create a response array to track all connection results
+	TArray<TSharedPtr<FJsonValue>> ResultsArray;
+	ResultsArray.Reserve(Connections.Num());
+	int32 SuccessfulConnections = 0;
+	bool HasErrors = false;
+	double MaxConnectionMs = 0.0;
 
-    FString ResultJson;
-    TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ResultJson);
-    FJsonSerializer::Serialize(ResponseObject.ToSharedRef(), Writer);
+	for (int32 i = 0; i < Connections.Num(); i++)
+	{
+		const TSharedPtr<FJsonObject> ConnectionObject = Connections[i]->AsObject();
+		if (!ConnectionObject.IsValid()) continue;
+
+		const double ConnectionStartTime = FPlatformTime::Seconds();
+		FString SourceNodeGuid, SourcePinName, TargetNodeGuid, TargetPinName;
+		ConnectionObject->TryGetStringField(TEXT("source_node_id"), SourceNodeGuid);
+		ConnectionObject->TryGetStringField(TEXT("source_pin"), SourcePinName);
+		ConnectionObject->TryGetStringField(TEXT("target_node_id"), TargetNodeGuid);
+		ConnectionObject->TryGetStringField(TEXT("target_pin"), TargetPinName);
+
+		const TSharedPtr<FJsonObject> ResultObject = ConnectPins(Blueprint, FunctionGraph, SourceNodeGuid, SourcePinName,
+		                                                         TargetNodeGuid, TargetPinName);
+		if (ResultObject->GetBoolField(TEXT("success")))
+		{
+			SuccessfulConnections++;
+		}
+		else
+		{
+			HasErrors = true;
+		}
 
-    UE_LOG(LogTemp, Log, TEXT("Connected %d/%d node pairs in blueprint %s"), 
-          SuccessfulConnections, ConnectionsArray.Num(), *BlueprintPath);
-    
-    return ResultJson;
+		// Add connection index and source/target identifiers
+		const double ConnectionMs = (FPlatformTime::Seconds() - ConnectionStartTime) * 1000.0;
+		MaxConnectionMs = FMath::Max(MaxConnectionMs, ConnectionMs);
+		ResultObject->SetNumberField(TEXT("connection_index"), i);
+		ResultObject->SetStringField(TEXT("source_node"), SourceNodeGuid);
+		ResultObject->SetStringField(TEXT("target_node"), TargetNodeGuid);
+		ResultObject->SetNumberField(TEXT("elapsed_ms"), ConnectionMs);
+		ResultsArray.Add(MakeShareable(new FJsonValueObject(ResultObject)));
+	}
+
+	// One structural change for the whole batch
+	if (SuccessfulConnections > 0)
+	{
+		Blueprint->Modify();
+		FunctionGraph->NotifyGraphChanged();
+		FGenEditSession::Get().RequestStructuralModification(Blueprint);
+	}
+
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	const double AverageConnectionMs = Connections.Num() > 0 ? ElapsedMs / Connections.Num() : 0.0;
+
+	// Create the final response
+	ResponseObject->SetBoolField(TEXT("success"), !HasErrors);
+	ResponseObject->SetNumberField(TEXT("total_connections"), Connections.Num());
+	ResponseObject->SetNumberField(TEXT("successful_connections"), SuccessfulConnections);
+	ResponseObject->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+	ResponseObject->SetNumberField(TEXT("average_connection_ms"), AverageConnectionMs);
+	ResponseObject->SetNumberField(TEXT("max_connection_ms"), MaxConnectionMs);
+	ResponseObject->SetArrayField(TEXT("results"), ResultsArray);
+
+	UE_LOG(LogTemp, Log, TEXT("Connected %d/%d node pairs in blueprint %s"),
+	       SuccessfulConnections, Connections.Num(), *BlueprintPath);
+	UE_LOG(LogGenPerformance, Display, TEXT("Connecting %d node pairs took: %f ms (%f ms per connection, %f ms max)"),
+	       Connections.Num(), ElapsedMs, AverageConnectionMs, MaxConnectionMs);
+	return ResponseObject;
 }
 
 bool UGenBlueprintUtils::OpenBlueprintGraph(UBlueprint* Blueprint, UEdGraph* Graph)
@@ -974,14 +1075,8 @@ FString UGenBlueprintUtils::GetNodeGUID(const FString& BlueprintPath, const FStr
         if (FunctionGuid.IsEmpty()) return TEXT("{\"success\": false, \"error\": \"Function GUID required for FunctionGraph\"}");
         FGuid GraphGuid;
         if (!FGuid::Parse(FunctionGuid, GraphGuid)) return TEXT("{\"success\": false, \"error\": \"Invalid function GUID\"}");
-        for (UEdGraph* Graph : Blueprint->FunctionGraphs)
-        {
-            if (Graph->GraphGuid == GraphGuid)
-            {
-                TargetGraph = Graph;
-                break;
-            }
-        }
+        TargetGraph = FGenNodeGuidIndex::Get().FindGraph(Blueprint, GraphGuid);
+        if (TargetGraph && !Blueprint->FunctionGraphs.Contains(TargetGraph)) TargetGraph = nullptr;
     }
 
     if (!TargetGraph) return TEXT("{\"success\": false, \"error\": \"Could not find specified graph\"}");
@@ -1034,7 +1129,7 @@ FString UGenBlueprintUtils::GetNodeGUID(const FString& BlueprintPath, const FStr
             if (TargetNode)
             {
                 Blueprint->Modify();
-                FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+                FGenEditSession::Get().RequestStructuralModification(Blueprint);
             }
         }
     }
@@ -1179,7 +1274,7 @@ FString UGenBlueprintUtils::AddComponentWithEvents(const FString& BlueprintPath,
 
     // Mark Blueprint as dirty and save
     Blueprint->Modify();
-    FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+    FGenEditSession::Get().RequestStructuralModification(Blueprint);
 
     // Return success with GUIDs
     return FString::Printf(TEXT("{\"success\": true, \"message\": \"Added collision component %s with overlap events\", \"begin_overlap_guid\": \"%s\", \"end_overlap_guid\": \"%s\"}"),
@@ -0,0 +1,288 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenCommandBatch.h"
+
+#include "Editor.h"
+#include "Editor/Transactor.h"
+#include "ScopedTransaction.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "MCP/GenBlueprintCompiler.h"
+#include "MCP/GenBlueprintUtils.h"
+#include "MCP/GenCommandDispatcher.h"
+#include "MCP/GenEditSession.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+#define LOCTEXT_NAMESPACE "GenCommandBatch"
+
+TSharedPtr<FJsonObject> FGenCommandBatch::Execute(const TSharedPtr<FJsonObject>& Batch)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Operations;
+	if (!Batch->TryGetArrayField(TEXT("operations"), Operations) || Operations->Num() == 0)
+	{
+		return FGenCommandDispatcher::MakeError(TEXT("Missing required parameter 'operations'"));
+	}
+
+	bool bCompile = true;
+	bool bStopOnError = true;
+	bool bRollbackOnError = false;
+	Batch->TryGetBoolField(TEXT("compile"), bCompile);
+	Batch->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+	Batch->TryGetBoolField(TEXT("rollback_on_error"), bRollbackOnError);
+
+	const double StartTime = FPlatformTime::Seconds();
+	TMap<FString, TSharedPtr<FJsonObject>> ResultsById;
+	TArray<TSharedPtr<FJsonValue>> Results;
+	TSet<FString> TouchedBlueprints;
+	TArray<FString> CompilePaths;
+	int32 FailedIndex = INDEX_NONE;
+
+	// Identifies the transaction a rollback may undo, so a batch that recorded nothing never undoes an earlier edit
+	const FText TransactionTitle = FText::Format(LOCTEXT("BatchTransaction", "MCP Batch ({0} operations)"), Operations->Num());
+	const FGuid PreviousTransactionId = GEditor && GEditor->Trans ? GEditor->Trans->GetUndoContext().TransactionId : FGuid();
+
+	FGenEditSession::Get().BeginSession();
+	{
+		const FScopedTransaction Transaction(TransactionTitle);
+		for (int32 Index = 0; Index < Operations->Num(); ++Index)
+		{
+			const TSharedPtr<FJsonObject>* Operation;
+			TSharedPtr<FJsonObject> Result;
+			FString Id;
+			if (!(*Operations)[Index]->TryGetObject(Operation))
+			{
+				Result = FGenCommandDispatcher::MakeError(TEXT("Operation is not an object"));
+			}
+			else
+			{
+				(*Operation)->TryGetStringField(TEXT("id"), Id);
+
+				FString Error;
+				const TSharedPtr<FJsonValue> Resolved = ResolveReferences(MakeShareable(new FJsonValueObject(*Operation)), ResultsById, Error);
+				Result = Resolved.IsValid() ? RunOperation(Resolved->AsObject(), TouchedBlueprints, CompilePaths) : FGenCommandDispatcher::MakeError(Error);
+			}
+
+			if (!Id.IsEmpty())
+			{
+				ResultsById.Add(Id, Result);
+			}
+			Results.Add(MakeShareable(new FJsonValueObject(Result)));
+
+			bool bSuccess = false;
+			if (!Result->TryGetBoolField(TEXT("success"), bSuccess) || !bSuccess)
+			{
+				if (FailedIndex == INDEX_NONE)
+				{
+					FailedIndex = Index;
+				}
+				if (bStopOnError)
+				{
+					break;
+				}
+			}
+		}
+	}
+	TArray<UBlueprint*> Blueprints = FGenEditSession::Get().EndSessionAndTakePending();
+
+	// Assets created by the batch are not deleted by the undo
+	bool bRollBack = false;
+	if (FailedIndex != INDEX_NONE && bRollbackOnError && GEditor && GEditor->Trans)
+	{
+		const FTransactionContext Context = GEditor->Trans->GetUndoContext();
+		bRollBack = Context.TransactionId.IsValid() && Context.TransactionId != PreviousTransactionId &&
+			Context.Title.EqualTo(TransactionTitle);
+		if (bRollBack)
+		{
+			GEditor->UndoTransaction(false);
+		}
+	}
+
+	const double CompileStartTime = FPlatformTime::Seconds();
+	TArray<TSharedPtr<FJsonValue>> Compiled;
+	bool bCompileSucceeded = true;
+	if (bCompile && !bRollBack)
+	{
+		for (const FString& Path : CompilePaths)
+		{
+			if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *Path))
+			{
+				Blueprints.AddUnique(Blueprint);
+			}
+		}
+
+		if (Blueprints.Num() > 0)
+		{
+			const TSharedPtr<FJsonObject> CompileResponse = FGenBlueprintCompiler::Compile(Blueprints);
+			bCompileSucceeded = CompileResponse->GetBoolField(TEXT("success"));
+			Compiled = CompileResponse->GetArrayField(TEXT("blueprints"));
+		}
+	}
+	else
+	{
+		// The structural modifications were held back for the compile. After a rollback the skeleton classes may
+		// have been updated from edits the undo removed
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
+	}
+	const double EndTime = FPlatformTime::Seconds();
+
+	UE_LOG(LogGenPerformance, Display, TEXT("Batch of %d operations took: %f ms (compiling %d blueprints: %f ms)"), Results.Num(),
+	       (EndTime - StartTime) * 1000.0, Compiled.Num(), (EndTime - CompileStartTime) * 1000.0);
+
+	const TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+	Response->SetBoolField(TEXT("success"), FailedIndex == INDEX_NONE && bCompileSucceeded);
+	Response->SetArrayField(TEXT("results"), Results);
+	Response->SetArrayField(TEXT("compiled"), Compiled);
+	if (FailedIndex != INDEX_NONE)
+	{
+		Response->SetNumberField(TEXT("failed_operation"), FailedIndex);
+		Response->SetStringField(TEXT("error"), FString::Printf(TEXT("Operation %d failed"), FailedIndex));
+	}
+	Response->SetBoolField(TEXT("rolled_back"), bRollBack);
+	Response->SetNumberField(TEXT("elapsed_ms"), (EndTime - StartTime) * 1000.0);
+	return Response;
+}
+
+TSharedPtr<FJsonObject> FGenCommandBatch::RunOperation(const TSharedPtr<FJsonObject>& Operation, TSet<FString>& TouchedBlueprints,
+                                                       TArray<FString>& CompilePaths)
+{
+	FString Type;
+	Operation->TryGetStringField(TEXT("type"), Type);
+	if (Type == TEXT("execute_batch"))
+	{
+		return FGenCommandDispatcher::MakeError(TEXT("Batches cannot be nested"));
+	}
+
+	// Record the Blueprint and its graphs in the transaction before the first operation changes them
+	FString BlueprintPath;
+	if (Operation->TryGetStringField(TEXT("blueprint_path"), BlueprintPath) && !TouchedBlueprints.Contains(BlueprintPath))
+	{
+		TouchedBlueprints.Add(BlueprintPath);
+		if (UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath))
+		{
+			Blueprint->Modify();
+			TArray<UEdGraph*> Graphs;
+			Blueprint->GetAllGraphs(Graphs);
+			for (UEdGraph* Graph : Graphs)
+			{
+				Graph->Modify();
+			}
+		}
+	}
+
+	if (Type == TEXT("compile_blueprint"))
+	{
+		if (BlueprintPath.IsEmpty())
+		{
+			return FGenCommandDispatcher::MakeError(TEXT("Missing required parameters"));
+		}
+		CompilePaths.AddUnique(BlueprintPath);
+
+		const TSharedPtr<FJsonObject> Result = MakeShareable(new FJsonObject());
+		Result->SetBoolField(TEXT("success"), true);
+		Result->SetBoolField(TEXT("deferred"), true);
+		return Result;
+	}
+
+	return FGenCommandDispatcher::Get().Dispatch(Operation);
+}
+
+TSharedPtr<FJsonValue> FGenCommandBatch::ResolveReferences(const TSharedPtr<FJsonValue>& Value, const TMap<FString, TSharedPtr<FJsonObject>>& Results,
+                                                           FString& OutError)
+{
+	switch (Value->Type)
+	{
+	case EJson::String:
+		{
+			// Only a whole "${...}" string is a reference, other strings (literal "$5" defaults, scripts) pass through untouched
+			const FString String = Value->AsString();
+			if (!String.EndsWith(TEXT("}")))
+			{
+				return Value;
+			}
+			if (String.StartsWith(TEXT("$${")))
+			{
+				return MakeShareable(new FJsonValueString(String.Mid(1)));
+			}
+			return String.StartsWith(TEXT("${")) ? ResolveReference(String.Mid(2, String.Len() - 3), Results, OutError) : Value;
+		}
+
+	case EJson::Array:
+		{
+			TArray<TSharedPtr<FJsonValue>> Resolved;
+			for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+			{
+				const TSharedPtr<FJsonValue> ResolvedElement = ResolveReferences(Element, Results, OutError);
+				if (!ResolvedElement.IsValid())
+				{
+					return nullptr;
+				}
+				Resolved.Add(ResolvedElement);
+			}
+			return MakeShareable(new FJsonValueArray(Resolved));
+		}
+
+	case EJson::Object:
+		{
+			const TSharedPtr<FJsonObject> Resolved = MakeShareable(new FJsonObject());
+			for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+			{
+				const TSharedPtr<FJsonValue> ResolvedField = ResolveReferences(Field.Value, Results, OutError);
+				if (!ResolvedField.IsValid())
+				{
+					return nullptr;
+				}
+				Resolved->SetField(Field.Key, ResolvedField);
+			}
+			return MakeShareable(new FJsonValueObject(Resolved));
+		}
+
+	default:
+		return Value;
+	}
+}
+
+TSharedPtr<FJsonValue> FGenCommandBatch::ResolveReference(const FString& Reference, const TMap<FString, TSharedPtr<FJsonObject>>& Results,
+                                                          FString& OutError)
+{
+	TArray<FString> Segments;
+	Reference.ParseIntoArray(Segments, TEXT("."));
+
+	const TSharedPtr<FJsonObject>* Result = Segments.Num() > 0 ? Results.Find(Segments[0]) : nullptr;
+	if (!Result)
+	{
+		OutError = FString::Printf(TEXT("Unknown operation id in reference ${%s}"), *Reference);
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonValue> Current = MakeShareable(new FJsonValueObject(*Result));
+	for (int32 Index = 1; Index < Segments.Num() && Current.IsValid(); ++Index)
+	{
+		if (Current->Type == EJson::Object)
+		{
+			Current = Current->AsObject()->TryGetField(Segments[Index]);
+		}
+		else if (Current->Type == EJson::Array && Segments[Index].IsNumeric())
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Array = Current->AsArray();
+			const int32 ElementIndex = FCString::Atoi(*Segments[Index]);
+			Current = Array.IsValidIndex(ElementIndex) ? Array[ElementIndex] : nullptr;
+		}
+		else
+		{
+			Current = nullptr;
+		}
+	}
+
+	if (!Current.IsValid())
+	{
+		OutError = FString::Printf(TEXT("Could not resolve reference ${%s}"), *Reference);
+	}
+	return Current;
+}
+
+#undef LOCTEXT_NAMESPACE
@@ -0,0 +1,703 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenCommandDispatcher.h"
+
+#include "MCP/GenActorUtils.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenBlueprintUtils.h"
+#include "MCP/GenCommandBatch.h"
+#include "MCP/GenCommandExecutor.h"
+#include "MCP/GenObjectProperties.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	TSharedPtr<FJsonObject> MakeSuccess()
+	{
+		const TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+		Response->SetBoolField(TEXT("success"), true);
+		return Response;
+	}
+
+	FString ReadString(const TSharedPtr<FJsonObject>& Command, const TCHAR* Field, const FString& Default = TEXT(""))
+	{
+		FString Value;
+		return Command->TryGetStringField(Field, Value) ? Value : Default;
+	}
+
+	// Any JSON value as a string, the way the Python handlers pass str()/json.dumps() values to C++
+	FString ReadAsString(const TSharedPtr<FJsonObject>& Command, const TCHAR* Field, const FString& Default = TEXT(""))
+	{
+		const TSharedPtr<FJsonValue> Value = Command->TryGetField(Field);
+		if (!Value.IsValid() || Value->IsNull())
+		{
+			return Default;
+		}
+		if (Value->Type == EJson::String || Value->Type == EJson::Number || Value->Type == EJson::Boolean)
+		{
+			return Value->AsString();
+		}
+
+		FString Serialized;
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Serialized);
+		FJsonSerializer::Serialize(Value, TEXT(""), Writer);
+		return Serialized;
+	}
+
+	bool ReadNumbers(const TSharedPtr<FJsonObject>& Command, const TCHAR* Field, int32 MinCount, TArray<double>& OutNumbers)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Values;
+		if (!Command->TryGetArrayField(Field, Values) || Values->Num() < MinCount)
+		{
+			return false;
+		}
+		for (const TSharedPtr<FJsonValue>& Value : *Values)
+		{
+			OutNumbers.Add(Value->AsNumber());
+		}
+		return true;
+	}
+
+	FVector ReadVector(const TSharedPtr<FJsonObject>& Command, const TCHAR* Field, const FVector& Default)
+	{
+		TArray<double> Numbers;
+		return ReadNumbers(Command, Field, 3, Numbers) ? FVector(Numbers[0], Numbers[1], Numbers[2]) : Default;
+	}
+
+	// Same component order as unreal.Rotator(roll, pitch, yaw) used by the Python handlers
+	FRotator ReadRotator(const TSharedPtr<FJsonObject>& Command, const TCHAR* Field)
+	{
+		TArray<double> Numbers;
+		return ReadNumbers(Command, Field, 3, Numbers) ? FRotator(Numbers[1], Numbers[2], Numbers[0]) : FRotator::ZeroRotator;
+	}
+}
+
+FGenCommandDispatcher& FGenCommandDispatcher::Get()
+{
+	static FGenCommandDispatcher Instance;
+	return Instance;
+}
+
+FGenCommandDispatcher::FGenCommandDispatcher()
+{
+	RegisterBuiltinHandlers();
+}
+
+void FGenCommandDispatcher::RegisterHandler(const FString& Type, FCommandHandler Handler)
+{
+	check(IsInGameThread());
+	Handlers.Add(Type, MoveTemp(Handler));
+}
+
+TSharedPtr<FJsonObject> FGenCommandDispatcher::Dispatch(const TSharedPtr<FJsonObject>& Command) const
+{
+	if (!Command.IsValid())
+	{
+		return MakeError(TEXT("Invalid command"));
+	}
+
+	const FString Type = ReadString(Command, TEXT("type"));
+	const FCommandHandler* Handler = Handlers.Find(Type);
+	if (!Handler)
+	{
+		return MakeError(FString::Printf(TEXT("Unknown command type: %s"), *Type));
+	}
+
+	TSharedPtr<FJsonObject> Response = (*Handler)(Command);
+	return Response.IsValid() ? Response : MakeError(FString::Printf(TEXT("Command %s returned no response"), *Type));
+}
+
+bool FGenCommandDispatcher::IsThreadSafeCommand(const FString& Type)
+{
+	return Type == TEXT("handshake");
+}
+
+TSharedPtr<FJsonObject> FGenCommandDispatcher::MakeError(const FString& Error)
+{
+	const TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+	Response->SetBoolField(TEXT("success"), false);
+	Response->SetStringField(TEXT("error"), Error);
+	return Response;
+}
+
+TSharedPtr<FJsonObject> FGenCommandDispatcher::ParseResult(const FString& ResultJson)
+{
+	TSharedPtr<FJsonObject> Result;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResultJson);
+	if (!FJsonSerializer::Deserialize(Reader, Result) || !Result.IsValid())
+	{
+		return MakeError(FString::Printf(TEXT("Failed to parse result: %s"), *ResultJson));
+	}
+	return Result;
+}
+
+void FGenCommandDispatcher::RegisterBuiltinHandlers()
+{
+	Handlers.Add(TEXT("handshake"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("message"), FString::Printf(TEXT("Received: %s"), *ReadString(Command, TEXT("message"))));
+		return Response;
+	});
+
+	// Command pump metrics, "reset": true starts a new measurement after reading them
+	Handlers.Add(TEXT("get_command_stats"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FGenCommandPumpStats Stats = FGenCommandExecutor::Get().GetStats();
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetNumberField(TEXT("queue_depth"), Stats.QueueDepth);
+		Response->SetNumberField(TEXT("peak_queue_depth"), Stats.PeakQueueDepth);
+		Response->SetNumberField(TEXT("commands_executed"), Stats.CommandsExecuted);
+		Response->SetNumberField(TEXT("average_wait_ms"), Stats.AverageWaitMs);
+		Response->SetNumberField(TEXT("max_wait_ms"), Stats.MaxWaitMs);
+		Response->SetNumberField(TEXT("average_execute_ms"), Stats.AverageExecuteMs);
+		Response->SetNumberField(TEXT("commands_per_second"), Stats.CommandsPerSecond);
+
+		bool bReset = false;
+		if (Command->TryGetBoolField(TEXT("reset"), bReset) && bReset)
+		{
+			FGenCommandExecutor::Get().ResetStats();
+		}
+		return Response;
+	});
+
+	// Basic object commands
+	Handlers.Add(TEXT("spawn"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString ActorClass = ReadString(Command, TEXT("actor_class"), TEXT("Cube"));
+		const FVector Location = ReadVector(Command, TEXT("location"), FVector::ZeroVector);
+		const FRotator Rotation = ReadRotator(Command, TEXT("rotation"));
+		const FVector Scale = ReadVector(Command, TEXT("scale"), FVector::OneVector);
+		const FString ActorLabel = ReadString(Command, TEXT("actor_label"));
+
+		static const TMap<FString, FString> ShapeMap = {
+			{TEXT("cube"), TEXT("Cube")}, {TEXT("sphere"), TEXT("Sphere")}, {TEXT("cylinder"), TEXT("Cylinder")}, {TEXT("cone"), TEXT("Cone")}
+		};
+		const FString* ShapeName = ShapeMap.Find(ActorClass.ToLower());
+		AActor* Actor = ShapeName
+			                ? UGenActorUtils::SpawnBasicShape(*ShapeName, Location, Rotation, Scale, ActorLabel)
+			                : UGenActorUtils::SpawnActorFromClass(ActorClass, Location, Rotation, Scale, ActorLabel);
+		if (!Actor)
+		{
+			return MakeError(FString::Printf(TEXT("Failed to spawn actor of type %s\nHint: For basic shapes, use 'Cube', 'Sphere', 'Cylinder', or 'Cone'. "
+			                                      "For other actors, try using '/Script/Engine.PointLight' format."), *ActorClass));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("actor_name"), Actor->GetActorLabel());
+		return Response;
+	});
+
+	Handlers.Add(TEXT("create_material"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString MaterialName = ReadString(Command, TEXT("material_name"), TEXT("NewMaterial"));
+		TArray<double> Color;
+		if (!ReadNumbers(Command, TEXT("color"), 3, Color))
+		{
+			Color = {1.0, 0.0, 0.0};
+		}
+
+		const FLinearColor LinearColor(Color[0], Color[1], Color[2], Color.Num() > 3 ? Color[3] : 1.0);
+		if (!UGenActorUtils::CreateMaterial(MaterialName, LinearColor))
+		{
+			return MakeError(TEXT("Failed to create material"));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("material_path"), FString::Printf(TEXT("/Game/Materials/%s"), *MaterialName));
+		return Response;
+	});
+
+	Handlers.Add(TEXT("modify_object"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString ActorName = ReadString(Command, TEXT("actor_name"));
+		const FString PropertyType = ReadString(Command, TEXT("property_type"));
+		if (ActorName.IsEmpty() || PropertyType.IsEmpty() || !Command->HasField(TEXT("value")))
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		bool bSuccess;
+		if (PropertyType == TEXT("material"))
+		{
+			bSuccess = UGenActorUtils::SetActorMaterialByPath(ActorName, ReadString(Command, TEXT("value")));
+		}
+		else if (PropertyType == TEXT("position") || PropertyType == TEXT("rotation") || PropertyType == TEXT("scale"))
+		{
+			TArray<double> Numbers;
+			if (!ReadNumbers(Command, TEXT("value"), 3, Numbers))
+			{
+				return MakeError(TEXT("Vector data must be a list of 3 floats"));
+			}
+			if (PropertyType == TEXT("position"))
+			{
+				bSuccess = UGenActorUtils::SetActorPosition(ActorName, FVector(Numbers[0], Numbers[1], Numbers[2]));
+			}
+			else if (PropertyType == TEXT("rotation"))
+			{
+				bSuccess = UGenActorUtils::SetActorRotation(ActorName, ReadRotator(Command, TEXT("value")));
+			}
+			else
+			{
+				bSuccess = UGenActorUtils::SetActorScale(ActorName, FVector(Numbers[0], Numbers[1], Numbers[2]));
+			}
+		}
+		else
+		{
+			return MakeError(FString::Printf(TEXT("Unknown property type: %s"), *PropertyType));
+		}
+
+		return bSuccess ? MakeSuccess() : MakeError(FString::Printf(TEXT("Failed to set %s for %s"), *PropertyType, *ActorName));
+	});
+
+	// Blueprint commands
+	Handlers.Add(TEXT("create_blueprint"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintName = ReadString(Command, TEXT("blueprint_name"), TEXT("NewBlueprint"));
+		const FString ParentClass = ReadString(Command, TEXT("parent_class"), TEXT("Actor"));
+		const FString SavePath = ReadString(Command, TEXT("save_path"), TEXT("/Game/Blueprints"));
+		if (!UGenBlueprintUtils::CreateBlueprint(BlueprintName, ParentClass, SavePath))
+		{
+			return MakeError(FString::Printf(TEXT("Failed to create Blueprint %s"), *BlueprintName));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("blueprint_path"), FString::Printf(TEXT("%s/%s"), *SavePath, *BlueprintName));
+		return Response;
+	});
+
+	Handlers.Add(TEXT("add_component"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString ComponentClass = ReadString(Command, TEXT("component_class"));
+		if (BlueprintPath.IsEmpty() || ComponentClass.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		return UGenBlueprintUtils::AddComponent(BlueprintPath, ComponentClass, ReadString(Command, TEXT("component_name")))
+			       ? MakeSuccess()
+			       : MakeError(FString::Printf(TEXT("Failed to add component %s to %s"), *ComponentClass, *BlueprintPath));
+	});
+
+	Handlers.Add(TEXT("add_variable"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString VariableName = ReadString(Command, TEXT("variable_name"));
+		const FString VariableType = ReadString(Command, TEXT("variable_type"));
+		if (BlueprintPath.IsEmpty() || VariableName.IsEmpty() || VariableType.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		return UGenBlueprintUtils::AddVariable(BlueprintPath, VariableName, VariableType, ReadAsString(Command, TEXT("default_value")),
+		                                       ReadString(Command, TEXT("category"), TEXT("Default")))
+			       ? MakeSuccess()
+			       : MakeError(FString::Printf(TEXT("Failed to add variable %s to %s"), *VariableName, *BlueprintPath));
+	});
+
+	Handlers.Add(TEXT("add_function"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionName = ReadString(Command, TEXT("function_name"));
+		if (BlueprintPath.IsEmpty() || FunctionName.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		const FString FunctionId = UGenBlueprintUtils::AddFunction(BlueprintPath, FunctionName, ReadAsString(Command, TEXT("inputs"), TEXT("[]")),
+		                                                           ReadAsString(Command, TEXT("outputs"), TEXT("[]")));
+		if (FunctionId.IsEmpty())
+		{
+			return MakeError(FString::Printf(TEXT("Failed to add function %s to %s"), *FunctionName, *BlueprintPath));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("function_id"), FunctionId);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("add_node"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		const FString NodeType = ReadString(Command, TEXT("node_type"));
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty() || NodeType.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		TArray<double> Position;
+		if (!ReadNumbers(Command, TEXT("node_position"), 2, Position))
+		{
+			Position = {0.0, 0.0};
+		}
+
+		const FString NodeId = UGenBlueprintNodeCreator::AddNode(BlueprintPath, FunctionId, NodeType, Position[0], Position[1],
+		                                                         ReadAsString(Command, TEXT("node_properties"), TEXT("{}")));
+		if (NodeId.IsEmpty())
+		{
+			return MakeError(FString::Printf(TEXT("Failed to add node %s to %s"), *NodeType, *BlueprintPath));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("node_id"), NodeId);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("connect_nodes"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		const FString SourceNodeId = ReadString(Command, TEXT("source_node_id"));
+		const FString SourcePin = ReadString(Command, TEXT("source_pin"));
+		const FString TargetNodeId = ReadString(Command, TEXT("target_node_id"));
+		const FString TargetPin = ReadString(Command, TEXT("target_pin"));
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty() || SourceNodeId.IsEmpty() || SourcePin.IsEmpty() ||
+			TargetNodeId.IsEmpty() || TargetPin.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		// Failures are passed through with the available pins
+		const TSharedPtr<FJsonObject> Result = ParseResult(
+			UGenBlueprintUtils::ConnectNodes(BlueprintPath, FunctionId, SourceNodeId, SourcePin, TargetNodeId, TargetPin));
+		return Result->GetBoolField(TEXT("success")) ? MakeSuccess() : Result;
+	});
+
+	Handlers.Add(TEXT("compile_blueprint"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		if (BlueprintPath.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		return UGenBlueprintUtils::CompileBlueprint(BlueprintPath)
+			       ? MakeSuccess()
+			       : MakeError(FString::Printf(TEXT("Failed to compile blueprint: %s"), *BlueprintPath));
+	});
+
+	Handlers.Add(TEXT("compile_blueprints"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* PathValues;
+		if (!Command->TryGetArrayField(TEXT("blueprint_paths"), PathValues) || PathValues->Num() == 0)
+		{
+			return MakeError(TEXT("Missing required parameter 'blueprint_paths'"));
+		}
+
+		TArray<FString> BlueprintPaths;
+		for (const TSharedPtr<FJsonValue>& PathValue : *PathValues)
+		{
+			BlueprintPaths.Add(PathValue->AsString());
+		}
+		bool bSequential = false;
+		Command->TryGetBoolField(TEXT("sequential"), bSequential);
+		return ParseResult(UGenBlueprintUtils::CompileBlueprints(BlueprintPaths, bSequential));
+	});
+
+	Handlers.Add(TEXT("validate_blueprint"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		if (BlueprintPath.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		bool bFix = false;
+		Command->TryGetBoolField(TEXT("fix"), bFix);
+		return ParseResult(UGenBlueprintUtils::ValidateBlueprint(BlueprintPath, bFix));
+	});
+
+	// Edit sessions, compiles requested by the edits are coalesced until the session ends or the edits go idle
+	Handlers.Add(TEXT("begin_edit_session"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		UGenBlueprintUtils::BeginEditSession();
+		return MakeSuccess();
+	});
+
+	Handlers.Add(TEXT("end_edit_session"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TSharedPtr<FJsonObject> Result = ParseResult(UGenBlueprintUtils::EndEditSession());
+		Result->SetBoolField(TEXT("success"), true);
+		return Result;
+	});
+
+	Handlers.Add(TEXT("flush_compiles"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		return ParseResult(UGenBlueprintUtils::FlushPendingCompiles(ReadString(Command, TEXT("blueprint_path"))));
+	});
+
+	Handlers.Add(TEXT("get_compile_stats"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TSharedPtr<FJsonObject> Result = ParseResult(UGenBlueprintUtils::GetCompileStats());
+		Result->SetBoolField(TEXT("success"), true);
+		return Result;
+	});
+
+	Handlers.Add(TEXT("spawn_blueprint"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		if (BlueprintPath.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		AActor* Actor = UGenBlueprintUtils::SpawnBlueprint(BlueprintPath, ReadVector(Command, TEXT("location"), FVector::ZeroVector),
+		                                                   ReadRotator(Command, TEXT("rotation")), ReadVector(Command, TEXT("scale"), FVector::OneVector),
+		                                                   ReadString(Command, TEXT("actor_label")));
+		if (!Actor)
+		{
+			return MakeError(FString::Printf(TEXT("Failed to spawn blueprint: %s"), *BlueprintPath));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("actor_name"), Actor->GetActorLabel());
+		return Response;
+	});
+
+	Handlers.Add(TEXT("delete_node"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		const FString NodeId = ReadString(Command, TEXT("node_id"));
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty() || NodeId.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		return UGenBlueprintNodeCreator::DeleteNode(BlueprintPath, FunctionId, NodeId)
+			       ? MakeSuccess()
+			       : MakeError(FString::Printf(TEXT("Failed to delete node %s"), *NodeId));
+	});
+
+	// Getters
+	Handlers.Add(TEXT("get_node_guid"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString GraphType = ReadString(Command, TEXT("graph_type"), TEXT("EventGraph"));
+		const FString NodeName = ReadString(Command, TEXT("node_name"));
+		if (BlueprintPath.IsEmpty())
+		{
+			return MakeError(TEXT("Missing blueprint_path"));
+		}
+		if (GraphType != TEXT("EventGraph") && GraphType != TEXT("FunctionGraph"))
+		{
+			return MakeError(FString::Printf(TEXT("Invalid graph_type: %s"), *GraphType));
+		}
+
+		const FString NodeGuid = UGenBlueprintUtils::GetNodeGUID(BlueprintPath, GraphType, NodeName, ReadString(Command, TEXT("function_id")));
+		if (NodeGuid.IsEmpty())
+		{
+			return MakeError(FString::Printf(TEXT("Node not found: %s"), NodeName.IsEmpty() ? TEXT("FunctionEntry") : *NodeName));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetStringField(TEXT("node_guid"), NodeGuid);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("get_all_nodes"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		const FString NodesJson = UGenBlueprintNodeCreator::GetAllNodesInGraph(BlueprintPath, FunctionId);
+		TArray<TSharedPtr<FJsonValue>> Nodes;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(NodesJson);
+		if (NodesJson.IsEmpty() || !FJsonSerializer::Deserialize(Reader, Nodes))
+		{
+			return MakeError(TEXT("Failed to get nodes"));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("nodes"), Nodes);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("get_node_suggestions"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString NodeType = ReadString(Command, TEXT("node_type"));
+		if (NodeType.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameter 'node_type'"));
+		}
+
+		FString Result = UGenBlueprintNodeCreator::GetNodeSuggestions(NodeType);
+		TArray<TSharedPtr<FJsonValue>> Suggestions;
+		if (!Result.IsEmpty())
+		{
+			if (!Result.RemoveFromStart(TEXT("SUGGESTIONS:")))
+			{
+				return MakeError(TEXT("Unexpected response format from Unreal"));
+			}
+			TArray<FString> Names;
+			Result.ParseIntoArray(Names, TEXT(", "));
+			for (const FString& Name : Names)
+			{
+				Suggestions.Add(MakeShareable(new FJsonValueString(Name)));
+			}
+		}
+
+		TArray<TSharedPtr<FJsonValue>> Candidates;
+		const FString CandidatesJson = UGenBlueprintNodeCreator::GetRankedNodeCandidates(NodeType, 10);
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(CandidatesJson);
+		FJsonSerializer::Deserialize(Reader, Candidates);
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetArrayField(TEXT("suggestions"), Suggestions);
+		Response->SetArrayField(TEXT("candidates"), Candidates);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("benchmark_node_lookup"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* NodeTypeValues;
+		if (!Command->TryGetArrayField(TEXT("node_types"), NodeTypeValues) || NodeTypeValues->Num() == 0)
+		{
+			return MakeError(TEXT("Missing required parameter 'node_types'"));
+		}
+
+		TArray<FString> NodeTypes;
+		for (const TSharedPtr<FJsonValue>& Value : *NodeTypeValues)
+		{
+			NodeTypes.Add(Value->AsString());
+		}
+		TArray<FString> ExpectedNames;
+		const TArray<TSharedPtr<FJsonValue>>* ExpectedValues;
+		if (Command->TryGetArrayField(TEXT("expected_names"), ExpectedValues))
+		{
+			for (const TSharedPtr<FJsonValue>& Value : *ExpectedValues)
+			{
+				ExpectedNames.Add(Value->AsString());
+			}
+		}
+		int32 Iterations = 100;
+		Command->TryGetNumberField(TEXT("iterations"), Iterations);
+
+		const TSharedPtr<FJsonObject> Result = ParseResult(UGenBlueprintNodeCreator::BenchmarkNodeLookup(NodeTypes, ExpectedNames, Iterations));
+		Result->SetBoolField(TEXT("success"), true);
+		return Result;
+	});
+
+	Handlers.Add(TEXT("reload_node_aliases"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const TSharedPtr<FJsonObject> Result = ParseResult(UGenBlueprintNodeCreator::ReloadNodeTypeAliases());
+		if (!Result->GetBoolField(TEXT("success")))
+		{
+			return MakeError(TEXT("Failed to load NodeTypeAliases.json, see the output log"));
+		}
+		return Result;
+	});
+
+	// Bulk commands
+	Handlers.Add(TEXT("add_nodes_bulk"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		const TArray<TSharedPtr<FJsonValue>>* NodesArray;
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty() || !Command->TryGetArrayField(TEXT("nodes"), NodesArray) || NodesArray->Num() == 0)
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+
+		// The parsed node objects go straight to the node creator, no JSON round trip
+		FString Error;
+		const TArray<TSharedPtr<FJsonValue>> Results = UGenBlueprintNodeCreator::AddNodesToGraph(BlueprintPath, FunctionId, *NodesArray, Error);
+		if (!Error.IsEmpty())
+		{
+			return MakeError(FString::Printf(TEXT("Failed to add nodes to %s: %s"), *BlueprintPath, *Error));
+		}
+
+		// Reference id -> node guid, like the Python handler
+		const TSharedPtr<FJsonObject> NodeMapping = MakeShareable(new FJsonObject());
+		for (const TSharedPtr<FJsonValue>& ResultValue : Results)
+		{
+			const TSharedPtr<FJsonObject> Result = ResultValue->AsObject();
+			if (!Result.IsValid())
+			{
+				continue;
+			}
+			FString RefId;
+			if (!Result->TryGetStringField(TEXT("ref_id"), RefId))
+			{
+				RefId = FString::Printf(TEXT("node_%d"), NodeMapping->Values.Num());
+			}
+			NodeMapping->SetStringField(RefId, ReadString(Result, TEXT("node_guid")));
+		}
+
+		const TSharedPtr<FJsonObject> Response = MakeSuccess();
+		Response->SetObjectField(TEXT("nodes"), NodeMapping);
+		return Response;
+	});
+
+	Handlers.Add(TEXT("connect_nodes_bulk"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString FunctionId = ReadString(Command, TEXT("function_id"));
+		if (BlueprintPath.IsEmpty() || FunctionId.IsEmpty() || !Command->HasField(TEXT("connections")))
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		// The parsed connection objects go straight to the wiring, no JSON round trip
+		const TArray<TSharedPtr<FJsonValue>>* ConnectionsArray;
+		if (Command->TryGetArrayField(TEXT("connections"), ConnectionsArray))
+		{
+			return UGenBlueprintUtils::ConnectNodesInGraph(BlueprintPath, FunctionId, *ConnectionsArray);
+		}
+		return ParseResult(UGenBlueprintUtils::ConnectNodesBulk(BlueprintPath, FunctionId, ReadAsString(Command, TEXT("connections"))));
+	});
+
+	Handlers.Add(TEXT("execute_batch"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		return FGenCommandBatch::Execute(Command);
+	});
+
+	// Components
+	Handlers.Add(TEXT("edit_component_property"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString ComponentName = ReadString(Command, TEXT("component_name"));
+		const FString PropertyName = ReadString(Command, TEXT("property_name"));
+		const FString Value = ReadAsString(Command, TEXT("value"));
+		bool bIsSceneActor = false;
+		Command->TryGetBoolField(TEXT("is_scene_actor"), bIsSceneActor);
+		const FString ActorName = ReadString(Command, TEXT("actor_name"));
+		if (ComponentName.IsEmpty() || PropertyName.IsEmpty() || Value.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		if (bIsSceneActor && ActorName.IsEmpty())
+		{
+			return MakeError(TEXT("Actor name required for scene actor"));
+		}
+		return ParseResult(UGenObjectProperties::EditComponentProperty(ReadString(Command, TEXT("blueprint_path")), ComponentName, PropertyName,
+		                                                               Value, bIsSceneActor, ActorName));
+	});
+
+	Handlers.Add(TEXT("add_component_with_events"), [](const TSharedPtr<FJsonObject>& Command)
+	{
+		const FString BlueprintPath = ReadString(Command, TEXT("blueprint_path"));
+		const FString ComponentName = ReadString(Command, TEXT("component_name"));
+		const FString ComponentClass = ReadString(Command, TEXT("component_class"));
+		if (BlueprintPath.IsEmpty() || ComponentName.IsEmpty() || ComponentClass.IsEmpty())
+		{
+			return MakeError(TEXT("Missing required parameters"));
+		}
+		return ParseResult(UGenBlueprintUtils::AddComponentWithEvents(BlueprintPath, ComponentName, ComponentClass));
+	});
+
+	// Python and editor scripting commands are only served by the Python bridge
+	for (const TCHAR* PythonOnly : {TEXT("execute_python"), TEXT("execute_unreal_command"), TEXT("get_all_scene_objects"),
+	                                TEXT("create_project_folder"), TEXT("get_files_in_folder"), TEXT("add_input_binding")})
+	{
+		const FString Type = PythonOnly;
+		Handlers.Add(Type, [Type](const TSharedPtr<FJsonObject>& Command)
+		{
+			return MakeError(FString::Printf(TEXT("%s is only available through the Python socket server"), *Type));
+		});
+	}
+}
@@ -0,0 +1,127 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenCommandExecutor.h"
+
+#include "GenerativeAISupportSettings.h"
+#include "MCP/GenCommandDispatcher.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	constexpr double IdleWindowSeconds = 0.25;
+}
+
+FGenCommandExecutor& FGenCommandExecutor::Get()
+{
+	static FGenCommandExecutor Instance;
+	return Instance;
+}
+
+FGenCommandExecutor::FGenCommandExecutor()
+{
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGenCommandExecutor::Tick));
+}
+
+void FGenCommandExecutor::Enqueue(TSharedPtr<FJsonObject> Command, FOnCommandExecuted OnExecuted, double ReceiveTime)
+{
+	Queue.Enqueue({MoveTemp(Command), MoveTemp(OnExecuted), ReceiveTime});
+	++QueueDepth;
+}
+
+FGenCommandPumpStats FGenCommandExecutor::GetStats() const
+{
+	FGenCommandPumpStats Stats;
+	Stats.QueueDepth = QueueDepth;
+	Stats.PeakQueueDepth = PeakQueueDepth;
+	Stats.CommandsExecuted = CommandsExecuted;
+	Stats.AverageWaitMs = CommandsExecuted > 0 ? TotalWaitSeconds * 1000.0 / CommandsExecuted : 0.0;
+	Stats.MaxWaitMs = MaxWaitSeconds * 1000.0;
+	Stats.AverageExecuteMs = CommandsExecuted > 0 ? TotalExecuteSeconds * 1000.0 / CommandsExecuted : 0.0;
+	// Use the window in progress while commands are still coming in
+	Stats.CommandsPerSecond = WindowCommands > 0 ? WindowCommands / FMath::Max(LastExecuteTime - WindowStartTime, 0.001) : CommandsPerSecond;
+	return Stats;
+}
+
+void FGenCommandExecutor::ResetStats()
+{
+	PeakQueueDepth = QueueDepth;
+	CommandsExecuted = 0;
+	TotalWaitSeconds = 0.0;
+	MaxWaitSeconds = 0.0;
+	TotalExecuteSeconds = 0.0;
+	WindowStartTime = 0.0;
+	LastExecuteTime = 0.0;
+	WindowCommands = 0;
+	CommandsPerSecond = 0.0;
+}
+
+void FGenCommandExecutor::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Queue.Empty();
+	QueueDepth = 0;
+}
+
+bool FGenCommandExecutor::Tick(float DeltaTime)
+{
+	const double FrameStart = FPlatformTime::Seconds();
+	PeakQueueDepth = FMath::Max(PeakQueueDepth, static_cast<int32>(QueueDepth));
+
+	const double BudgetSeconds = FMath::Max(0.0f, GetDefault<UGenerativeAISupportSettings>()->CommandFrameBudgetMs) / 1000.0;
+	double Now = FrameStart;
+	int32 Executed = 0;
+	FQueuedCommand Queued;
+	while ((Executed == 0 || Now - FrameStart < BudgetSeconds) && Queue.Dequeue(Queued))
+	{
+		--QueueDepth;
+		const double DispatchStart = FPlatformTime::Seconds();
+		const TSharedPtr<FJsonObject> Response = FGenCommandDispatcher::Get().Dispatch(Queued.Command);
+		Now = FPlatformTime::Seconds();
+
+		const double WaitSeconds = DispatchStart - Queued.ReceiveTime;
+		TotalWaitSeconds += WaitSeconds;
+		MaxWaitSeconds = FMath::Max(MaxWaitSeconds, WaitSeconds);
+		TotalExecuteSeconds += Now - DispatchStart;
+		++CommandsExecuted;
+		++Executed;
+
+		FString Type;
+		Queued.Command->TryGetStringField(TEXT("type"), Type);
+		UE_LOG(LogGenPerformance, Verbose, TEXT("Command %s waited: %f ms, dispatch took: %f ms"), *Type, WaitSeconds * 1000.0,
+		       (Now - DispatchStart) * 1000.0);
+
+		if (Queued.OnExecuted)
+		{
+			Queued.OnExecuted(Response);
+		}
+		Now = FPlatformTime::Seconds();
+	}
+
+	// Throughput is measured over windows of at most one second, a window also ends once the queue stays idle
+	if (Executed > 0)
+	{
+		if (WindowCommands == 0)
+		{
+			WindowStartTime = FrameStart;
+		}
+		WindowCommands += Executed;
+		LastExecuteTime = Now;
+	}
+	const bool bWindowFull = Now - WindowStartTime >= 1.0;
+	const bool bWindowIdle = Executed == 0 && Now - LastExecuteTime >= IdleWindowSeconds;
+	if (WindowCommands > 0 && (bWindowFull || bWindowIdle))
+	{
+		CommandsPerSecond = WindowCommands / FMath::Max(LastExecuteTime - WindowStartTime, 0.001);
+		UE_LOG(LogGenPerformance, Display, TEXT("Command pump: %.1f commands/s, queue depth %d (peak %d), average wait: %f ms, max wait: %f ms"),
+		       CommandsPerSecond, static_cast<int32>(QueueDepth), PeakQueueDepth,
+		       CommandsExecuted > 0 ? TotalWaitSeconds * 1000.0 / CommandsExecuted : 0.0, MaxWaitSeconds * 1000.0);
+		WindowCommands = 0;
+	}
+	return true;
+}
@@ -0,0 +1,407 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenCommandServer.h"
+
+#include "Common/TcpListener.h"
+#include "HAL/RunnableThread.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "MCP/GenCommandDispatcher.h"
+#include "MCP/GenCommandExecutor.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	constexpr int32 RecvChunkSize = 64 * 1024;
+
+	// Echoes the request id of the command so clients can match out-of-order responses
+	FString SerializeResponse(const TSharedPtr<FJsonObject>& Response, const TSharedPtr<FJsonValue>& RequestId = nullptr)
+	{
+		if (RequestId.IsValid())
+		{
+			Response->SetField(TEXT("request_id"), RequestId);
+		}
+
+		FString Json;
+		const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+		FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
+		return Json;
+	}
+}
+
+FGenCommandServer::FConnection::FConnection(FSocket* InSocket)
+	: Socket(InSocket)
+{
+}
+
+FGenCommandServer::FConnection::~FConnection()
+{
+	Socket->Close();
+	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+}
+
+FGenCommandServer& FGenCommandServer::Get()
+{
+	static FGenCommandServer Instance;
+	return Instance;
+}
+
+FGenCommandServer::~FGenCommandServer()
+{
+	Shutdown();
+}
+
+bool FGenCommandServer::Start(int32 Port)
+{
+	check(IsInGameThread());
+	if (IsRunning())
+	{
+		return true;
+	}
+
+	// The listener accepts as soon as it exists, so everything OnConnectionAccepted touches is set up first
+	bStopping = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+
+	// Same as the Python server, only local clients are accepted
+	Listener = MakeUnique<FTcpListener>(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port), FTimespan::FromMilliseconds(100));
+	if (!Listener->IsActive())
+	{
+		UE_LOG(LogGenAI, Error, TEXT("Native command server could not listen on port %d"), Port);
+		Listener.Reset();
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+		WakeEvent = nullptr;
+		return false;
+	}
+	Listener->OnConnectionAccepted().BindRaw(this, &FGenCommandServer::OnConnectionAccepted);
+
+	// Make sure the pump is created (and its ticker registered) on the game thread
+	FGenCommandExecutor::Get();
+	Thread = FRunnableThread::Create(this, TEXT("GenCommandServer"));
+
+	UE_LOG(LogGenAI, Log, TEXT("Native command server listening on port %d"), Port);
+	return true;
+}
+
+void FGenCommandServer::Shutdown()
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	// Stop accepting first so no socket is queued after the I/O thread is gone
+	Listener.Reset();
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	FSocket* Socket;
+	while (AcceptedSockets.Dequeue(Socket))
+	{
+		Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+	}
+
+	UE_LOG(LogGenAI, Log, TEXT("Native command server stopped"));
+}
+
+TArray<uint8> FGenCommandServer::MakeFrame(const FString& Json)
+{
+	const FTCHARToUTF8 Utf8(*Json);
+	const uint32 Length = Utf8.Length();
+
+	TArray<uint8> Frame;
+	Frame.Reserve(4 + Length);
+	Frame.Add(static_cast<uint8>(Length >> 24));
+	Frame.Add(static_cast<uint8>(Length >> 16));
+	Frame.Add(static_cast<uint8>(Length >> 8));
+	Frame.Add(static_cast<uint8>(Length));
+	Frame.Append(reinterpret_cast<const uint8*>(Utf8.Get()), Length);
+	return Frame;
+}
+
+FGenCommandServer::EFrameStatus FGenCommandServer::DecodeFrame(const uint8* Data, int32 Num, int32& OutPayloadSize)
+{
+	if (Num < 4)
+	{
+		return EFrameStatus::Incomplete;
+	}
+
+	const uint32 Length = (static_cast<uint32>(Data[0]) << 24) | (static_cast<uint32>(Data[1]) << 16) |
+		(static_cast<uint32>(Data[2]) << 8) | static_cast<uint32>(Data[3]);
+	if (Length > static_cast<uint32>(MaxFrameSize))
+	{
+		OutPayloadSize = static_cast<int32>(FMath::Min(Length, static_cast<uint32>(MAX_int32)));
+		return EFrameStatus::TooLarge;
+	}
+
+	OutPayloadSize = static_cast<int32>(Length);
+	return Num - 4 >= OutPayloadSize ? EFrameStatus::Complete : EFrameStatus::Incomplete;
+}
+
+TSharedPtr<FJsonValue> FGenCommandServer::FindRequestId(const FString& Json)
+{
+	const FString Key = TEXT("\"request_id\"");
+	const int32 KeyIndex = Json.Find(Key, ESearchCase::CaseSensitive, ESearchDir::FromEnd);
+	if (KeyIndex == INDEX_NONE)
+	{
+		return nullptr;
+	}
+
+	int32 Index = KeyIndex + Key.Len();
+	while (Index < Json.Len() && FChar::IsWhitespace(Json[Index]))
+	{
+		++Index;
+	}
+	if (Index >= Json.Len() || Json[Index] != TEXT(':'))
+	{
+		return nullptr;
+	}
+	++Index;
+	while (Index < Json.Len() && FChar::IsWhitespace(Json[Index]))
+	{
+		++Index;
+	}
+
+	// Ids are numbers or strings, anything else is not worth guessing at
+	const int32 ValueStart = Index;
+	if (Index < Json.Len() && Json[Index] == TEXT('"'))
+	{
+		for (++Index; Index < Json.Len(); ++Index)
+		{
+			if (Json[Index] == TEXT('\\'))
+			{
+				++Index;
+			}
+			else if (Json[Index] == TEXT('"'))
+			{
+				// Wrapped in an object so the reader takes care of the escapes
+				TSharedPtr<FJsonObject> Wrapper;
+				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(
+					FString::Printf(TEXT("{\"id\":%s}"), *Json.Mid(ValueStart, Index - ValueStart + 1)));
+				return FJsonSerializer::Deserialize(Reader, Wrapper) && Wrapper.IsValid() ? Wrapper->TryGetField(TEXT("id")) : nullptr;
+			}
+		}
+		return nullptr;
+	}
+
+	if (Index < Json.Len() && Json[Index] == TEXT('-'))
+	{
+		++Index;
+	}
+	while (Index < Json.Len() && FChar::IsDigit(Json[Index]))
+	{
+		++Index;
+	}
+	if (Index == ValueStart || !FChar::IsDigit(Json[Index - 1]))
+	{
+		return nullptr;
+	}
+	return MakeShareable(new FJsonValueNumber(FCString::Atod(*Json.Mid(ValueStart, Index - ValueStart))));
+}
+
+void FGenCommandServer::Stop()
+{
+	bStopping = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+bool FGenCommandServer::OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint)
+{
+	if (bStopping)
+	{
+		return false;
+	}
+
+	Socket->SetNonBlocking(true);
+	Socket->SetNoDelay(true);
+	AcceptedSockets.Enqueue(Socket);
+	WakeEvent->Trigger();
+
+	UE_LOG(LogGenAI, Log, TEXT("Native command server accepted connection from %s"), *Endpoint.ToString());
+	return true;
+}
+
+uint32 FGenCommandServer::Run()
+{
+	while (!bStopping)
+	{
+		FSocket* Socket;
+		while (AcceptedSockets.Dequeue(Socket))
+		{
+			Connections.Add(MakeShared<FConnection, ESPMode::ThreadSafe>(Socket));
+		}
+
+		bool bActive = false;
+		for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+		{
+			if (!ReadFrames(Connections[Index], bActive) || !WriteFrames(*Connections[Index], bActive))
+			{
+				// Responses to commands still queued for this connection are dropped
+				Connections.RemoveAtSwap(Index);
+			}
+		}
+
+		if (!bActive)
+		{
+			WakeEvent->Wait(1);
+		}
+	}
+
+	Connections.Empty();
+	return 0;
+}
+
+bool FGenCommandServer::ReadFrames(const TSharedPtr<FConnection, ESPMode::ThreadSafe>& Connection, bool& bOutActive)
+{
+	TArray<uint8>& Buffer = Connection->ReadBuffer;
+	int32 BytesThisTick = 0;
+	while (BytesThisTick < MaxBytesPerTick)
+	{
+		// Frames are handled after every chunk, so the header of the next one is checked before its payload is drained
+		if (!ProcessFrames(Connection))
+		{
+			return false;
+		}
+
+		const int32 ChunkSize = FMath::Min(RecvChunkSize, MaxBytesPerTick - BytesThisTick);
+		const int32 Offset = Buffer.Num();
+		Buffer.AddUninitialized(ChunkSize);
+		int32 BytesRead = 0;
+		const bool bReceived = Connection->Socket->Recv(Buffer.GetData() + Offset, ChunkSize, BytesRead);
+		Buffer.SetNum(Offset + BytesRead, EAllowShrinking::No);
+
+		// Stream sockets report a closed connection as a failed receive
+		if (!bReceived)
+		{
+			return false;
+		}
+		if (BytesRead == 0)
+		{
+			return true;
+		}
+		BytesThisTick += BytesRead;
+		bOutActive = true;
+	}
+
+	// The rest is read on the next pass, bOutActive keeps the I/O thread from waiting in between
+	return ProcessFrames(Connection);
+}
+
+bool FGenCommandServer::ProcessFrames(const TSharedPtr<FConnection, ESPMode::ThreadSafe>& Connection)
+{
+	TArray<uint8>& Buffer = Connection->ReadBuffer;
+	int32 Consumed = 0;
+	for (;;)
+	{
+		int32 Length = 0;
+		const EFrameStatus Status = DecodeFrame(Buffer.GetData() + Consumed, Buffer.Num() - Consumed, Length);
+		if (Status == EFrameStatus::TooLarge)
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Native command server received a %d byte frame, closing connection"), Length);
+			return false;
+		}
+		if (Status == EFrameStatus::Incomplete)
+		{
+			break;
+		}
+
+		const double ReceiveTime = FPlatformTime::Seconds();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + Consumed + 4), Length);
+		const FString Json(Converted.Length(), Converted.Get());
+		Consumed += 4 + Length;
+
+		// Parsing happens here so the game thread only pays for the command itself
+		TSharedPtr<FJsonObject> Command;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Json);
+		if (!FJsonSerializer::Deserialize(Reader, Command) || !Command.IsValid())
+		{
+			// Without an id the client cannot tell which request failed, closing the connection fails all of them
+			const TSharedPtr<FJsonValue> RequestId = FindRequestId(Json);
+			if (!RequestId.IsValid())
+			{
+				UE_LOG(LogGenAI, Warning, TEXT("Native command server received invalid JSON without a request_id, closing connection"));
+				return false;
+			}
+			Connection->Outgoing.Enqueue(MakeFrame(SerializeResponse(FGenCommandDispatcher::MakeError(TEXT("Invalid JSON format")), RequestId)));
+			continue;
+		}
+
+		FString Type;
+		Command->TryGetStringField(TEXT("type"), Type);
+		TSharedPtr<FJsonValue> RequestId = Command->TryGetField(TEXT("request_id"));
+		if (FGenCommandDispatcher::IsThreadSafeCommand(Type))
+		{
+			Connection->Outgoing.Enqueue(MakeFrame(SerializeResponse(FGenCommandDispatcher::Get().Dispatch(Command), RequestId)));
+			continue;
+		}
+
+		// The JSON objects are not thread safe, so they are moved over without keeping a reference on this thread.
+		// Responses for connections that closed in the meantime are dropped
+		FGenCommandExecutor::Get().Enqueue(MoveTemp(Command), [this, WeakConnection = TWeakPtr<FConnection, ESPMode::ThreadSafe>(Connection), RequestId = MoveTemp(RequestId)](const TSharedPtr<FJsonObject>& Response)
+		{
+			if (const TSharedPtr<FConnection, ESPMode::ThreadSafe> Pinned = WeakConnection.Pin())
+			{
+				Pinned->Outgoing.Enqueue(MakeFrame(SerializeResponse(Response, RequestId)));
+				if (WakeEvent)
+				{
+					WakeEvent->Trigger();
+				}
+			}
+		}, ReceiveTime);
+	}
+
+	if (Consumed > 0)
+	{
+		Buffer.RemoveAt(0, Consumed, EAllowShrinking::No);
+	}
+	return true;
+}
+
+bool FGenCommandServer::WriteFrames(FConnection& Connection, bool& bOutActive)
+{
+	for (;;)
+	{
+		if (Connection.WriteOffset >= Connection.WriteBuffer.Num())
+		{
+			Connection.WriteBuffer.Reset();
+			Connection.WriteOffset = 0;
+			if (!Connection.Outgoing.Dequeue(Connection.WriteBuffer))
+			{
+				return true;
+			}
+		}
+
+		int32 BytesSent = 0;
+		if (!Connection.Socket->Send(Connection.WriteBuffer.GetData() + Connection.WriteOffset,
+		                             Connection.WriteBuffer.Num() - Connection.WriteOffset, BytesSent))
+		{
+			// A full send buffer fails the non-blocking send with EWOULDBLOCK while the client is slow to read,
+			// the rest is sent on a later pass. Any other error means the connection is gone
+			const ESocketErrors Error = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+			return Error == SE_EWOULDBLOCK || Error == SE_NO_ERROR;
+		}
+		if (BytesSent <= 0)
+		{
+			// Send buffer is full, retry on the next pass
+			return true;
+		}
+		Connection.WriteOffset += BytesSent;
+		bOutActive = true;
+	}
+}
@@ -0,0 +1,324 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenEditSession.h"
+
+#include "GenerativeAISupportSettings.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "MCP/GenBlueprintCompiler.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	// An MCP client that opened a session and went away must not keep the Blueprints uncompiled forever
+	constexpr double ExternalSessionTimeoutSeconds = 60.0;
+}
+
+FGenEditSession& FGenEditSession::Get()
+{
+	static FGenEditSession Instance;
+	return Instance;
+}
+
+void FGenEditSession::BeginSession()
+{
+	if (SessionDepth++ == 0)
+	{
+		PendingBeforeSession = MoveTemp(Pending);
+		Pending.Reset();
+	}
+	LastEditTime = FPlatformTime::Seconds();
+}
+
+void FGenEditSession::EndSession()
+{
+	check(SessionDepth > 0);
+	if (--SessionDepth == 0)
+	{
+		RestorePendingBeforeSession();
+		Flush();
+	}
+}
+
+TArray<UBlueprint*> FGenEditSession::EndSessionAndTakePending()
+{
+	check(SessionDepth > 0);
+	TArray<UBlueprint*> Blueprints;
+	if (--SessionDepth == 0)
+	{
+		for (const TPair<TWeakObjectPtr<UBlueprint>, FPendingEdit>& Edit : Pending)
+		{
+			if (UBlueprint* Blueprint = Edit.Key.Get())
+			{
+				Blueprints.Add(Blueprint);
+			}
+		}
+		Pending.Reset();
+
+		// A rolled back batch drops its own edits, not the compiles queued before it
+		RestorePendingBeforeSession();
+		if (Pending.Num() > 0)
+		{
+			EnsureTicker();
+		}
+	}
+	return Blueprints;
+}
+
+void FGenEditSession::RestorePendingBeforeSession()
+{
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FPendingEdit>& Edit : PendingBeforeSession)
+	{
+		MergeEdit(Pending.FindOrAdd(Edit.Key), Edit.Value);
+	}
+	PendingBeforeSession.Reset();
+}
+
+void FGenEditSession::MergeEdit(FPendingEdit& Into, const FPendingEdit& Edit)
+{
+	Into.bCompile |= Edit.bCompile;
+	Into.bStructural |= Edit.bStructural;
+}
+
+void FGenEditSession::BeginExternalSession()
+{
+	if (!bExternalSession)
+	{
+		bExternalSession = true;
+		BeginSession();
+		EnsureTicker();
+	}
+	LastEditTime = FPlatformTime::Seconds();
+}
+
+void FGenEditSession::EndExternalSession()
+{
+	if (bExternalSession)
+	{
+		bExternalSession = false;
+		EndSession();
+	}
+}
+
+void FGenEditSession::RequestCompile(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	if (SessionDepth == 0 && GetIdleDelay() <= 0.0f)
+	{
+		CompileNow(Blueprint);
+		return;
+	}
+
+	FPendingEdit* Edit = AddPending(Blueprint);
+	if (Edit->bCompile)
+	{
+		++CoalescedRequestCount;
+	}
+	Edit->bCompile = true;
+	Edit->bStructural = true;
+}
+
+void FGenEditSession::RequestStructuralModification(UBlueprint* Blueprint)
+{
+	if (!Blueprint)
+	{
+		return;
+	}
+
+	if (SessionDepth == 0 && GetIdleDelay() <= 0.0f)
+	{
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		++StructuralModificationCount;
+		return;
+	}
+
+	FPendingEdit* Edit = AddPending(Blueprint);
+	if (Edit->bStructural || Edit->bCompile)
+	{
+		++CoalescedRequestCount;
+	}
+	Edit->bStructural = true;
+}
+
+FGenEditSession::FPendingEdit* FGenEditSession::AddPending(UBlueprint* Blueprint)
+{
+	LastEditTime = FPlatformTime::Seconds();
+	EnsureTicker();
+	return &Pending.FindOrAdd(Blueprint);
+}
+
+void FGenEditSession::UpdateSkeleton(UBlueprint* Blueprint)
+{
+	FPendingEdit* Edit = Pending.Find(Blueprint);
+	FPendingEdit* EditBeforeSession = PendingBeforeSession.Find(Blueprint);
+	if ((Edit && Edit->bStructural) || (EditBeforeSession && EditBeforeSession->bStructural))
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		++StructuralModificationCount;
+		UE_LOG(LogGenPerformance, Display, TEXT("Updating the skeleton of %s took: %f ms"), *Blueprint->GetName(),
+		       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+		// The entries stay so a session still hands the Blueprint out for its compile
+		if (Edit)
+		{
+			Edit->bStructural = false;
+		}
+		if (EditBeforeSession)
+		{
+			EditBeforeSession->bStructural = false;
+		}
+	}
+}
+
+int32 FGenEditSession::Flush(UBlueprint* Blueprint)
+{
+	// Compiling can run editor callbacks that request more edits, so work on a copy
+	TArray<TPair<TWeakObjectPtr<UBlueprint>, FPendingEdit>> Edits;
+	if (Blueprint)
+	{
+		FPendingEdit Edit, EditBeforeSession;
+		const bool bPending = Pending.RemoveAndCopyValue(Blueprint, Edit);
+		if (PendingBeforeSession.RemoveAndCopyValue(Blueprint, EditBeforeSession) || bPending)
+		{
+			MergeEdit(Edit, EditBeforeSession);
+			Edits.Emplace(Blueprint, Edit);
+		}
+	}
+	else
+	{
+		RestorePendingBeforeSession();
+		Edits = Pending.Array();
+		Pending.Reset();
+	}
+
+	TArray<UBlueprint*> ToCompile;
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FPendingEdit>& Edit : Edits)
+	{
+		UBlueprint* EditedBlueprint = Edit.Key.Get();
+		if (!EditedBlueprint)
+		{
+			continue;
+		}
+
+		// Compiling regenerates the classes, so it covers the structural modification
+		if (Edit.Value.bCompile)
+		{
+			ToCompile.Add(EditedBlueprint);
+		}
+		else if (Edit.Value.bStructural)
+		{
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(EditedBlueprint);
+			++StructuralModificationCount;
+		}
+	}
+
+	// Several Blueprints edited together go through the compilation manager in one pass
+	if (ToCompile.Num() > 1)
+	{
+		FGenBlueprintCompiler::Compile(ToCompile);
+	}
+	else if (ToCompile.Num() == 1)
+	{
+		CompileNow(ToCompile[0]);
+	}
+	return ToCompile.Num();
+}
+
+void FGenEditSession::CompileNow(UBlueprint* Blueprint)
+{
+	Pending.Remove(Blueprint);
+	PendingBeforeSession.Remove(Blueprint);
+
+	const double StartTime = FPlatformTime::Seconds();
+	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	RecordCompiles({Blueprint}, ElapsedMs);
+	UE_LOG(LogGenPerformance, Display, TEXT("Compiling %s took: %f ms"), *Blueprint->GetName(), ElapsedMs);
+}
+
+void FGenEditSession::RecordCompiles(const TArray<UBlueprint*>& Blueprints, double ElapsedMs)
+{
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		Pending.Remove(Blueprint);
+		PendingBeforeSession.Remove(Blueprint);
+	}
+	CompileCount += Blueprints.Num();
+	TotalCompileMs += ElapsedMs;
+	MaxCompileMs = FMath::Max(MaxCompileMs, ElapsedMs);
+}
+
+TSharedPtr<FJsonObject> FGenEditSession::GetStats() const
+{
+	TSharedPtr<FJsonObject> Stats = MakeShareable(new FJsonObject());
+	Stats->SetNumberField(TEXT("compiles"), CompileCount);
+	Stats->SetNumberField(TEXT("compile_ms_total"), TotalCompileMs);
+	Stats->SetNumberField(TEXT("compile_ms_max"), MaxCompileMs);
+	Stats->SetNumberField(TEXT("structural_modifications"), StructuralModificationCount);
+	Stats->SetNumberField(TEXT("coalesced_requests"), CoalescedRequestCount);
+	int32 NumPending = Pending.Num();
+	for (const TPair<TWeakObjectPtr<UBlueprint>, FPendingEdit>& Edit : PendingBeforeSession)
+	{
+		NumPending += Pending.Contains(Edit.Key) ? 0 : 1;
+	}
+	Stats->SetNumberField(TEXT("pending"), NumPending);
+	Stats->SetBoolField(TEXT("in_session"), SessionDepth > 0);
+	return Stats;
+}
+
+void FGenEditSession::Shutdown()
+{
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	Pending.Empty();
+	PendingBeforeSession.Empty();
+	SessionDepth = 0;
+	bExternalSession = false;
+}
+
+void FGenEditSession::EnsureTicker()
+{
+	if (!TickerHandle.IsValid())
+	{
+		TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGenEditSession::Tick), 0.1f);
+	}
+}
+
+bool FGenEditSession::Tick(float DeltaTime)
+{
+	const double IdleSeconds = FPlatformTime::Seconds() - LastEditTime;
+	if (bExternalSession && IdleSeconds >= ExternalSessionTimeoutSeconds)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Ending the MCP edit session after %.0f s without edits"), IdleSeconds);
+		EndExternalSession();
+	}
+
+	if (SessionDepth == 0 && Pending.Num() > 0 && IdleSeconds >= GetIdleDelay())
+	{
+		Flush();
+	}
+
+	if (SessionDepth == 0 && Pending.Num() == 0)
+	{
+		TickerHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+float FGenEditSession::GetIdleDelay()
+{
+	return GetDefault<UGenerativeAISupportSettings>()->CompileIdleDelaySeconds;
+}
@@ -0,0 +1,917 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenFunctionIndex.h"
+
+#include "Async/Async.h"
+#include "Dom/JsonObject.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectGlobals.h"
+#include "UObject/UObjectIterator.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+const FGenFunctionIndex::FScoreWeights FGenFunctionIndex::CreationWeights = {120, 80, 20, 10, 15, 30};
+const FGenFunctionIndex::FScoreWeights FGenFunctionIndex::SuggestionWeights = {100, 50, 10, 5, 10, 25};
+
+struct FGenFunctionIndexData
+{
+	TArray<FGenFunctionCatalogEntry> Entries;
+	TArray<FString> NormalizedNames;
+	// Empty when the node title normalizes to the function name
+	TArray<FString> NormalizedTitles;
+	TArray<FString> DisplayNames;
+	TArray<EGenFunctionFlags> Flags;
+
+	// Unique trigrams of the name and title of every entry, and trigram -> entries holding it
+	TArray<uint16> TrigramCounts;
+	TMap<uint64, TArray<int32>> TrigramPostings;
+
+	// Token ids of entry i are EntryTokens[TokenOffsets[i] .. TokenOffsets[i + 1])
+	TArray<int32> TokenOffsets;
+	TArray<int32> EntryTokens;
+	TMap<FString, int32> TokenIds;
+
+	// "class.function" (normalized) -> entry
+	TMap<FString, int32> QualifiedIndex;
+};
+
+namespace
+{
+	// Catalogued first, so ties in the scoring prefer the common libraries
+	const TCHAR* const PriorityClasses[] = {
+		TEXT("KismetMathLibrary"), TEXT("KismetSystemLibrary"), TEXT("KismetStringLibrary"),
+		TEXT("KismetArrayLibrary"), TEXT("KismetTextLibrary"), TEXT("GameplayStatics"),
+		TEXT("Actor"), TEXT("Pawn"), TEXT("Character")
+	};
+
+	constexpr int32 CacheMagic = 0x434E4647; // "GFNC"
+	constexpr int32 CacheVersion = 2;
+
+	// Module loads come in bursts at startup, wait for them to settle before reading the classes
+	constexpr double RefreshDelaySeconds = 2.0;
+	constexpr double SnapshotBudgetSeconds = 0.002;
+
+	// Only the entries with the most trigrams in common with the request get the full scoring
+	constexpr int32 ShortlistSize = 256;
+
+	// Set on module shutdown, catalog tasks still queued must not reach the index anymore
+	TAtomic<bool> bIndexShutDown{false};
+
+	// Edits tolerated before a name no longer counts as a near miss
+	int32 GetMaxTypos(int32 Len)
+	{
+		return Len < 4 ? 0 : Len < 8 ? 1 : 2;
+	}
+
+	uint64 MakeTrigram(TCHAR A, TCHAR B, TCHAR C)
+	{
+		return (static_cast<uint64>(A) << 32) | (static_cast<uint64>(B) << 16) | static_cast<uint64>(C);
+	}
+
+	void AddTrigrams(const FString& Name, TArray<uint64>& OutTrigrams)
+	{
+		for (int32 i = 0; i + 2 < Name.Len(); ++i)
+		{
+			OutTrigrams.AddUnique(MakeTrigram(Name[i], Name[i + 1], Name[i + 2]));
+		}
+	}
+
+	bool ShouldCatalogClass(const UClass* Class)
+	{
+		if (Class->HasAnyClassFlags(CLASS_Deprecated | CLASS_NewerVersionExists) || Class->GetOutermost() == GetTransientPackage())
+		{
+			return false;
+		}
+		const FString ClassName = Class->GetName();
+		return !ClassName.StartsWith(TEXT("SKEL_")) && !ClassName.StartsWith(TEXT("REINST_")) &&
+			!ClassName.StartsWith(TEXT("TRASHCLASS_")) && !ClassName.StartsWith(TEXT("HOTRELOADED_"));
+	}
+}
+
+FGenFunctionIndex& FGenFunctionIndex::Get()
+{
+	static FGenFunctionIndex Instance;
+	return Instance;
+}
+
+FGenFunctionIndex::FGenFunctionIndex()
+{
+	// Newly loaded modules and reloaded code can add, remove or replace functions
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddLambda([this](FName, EModuleChangeReason)
+	{
+		Invalidate();
+	});
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		Invalidate();
+	});
+}
+
+void FGenFunctionIndex::Start()
+{
+	if (TickerHandle.IsValid())
+	{
+		return;
+	}
+	bIndexShutDown = false;
+	TickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateRaw(this, &FGenFunctionIndex::Tick));
+	bRefreshRequested = true;
+	RefreshRequestTime = FPlatformTime::Seconds();
+
+	// The cached catalog answers lookups until the refresh has read the loaded classes
+	const int32 CacheGeneration = Generation;
+	bBuildInFlight = true;
+	Async(EAsyncExecution::ThreadPool, [CacheGeneration]()
+	{
+		if (bIndexShutDown)
+		{
+			return;
+		}
+		const double StartTime = FPlatformTime::Seconds();
+		TArray<FGenFunctionCatalogEntry> Entries;
+		TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> CachedData;
+		if (LoadCache(Entries))
+		{
+			CachedData = BuildIndexData(MoveTemp(Entries));
+			UE_LOG(LogGenPerformance, Display, TEXT("Function catalog cache load (%d functions) took: %f ms"),
+			       CachedData->Entries.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		}
+
+		AsyncTask(ENamedThreads::GameThread, [CacheGeneration, CachedData]()
+		{
+			if (bIndexShutDown)
+			{
+				return;
+			}
+			FGenFunctionIndex& Index = FGenFunctionIndex::Get();
+			if (Index.Generation != CacheGeneration)
+			{
+				return;
+			}
+			Index.bBuildInFlight = false;
+			// A synchronous rebuild may have happened while the cache was loading, it is more recent
+			if (CachedData.IsValid() && !Index.Data.IsValid())
+			{
+				Index.SetData(CachedData);
+			}
+		});
+	});
+}
+
+void FGenFunctionIndex::Shutdown()
+{
+	bIndexShutDown = true;
+	if (TickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+		TickerHandle.Reset();
+	}
+	if (ModulesChangedHandle.IsValid())
+	{
+		FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+		ModulesChangedHandle.Reset();
+	}
+	if (ReloadCompleteHandle.IsValid())
+	{
+		FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+		ReloadCompleteHandle.Reset();
+	}
+
+	// Results of builds still in flight are dropped
+	++Generation;
+	bRefreshRequested = false;
+	bSnapshotInProgress = false;
+	bBuildInFlight = false;
+	PendingClasses.Empty();
+	SnapshotEntries.Empty();
+	SetData(nullptr);
+}
+
+void FGenFunctionIndex::Invalidate()
+{
+	if (TickerHandle.IsValid())
+	{
+		bRefreshRequested = true;
+		RefreshRequestTime = FPlatformTime::Seconds();
+		return;
+	}
+	SetData(nullptr);
+}
+
+void FGenFunctionIndex::Rebuild()
+{
+	// Supersedes any refresh in progress
+	++Generation;
+	bSnapshotInProgress = false;
+	bBuildInFlight = false;
+
+	BeginSnapshot();
+	ContinueSnapshot(TNumericLimits<double>::Max());
+	bSnapshotInProgress = false;
+	SetData(BuildIndexData(MoveTemp(SnapshotEntries)));
+	SnapshotEntries.Reset();
+	UE_LOG(LogGenPerformance, Display, TEXT("Function catalog rebuild (%d functions) took: %f ms"), Data->Entries.Num(),
+	       (FPlatformTime::Seconds() - SnapshotStartTime) * 1000.0);
+}
+
+void FGenFunctionIndex::EnsureBuilt()
+{
+	if (!Data.IsValid())
+	{
+		Rebuild();
+	}
+}
+
+void FGenFunctionIndex::SetData(const TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe>& NewData)
+{
+	Data = NewData;
+	const int32 Count = Data.IsValid() ? Data->Entries.Num() : 0;
+	ResolvedFunctions.Reset();
+	ResolvedFunctions.SetNum(Count);
+	ResolvedClasses.Reset();
+	ResolvedClasses.SetNum(Count);
+	TrigramHits.Reset();
+	TrigramHits.SetNumZeroed(Count);
+}
+
+int32 FGenFunctionIndex::Num()
+{
+	EnsureBuilt();
+	return Data->Entries.Num();
+}
+
+const FString& FGenFunctionIndex::GetDisplayName(int32 Index) const
+{
+	return Data->DisplayNames[Index];
+}
+
+EGenFunctionFlags FGenFunctionIndex::GetFlags(int32 Index) const
+{
+	return Data->Flags[Index];
+}
+
+UClass* FGenFunctionIndex::GetOwnerClass(int32 Index)
+{
+	if (!Data.IsValid() || !Data->Entries.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+	if (UClass* Class = ResolvedClasses[Index].Get())
+	{
+		return Class;
+	}
+	UClass* Class = FindObject<UClass>(nullptr, *Data->Entries[Index].ClassPath);
+	ResolvedClasses[Index] = Class;
+	return Class;
+}
+
+UFunction* FGenFunctionIndex::GetFunction(int32 Index)
+{
+	if (!Data.IsValid() || !Data->Entries.IsValidIndex(Index))
+	{
+		return nullptr;
+	}
+	if (UFunction* Function = ResolvedFunctions[Index].Get())
+	{
+		return Function;
+	}
+	UClass* Class = GetOwnerClass(Index);
+	UFunction* Function = Class ? Class->FindFunctionByName(FName(*Data->Entries[Index].FunctionName)) : nullptr;
+	ResolvedFunctions[Index] = Function;
+	return Function;
+}
+
+void FGenFunctionIndex::Tokenize(const FString& Name, TArray<FString>& OutTokens)
+{
+	OutTokens.Reset();
+	FString Token;
+
+	auto FlushToken = [&OutTokens, &Token]()
+	{
+		if (!Token.IsEmpty())
+		{
+			OutTokens.AddUnique(Token.ToLower());
+			Token.Reset();
+		}
+	};
+
+	const int32 Len = Name.Len();
+	for (int32 i = 0; i < Len; ++i)
+	{
+		const TCHAR C = Name[i];
+		if (!FChar::IsAlnum(C))
+		{
+			FlushToken();
+			continue;
+		}
+
+		if (!Token.IsEmpty() && FChar::IsUpper(C))
+		{
+			const TCHAR Previous = Name[i - 1];
+			const bool bNextIsLower = i + 1 < Len && FChar::IsLower(Name[i + 1]);
+			// "GetActor" splits before 'A', "AIController" splits before the 'C' that starts the next word
+			if (FChar::IsLower(Previous) || FChar::IsDigit(Previous) || (FChar::IsUpper(Previous) && bNextIsLower))
+			{
+				FlushToken();
+			}
+		}
+		Token.AppendChar(C);
+	}
+	FlushToken();
+}
+
+FString FGenFunctionIndex::NormalizeName(const FString& Name)
+{
+	FString Normalized;
+	Normalized.Reserve(Name.Len());
+	for (const TCHAR C : Name)
+	{
+		if (FChar::IsAlnum(C))
+		{
+			Normalized.AppendChar(FChar::ToLower(C));
+		}
+	}
+	if (Normalized.Len() > 2 && Normalized.StartsWith(TEXT("k2"), ESearchCase::CaseSensitive))
+	{
+		Normalized = Normalized.RightChop(2);
+	}
+	return Normalized;
+}
+
+int32 FGenFunctionIndex::EditDistance(const FString& A, const FString& B, int32 MaxDistance)
+{
+	const int32 LenA = A.Len();
+	const int32 LenB = B.Len();
+	if (FMath::Abs(LenA - LenB) > MaxDistance)
+	{
+		return MaxDistance + 1;
+	}
+
+	// Three rows, the one two back is needed for transpositions
+	TArray<int32, TInlineAllocator<64>> Rows[3];
+	for (TArray<int32, TInlineAllocator<64>>& Row : Rows)
+	{
+		Row.SetNumUninitialized(LenB + 1);
+	}
+	for (int32 j = 0; j <= LenB; ++j)
+	{
+		Rows[0][j] = j;
+	}
+
+	for (int32 i = 1; i <= LenA; ++i)
+	{
+		TArray<int32, TInlineAllocator<64>>& Current = Rows[i % 3];
+		const TArray<int32, TInlineAllocator<64>>& Previous = Rows[(i - 1) % 3];
+		const TArray<int32, TInlineAllocator<64>>& BeforePrevious = Rows[(i + 1) % 3];
+
+		Current[0] = i;
+		int32 RowMin = Current[0];
+		for (int32 j = 1; j <= LenB; ++j)
+		{
+			const int32 Cost = A[i - 1] == B[j - 1] ? 0 : 1;
+			int32 Distance = FMath::Min3(Previous[j] + 1, Current[j - 1] + 1, Previous[j - 1] + Cost);
+			if (i > 1 && j > 1 && A[i - 1] == B[j - 2] && A[i - 2] == B[j - 1])
+			{
+				Distance = FMath::Min(Distance, BeforePrevious[j - 2] + 1);
+			}
+			Current[j] = Distance;
+			RowMin = FMath::Min(RowMin, Distance);
+		}
+
+		if (RowMin > MaxDistance)
+		{
+			return MaxDistance + 1;
+		}
+	}
+	return FMath::Min(Rows[LenA % 3][LenB], MaxDistance + 1);
+}
+
+bool FGenFunctionIndex::Tick(float DeltaTime)
+{
+	if (!bSnapshotInProgress && !bBuildInFlight && bRefreshRequested &&
+		FPlatformTime::Seconds() - RefreshRequestTime >= RefreshDelaySeconds)
+	{
+		bRefreshRequested = false;
+		++Generation;
+		BeginSnapshot();
+	}
+
+	if (bSnapshotInProgress && ContinueSnapshot(SnapshotBudgetSeconds))
+	{
+		FinishSnapshot();
+	}
+	return true;
+}
+
+void FGenFunctionIndex::BeginSnapshot()
+{
+	SnapshotStartTime = FPlatformTime::Seconds();
+	bSnapshotInProgress = true;
+	SnapshotEntries.Reset();
+	PendingClasses.Reset();
+	NextPendingClass = 0;
+
+	TSet<UClass*> PriorityClassSet;
+	for (const TCHAR* ClassName : PriorityClasses)
+	{
+		if (UClass* Class = FindObject<UClass>(ANY_PACKAGE, ClassName))
+		{
+			PendingClasses.Add(Class);
+			PriorityClassSet.Add(Class);
+		}
+	}
+
+	// Only collecting the pointers here, reading the functions is spread over the following frames
+	for (TObjectIterator<UClass> ClassIt; ClassIt; ++ClassIt)
+	{
+		UClass* Class = *ClassIt;
+		if (!PriorityClassSet.Contains(Class) && ShouldCatalogClass(Class))
+		{
+			PendingClasses.Add(Class);
+		}
+	}
+}
+
+bool FGenFunctionIndex::ContinueSnapshot(double BudgetSeconds)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	while (NextPendingClass < PendingClasses.Num())
+	{
+		if (UClass* Class = PendingClasses[NextPendingClass].Get())
+		{
+			AddClassFunctions(Class, SnapshotEntries);
+		}
+		++NextPendingClass;
+
+		if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+		{
+			break;
+		}
+	}
+	return NextPendingClass >= PendingClasses.Num();
+}
+
+void FGenFunctionIndex::FinishSnapshot()
+{
+	bSnapshotInProgress = false;
+	bBuildInFlight = true;
+	PendingClasses.Empty();
+
+	const int32 SnapshotGeneration = Generation;
+	const double StartTime = SnapshotStartTime;
+	Async(EAsyncExecution::ThreadPool, [SnapshotGeneration, StartTime, Entries = MoveTemp(SnapshotEntries)]() mutable
+	{
+		if (bIndexShutDown)
+		{
+			return;
+		}
+		if (!SaveCache(Entries))
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Failed to write function catalog cache %s"), *GetCacheFile());
+		}
+		TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> NewData = BuildIndexData(MoveTemp(Entries));
+
+		AsyncTask(ENamedThreads::GameThread, [SnapshotGeneration, StartTime, NewData]()
+		{
+			if (bIndexShutDown)
+			{
+				return;
+			}
+			FGenFunctionIndex& Index = FGenFunctionIndex::Get();
+			if (Index.Generation != SnapshotGeneration)
+			{
+				return;
+			}
+			Index.bBuildInFlight = false;
+			Index.SetData(NewData);
+			UE_LOG(LogGenPerformance, Display, TEXT("Function catalog refresh (%d functions, %d tokens) took: %f ms"),
+			       NewData->Entries.Num(), NewData->TokenIds.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+		});
+	});
+	SnapshotEntries.Reset();
+}
+
+void FGenFunctionIndex::AddClassFunctions(UClass* Class, TArray<FGenFunctionCatalogEntry>& OutEntries)
+{
+	const FString ClassPath = Class->GetPathName();
+	const FString ClassName = Class->GetName();
+
+	// Inherited functions are catalogued with the class declaring them
+	for (TFieldIterator<UFunction> FuncIt(Class, EFieldIteratorFlags::ExcludeSuper); FuncIt; ++FuncIt)
+	{
+		const UFunction* Function = *FuncIt;
+		if (!Function->HasAnyFunctionFlags(FUNC_BlueprintCallable) || Function->HasAnyFunctionFlags(FUNC_Delegate))
+		{
+			continue;
+		}
+
+		EGenFunctionFlags FunctionFlags = EGenFunctionFlags::None;
+		if (Function->HasAnyFunctionFlags(FUNC_BlueprintPure)) FunctionFlags |= EGenFunctionFlags::Pure;
+		if (Function->HasAnyFunctionFlags(FUNC_Static)) FunctionFlags |= EGenFunctionFlags::Static;
+		if (Function->HasMetaData(TEXT("Latent"))) FunctionFlags |= EGenFunctionFlags::Latent;
+		if (Function->HasMetaData(TEXT("DeprecatedFunction")) || Function->HasMetaData(TEXT("BlueprintInternalUseOnly")))
+		{
+			FunctionFlags |= EGenFunctionFlags::Hidden;
+		}
+
+		FGenFunctionCatalogEntry& Entry = OutEntries.AddDefaulted_GetRef();
+		Entry.ClassPath = ClassPath;
+		Entry.ClassName = ClassName;
+		Entry.FunctionName = Function->GetName();
+		Entry.NodeTitle = Function->GetMetaData(TEXT("DisplayName"));
+		Entry.Flags = FunctionFlags;
+	}
+}
+
+TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> FGenFunctionIndex::BuildIndexData(TArray<FGenFunctionCatalogEntry>&& Entries)
+{
+	TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> NewData = MakeShared<FGenFunctionIndexData, ESPMode::ThreadSafe>();
+	NewData->Entries = MoveTemp(Entries);
+
+	const int32 Count = NewData->Entries.Num();
+	NewData->NormalizedNames.Reserve(Count);
+	NewData->NormalizedTitles.Reserve(Count);
+	NewData->DisplayNames.Reserve(Count);
+	NewData->Flags.Reserve(Count);
+	NewData->TrigramCounts.Reserve(Count);
+	NewData->TokenOffsets.Reserve(Count + 1);
+
+	TArray<FString> Tokens;
+	TArray<uint64> Trigrams;
+	for (int32 Index = 0; Index < Count; ++Index)
+	{
+		const FGenFunctionCatalogEntry& Entry = NewData->Entries[Index];
+		const FString NormalizedName = NormalizeName(Entry.FunctionName);
+		FString NormalizedTitle = NormalizeName(Entry.NodeTitle);
+		if (NormalizedTitle == NormalizedName)
+		{
+			NormalizedTitle.Reset();
+		}
+
+		Trigrams.Reset();
+		AddTrigrams(NormalizedName, Trigrams);
+		AddTrigrams(NormalizedTitle, Trigrams);
+		for (const uint64 Trigram : Trigrams)
+		{
+			NewData->TrigramPostings.FindOrAdd(Trigram).Add(Index);
+		}
+		NewData->TrigramCounts.Add(static_cast<uint16>(FMath::Min(Trigrams.Num(), static_cast<int32>(MAX_uint16))));
+
+		Tokenize(Entry.FunctionName, Tokens);
+		NewData->TokenOffsets.Add(NewData->EntryTokens.Num());
+		for (const FString& Token : Tokens)
+		{
+			const int32* TokenId = NewData->TokenIds.Find(Token);
+			NewData->EntryTokens.Add(TokenId ? *TokenId : NewData->TokenIds.Add(Token, NewData->TokenIds.Num()));
+		}
+
+		NewData->QualifiedIndex.FindOrAdd(NormalizeName(Entry.ClassName) + TEXT(".") + NormalizedName, Index);
+		NewData->NormalizedNames.Add(NormalizedName);
+		NewData->NormalizedTitles.Add(MoveTemp(NormalizedTitle));
+		NewData->DisplayNames.Add(FString::Printf(TEXT("%s.%s"), *Entry.ClassName, *Entry.FunctionName));
+		NewData->Flags.Add(Entry.Flags);
+	}
+	NewData->TokenOffsets.Add(NewData->EntryTokens.Num());
+	return NewData;
+}
+
+FString FGenFunctionIndex::GetCacheFile()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("FunctionCatalog.bin");
+}
+
+FString FGenFunctionIndex::GetAliasFile()
+{
+	return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("LearnedNodeAliases.json");
+}
+
+void FGenFunctionIndex::LoadAliases()
+{
+	bAliasesLoaded = true;
+	FString AliasJson;
+	if (!FFileHelper::LoadFileToString(AliasJson, *GetAliasFile()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> AliasObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(AliasJson);
+	if (!FJsonSerializer::Deserialize(Reader, AliasObject) || !AliasObject.IsValid())
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Ignoring malformed learned node aliases in %s"), *GetAliasFile());
+		return;
+	}
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Alias : AliasObject->Values)
+	{
+		LearnedAliases.Add(Alias.Key, Alias.Value->AsString());
+	}
+}
+
+bool FGenFunctionIndex::IsConfidentResolution(const TArray<FGenFunctionMatch>& Matches, const FScoreWeights& Weights)
+{
+	if (Matches.Num() == 0 || Matches[0].bNearMiss || Matches[0].Score < Weights.Exact)
+	{
+		return false;
+	}
+	return Matches.Num() == 1 || Matches[0].Score - Matches[1].Score > Weights.Typo;
+}
+
+void FGenFunctionIndex::RecordResolution(const FString& NodeType, int32 Index)
+{
+	if (!Data.IsValid() || !Data->Entries.IsValidIndex(Index))
+	{
+		return;
+	}
+	if (!bAliasesLoaded)
+	{
+		LoadAliases();
+	}
+
+	// Exact names resolve on their own
+	const FString Alias = NormalizeName(NodeType);
+	if (Alias.IsEmpty() || Alias == Data->NormalizedNames[Index] || Alias == Data->NormalizedTitles[Index])
+	{
+		return;
+	}
+
+	const FString QualifiedName = NormalizeName(Data->Entries[Index].ClassName) + TEXT(".") + Data->NormalizedNames[Index];
+	const FString* Existing = LearnedAliases.Find(Alias);
+	if (Existing && *Existing == QualifiedName)
+	{
+		return;
+	}
+	LearnedAliases.Add(Alias, QualifiedName);
+
+	const TSharedPtr<FJsonObject> AliasObject = MakeShareable(new FJsonObject());
+	for (const TPair<FString, FString>& LearnedAlias : LearnedAliases)
+	{
+		AliasObject->SetStringField(LearnedAlias.Key, LearnedAlias.Value);
+	}
+	FString AliasJson;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&AliasJson);
+	FJsonSerializer::Serialize(AliasObject.ToSharedRef(), Writer);
+	if (!FFileHelper::SaveStringToFile(AliasJson, *GetAliasFile()))
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Failed to write learned node aliases %s"), *GetAliasFile());
+	}
+}
+
+bool FGenFunctionIndex::SaveCache(const TArray<FGenFunctionCatalogEntry>& Entries)
+{
+	// Class paths are stored once, entries refer to them by index
+	TArray<FString> ClassPaths;
+	TArray<FString> ClassNames;
+	TMap<FString, int32> ClassIndices;
+	TArray<int32> EntryClasses;
+	EntryClasses.Reserve(Entries.Num());
+	for (const FGenFunctionCatalogEntry& Entry : Entries)
+	{
+		int32* ClassIndex = ClassIndices.Find(Entry.ClassPath);
+		if (!ClassIndex)
+		{
+			ClassIndex = &ClassIndices.Add(Entry.ClassPath, ClassPaths.Num());
+			ClassPaths.Add(Entry.ClassPath);
+			ClassNames.Add(Entry.ClassName);
+		}
+		EntryClasses.Add(*ClassIndex);
+	}
+
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+	int32 Magic = CacheMagic;
+	int32 Version = CacheVersion;
+	FString EngineVersion = FEngineVersion::Current().ToString();
+	int32 EntryCount = Entries.Num();
+	Writer << Magic << Version << EngineVersion << ClassPaths << ClassNames << EntryCount;
+	for (int32 Index = 0; Index < EntryCount; ++Index)
+	{
+		FString FunctionName = Entries[Index].FunctionName;
+		FString NodeTitle = Entries[Index].NodeTitle;
+		uint8 Flags = static_cast<uint8>(Entries[Index].Flags);
+		Writer << EntryClasses[Index] << FunctionName << NodeTitle << Flags;
+	}
+	return FFileHelper::SaveArrayToFile(Bytes, *GetCacheFile());
+}
+
+bool FGenFunctionIndex::LoadCache(TArray<FGenFunctionCatalogEntry>& OutEntries)
+{
+	TArray<uint8> Bytes;
+	if (!FFileHelper::LoadFileToArray(Bytes, *GetCacheFile(), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	FMemoryReader Reader(Bytes);
+	int32 Magic = 0;
+	int32 Version = 0;
+	FString EngineVersion;
+	Reader << Magic << Version << EngineVersion;
+	if (Magic != CacheMagic || Version != CacheVersion || EngineVersion != FEngineVersion::Current().ToString())
+	{
+		return false;
+	}
+
+	TArray<FString> ClassPaths;
+	TArray<FString> ClassNames;
+	int32 EntryCount = 0;
+	Reader << ClassPaths << ClassNames << EntryCount;
+	if (Reader.IsError() || ClassPaths.Num() != ClassNames.Num() || EntryCount < 0)
+	{
+		return false;
+	}
+
+	OutEntries.Reset(EntryCount);
+	for (int32 Index = 0; Index < EntryCount && !Reader.IsError(); ++Index)
+	{
+		int32 ClassIndex = 0;
+		uint8 Flags = 0;
+		FGenFunctionCatalogEntry Entry;
+		Reader << ClassIndex << Entry.FunctionName << Entry.NodeTitle << Flags;
+		if (!ClassPaths.IsValidIndex(ClassIndex))
+		{
+			return false;
+		}
+		Entry.ClassPath = ClassPaths[ClassIndex];
+		Entry.ClassName = ClassNames[ClassIndex];
+		Entry.Flags = static_cast<EGenFunctionFlags>(Flags);
+		OutEntries.Add(MoveTemp(Entry));
+	}
+	return !Reader.IsError();
+}
+
+void FGenFunctionIndex::FindMatches(const FString& NodeType, const FScoreWeights& Weights, int32 MaxResults,
+                                    TArray<FGenFunctionMatch>& OutMatches)
+{
+	EnsureBuilt();
+	if (!bAliasesLoaded)
+	{
+		LoadAliases();
+	}
+	OutMatches.Reset();
+	const FGenFunctionIndexData& IndexData = *Data;
+
+	// "KismetMathLibrary.Add_FloatFloat", the format suggestions are reported in, carries a class hint
+	FString ClassHint;
+	FString FunctionPart = NodeType;
+	int32 DotIndex;
+	if (NodeType.FindLastChar(TEXT('.'), DotIndex))
+	{
+		ClassHint = NormalizeName(NodeType.Left(DotIndex));
+		FunctionPart = NodeType.Mid(DotIndex + 1);
+	}
+	const FString Query = NormalizeName(FunctionPart);
+	if (Query.IsEmpty()) return;
+
+	int32 PinnedEntry = INDEX_NONE;
+	if (const FString* QualifiedName = LearnedAliases.Find(NormalizeName(NodeType)))
+	{
+		if (const int32* AliasEntry = IndexData.QualifiedIndex.Find(*QualifiedName))
+		{
+			PinnedEntry = *AliasEntry;
+		}
+	}
+
+	// Candidates share trigrams with the request, names too short for trigrams are matched by substring
+	TArray<uint64> QueryTrigrams;
+	AddTrigrams(Query, QueryTrigrams);
+	TArray<int32> Touched;
+	if (QueryTrigrams.Num() == 0)
+	{
+		for (int32 Entry = 0; Entry < IndexData.NormalizedNames.Num(); ++Entry)
+		{
+			if (IndexData.NormalizedNames[Entry].Contains(Query, ESearchCase::CaseSensitive) ||
+				IndexData.NormalizedTitles[Entry].Contains(Query, ESearchCase::CaseSensitive))
+			{
+				TrigramHits[Entry] = 1;
+				Touched.Add(Entry);
+			}
+		}
+	}
+	for (const uint64 Trigram : QueryTrigrams)
+	{
+		if (const TArray<int32>* Postings = IndexData.TrigramPostings.Find(Trigram))
+		{
+			for (const int32 Entry : *Postings)
+			{
+				if (TrigramHits[Entry]++ == 0)
+				{
+					Touched.Add(Entry);
+				}
+			}
+		}
+	}
+
+	// Every edit can break up to three trigrams of the request
+	const int32 MaxTypos = GetMaxTypos(Query.Len());
+	const int32 QueryTrigramCount = FMath::Max(QueryTrigrams.Num(), 1);
+	const int32 MinSharedTrigrams = FMath::Max(1, QueryTrigrams.Num() - 3 * MaxTypos);
+
+	struct FCandidate
+	{
+		int32 Entry;
+		float Similarity;
+	};
+	TArray<FCandidate> Shortlist;
+	for (const int32 Entry : Touched)
+	{
+		const int32 Shared = TrigramHits[Entry];
+		TrigramHits[Entry] = 0;
+		if ((Shared >= MinSharedTrigrams || Entry == PinnedEntry) && !EnumHasAnyFlags(IndexData.Flags[Entry], EGenFunctionFlags::Hidden))
+		{
+			// Dice coefficient of the trigram sets
+			Shortlist.Add({Entry, 2.0f * Shared / (QueryTrigramCount + FMath::Max<int32>(IndexData.TrigramCounts[Entry], 1))});
+		}
+	}
+	if (PinnedEntry != INDEX_NONE && !Shortlist.ContainsByPredicate([PinnedEntry](const FCandidate& Candidate) { return Candidate.Entry == PinnedEntry; }))
+	{
+		Shortlist.Add({PinnedEntry, 0.0f});
+	}
+	if (Shortlist.Num() > ShortlistSize)
+	{
+		Shortlist.Sort([](const FCandidate& A, const FCandidate& B) { return A.Similarity > B.Similarity; });
+		Shortlist.SetNum(ShortlistSize);
+	}
+
+	TArray<FString> QueryTokens;
+	Tokenize(FunctionPart, QueryTokens);
+	TArray<int32> QueryTokenIds;
+	for (const FString& Token : QueryTokens)
+	{
+		if (const int32* TokenId = IndexData.TokenIds.Find(Token))
+		{
+			QueryTokenIds.Add(*TokenId);
+		}
+	}
+
+	auto ScoreName = [&Query, &Weights, MaxTypos](const FString& Name, bool& bOutNearMiss)
+	{
+		bOutNearMiss = false;
+		if (Name.IsEmpty()) return 0;
+
+		int32 Score = 0;
+		if (Name.Equals(Query, ESearchCase::CaseSensitive)) Score = Weights.Exact;
+		else if (Name.Contains(Query, ESearchCase::CaseSensitive)) Score = Weights.Substring;
+		else if (MaxTypos > 0)
+		{
+			const int32 Distance = EditDistance(Query, Name, MaxTypos);
+			if (Distance <= MaxTypos)
+			{
+				Score = Weights.Exact - Distance * Weights.Typo;
+				bOutNearMiss = true;
+			}
+		}
+
+		if (Name.StartsWith(Query, ESearchCase::CaseSensitive)) Score += Weights.Prefix;
+		if (Name.Len() > Query.Len() * 2) Score -= Weights.LongNamePenalty;
+		return Score;
+	};
+
+	for (const FCandidate& Candidate : Shortlist)
+	{
+		const int32 Entry = Candidate.Entry;
+		bool bNameNearMiss;
+		bool bTitleNearMiss;
+		const int32 NameScore = ScoreName(IndexData.NormalizedNames[Entry], bNameNearMiss);
+		const int32 TitleScore = ScoreName(IndexData.NormalizedTitles[Entry], bTitleNearMiss);
+		int32 Score = FMath::Max(NameScore, TitleScore);
+		const bool bNearMiss = NameScore >= TitleScore ? bNameNearMiss : bTitleNearMiss;
+
+		for (int32 TokenIndex = IndexData.TokenOffsets[Entry]; TokenIndex < IndexData.TokenOffsets[Entry + 1]; ++TokenIndex)
+		{
+			if (QueryTokenIds.Contains(IndexData.EntryTokens[TokenIndex])) Score += Weights.Token;
+		}
+		Score += FMath::RoundToInt(Candidate.Similarity * Weights.Token);
+
+		if (!ClassHint.IsEmpty())
+		{
+			Score += NormalizeName(IndexData.Entries[Entry].ClassName) == ClassHint ? 2 * Weights.Token : -Weights.Token;
+		}
+		if (Entry == PinnedEntry)
+		{
+			Score = FMath::Max(Score, Weights.Exact + Weights.Prefix);
+		}
+
+		if (Score > 0)
+		{
+			OutMatches.Add({Entry, Score, bNearMiss});
+		}
+	}
+
+	OutMatches.Sort([](const FGenFunctionMatch& A, const FGenFunctionMatch& B)
+	{
+		return A.Score != B.Score ? A.Score > B.Score : A.Index < B.Index;
+	});
+	if (MaxResults > 0 && OutMatches.Num() > MaxResults)
+	{
+		OutMatches.SetNum(MaxResults);
+	}
+}
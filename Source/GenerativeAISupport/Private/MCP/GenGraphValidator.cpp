@@ -0,0 +1,259 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenGraphValidator.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "EdGraphSchema_K2.h"
+#include "Engine/Blueprint.h"
+#include "MCP/GenEditSession.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	struct FGraphDiagnostics
+	{
+		TArray<TSharedPtr<FJsonValue>> Diagnostics;
+		int32 Errors = 0;
+		int32 Warnings = 0;
+		int32 Fixed = 0;
+
+		void Add(const bool bError, const TCHAR* Code, const FString& Message, const UEdGraph* Graph, const UEdGraphNode* Node,
+		         const UEdGraphPin* Pin = nullptr, const UEdGraphPin* LinkedPin = nullptr, const bool bFixed = false)
+		{
+			const TSharedPtr<FJsonObject> Diagnostic = MakeShareable(new FJsonObject());
+			Diagnostic->SetStringField(TEXT("severity"), bError ? TEXT("error") : TEXT("warning"));
+			Diagnostic->SetStringField(TEXT("code"), Code);
+			Diagnostic->SetStringField(TEXT("message"), Message);
+			Diagnostic->SetStringField(TEXT("graph"), Graph->GetName());
+			Diagnostic->SetStringField(TEXT("graph_guid"), Graph->GraphGuid.ToString());
+			Diagnostic->SetStringField(TEXT("node"), Node->GetNodeTitle(ENodeTitleType::ListView).ToString());
+			Diagnostic->SetStringField(TEXT("node_guid"), Node->NodeGuid.ToString());
+			if (Pin)
+			{
+				Diagnostic->SetStringField(TEXT("pin"), Pin->PinName.ToString());
+			}
+			if (LinkedPin)
+			{
+				if (const UEdGraphNode* LinkedNode = LinkedPin->GetOwningNodeUnchecked())
+				{
+					Diagnostic->SetStringField(TEXT("linked_node_guid"), LinkedNode->NodeGuid.ToString());
+				}
+				Diagnostic->SetStringField(TEXT("linked_pin"), LinkedPin->PinName.ToString());
+			}
+			if (bFixed)
+			{
+				Diagnostic->SetBoolField(TEXT("fixed"), true);
+				++Fixed;
+			}
+			(bError ? Errors : Warnings)++;
+			Diagnostics.Add(MakeShareable(new FJsonValueObject(Diagnostic)));
+		}
+	};
+
+	bool IsExecPin(const UEdGraphPin* Pin)
+	{
+		return Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Exec;
+	}
+}
+
+TSharedPtr<FJsonObject> FGenGraphValidator::Validate(UBlueprint* Blueprint, EGenGraphFix Fix)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const bool bFixBrokenLinks = Fix == EGenGraphFix::All;
+	const bool bFixExecLinks = Fix != EGenGraphFix::None;
+
+	TArray<UEdGraph*> Graphs;
+	Blueprint->GetAllGraphs(Graphs);
+
+	FGraphDiagnostics Result;
+	int32 NodeCount = 0;
+	int32 LinkCount = 0;
+	// Broken link entries are only removed after the walk, never while iterating LinkedTo
+	TArray<TPair<UEdGraphPin*, UEdGraphPin*>> LinksToRemove;
+	TArray<TPair<UEdGraphPin*, UEdGraphPin*>> LinksToBreak;
+
+	for (const UEdGraph* Graph : Graphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		// Links may only point at nodes of the same graph
+		TSet<const UEdGraphNode*> GraphNodes;
+		GraphNodes.Reserve(Graph->Nodes.Num());
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			GraphNodes.Add(Node);
+		}
+		const UEdGraphSchema_K2* K2Schema = Cast<UEdGraphSchema_K2>(Graph->GetSchema());
+		for (const UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+			++NodeCount;
+
+			bool bHasLinks = false;
+			bool bHasExecInput = false;
+			bool bHasExecOutput = false;
+			bool bExecInputLinked = false;
+			const UEdGraphPin* FirstExecInput = nullptr;
+			for (UEdGraphPin* Pin : Node->Pins)
+			{
+				if (!Pin)
+				{
+					continue;
+				}
+
+				if (IsExecPin(Pin))
+				{
+					if (Pin->Direction == EGPD_Input)
+					{
+						bHasExecInput = true;
+						bExecInputLinked |= Pin->LinkedTo.Num() > 0;
+						if (!FirstExecInput)
+						{
+							FirstExecInput = Pin;
+						}
+					}
+					else
+					{
+						bHasExecOutput = true;
+					}
+				}
+
+				if (Pin->bOrphanedPin && Pin->LinkedTo.Num() > 0)
+				{
+					Result.Add(true, TEXT("orphaned_pin"), FString::Printf(TEXT("Pin %s no longer exists on the node but is still linked"),
+					           *Pin->PinName.ToString()), Graph, Node, Pin);
+				}
+
+				int32 ValidExecLinks = 0;
+				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+				{
+					bHasLinks = true;
+					if (!LinkedPin)
+					{
+						Result.Add(true, TEXT("null_link"), TEXT("Pin has a link to nothing"), Graph, Node, Pin, nullptr, bFixBrokenLinks);
+						LinksToRemove.Emplace(Pin, nullptr);
+						continue;
+					}
+
+					const UEdGraphNode* LinkedNode = LinkedPin->GetOwningNodeUnchecked();
+					if (!LinkedNode || !GraphNodes.Contains(LinkedNode))
+					{
+						Result.Add(true, TEXT("dangling_link"), TEXT("Pin is linked to a pin of a node that is not in this graph"),
+						           Graph, Node, Pin, LinkedPin, bFixBrokenLinks);
+						LinksToRemove.Emplace(Pin, LinkedPin);
+						continue;
+					}
+
+					if (!LinkedPin->LinkedTo.Contains(Pin))
+					{
+						Result.Add(true, TEXT("asymmetric_link"), TEXT("Pin is linked to a pin that does not link back"),
+						           Graph, Node, Pin, LinkedPin, bFixBrokenLinks);
+						LinksToRemove.Emplace(Pin, LinkedPin);
+						continue;
+					}
+
+					// The rest is checked once per link, from its output side. Both ends of a link between pins of the
+					// same direction see it from that side, the one with the lower address reports it
+					if (Pin->Direction == LinkedPin->Direction)
+					{
+						if (Pin <= LinkedPin)
+						{
+							++LinkCount;
+							Result.Add(true, TEXT("direction_mismatch"), Pin->Direction == EGPD_Input ? TEXT("Two input pins are linked")
+							           : TEXT("Two output pins are linked"), Graph, Node, Pin, LinkedPin);
+						}
+						continue;
+					}
+					if (Pin->Direction != EGPD_Output)
+					{
+						continue;
+					}
+					++LinkCount;
+
+					if (K2Schema && !K2Schema->ArePinsCompatible(Pin, LinkedPin, Blueprint->SkeletonGeneratedClass))
+					{
+						Result.Add(true, TEXT("type_mismatch"), FString::Printf(TEXT("Output of type %s is linked to an input of type %s"),
+						           *UEdGraphSchema_K2::TypeToText(Pin->PinType).ToString(), *UEdGraphSchema_K2::TypeToText(LinkedPin->PinType).ToString()),
+						           Graph, Node, Pin, LinkedPin);
+					}
+
+					if (IsExecPin(Pin) && ++ValidExecLinks > 1)
+					{
+						Result.Add(true, TEXT("multiple_exec_links"), TEXT("Exec output is linked more than once, only the first link can run"),
+						           Graph, Node, Pin, LinkedPin, bFixExecLinks);
+						LinksToBreak.Emplace(Pin, LinkedPin);
+					}
+				}
+			}
+
+			// Events and entries have exec outputs but no exec input, comments have no pins at all
+			const bool bEntryNode = bHasExecOutput && !bHasExecInput;
+			if (!bHasLinks && !bEntryNode && Node->Pins.Num() > 0)
+			{
+				Result.Add(false, TEXT("orphaned_node"), TEXT("Node is not connected to anything"), Graph, Node);
+			}
+			else if (bHasExecInput && !bExecInputLinked)
+			{
+				// Nodes with several exec inputs (Gate, Timeline...) only need one of them connected
+				Result.Add(false, TEXT("exec_input_unconnected"), TEXT("Nothing executes this node, its exec input is not connected"),
+				           Graph, Node, FirstExecInput);
+			}
+		}
+	}
+
+	if ((bFixBrokenLinks && LinksToRemove.Num() > 0) || (bFixExecLinks && LinksToBreak.Num() > 0))
+	{
+		Blueprint->Modify();
+		if (bFixBrokenLinks)
+		{
+			for (const TPair<UEdGraphPin*, UEdGraphPin*>& Link : LinksToRemove)
+			{
+				Link.Key->GetOwningNode()->Modify();
+				Link.Key->LinkedTo.Remove(Link.Value);
+
+				// A pin outside the graph can still link back, it would keep the node it was removed from referenced
+				UEdGraphNode* LinkedNode = Link.Value ? Link.Value->GetOwningNodeUnchecked() : nullptr;
+				if (LinkedNode && Link.Value->LinkedTo.Contains(Link.Key))
+				{
+					LinkedNode->Modify();
+					Link.Value->LinkedTo.Remove(Link.Key);
+				}
+			}
+		}
+		// Valid links are broken on both pins
+		for (const TPair<UEdGraphPin*, UEdGraphPin*>& Link : LinksToBreak)
+		{
+			Link.Key->GetOwningNode()->Modify();
+			Link.Value->GetOwningNode()->Modify();
+			Link.Key->BreakLinkTo(Link.Value);
+		}
+		FGenEditSession::Get().RequestStructuralModification(Blueprint);
+	}
+
+	const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+	UE_LOG(LogGenPerformance, Display, TEXT("Validating %s (%d nodes, %d links in %d graphs) took: %f ms"), *Blueprint->GetName(),
+	       NodeCount, LinkCount, Graphs.Num(), ElapsedMs);
+
+	const TSharedPtr<FJsonObject> Response = MakeShareable(new FJsonObject());
+	Response->SetBoolField(TEXT("success"), Result.Errors == Result.Fixed);
+	Response->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
+	Response->SetNumberField(TEXT("graphs"), Graphs.Num());
+	Response->SetNumberField(TEXT("nodes"), NodeCount);
+	Response->SetNumberField(TEXT("links"), LinkCount);
+	Response->SetNumberField(TEXT("errors"), Result.Errors);
+	Response->SetNumberField(TEXT("warnings"), Result.Warnings);
+	Response->SetNumberField(TEXT("fixed"), Result.Fixed);
+	Response->SetNumberField(TEXT("elapsed_ms"), ElapsedMs);
+	Response->SetArrayField(TEXT("diagnostics"), Result.Diagnostics);
+	return Response;
+}
@@ -0,0 +1,320 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenNodeGuidIndex.h"
+
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Engine/Blueprint.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+FGenNodeGuidIndex& FGenNodeGuidIndex::Get()
+{
+	static FGenNodeGuidIndex Instance;
+	return Instance;
+}
+
+UEdGraphNode* FGenNodeGuidIndex::FindNode(UBlueprint* Blueprint, const FGuid& NodeGuid)
+{
+	if (!Blueprint || !NodeGuid.IsValid())
+	{
+		return nullptr;
+	}
+
+	FBlueprintIndex& Index = GetIndex(Blueprint);
+	if (UEdGraphNode* Node = FindIndexedNode(Blueprint, Index, NodeGuid))
+	{
+		return Node;
+	}
+
+	// Only graphs whose notifications did not say what changed are re-read, a plain miss costs nothing more
+	return SyncStaleGraphs(Blueprint, Index) ? FindIndexedNode(Blueprint, Index, NodeGuid) : nullptr;
+}
+
+UEdGraph* FGenNodeGuidIndex::FindGraph(UBlueprint* Blueprint, const FGuid& GraphGuid)
+{
+	if (!Blueprint || !GraphGuid.IsValid())
+	{
+		return nullptr;
+	}
+
+	// Removed graphs are moved out of the Blueprint, so the outer tells whether an entry is still current
+	FBlueprintIndex& Index = GetIndex(Blueprint);
+	UEdGraph* Graph = Index.Graphs.FindRef(GraphGuid).Get();
+	if (IsValid(Graph) && Graph->GraphGuid == GraphGuid && Graph->GetTypedOuter<UBlueprint>() == Blueprint)
+	{
+		return Graph;
+	}
+
+	if (IsStale(Index))
+	{
+		Rebuild(Blueprint, Index);
+		Graph = Index.Graphs.FindRef(GraphGuid).Get();
+		if (IsValid(Graph) && Graph->GraphGuid == GraphGuid)
+		{
+			return Graph;
+		}
+	}
+	return nullptr;
+}
+
+void FGenNodeGuidIndex::Invalidate(UBlueprint* Blueprint)
+{
+	const TWeakObjectPtr<UBlueprint> WeakBlueprint(Blueprint);
+	if (FBlueprintIndex* Index = Indices.Find(WeakBlueprint))
+	{
+		UnregisterDelegates(Blueprint, *Index);
+		Indices.Remove(WeakBlueprint);
+	}
+}
+
+void FGenNodeGuidIndex::Shutdown()
+{
+	for (TPair<TWeakObjectPtr<UBlueprint>, FBlueprintIndex>& Entry : Indices)
+	{
+		UnregisterDelegates(Entry.Key.Get(), Entry.Value);
+	}
+	Indices.Empty();
+}
+
+FGenNodeGuidIndex::FBlueprintIndex& FGenNodeGuidIndex::GetIndex(UBlueprint* Blueprint)
+{
+	const TWeakObjectPtr<UBlueprint> WeakBlueprint(Blueprint);
+	if (FBlueprintIndex* Existing = Indices.Find(WeakBlueprint))
+	{
+		return *Existing;
+	}
+
+	// Drop the tables of Blueprints that were garbage collected before adding a new one
+	for (auto It = Indices.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid())
+		{
+			UnregisterDelegates(nullptr, It->Value);
+			It.RemoveCurrent();
+		}
+	}
+
+	FBlueprintIndex& Index = Indices.Add(WeakBlueprint);
+	Index.ChangedHandle = Blueprint->OnChanged().AddLambda([this](UBlueprint* ChangedBlueprint)
+	{
+		if (FBlueprintIndex* ChangedIndex = Indices.Find(TWeakObjectPtr<UBlueprint>(ChangedBlueprint)))
+		{
+			ChangedIndex->bGraphsDirty = true;
+		}
+	});
+	Rebuild(Blueprint, Index);
+	return Index;
+}
+
+void FGenNodeGuidIndex::Rebuild(UBlueprint* Blueprint, FBlueprintIndex& Index)
+{
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+	const TSet<UEdGraph*> GraphSet(AllGraphs);
+
+	// Stop listening to graphs that are no longer part of the Blueprint
+	for (auto It = Index.GraphEntries.CreateIterator(); It; ++It)
+	{
+		UEdGraph* Graph = It->Key.Get();
+		if (!Graph || !GraphSet.Contains(Graph))
+		{
+			if (Graph)
+			{
+				Graph->RemoveOnGraphChangedHandler(It->Value.Handle);
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	Index.Nodes.Reset();
+	Index.Graphs.Reset();
+	const TWeakObjectPtr<UBlueprint> WeakBlueprint(Blueprint);
+	for (UEdGraph* Graph : AllGraphs)
+	{
+		if (!Graph)
+		{
+			continue;
+		}
+
+		FGraphEntry& Entry = Index.GraphEntries.FindOrAdd(Graph);
+		if (!Entry.Handle.IsValid())
+		{
+			Entry.Handle = Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateRaw(
+				this, &FGenNodeGuidIndex::OnGraphChanged, WeakBlueprint));
+		}
+
+		Index.Graphs.Add(Graph->GraphGuid, Graph);
+		Entry.NodeGuids.Reset();
+		SyncGraph(Index, Graph, Entry);
+	}
+	Index.bGraphsDirty = false;
+	++RebuildCount;
+
+	UE_LOG(LogGenPerformance, Display, TEXT("Node GUID index of %s (%d nodes in %d graphs) took: %f ms"), *Blueprint->GetName(),
+	       Index.Nodes.Num(), Index.Graphs.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void FGenNodeGuidIndex::SyncGraph(FBlueprintIndex& Index, UEdGraph* Graph, FGraphEntry& Entry)
+{
+	for (const FGuid& NodeGuid : Entry.NodeGuids)
+	{
+		// Removed nodes keep this graph as their outer, entries another graph took over stay
+		const UEdGraphNode* Node = Index.Nodes.FindRef(NodeGuid).Get();
+		if (!Node || Node->GetGraph() == Graph)
+		{
+			Index.Nodes.Remove(NodeGuid);
+		}
+	}
+	Entry.NodeGuids.Reset();
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (Node && Node->NodeGuid.IsValid())
+		{
+			Index.Nodes.Add(Node->NodeGuid, Node);
+			Entry.NodeGuids.Add(Node->NodeGuid);
+		}
+	}
+	Entry.NodeCount = Graph->Nodes.Num();
+	Entry.bDirty = false;
+}
+
+bool FGenNodeGuidIndex::SyncStaleGraphs(UBlueprint* Blueprint, FBlueprintIndex& Index)
+{
+	bool bGraphsChanged = Index.bGraphsDirty;
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& GraphEntry : Index.GraphEntries)
+	{
+		bGraphsChanged |= !GraphEntry.Key.IsValid();
+	}
+	if (bGraphsChanged)
+	{
+		Rebuild(Blueprint, Index);
+		return true;
+	}
+
+	bool bSynced = false;
+	for (TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& GraphEntry : Index.GraphEntries)
+	{
+		UEdGraph* Graph = GraphEntry.Key.Get();
+		if (!IsGraphInStep(Graph, GraphEntry.Value))
+		{
+			SyncGraph(Index, Graph, GraphEntry.Value);
+			++GraphSyncCount;
+			bSynced = true;
+		}
+	}
+	return bSynced;
+}
+
+UEdGraphNode* FGenNodeGuidIndex::FindIndexedNode(const UBlueprint* Blueprint, const FBlueprintIndex& Index, const FGuid& NodeGuid)
+{
+	// Removed nodes keep their outer graph (undo, rollback, RemoveNode), the node set of the graph tells
+	UEdGraphNode* Node = Index.Nodes.FindRef(NodeGuid).Get();
+	if (!IsValid(Node) || Node->NodeGuid != NodeGuid)
+	{
+		return nullptr;
+	}
+	UEdGraph* Graph = Node->GetGraph();
+	const FGraphEntry* Entry = IsValid(Graph) ? Index.GraphEntries.Find(Graph) : nullptr;
+	if (!Entry || !IsGraphInStep(Graph, *Entry) || !Entry->NodeGuids.Contains(NodeGuid))
+	{
+		return nullptr;
+	}
+	return Graph->GetTypedOuter<UBlueprint>() == Blueprint ? Node : nullptr;
+}
+
+bool FGenNodeGuidIndex::IsGraphInStep(const UEdGraph* Graph, const FGraphEntry& Entry)
+{
+	return !Entry.bDirty && Graph->Nodes.Num() == Entry.NodeCount;
+}
+
+bool FGenNodeGuidIndex::IsStale(const FBlueprintIndex& Index)
+{
+	if (Index.bGraphsDirty)
+	{
+		return true;
+	}
+
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& GraphEntry : Index.GraphEntries)
+	{
+		const UEdGraph* Graph = GraphEntry.Key.Get();
+		if (!Graph || !IsGraphInStep(Graph, GraphEntry.Value))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FGenNodeGuidIndex::UnregisterDelegates(UBlueprint* Blueprint, FBlueprintIndex& Index)
+{
+	for (const TPair<TWeakObjectPtr<UEdGraph>, FGraphEntry>& GraphEntry : Index.GraphEntries)
+	{
+		if (UEdGraph* Graph = GraphEntry.Key.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(GraphEntry.Value.Handle);
+		}
+	}
+	Index.GraphEntries.Empty();
+
+	if (Blueprint)
+	{
+		Blueprint->OnChanged().Remove(Index.ChangedHandle);
+	}
+	Index.ChangedHandle.Reset();
+}
+
+void FGenNodeGuidIndex::OnGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UBlueprint> WeakBlueprint)
+{
+	FBlueprintIndex* Index = Indices.Find(WeakBlueprint);
+	if (!Index)
+	{
+		return;
+	}
+
+	FGraphEntry* Entry = Action.Graph ? Index->GraphEntries.Find(Action.Graph) : nullptr;
+	if (!Entry)
+	{
+		Index->bGraphsDirty = true;
+		return;
+	}
+
+	// Undo, redo and other bulk edits only send a generic notification, the graph is re-read on its next lookup
+	if (Action.Action == GRAPHACTION_Default)
+	{
+		Entry->bDirty = true;
+	}
+
+	if (Action.Action & GRAPHACTION_AddNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			if (Node && Node->NodeGuid.IsValid())
+			{
+				Index->Nodes.Add(Node->NodeGuid, const_cast<UEdGraphNode*>(Node));
+				bool bAlreadyListed = false;
+				Entry->NodeGuids.Add(Node->NodeGuid, &bAlreadyListed);
+				Entry->NodeCount += bAlreadyListed ? 0 : 1;
+			}
+		}
+	}
+	if (Action.Action & GRAPHACTION_RemoveNode)
+	{
+		for (const UEdGraphNode* Node : Action.Nodes)
+		{
+			if (!Node)
+			{
+				continue;
+			}
+			if (Index->Nodes.FindRef(Node->NodeGuid).Get() == Node)
+			{
+				Index->Nodes.Remove(Node->NodeGuid);
+			}
+			Entry->NodeCount -= Entry->NodeGuids.Remove(Node->NodeGuid);
+		}
+	}
+}
@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "MCP/GenNodeTypeRegistry.h"
+
+#include "Dom/JsonObject.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#if WITH_EDITOR
+#include "DirectoryWatcherModule.h"
+#include "IDirectoryWatcher.h"
+#endif
+
+namespace
+{
+	const TCHAR* const AliasFileName = TEXT("NodeTypeAliases.json");
+
+	// "Class.Member" into its two parts
+	bool SplitMember(const FString& QualifiedName, FString& OutClassName, FName& OutMemberName)
+	{
+		FString MemberName;
+		if (!QualifiedName.Split(TEXT("."), &OutClassName, &MemberName) || OutClassName.IsEmpty() || MemberName.IsEmpty())
+		{
+			return false;
+		}
+		OutMemberName = FName(*MemberName);
+		return true;
+	}
+}
+
+FGenNodeTypeRegistry& FGenNodeTypeRegistry::Get()
+{
+	static FGenNodeTypeRegistry Instance;
+	return Instance;
+}
+
+FString FGenNodeTypeRegistry::GetPluginFile()
+{
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("GenerativeAISupport"));
+	return Plugin.IsValid() ? Plugin->GetBaseDir() / TEXT("Config") / AliasFileName : FString();
+}
+
+FString FGenNodeTypeRegistry::GetProjectFile()
+{
+	return FPaths::ProjectConfigDir() / TEXT("GenerativeAISupport") / AliasFileName;
+}
+
+const FGenNodeRecipe* FGenNodeTypeRegistry::FindRecipe(const FString& NodeType, FString& OutResolvedType)
+{
+	if (!bLoaded)
+	{
+		Reload();
+	}
+
+	OutResolvedType = NodeType;
+	if (NodeType.IsEmpty() || NodeType.Len() >= NAME_SIZE)
+	{
+		return nullptr;
+	}
+
+	// FNAME_Find never adds to the name table, names nobody registered can't be in the maps anyway
+	const FName NodeName(*NodeType, FNAME_Find);
+	if (NodeName.IsNone())
+	{
+		return nullptr;
+	}
+
+	FName CanonicalName = NodeName;
+	if (const FName* AliasTarget = Aliases.Find(NodeName))
+	{
+		CanonicalName = *AliasTarget;
+		OutResolvedType = CanonicalName.ToString();
+	}
+	return Recipes.Find(CanonicalName);
+}
+
+bool FGenNodeTypeRegistry::Reload()
+{
+	bLoaded = true;
+	const double StartTime = FPlatformTime::Seconds();
+
+	TMap<FName, FGenNodeRecipe> NewRecipes;
+	TMap<FName, FName> NewAliases;
+	const FString PluginFile = GetPluginFile();
+	if (PluginFile.IsEmpty() || !ParseFile(PluginFile, NewRecipes, NewAliases))
+	{
+		return false;
+	}
+
+	// Project entries are optional and win over the plugin ones
+	const FString ProjectFile = GetProjectFile();
+	if (FPaths::FileExists(ProjectFile) && !ParseFile(ProjectFile, NewRecipes, NewAliases))
+	{
+		return false;
+	}
+
+	Recipes = MoveTemp(NewRecipes);
+	Aliases = MoveTemp(NewAliases);
+	UE_LOG(LogGenPerformance, Display, TEXT("Node type aliases load (%d recipes, %d aliases) took: %f ms"), Recipes.Num(), Aliases.Num(),
+	       (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	return true;
+}
+
+bool FGenNodeTypeRegistry::ParseFile(const FString& FilePath, TMap<FName, FGenNodeRecipe>& OutRecipes, TMap<FName, FName>& OutAliases)
+{
+	FString FileContent;
+	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	{
+		UE_LOG(LogGenAI, Error, TEXT("Could not read node type aliases from %s"), *FilePath);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContent);
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+	{
+		UE_LOG(LogGenAI, Error, TEXT("Malformed node type aliases in %s"), *FilePath);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* RecipesObject;
+	if (Root->TryGetObjectField(TEXT("recipes"), RecipesObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& RecipeValue : (*RecipesObject)->Values)
+		{
+			const TSharedPtr<FJsonObject> RecipeObject = RecipeValue.Value->AsObject();
+			if (!RecipeObject.IsValid())
+			{
+				UE_LOG(LogGenAI, Warning, TEXT("Skipping node recipe %s in %s, it is not an object"), *RecipeValue.Key, *FilePath);
+				continue;
+			}
+
+			FGenNodeRecipe Recipe;
+			Recipe.Name = FName(*RecipeValue.Key);
+			FString Value;
+			bool bValid = true;
+			if (RecipeObject->TryGetStringField(TEXT("function"), Value))
+			{
+				Recipe.Kind = EGenNodeRecipeKind::CallFunction;
+				bValid = SplitMember(Value, Recipe.ClassName, Recipe.MemberName);
+			}
+			else if (RecipeObject->TryGetStringField(TEXT("event"), Value))
+			{
+				Recipe.Kind = EGenNodeRecipeKind::Event;
+				bValid = SplitMember(Value, Recipe.ClassName, Recipe.MemberName);
+			}
+			else if (RecipeObject->TryGetStringField(TEXT("node_class"), Value))
+			{
+				Recipe.Kind = EGenNodeRecipeKind::NodeClass;
+				Recipe.ClassName = Value;
+			}
+			else if (RecipeObject->TryGetStringField(TEXT("special"), Value))
+			{
+				if (Value == TEXT("FunctionEntry")) Recipe.Kind = EGenNodeRecipeKind::FunctionEntry;
+				else if (Value == TEXT("InputAction")) Recipe.Kind = EGenNodeRecipeKind::InputAction;
+				else if (Value == TEXT("VariableGet")) Recipe.Kind = EGenNodeRecipeKind::VariableGet;
+				else if (Value == TEXT("VariableSet")) Recipe.Kind = EGenNodeRecipeKind::VariableSet;
+				else bValid = false;
+			}
+			else
+			{
+				bValid = false;
+			}
+
+			if (!bValid)
+			{
+				UE_LOG(LogGenAI, Warning, TEXT("Skipping node recipe %s in %s, it needs a function, event, node_class or known special"),
+				       *RecipeValue.Key, *FilePath);
+				continue;
+			}
+
+			OutRecipes.Add(Recipe.Name, Recipe);
+			const TArray<TSharedPtr<FJsonValue>>* RecipeAliases;
+			if (RecipeObject->TryGetArrayField(TEXT("aliases"), RecipeAliases))
+			{
+				for (const TSharedPtr<FJsonValue>& Alias : *RecipeAliases)
+				{
+					OutAliases.Add(FName(*Alias->AsString()), Recipe.Name);
+				}
+			}
+		}
+	}
+
+	const TSharedPtr<FJsonObject>* AliasesObject;
+	if (Root->TryGetObjectField(TEXT("aliases"), AliasesObject))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Alias : (*AliasesObject)->Values)
+		{
+			OutAliases.Add(FName(*Alias.Key), FName(*Alias.Value->AsString()));
+		}
+	}
+	return true;
+}
+
+void FGenNodeTypeRegistry::StartWatching()
+{
+#if WITH_EDITOR
+	if (WatchHandles.Num() > 0)
+	{
+		return;
+	}
+
+	IDirectoryWatcher* DirectoryWatcher = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")).Get();
+	if (!DirectoryWatcher)
+	{
+		return;
+	}
+
+	for (const FString& WatchedFile : {GetPluginFile(), GetProjectFile()})
+	{
+		const FString Directory = FPaths::GetPath(WatchedFile);
+		if (WatchedFile.IsEmpty() || !FPaths::DirectoryExists(Directory))
+		{
+			continue;
+		}
+
+		FDelegateHandle Handle;
+		DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory, IDirectoryWatcher::FDirectoryChanged::CreateLambda(
+			[this](const TArray<FFileChangeData>& Changes)
+			{
+				for (const FFileChangeData& Change : Changes)
+				{
+					if (FPaths::GetCleanFilename(Change.Filename) == AliasFileName)
+					{
+						UE_LOG(LogGenAI, Log, TEXT("Reloading node type aliases after %s changed"), *Change.Filename);
+						Reload();
+						return;
+					}
+				}
+			}), Handle);
+		WatchHandles.Emplace(Directory, Handle);
+	}
+#endif
+}
+
+void FGenNodeTypeRegistry::StopWatching()
+{
+#if WITH_EDITOR
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& WatchHandle : WatchHandles)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(WatchHandle.Key, WatchHandle.Value);
+			}
+		}
+	}
+#endif
+	WatchHandles.Empty();
+}
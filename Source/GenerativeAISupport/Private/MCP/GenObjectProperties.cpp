@@ -8,6 +8,7 @@
 #include "Engine/SCS_Node.h"
 #include "Engine/SimpleConstructionScript.h"
 #include "Kismet2/BlueprintEditorUtils.h"
+#include "MCP/GenEditSession.h"
 
 FString UGenObjectProperties::EditComponentProperty(const FString& BlueprintPath, const FString& ComponentName,
                                                     const FString& PropertyName, const FString& Value,
@@ -108,7 +109,7 @@ FString UGenObjectProperties::EditComponentProperty(const FString& BlueprintPath
 		if (Blueprint)
 		{
 			Blueprint->Modify();
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+			FGenEditSession::Get().RequestStructuralModification(Blueprint);
 		}
 		else if (SceneActor)
 		{
@@ -209,7 +210,7 @@ FString UGenObjectProperties::EditComponentProperty(const FString& BlueprintPath
 	if (Blueprint)
 	{
 		Blueprint->Modify();
-		FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		FGenEditSession::Get().RequestStructuralModification(Blueprint);
 	}
 	else if (SceneActor)
 	{
@@ -9,6 +9,9 @@
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Secure/GenSecureKey.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tools/GenToolRegistry.h"
+#include "Utilities/GenImageUtils.h"
 #include "Utilities/GenUtils.h"
 
 
@@ -42,10 +45,11 @@ void UGenClaudeChat::Activate()
     });
 }
 
-void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                 const TSharedPtr<FGenImageAttachments>& CachedImages)
 {
     FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::Anthropic);
-    if (ApiKey.IsEmpty())
+    if (ApiKey.IsEmpty() && ChatSettings.EndpointOverride.IsEmpty())
     {
         ResponseCallback(TEXT(""), TEXT("Anthropic API key not set"), false);
         return;
@@ -60,15 +64,9 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
     JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
     JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
 
-    TArray<TSharedPtr<FJsonValue>> MessagesArray;
-    for (const FGenChatMessage& Message : ChatSettings.Messages)
-    {
-        TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
-        JsonMessage->SetStringField(TEXT("role"), Message.Role);
-        JsonMessage->SetStringField(TEXT("content"), Message.Content);
-        MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
-    }
-    JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
+    const TSharedRef<FGenImageAttachments> Images = CachedImages.IsValid() ? CachedImages.ToSharedRef() : MakeShared<FGenImageAttachments>();
+    JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages(ChatSettings.Messages, EGenToolFormat::Anthropic, &Images.Get()));
+    FGenToolCallCodec::WriteTools(JsonPayload, ChatSettings.Tools, ChatSettings.ToolChoice, EGenToolFormat::Anthropic);
 
     FString PayloadString;
     TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
@@ -78,17 +76,21 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
     TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
     HttpRequest->SetTimeout(180.0f);
     HttpRequest->SetVerb(TEXT("POST"));
-    HttpRequest->SetURL(TEXT("https://api.anthropic.com/v1/messages"));
+    HttpRequest->SetURL(ChatSettings.EndpointOverride.IsEmpty() ? TEXT("https://api.anthropic.com/v1/messages") : *ChatSettings.EndpointOverride);
     HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
     HttpRequest->SetHeader(TEXT("x-api-key"), ApiKey);
     HttpRequest->SetHeader(TEXT("anthropic-version"), TEXT("2023-06-01"));
-    HttpRequest->SetContentAsString(PayloadString);
+    if (Images->Num() == 0)
+    {
+        HttpRequest->SetContentAsString(PayloadString);
+    }
     
     UE_LOG(LogTemp, Log, TEXT("Claude API Request: %s"), *PayloadString);
 
     HttpRequest->OnProcessRequestComplete().BindLambda(
-        [ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+        [ChatSettings, ResponseCallback, Images](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
         {
+            UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::Anthropic, Request, Response);
             if (!bSuccess || !Response.IsValid())
             {
                 FString ErrorMessage = Response.IsValid() ? Response->GetContentAsString() : TEXT("Request failed. No response received.");
@@ -103,13 +105,23 @@ void UGenClaudeChat::MakeRequest(const FGenClaudeChatSettings& ChatSettings, con
                 return;
             }
 
-            ProcessResponse(Response->GetContentAsString(), ResponseCallback);
+            ProcessResponse(Response->GetContentAsString(), ChatSettings, ResponseCallback, Images);
         });
     
+    if (Images->Num() > 0)
+    {
+        // Images are encoded on a worker thread and spliced into the body before the request is sent
+        FGenImageUtils::ProcessRequestWithImages(HttpRequest, PayloadString, Images, [ResponseCallback](const FString& Error)
+        {
+            ResponseCallback(TEXT(""), Error, false);
+        });
+        return;
+    }
     HttpRequest->ProcessRequest();
 }
 
-void UGenClaudeChat::ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+void UGenClaudeChat::ProcessResponse(const FString& ResponseStr, const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                     const TSharedPtr<FGenImageAttachments>& CachedImages)
 {
     TSharedPtr<FJsonObject> JsonObject;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
@@ -121,6 +133,26 @@ void UGenClaudeChat::ProcessResponse(const FString& ResponseStr, const TFunction
             const TArray<TSharedPtr<FJsonValue>>* ContentArray;
             if (JsonObject->TryGetArrayField(TEXT("content"), ContentArray) && ContentArray->Num() > 0)
             {
+                FString Text;
+                if (TArray<FGenToolCall> ToolCalls; FGenToolCallCodec::ReadAnthropicContent(*ContentArray, Text, ToolCalls))
+                {
+                    if (ChatSettings.MaxToolRoundTrips <= 0)
+                    {
+                        ResponseCallback(TEXT(""), TEXT("Tool call limit reached"), false);
+                        return;
+                    }
+
+                    FGenClaudeChatSettings NextSettings = ChatSettings;
+                    NextSettings.MaxToolRoundTrips--;
+                    FGenToolRegistry::Get().ExecuteToolCalls(ToolCalls,
+                        [NextSettings, Text, ToolCalls, ResponseCallback, CachedImages](const TArray<FGenToolResult>& Results) mutable
+                        {
+                            FGenToolCallCodec::AppendToolRound(NextSettings.Messages, Text, ToolCalls, Results);
+                            MakeRequest(NextSettings, ResponseCallback, CachedImages);
+                        });
+                    return;
+                }
+
                 const TSharedPtr<FJsonObject>* ContentObj;
                 if ((*ContentArray)[0]->TryGetObject(ContentObj) && ContentObj->IsValid() && (*ContentObj)->HasField(TEXT("text")))
                 {
@@ -9,6 +9,8 @@
 #include "Interfaces/IHttpRequest.h"
 #include "Interfaces/IHttpResponse.h"
 #include "Secure/GenSecureKey.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tools/GenToolRegistry.h"
 #include "Utilities/GenUtils.h"
 
 
@@ -57,17 +59,15 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 		TEXT("model"),
 		UGenUtils::GetEnumDisplayName(StaticEnum<EDeepSeekModels>(), static_cast<int32>(ChatSettings.Model)));
 	JsonPayload->SetNumberField(TEXT("max_tokens"), ChatSettings.MaxTokens);
-	JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
-
-	TArray<TSharedPtr<FJsonValue>> MessagesArray;
-	for (const FGenChatMessage& Message : ChatSettings.Messages)
+	if (ChatSettings.Temperature >= 0.0f)
 	{
-		TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
-		JsonMessage->SetStringField(TEXT("role"), Message.Role);
-		JsonMessage->SetStringField(TEXT("content"), Message.Content);
-		MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+		JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
 	}
-	JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
+	JsonPayload->SetBoolField(TEXT("stream"), ChatSettings.bStreamResponse);
+
+	// DeepSeek follows the OpenAI format for tools
+	JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages(ChatSettings.Messages, EGenToolFormat::OpenAI));
+	FGenToolCallCodec::WriteTools(JsonPayload, ChatSettings.Tools, ChatSettings.ToolChoice, EGenToolFormat::OpenAI);
 
 	FString PayloadString;
 	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
@@ -90,8 +90,9 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 	UE_LOG(LogTemp, Log, TEXT("Payload: %s"), *PayloadString);
 
 	HttpRequest->OnProcessRequestComplete().BindLambda(
-		[ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		[ChatSettings, ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
 		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::DeepSeek, Request, Response);
 			if (!bSuccess || !Response.IsValid())
 			{
 				FString ErrorMessage = Response.IsValid() ? Response->GetContentAsString() : TEXT("Request failed. No response received.");
@@ -106,13 +107,13 @@ void UGenDSeekChat::MakeRequest(const FGenDSeekChatSettings& ChatSettings,
 				return;
 			}
 
-			ProcessResponse(Response->GetContentAsString(), ResponseCallback);
+			ProcessResponse(Response->GetContentAsString(), ChatSettings, ResponseCallback);
 		});
 	HttpRequest->ProcessRequest();
 }
 
 
-void UGenDSeekChat::ProcessResponse(const FString& ResponseStr,
+void UGenDSeekChat::ProcessResponse(const FString& ResponseStr, const FGenDSeekChatSettings& ChatSettings,
                                     const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
 {
 	TSharedPtr<FJsonObject> JsonObject;
@@ -126,7 +127,27 @@ void UGenDSeekChat::ProcessResponse(const FString& ResponseStr,
 			if (Choices.Num() > 0 && Choices[0]->AsObject()->HasField(TEXT("message")))
 			{
 				const TSharedPtr<FJsonObject> Message = Choices[0]->AsObject()->GetObjectField(TEXT("message"));
-				FString Content = Message->GetStringField(TEXT("content"));
+				FString Content;
+				Message->TryGetStringField(TEXT("content"), Content);
+
+				if (TArray<FGenToolCall> ToolCalls; FGenToolCallCodec::ReadOpenAIToolCalls(Message, ToolCalls))
+				{
+					if (ChatSettings.MaxToolRoundTrips <= 0)
+					{
+						ResponseCallback(TEXT(""), TEXT("Tool call limit reached"), false);
+						return;
+					}
+
+					FGenDSeekChatSettings NextSettings = ChatSettings;
+					NextSettings.MaxToolRoundTrips--;
+					FGenToolRegistry::Get().ExecuteToolCalls(ToolCalls,
+						[NextSettings, Content, ToolCalls, ResponseCallback](const TArray<FGenToolResult>& Results) mutable
+						{
+							FGenToolCallCodec::AppendToolRound(NextSettings.Messages, Content, ToolCalls, Results);
+							MakeRequest(NextSettings, ResponseCallback);
+						});
+					return;
+				}
 
 				// If using deepseek-reasoner, extract reasoning content as well
 				if (Message->HasField(TEXT("reasoning_content")))
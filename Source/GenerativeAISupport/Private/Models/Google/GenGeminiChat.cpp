@@ -0,0 +1,277 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Models/Google/GenGeminiChat.h"
+
+#include "Http.h"
+#include "Data/GenAIOrgs.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenSSEParser.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenHttpStream.h"
+
+void UGenGeminiChat::SendChatRequest(const FGenGeminiChatSettings& ChatSettings, const FOnGeminiChatCompletionResponse& OnComplete,
+                                     const FOnGeminiChatDelta& OnDelta)
+{
+	MakeRequest(ChatSettings,
+	            [OnDelta](const FString& Delta)
+	            {
+		            OnDelta.ExecuteIfBound(Delta);
+	            },
+	            [OnComplete](const FString& Response, const FString& Error, bool Success)
+	            {
+		            if (OnComplete.IsBound())
+		            {
+			            OnComplete.Execute(Response, Error, Success);
+		            }
+	            });
+}
+
+UGenGeminiChat* UGenGeminiChat::RequestGeminiChat(UObject* WorldContextObject, const FGenGeminiChatSettings& ChatSettings)
+{
+	UGenGeminiChat* AsyncAction = NewObject<UGenGeminiChat>();
+	AsyncAction->ChatSettings = ChatSettings;
+	return AsyncAction;
+}
+
+void UGenGeminiChat::Activate()
+{
+	MakeRequest(ChatSettings,
+	            [this](const FString& Delta)
+	            {
+		            OnDelta.Broadcast(Delta);
+	            },
+	            [this](const FString& Response, const FString& Error, bool Success)
+	            {
+		            OnComplete.Broadcast(Response, Error, Success);
+		            Cancel();
+	            });
+}
+
+void UGenGeminiChat::MakeRequest(const FGenGeminiChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+                                 const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::Google);
+	if (ApiKey.IsEmpty() && ChatSettings.EndpointOverride.IsEmpty())
+	{
+		ResponseCallback(TEXT(""), TEXT("Google API key not set"), false);
+		return;
+	}
+
+	const bool bStream = ChatSettings.bStreamResponse;
+	FString Url = ChatSettings.EndpointOverride;
+	if (Url.IsEmpty())
+	{
+		Url = FString::Printf(TEXT("https://generativelanguage.googleapis.com/v1beta/models/%s:%s"), *ChatSettings.Model,
+		                      bStream ? TEXT("streamGenerateContent?alt=sse") : TEXT("generateContent"));
+	}
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(Url);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("x-goog-api-key"), ApiKey);
+	HttpRequest->SetContentAsString(BuildPayload(ChatSettings));
+
+	// Shared between the progress and completion callbacks
+	struct FStreamState
+	{
+		FGenSSEParser SSEParser;
+		FString Content;
+		FString Error;
+		double StartTime = 0.0;
+		bool bReceivedDelta = false;
+	};
+	const TSharedRef<FStreamState, ESPMode::ThreadSafe> State = MakeShared<FStreamState, ESPMode::ThreadSafe>();
+	State->StartTime = FPlatformTime::Seconds();
+
+	auto HandleEvent = [State, DeltaCallback](const FString& EventName, const FString& Data)
+	{
+		TSharedPtr<FJsonObject> ChunkObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+		if (!FJsonSerializer::Deserialize(Reader, ChunkObject) || !ChunkObject.IsValid())
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Failed to parse Gemini stream chunk: %s"), *Data);
+			return;
+		}
+
+		FString Text;
+		if (!ReadCandidateText(ChunkObject, Text, State->Error) || Text.IsEmpty())
+		{
+			return;
+		}
+
+		if (!State->bReceivedDelta)
+		{
+			State->bReceivedDelta = true;
+			UE_LOG(LogGenPerformance, Display, TEXT("Gemini time to first token: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+		}
+		State->Content.Append(Text);
+		DeltaCallback(Text);
+	};
+
+	TSharedPtr<FGenHttpStreamReader, ESPMode::ThreadSafe> StreamReader;
+	if (bStream)
+	{
+		StreamReader = FGenHttpStreamReader::Bind(HttpRequest, [State, HandleEvent](const uint8* Data, int32 Num)
+		{
+			State->SSEParser.Feed(Data, Num, HandleEvent);
+		});
+	}
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[State, StreamReader, HandleEvent, ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::Google, Request, Response);
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Gemini request failed, Response code: %d"), Response.IsValid() ? Response->GetResponseCode() : -1);
+				ResponseCallback(TEXT(""), TEXT("Request failed"), false);
+				return;
+			}
+
+			if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				// Errors are returned as a regular JSON body, also for streamed requests
+				const FString ErrorBody = StreamReader.IsValid() ? StreamReader->GetBodyPrefix(Response) : Response->GetContentAsString();
+				UE_LOG(LogGenAI, Error, TEXT("Gemini request failed, Response code: %d, %s"), Response->GetResponseCode(), *ErrorBody);
+				ResponseCallback(TEXT(""), ErrorBody, false);
+				return;
+			}
+
+			if (StreamReader.IsValid())
+			{
+				StreamReader->Flush(Response);
+				State->SSEParser.Flush(HandleEvent);
+			}
+			else
+			{
+				TSharedPtr<FJsonObject> JsonObject;
+				const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+				if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+				{
+					ResponseCallback(TEXT(""), TEXT("Invalid response"), false);
+					return;
+				}
+				ReadCandidateText(JsonObject, State->Content, State->Error);
+			}
+
+			UE_LOG(LogGenPerformance, Display, TEXT("Gemini request took: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+			// A blocked candidate fails the request, the text generated before the stop is still passed on
+			if (!State->Error.IsEmpty())
+			{
+				UE_LOG(LogGenAI, Warning, TEXT("Gemini response failed: %s"), *State->Error);
+				ResponseCallback(State->Content, State->Error, false);
+				return;
+			}
+			ResponseCallback(State->Content, TEXT(""), true);
+		});
+
+	HttpRequest->ProcessRequest();
+}
+
+FString UGenGeminiChat::BuildPayload(const FGenGeminiChatSettings& ChatSettings)
+{
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+
+	TArray<TSharedPtr<FJsonValue>> Contents;
+	TArray<TSharedPtr<FJsonValue>> SystemParts;
+	for (const FGenChatMessage& Message : ChatSettings.Messages)
+	{
+		const TSharedPtr<FJsonObject> Part = MakeShareable(new FJsonObject());
+		Part->SetStringField(TEXT("text"), Message.Content);
+
+		if (Message.Role == TEXT("system") || Message.Role == TEXT("developer"))
+		{
+			SystemParts.Add(MakeShareable(new FJsonValueObject(Part)));
+			continue;
+		}
+
+		// Consecutive messages of the same role are merged, Gemini expects the roles to alternate
+		const FString Role = Message.Role == TEXT("assistant") ? TEXT("model") : TEXT("user");
+		if (Contents.Num() > 0)
+		{
+			const TSharedPtr<FJsonObject> Previous = Contents.Last()->AsObject();
+			if (Previous->GetStringField(TEXT("role")) == Role)
+			{
+				TArray<TSharedPtr<FJsonValue>> Parts = Previous->GetArrayField(TEXT("parts"));
+				Parts.Add(MakeShareable(new FJsonValueObject(Part)));
+				Previous->SetArrayField(TEXT("parts"), Parts);
+				continue;
+			}
+		}
+
+		const TSharedPtr<FJsonObject> Content = MakeShareable(new FJsonObject());
+		Content->SetStringField(TEXT("role"), Role);
+		Content->SetArrayField(TEXT("parts"), {MakeShareable(new FJsonValueObject(Part))});
+		Contents.Add(MakeShareable(new FJsonValueObject(Content)));
+	}
+	JsonPayload->SetArrayField(TEXT("contents"), Contents);
+
+	if (SystemParts.Num() > 0)
+	{
+		const TSharedPtr<FJsonObject> SystemInstruction = MakeShareable(new FJsonObject());
+		SystemInstruction->SetArrayField(TEXT("parts"), SystemParts);
+		JsonPayload->SetObjectField(TEXT("systemInstruction"), SystemInstruction);
+	}
+
+	const TSharedPtr<FJsonObject> GenerationConfig = MakeShareable(new FJsonObject());
+	GenerationConfig->SetNumberField(TEXT("maxOutputTokens"), ChatSettings.MaxTokens);
+	GenerationConfig->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
+	JsonPayload->SetObjectField(TEXT("generationConfig"), GenerationConfig);
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+	return PayloadString;
+}
+
+bool UGenGeminiChat::ReadCandidateText(const TSharedPtr<FJsonObject>& ResponseObject, FString& OutText, FString& OutError)
+{
+	const TSharedPtr<FJsonObject>* ErrorObject;
+	if (ResponseObject->TryGetObjectField(TEXT("error"), ErrorObject))
+	{
+		(*ErrorObject)->TryGetStringField(TEXT("message"), OutError);
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject>* PromptFeedback;
+	FString BlockReason;
+	if (ResponseObject->TryGetObjectField(TEXT("promptFeedback"), PromptFeedback) &&
+		(*PromptFeedback)->TryGetStringField(TEXT("blockReason"), BlockReason))
+	{
+		OutError = FString::Printf(TEXT("Prompt blocked: %s"), *BlockReason);
+		return false;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>>* Candidates;
+	if (!ResponseObject->TryGetArrayField(TEXT("candidates"), Candidates) || Candidates->Num() == 0)
+	{
+		return false;
+	}
+
+	const TSharedPtr<FJsonObject> Candidate = (*Candidates)[0]->AsObject();
+	const TSharedPtr<FJsonObject>* Content;
+	const TArray<TSharedPtr<FJsonValue>>* Parts;
+	if (Candidate.IsValid() && Candidate->TryGetObjectField(TEXT("content"), Content) && (*Content)->TryGetArrayField(TEXT("parts"), Parts))
+	{
+		for (const TSharedPtr<FJsonValue>& Part : *Parts)
+		{
+			FString Text;
+			if (Part->AsObject().IsValid() && Part->AsObject()->TryGetStringField(TEXT("text"), Text))
+			{
+				OutText.Append(Text);
+			}
+		}
+	}
+
+	FString FinishReason;
+	if (Candidate.IsValid() && Candidate->TryGetStringField(TEXT("finishReason"), FinishReason) &&
+		(FinishReason == TEXT("SAFETY") || FinishReason == TEXT("RECITATION") || FinishReason == TEXT("PROHIBITED_CONTENT")))
+	{
+		OutError = FString::Printf(TEXT("Response stopped: %s"), *FinishReason);
+	}
+	return true;
+}
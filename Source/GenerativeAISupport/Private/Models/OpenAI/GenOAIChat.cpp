@@ -11,6 +11,9 @@
 #include "Serialization/JsonReader.h"
 #include "Serialization/JsonSerializer.h"
 #include "Engine/Engine.h"  // For GEngine and screen logging
+#include "Serialize/GenToolCallCodec.h"
+#include "Tools/GenToolRegistry.h"
+#include "Utilities/GenImageUtils.h"
 #include "Utilities/GenGlobalDefinitions.h"
 
 
@@ -43,10 +46,11 @@ void UGenOAIChat::Activate()
 }
 
 void UGenOAIChat::MakeRequest(const FGenChatSettings& ChatSettings,
-                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                              const TSharedPtr<FGenImageAttachments>& CachedImages)
 {
 	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
-	if (ApiKey.IsEmpty())
+	if (ApiKey.IsEmpty() && ChatSettings.EndpointOverride.IsEmpty())
 	{
 		ResponseCallback(TEXT(""), TEXT("API key not set"), false);
 		return;
@@ -55,16 +59,14 @@ void UGenOAIChat::MakeRequest(const FGenChatSettings& ChatSettings,
 	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
 	JsonPayload->SetStringField(TEXT("model"), ChatSettings.Model);
 	JsonPayload->SetNumberField(TEXT("max_completion_tokens"), ChatSettings.MaxTokens);
-
-	TArray<TSharedPtr<FJsonValue>> MessagesArray;
-	for (const auto& [Role, Content] : ChatSettings.Messages)
+	if (ChatSettings.Temperature >= 0.0f)
 	{
-		const TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
-		JsonMessage->SetStringField(TEXT("role"), Role);
-		JsonMessage->SetStringField(TEXT("content"), Content);
-		MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+		JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
 	}
-	JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
+
+	const TSharedRef<FGenImageAttachments> Images = CachedImages.IsValid() ? CachedImages.ToSharedRef() : MakeShared<FGenImageAttachments>();
+	JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages(ChatSettings.Messages, EGenToolFormat::OpenAI, &Images.Get()));
+	FGenToolCallCodec::WriteTools(JsonPayload, ChatSettings.Tools, ChatSettings.ToolChoice, EGenToolFormat::OpenAI);
 
 	FString PayloadString;
 	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
@@ -72,16 +74,20 @@ void UGenOAIChat::MakeRequest(const FGenChatSettings& ChatSettings,
 
 	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
 	HttpRequest->SetVerb(TEXT("POST"));
-	HttpRequest->SetURL(TEXT("https://api.openai.com/v1/chat/completions"));
+	HttpRequest->SetURL(ChatSettings.EndpointOverride.IsEmpty() ? TEXT("https://api.openai.com/v1/chat/completions") : *ChatSettings.EndpointOverride);
 	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
 	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
-	HttpRequest->SetContentAsString(PayloadString);
+	if (Images->Num() == 0)
+	{
+		HttpRequest->SetContentAsString(PayloadString);
+	}
 
 	//UE_LOG(LogGenAIVerbose, Log, TEXT("Sending chat request... Payload: %s"), *PayloadString);
 
 	HttpRequest->OnProcessRequestComplete().BindLambda(
-		[ResponseCallback](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
+		[ChatSettings, ResponseCallback, Images](FHttpRequestPtr Request, const FHttpResponsePtr& Response, const bool bSuccess)
 		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
 			if (!bSuccess || !Response.IsValid())
 			{
 				ResponseCallback(TEXT(""), TEXT("Request failed"), false);
@@ -89,14 +95,24 @@ void UGenOAIChat::MakeRequest(const FGenChatSettings& ChatSettings,
 				       Response.IsValid() ? Response->GetResponseCode() : -1);
 				return;
 			}
-			ProcessResponse(Response->GetContentAsString(), ResponseCallback);
+			ProcessResponse(Response->GetContentAsString(), ChatSettings, ResponseCallback, Images);
 		});
 
+	if (Images->Num() > 0)
+	{
+		// Images are encoded on a worker thread and spliced into the body before the request is sent
+		FGenImageUtils::ProcessRequestWithImages(HttpRequest, PayloadString, Images, [ResponseCallback](const FString& Error)
+		{
+			ResponseCallback(TEXT(""), Error, false);
+		});
+		return;
+	}
 	HttpRequest->ProcessRequest();
 }
 
-void UGenOAIChat::ProcessResponse(const FString& ResponseStr,
-                                  const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+void UGenOAIChat::ProcessResponse(const FString& ResponseStr, const FGenChatSettings& ChatSettings,
+                                  const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                  const TSharedPtr<FGenImageAttachments>& CachedImages)
 {
 	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
 
@@ -111,8 +127,30 @@ void UGenOAIChat::ProcessResponse(const FString& ResponseStr,
 				if (const TSharedPtr<FJsonObject> FirstChoice = ChoicesArray[0]->AsObject(); FirstChoice.IsValid() &&
 					FirstChoice->HasField(TEXT("message")))
 				{
-					if (const TSharedPtr<FJsonObject> MessageObject = FirstChoice->GetObjectField(TEXT("message"));
-						MessageObject.IsValid() && MessageObject->HasField(TEXT("content")))
+					const TSharedPtr<FJsonObject> MessageObject = FirstChoice->GetObjectField(TEXT("message"));
+					if (TArray<FGenToolCall> ToolCalls; FGenToolCallCodec::ReadOpenAIToolCalls(MessageObject, ToolCalls))
+					{
+						if (ChatSettings.MaxToolRoundTrips <= 0)
+						{
+							ResponseCallback(TEXT(""), TEXT("Tool call limit reached"), false);
+							return;
+						}
+
+						FString AssistantText;
+						MessageObject->TryGetStringField(TEXT("content"), AssistantText);
+
+						FGenChatSettings NextSettings = ChatSettings;
+						NextSettings.MaxToolRoundTrips--;
+						FGenToolRegistry::Get().ExecuteToolCalls(ToolCalls,
+							[NextSettings, AssistantText, ToolCalls, ResponseCallback, CachedImages](const TArray<FGenToolResult>& Results) mutable
+							{
+								FGenToolCallCodec::AppendToolRound(NextSettings.Messages, AssistantText, ToolCalls, Results);
+								MakeRequest(NextSettings, ResponseCallback, CachedImages);
+							});
+						return;
+					}
+
+					if (MessageObject.IsValid() && MessageObject->HasField(TEXT("content")))
 					{
 						const FString Content = MessageObject->GetStringField(TEXT("content"));
 						ResponseCallback(Content, TEXT(""), true);
@@ -0,0 +1,373 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Models/OpenAI/GenOAIImage.h"
+
+#include "Http.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Async/Async.h"
+#include "Data/GenAIOrgs.h"
+#include "HAL/FileManager.h"
+#include "Misc/Base64.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/SecureHash.h"
+#include "Modules/ModuleManager.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	// Shared by the decode tasks of one request, every task writes only its own slot
+	struct FImageBatch
+	{
+		TArray<FTexturePlatformData*> PlatformData;
+		FThreadSafeCounter Remaining;
+		FCriticalSection ErrorLock;
+		FString Error;
+		double StartTime = 0.0;
+		IImageWrapperModule* ImageWrapperModule = nullptr;
+		TFunction<void(const TArray<UTexture2D*>&, const FString&, bool)> ResponseCallback;
+	};
+	using FImageBatchRef = TSharedRef<FImageBatch, ESPMode::ThreadSafe>;
+
+	FString GetCacheDirectory()
+	{
+		return FPaths::ProjectSavedDir() / TEXT("GenAI") / TEXT("ImageCache");
+	}
+
+	// Decodes PNG/JPEG into the mip of a new platform data, so the game thread only has to hand it to a texture
+	FTexturePlatformData* DecodeToPlatformData(IImageWrapperModule& ImageWrapperModule, const TArray<uint8>& CompressedData, FString& OutError)
+	{
+		const EImageFormat Format = ImageWrapperModule.DetectImageFormat(CompressedData.GetData(), CompressedData.Num());
+		const TSharedPtr<IImageWrapper> ImageWrapper = Format != EImageFormat::Invalid ? ImageWrapperModule.CreateImageWrapper(Format) : nullptr;
+		TArray64<uint8> RawData;
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(CompressedData.GetData(), CompressedData.Num()) ||
+			!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
+		{
+			OutError = TEXT("Failed to decode image");
+			return nullptr;
+		}
+
+		const int32 Width = ImageWrapper->GetWidth();
+		const int32 Height = ImageWrapper->GetHeight();
+
+		FTexturePlatformData* PlatformData = new FTexturePlatformData();
+		PlatformData->SizeX = Width;
+		PlatformData->SizeY = Height;
+		PlatformData->SetNumSlices(1);
+		PlatformData->PixelFormat = PF_B8G8R8A8;
+
+		FTexture2DMipMap* Mip = new FTexture2DMipMap();
+		Mip->SizeX = Width;
+		Mip->SizeY = Height;
+		Mip->BulkData.Lock(LOCK_READ_WRITE);
+		void* MipData = Mip->BulkData.Realloc(RawData.Num());
+		FMemory::Memcpy(MipData, RawData.GetData(), RawData.Num());
+		Mip->BulkData.Unlock();
+		PlatformData->Mips.Add(Mip);
+
+		return PlatformData;
+	}
+
+	// All or nothing: when one image failed, no textures are created and the decoded images are freed
+	void CreateTextures(const FImageBatchRef& Batch)
+	{
+		const int32 NumFailed = Batch->PlatformData.FilterByPredicate([](const FTexturePlatformData* PlatformData)
+		{
+			return PlatformData == nullptr;
+		}).Num();
+		if (NumFailed > 0)
+		{
+			for (const FTexturePlatformData* PlatformData : Batch->PlatformData)
+			{
+				delete PlatformData;
+			}
+			const FString Error = FString::Printf(TEXT("%d of %d images failed: %s"), NumFailed, Batch->PlatformData.Num(), *Batch->Error);
+			UE_LOG(LogGenAI, Error, TEXT("Image generation failed, %s"), *Error);
+			Batch->ResponseCallback(TArray<UTexture2D*>(), Error, false);
+			return;
+		}
+
+		LOG_TIME_START(TextureStartTime);
+
+		TArray<UTexture2D*> Textures;
+		for (FTexturePlatformData* PlatformData : Batch->PlatformData)
+		{
+
+			UTexture2D* Texture = NewObject<UTexture2D>(GetTransientPackage(), NAME_None, RF_Transient);
+			Texture->NeverStream = true;
+			Texture->SRGB = true;
+			Texture->SetPlatformData(PlatformData);
+			Texture->UpdateResource();
+			Textures.Add(Texture);
+		}
+
+		LOG_TIME_ELAPSED(TextureStartTime, TEXT("Creating generated image textures on the game thread"));
+		UE_LOG(LogGenPerformance, Display, TEXT("Decode to texture for %d images took: %f ms"), Textures.Num(),
+		       (FPlatformTime::Seconds() - Batch->StartTime) * 1000.0);
+
+		Batch->ResponseCallback(Textures, FString(), true);
+	}
+
+	void FinishImage(const FImageBatchRef& Batch, int32 Index, FTexturePlatformData* PlatformData, const FString& Error)
+	{
+		Batch->PlatformData[Index] = PlatformData;
+		if (!PlatformData)
+		{
+			FScopeLock Lock(&Batch->ErrorLock);
+			Batch->Error = Error;
+		}
+
+		if (Batch->Remaining.Decrement() == 0)
+		{
+			AsyncTask(ENamedThreads::GameThread, [Batch]()
+			{
+				CreateTextures(Batch);
+			});
+		}
+	}
+
+	// Runs on a worker thread, CacheFile is empty when the data came from the cache
+	void DecodeImage(const FImageBatchRef& Batch, int32 Index, const TArray<uint8>& CompressedData, const FString& CacheFile)
+	{
+		const double DecodeStartTime = FPlatformTime::Seconds();
+		if (!CacheFile.IsEmpty() && !FFileHelper::SaveArrayToFile(CompressedData, *CacheFile))
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Failed to write image cache file %s"), *CacheFile);
+		}
+
+		FString Error;
+		FTexturePlatformData* PlatformData = DecodeToPlatformData(*Batch->ImageWrapperModule, CompressedData, Error);
+		UE_LOG(LogGenPerformance, Display, TEXT("Decoding generated image %d (%d bytes) took: %f ms"), Index, CompressedData.Num(),
+		       (FPlatformTime::Seconds() - DecodeStartTime) * 1000.0);
+		FinishImage(Batch, Index, PlatformData, Error);
+	}
+
+	void DownloadImage(const FImageBatchRef& Batch, int32 Index, const FString& URL, const FString& CacheFile)
+	{
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetVerb(TEXT("GET"));
+		HttpRequest->SetURL(URL);
+		HttpRequest->OnProcessRequestComplete().BindLambda(
+			[Batch, Index, CacheFile](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+			{
+				if (!bSuccess || !Response.IsValid() || !EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+				{
+					FinishImage(Batch, Index, nullptr, TEXT("Image download failed"));
+					return;
+				}
+
+				// The response owns the downloaded bytes, decoding reads them in place on the worker
+				Async(EAsyncExecution::ThreadPool, [Batch, Index, CacheFile, Response]()
+				{
+					DecodeImage(Batch, Index, Response->GetContent(), CacheFile);
+				});
+			});
+		HttpRequest->ProcessRequest();
+	}
+
+	void ProcessResponse(const FImageBatchRef& Batch, const FHttpResponsePtr& Response, const FGenOAIImageSettings& ImageSettings)
+	{
+		const TArray<uint8>& Content = Response->GetContent();
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Content.GetData()), Content.Num());
+		const FString ResponseStr(Converted.Length(), Converted.Get());
+
+		TSharedPtr<FJsonObject> JsonObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
+		const TArray<TSharedPtr<FJsonValue>>* DataArray = nullptr;
+		if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid() ||
+			!JsonObject->TryGetArrayField(TEXT("data"), DataArray) || DataArray->Num() == 0)
+		{
+			FString Error = TEXT("Unexpected JSON structure");
+			const TSharedPtr<FJsonObject>* ErrorObject;
+			if (JsonObject.IsValid() && JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
+			{
+				(*ErrorObject)->TryGetStringField(TEXT("message"), Error);
+			}
+			UE_LOG(LogGenAI, Error, TEXT("Image generation failed: %s"), *Error);
+
+			AsyncTask(ENamedThreads::GameThread, [Batch, Error]()
+			{
+				Batch->ResponseCallback(TArray<UTexture2D*>(), Error, false);
+			});
+			return;
+		}
+
+		Batch->PlatformData.SetNumZeroed(DataArray->Num());
+		Batch->Remaining.Set(DataArray->Num());
+		for (int32 Index = 0; Index < DataArray->Num(); ++Index)
+		{
+			const FString CacheFile = ImageSettings.bUseCache ? UGenOAIImage::GetCacheFilePath(ImageSettings, Index) : FString();
+			const TSharedPtr<FJsonObject> ImageObject = (*DataArray)[Index]->AsObject();
+
+			FString Base64Data;
+			FString URL;
+			if (ImageObject.IsValid() && ImageObject->TryGetStringField(TEXT("b64_json"), Base64Data))
+			{
+				Async(EAsyncExecution::ThreadPool, [Batch, Index, Base64Data = MoveTemp(Base64Data), CacheFile]()
+				{
+					TArray<uint8> CompressedData;
+					if (!FBase64::Decode(Base64Data, CompressedData))
+					{
+						FinishImage(Batch, Index, nullptr, TEXT("Invalid base64 image data"));
+						return;
+					}
+					DecodeImage(Batch, Index, CompressedData, CacheFile);
+				});
+			}
+			else if (ImageObject.IsValid() && ImageObject->TryGetStringField(TEXT("url"), URL))
+			{
+				AsyncTask(ENamedThreads::GameThread, [Batch, Index, URL, CacheFile]()
+				{
+					DownloadImage(Batch, Index, URL, CacheFile);
+				});
+			}
+			else
+			{
+				FinishImage(Batch, Index, nullptr, TEXT("Image entry has no data"));
+			}
+		}
+	}
+}
+
+void UGenOAIImage::RequestImages(const FGenOAIImageSettings& ImageSettings, const FOnImageGenerationResponse& OnComplete)
+{
+	MakeRequest(ImageSettings, [OnComplete](const TArray<UTexture2D*>& Textures, const FString& Error, bool Success)
+	{
+		if (OnComplete.IsBound())
+		{
+			OnComplete.Execute(Textures, Error, Success);
+		}
+	});
+}
+
+UGenOAIImage* UGenOAIImage::RequestOpenAIImage(UObject* WorldContextObject, const FGenOAIImageSettings& ImageSettings)
+{
+	UGenOAIImage* AsyncAction = NewObject<UGenOAIImage>();
+	AsyncAction->ImageSettings = ImageSettings;
+	return AsyncAction;
+}
+
+void UGenOAIImage::Activate()
+{
+	MakeRequest(ImageSettings, [this](const TArray<UTexture2D*>& Textures, const FString& Error, bool Success)
+	{
+		OnComplete.Broadcast(Textures, Error, Success);
+		Cancel();
+	});
+}
+
+FString UGenOAIImage::GetCacheFilePath(const FGenOAIImageSettings& ImageSettings, int32 ImageIndex)
+{
+	const FString CacheKey = FString::Printf(TEXT("%s|%s|%s|%d|%s"), *ImageSettings.Model, *ImageSettings.Size,
+	                                         *ImageSettings.Quality, ImageSettings.NumImages, *ImageSettings.Prompt);
+	// Hashed as UTF-8, prompts that only differ in non-ASCII characters get their own entries
+	const FTCHARToUTF8 CacheKeyUtf8(*CacheKey);
+	const FString Hash = FMD5::HashBytes(reinterpret_cast<const uint8*>(CacheKeyUtf8.Get()), CacheKeyUtf8.Length());
+	return GetCacheDirectory() / FString::Printf(TEXT("%s_%d.img"), *Hash, ImageIndex);
+}
+
+void UGenOAIImage::ClearImageCache()
+{
+	IFileManager::Get().DeleteDirectory(*GetCacheDirectory(), false, true);
+}
+
+void UGenOAIImage::MakeRequest(const FGenOAIImageSettings& ImageSettings,
+                               const TFunction<void(const TArray<UTexture2D*>&, const FString&, bool)>& ResponseCallback)
+{
+	const FImageBatchRef Batch = MakeShared<FImageBatch, ESPMode::ThreadSafe>();
+	Batch->ResponseCallback = ResponseCallback;
+	// Module loading is only allowed on the game thread
+	Batch->ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	const int32 NumImages = FMath::Max(1, ImageSettings.NumImages);
+	if (ImageSettings.bUseCache)
+	{
+		TArray<FString> CacheFiles;
+		for (int32 Index = 0; Index < NumImages; ++Index)
+		{
+			CacheFiles.Add(GetCacheFilePath(ImageSettings, Index));
+		}
+
+		if (!CacheFiles.ContainsByPredicate([](const FString& File) { return !FPaths::FileExists(File); }))
+		{
+			UE_LOG(LogGenAI, Log, TEXT("Using %d cached images for prompt: %s"), NumImages, *ImageSettings.Prompt);
+			Batch->StartTime = FPlatformTime::Seconds();
+			Batch->PlatformData.SetNumZeroed(NumImages);
+			Batch->Remaining.Set(NumImages);
+			for (int32 Index = 0; Index < NumImages; ++Index)
+			{
+				Async(EAsyncExecution::ThreadPool, [Batch, Index, CacheFile = CacheFiles[Index]]()
+				{
+					TArray<uint8> CompressedData;
+					if (!FFileHelper::LoadFileToArray(CompressedData, *CacheFile))
+					{
+						FinishImage(Batch, Index, nullptr, TEXT("Failed to read cached image"));
+						return;
+					}
+					DecodeImage(Batch, Index, CompressedData, FString());
+				});
+			}
+			return;
+		}
+	}
+
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty() && ImageSettings.EndpointOverride.IsEmpty())
+	{
+		ResponseCallback(TArray<UTexture2D*>(), TEXT("API key not set"), false);
+		return;
+	}
+
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+	JsonPayload->SetStringField(TEXT("model"), ImageSettings.Model);
+	JsonPayload->SetStringField(TEXT("prompt"), ImageSettings.Prompt);
+	JsonPayload->SetStringField(TEXT("size"), ImageSettings.Size);
+	JsonPayload->SetNumberField(TEXT("n"), NumImages);
+	if (!ImageSettings.Quality.IsEmpty())
+	{
+		JsonPayload->SetStringField(TEXT("quality"), ImageSettings.Quality);
+	}
+	// gpt-image-1 always returns base64, dall-e models return URLs unless asked otherwise
+	if (ImageSettings.Model.StartsWith(TEXT("dall-e")))
+	{
+		JsonPayload->SetStringField(TEXT("response_format"), TEXT("b64_json"));
+	}
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(ImageSettings.EndpointOverride.IsEmpty() ? TEXT("https://api.openai.com/v1/images/generations") : *ImageSettings.EndpointOverride);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContentAsString(PayloadString);
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[Batch, ImageSettings](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Image request failed, Response code: %d"),
+				       Response.IsValid() ? Response->GetResponseCode() : -1);
+				Batch->ResponseCallback(TArray<UTexture2D*>(), TEXT("Request failed"), false);
+				return;
+			}
+
+			// The base64 payload of several megabytes is parsed and decoded off the game thread
+			Batch->StartTime = FPlatformTime::Seconds();
+			Async(EAsyncExecution::ThreadPool, [Batch, Response, ImageSettings]()
+			{
+				ProcessResponse(Batch, Response, ImageSettings);
+			});
+		});
+
+	HttpRequest->ProcessRequest();
+}
@@ -0,0 +1,197 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Models/OpenAI/GenOAISpeech.h"
+
+#include "Http.h"
+#include "Data/GenAIOrgs.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenHttpStream.h"
+
+USoundWaveProcedural* UGenOAISpeech::RequestSpeech(const FGenOAISpeechSettings& SpeechSettings, const FOnSpeechStarted& OnStarted,
+                                                   const FOnSpeechResponse& OnComplete)
+{
+	USoundWaveProcedural* Sound = CreateSoundWave();
+
+	// Kept alive until the stream ends, afterwards the caller owns it
+	Sound->AddToRoot();
+	MakeRequest(SpeechSettings, Sound,
+	            [OnStarted, Sound]()
+	            {
+		            OnStarted.ExecuteIfBound(Sound);
+	            },
+	            [OnComplete, Sound](const FString& Error, bool Success)
+	            {
+		            Sound->RemoveFromRoot();
+		            if (OnComplete.IsBound())
+		            {
+			            OnComplete.Execute(Sound, Error, Success);
+		            }
+	            });
+	return Sound;
+}
+
+UGenOAISpeech* UGenOAISpeech::RequestOpenAISpeech(UObject* WorldContextObject, const FGenOAISpeechSettings& SpeechSettings)
+{
+	UGenOAISpeech* AsyncAction = NewObject<UGenOAISpeech>();
+	AsyncAction->SpeechSettings = SpeechSettings;
+	return AsyncAction;
+}
+
+void UGenOAISpeech::Activate()
+{
+	SoundWave = CreateSoundWave();
+	MakeRequest(SpeechSettings, SoundWave,
+	            [this]()
+	            {
+		            OnStarted.Broadcast(SoundWave);
+	            },
+	            [this](const FString& Error, bool Success)
+	            {
+		            OnComplete.Broadcast(SoundWave, Error, Success);
+		            Cancel();
+	            });
+}
+
+USoundWaveProcedural* UGenOAISpeech::CreateSoundWave()
+{
+	USoundWaveProcedural* Sound = NewObject<USoundWaveProcedural>();
+	Sound->SetSampleRate(SampleRate);
+	Sound->NumChannels = 1;
+	Sound->Duration = INDEFINITELY_LOOPING_DURATION;
+	Sound->SoundGroup = SOUNDGROUP_Voice;
+	Sound->bLooping = false;
+	return Sound;
+}
+
+void UGenOAISpeech::MakeRequest(const FGenOAISpeechSettings& SpeechSettings, USoundWaveProcedural* SoundWave,
+                                const TFunction<void()>& StartedCallback, const TFunction<void(const FString&, bool)>& ResponseCallback)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty() && SpeechSettings.EndpointOverride.IsEmpty())
+	{
+		ResponseCallback(TEXT("API key not set"), false);
+		return;
+	}
+
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+	JsonPayload->SetStringField(TEXT("model"), SpeechSettings.Model);
+	JsonPayload->SetStringField(TEXT("input"), SpeechSettings.Input);
+	JsonPayload->SetStringField(TEXT("voice"), SpeechSettings.Voice);
+	JsonPayload->SetStringField(TEXT("response_format"), TEXT("pcm"));
+	JsonPayload->SetNumberField(TEXT("speed"), SpeechSettings.Speed);
+	if (!SpeechSettings.Instructions.IsEmpty())
+	{
+		JsonPayload->SetStringField(TEXT("instructions"), SpeechSettings.Instructions);
+	}
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(SpeechSettings.EndpointOverride.IsEmpty() ? TEXT("https://api.openai.com/v1/audio/speech") : *SpeechSettings.EndpointOverride);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContentAsString(PayloadString);
+
+	struct FStreamState
+	{
+		double StartTime = 0.0;
+		int64 NumQueuedBytes = 0;
+		uint8 PendingByte = 0;
+		bool bHasPendingByte = false;
+		bool bStarted = false;
+		bool bFailed = false;
+	};
+	const TSharedRef<FStreamState, ESPMode::ThreadSafe> State = MakeShared<FStreamState, ESPMode::ThreadSafe>();
+	State->StartTime = FPlatformTime::Seconds();
+
+	const TWeakObjectPtr<USoundWaveProcedural> WeakSound(SoundWave);
+	const TWeakPtr<IHttpRequest, ESPMode::ThreadSafe> WeakRequest(HttpRequest);
+	const TSharedRef<FGenHttpStreamReader, ESPMode::ThreadSafe> StreamReader = FGenHttpStreamReader::Bind(
+		HttpRequest, [State, WeakSound, WeakRequest, StartedCallback](const uint8* Data, int32 Num)
+		{
+			USoundWaveProcedural* Sound = WeakSound.Get();
+			if (!Sound || State->bFailed || Num <= 0)
+			{
+				return;
+			}
+
+			// Error responses are JSON, they must not end up in the audio
+			if (!State->bStarted)
+			{
+				const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> Request = WeakRequest.Pin();
+				const FHttpResponsePtr Response = Request.IsValid() ? Request->GetResponse() : nullptr;
+				if (Response.IsValid() && Response->GetResponseCode() >= 400)
+				{
+					State->bFailed = true;
+					return;
+				}
+			}
+
+			// QueueAudio takes whole 16 bit samples, an odd trailing byte waits for the next chunk
+			if (State->bHasPendingByte)
+			{
+				const uint8 Sample[2] = {State->PendingByte, Data[0]};
+				Sound->QueueAudio(Sample, 2);
+				State->bHasPendingByte = false;
+				++Data;
+				--Num;
+			}
+			if (Num % 2 != 0)
+			{
+				State->PendingByte = Data[Num - 1];
+				State->bHasPendingByte = true;
+				--Num;
+			}
+			if (Num > 0)
+			{
+				Sound->QueueAudio(Data, Num);
+				State->NumQueuedBytes += Num;
+			}
+
+			if (!State->bStarted)
+			{
+				State->bStarted = true;
+				UE_LOG(LogGenPerformance, Display, TEXT("Time to first speech audio: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+				StartedCallback();
+			}
+		});
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[State, StreamReader, StartedCallback, ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Speech request failed, Response code: %d"), Response.IsValid() ? Response->GetResponseCode() : -1);
+				ResponseCallback(TEXT("Request failed"), false);
+				return;
+			}
+
+			if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				const FString ErrorBody = StreamReader->GetBodyPrefix(Response);
+				UE_LOG(LogGenAI, Error, TEXT("Speech request failed, Response code: %d, %s"), Response->GetResponseCode(), *ErrorBody);
+				ResponseCallback(ErrorBody, false);
+				return;
+			}
+
+			StreamReader->Flush(Response);
+			UE_LOG(LogGenPerformance, Display, TEXT("Speech stream of %.2f s audio took: %f ms"),
+			       State->NumQueuedBytes / static_cast<double>(SampleRate * sizeof(int16)), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+
+			// Short clips may arrive in a single chunk without any progress update
+			if (!State->bStarted)
+			{
+				StartedCallback();
+			}
+			ResponseCallback(TEXT(""), true);
+		});
+
+	HttpRequest->ProcessRequest();
+}
@@ -4,10 +4,16 @@
 #include "Models/OpenAI/GenOAIStructuredOpService.h"
 
 #include "Http.h"
+#include "Async/Async.h"
 #include "Data/GenAIOrgs.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Engine/Engine.h" // For GEngine logging
 #include "Secure/GenSecureKey.h"
+#include "Serialize/GenJsonSchemaBuilder.h"
+#include "Serialize/GenJsonStreamParser.h"
+#include "Serialize/GenJsonStructReader.h"
+#include "Serialize/GenSSEParser.h"
+#include "Utilities/GenHttpStream.h"
 #include "Utilities/GenGlobalDefinitions.h"
 
 void UGenOAIStructuredOpService::RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete)
@@ -23,6 +29,81 @@ void UGenOAIStructuredOpService::RequestStructuredOutput(const FGenOAIStructured
     );
 }
 
+void UGenOAIStructuredOpService::RequestStructuredOutputTyped(const FGenOAIStructuredChatSettings& StructuredChatSettings, const UScriptStruct* ResponseStruct, const FOnTypedSchemaResponse& OnComplete)
+{
+    if (!ResponseStruct)
+    {
+        OnComplete.ExecuteIfBound(nullptr, TEXT("No response struct given"), false);
+        return;
+    }
+
+    const TSharedPtr<FJsonObject> SchemaObject = FGenJsonSchemaBuilder::BuildStructSchema(ResponseStruct);
+    if (!SchemaObject.IsValid())
+    {
+        OnComplete.ExecuteIfBound(nullptr, FString::Printf(TEXT("%s can not be used as a structured output, it must only hold plain data"),
+                                                           *ResponseStruct->GetName()), false);
+        return;
+    }
+
+    FGenOAIStructuredChatSettings TypedSettings = StructuredChatSettings;
+    if (TypedSettings.Name.IsEmpty())
+    {
+        TypedSettings.Name = ResponseStruct->GetName();
+    }
+
+    FString Error;
+    const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateHttpRequest(TypedSettings, SchemaObject, Error);
+    if (!HttpRequest.IsValid())
+    {
+        OnComplete.ExecuteIfBound(nullptr, Error, false);
+        return;
+    }
+
+    HttpRequest->OnProcessRequestComplete().BindLambda([ResponseStruct, OnComplete](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess) {
+        UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+        if (!bSuccess || !Response.IsValid())
+        {
+            UE_LOG(LogGenAI, Error, TEXT("Request failed, check your internet connection."));
+            OnComplete.ExecuteIfBound(nullptr, TEXT("Request failed"), false);
+            return;
+        }
+
+        // Decode off the game thread, safe because the schema builder only accepts plain data structs
+        AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [ResponseStruct, OnComplete, Response]()
+        {
+            LOG_TIME_START(DecodeStart);
+
+            FString DecodeError;
+            const TSharedPtr<FStructOnScope> Result = DecodeTypedResponse(Response->GetContentAsString(), ResponseStruct, DecodeError);
+
+            LOG_TIME_ELAPSED(DecodeStart, TEXT("Structured output typed decode"));
+
+            AsyncTask(ENamedThreads::GameThread, [OnComplete, Result, DecodeError]()
+            {
+                OnComplete.ExecuteIfBound(Result, DecodeError, Result.IsValid());
+            });
+        });
+    });
+
+    HttpRequest->ProcessRequest();
+}
+
+void UGenOAIStructuredOpService::RequestStructuredOutputStream(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaStreamElement& OnElement, const FOnSchemaResponse& OnComplete)
+{
+    MakeStreamRequest(
+        StructuredChatSettings,
+        [OnElement](const FString& Key, int32 Index, const FString& ElementJson) {
+            OnElement.ExecuteIfBound(Key, Index, ElementJson);
+        },
+        [OnComplete](const FString& Response, const FString& Error, bool Success) {
+            if (OnComplete.IsBound())
+            {
+                OnComplete.Execute(Response, Error, Success);
+            }
+        }
+    );
+}
+
 UGenOAIStructuredOpService* UGenOAIStructuredOpService::RequestOpenAIStructuredOutput(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings)
 {
     UGenOAIStructuredOpService* AsyncAction = NewObject<UGenOAIStructuredOpService>();
@@ -30,6 +111,27 @@ UGenOAIStructuredOpService* UGenOAIStructuredOpService::RequestOpenAIStructuredO
     return AsyncAction;
 }
 
+UGenOAIStructuredStreamOpService* UGenOAIStructuredStreamOpService::RequestOpenAIStructuredOutputStream(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings)
+{
+    UGenOAIStructuredStreamOpService* AsyncAction = NewObject<UGenOAIStructuredStreamOpService>();
+    AsyncAction->StructuredChatSettings = StructuredChatSettings;
+    return AsyncAction;
+}
+
+void UGenOAIStructuredStreamOpService::Activate()
+{
+    MakeStreamRequest(
+        StructuredChatSettings,
+        [this](const FString& Key, int32 Index, const FString& ElementJson) {
+            OnElement.Broadcast(Key, Index, ElementJson);
+        },
+        [this](const FString& Response, const FString& Error, bool Success) {
+            OnComplete.Broadcast(Response, Error, Success);
+            Cancel();
+        }
+    );
+}
+
 void UGenOAIStructuredOpService::Activate()
 {
     MakeRequest(
@@ -42,13 +144,147 @@ void UGenOAIStructuredOpService::Activate()
 }
 
 void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+    FString Error;
+    const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateHttpRequest(StructuredChatSettings, nullptr, Error);
+    if (!HttpRequest.IsValid())
+    {
+        ResponseCallback(TEXT(""), Error, false);
+        return;
+    }
+
+    HttpRequest->OnProcessRequestComplete().BindLambda([ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess) {
+        UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+        if (!bSuccess || !Response.IsValid())
+        {
+            ResponseCallback(TEXT(""), TEXT("Request failed"), false);
+            UE_LOG(LogGenAI, Error, TEXT("Request failed, check your internet connection."));
+            return;
+        }
+        ProcessResponse(Response->GetContentAsString(), ResponseCallback);
+    });
+
+    HttpRequest->ProcessRequest();
+}
+
+void UGenOAIStructuredOpService::MakeStreamRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, int32, const FString&)>& ElementCallback,
+                                                   const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+    FString Error;
+    const TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = CreateHttpRequest(StructuredChatSettings, nullptr, Error, true);
+    if (!HttpRequest.IsValid())
+    {
+        ResponseCallback(TEXT(""), Error, false);
+        return;
+    }
+
+    // Shared between the progress and completion callbacks, so parsing resumes where the last chunk ended
+    struct FStreamState
+    {
+        FStreamState(const FGenJsonStreamParser::FOnElement& InOnElement, TArray<FString> ElementPath) : JsonParser(InOnElement, MoveTemp(ElementPath)) {}
+
+        FGenSSEParser SSEParser;
+        FGenJsonStreamParser JsonParser;
+        FString Content;
+        FString Refusal;
+    };
+    TArray<FString> ElementPath;
+    StructuredChatSettings.StreamElementPath.ParseIntoArray(ElementPath, TEXT("."));
+    const TSharedRef<FStreamState, ESPMode::ThreadSafe> State = MakeShared<FStreamState, ESPMode::ThreadSafe>(ElementCallback, MoveTemp(ElementPath));
+
+    auto HandleEvent = [State](const FString& EventName, const FString& Data)
+    {
+        if (Data == TEXT("[DONE]"))
+        {
+            return;
+        }
+
+        TSharedPtr<FJsonObject> ChunkObject;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+        if (!FJsonSerializer::Deserialize(Reader, ChunkObject) || !ChunkObject.IsValid())
+        {
+            UE_LOG(LogGenAI, Warning, TEXT("Failed to parse stream chunk: %s"), *Data);
+            return;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Choices;
+        if (!ChunkObject->TryGetArrayField(TEXT("choices"), Choices) || Choices->Num() == 0)
+        {
+            return;
+        }
+
+        const TSharedPtr<FJsonObject>* Delta;
+        const TSharedPtr<FJsonObject> FirstChoice = (*Choices)[0]->AsObject();
+        if (FirstChoice.IsValid() && FirstChoice->TryGetObjectField(TEXT("delta"), Delta))
+        {
+            FString Text;
+            if ((*Delta)->TryGetStringField(TEXT("content"), Text))
+            {
+                State->Content.Append(Text);
+                State->JsonParser.Feed(Text);
+            }
+            if ((*Delta)->TryGetStringField(TEXT("refusal"), Text))
+            {
+                State->Refusal.Append(Text);
+            }
+        }
+    };
+
+    const TSharedRef<FGenHttpStreamReader, ESPMode::ThreadSafe> StreamReader = FGenHttpStreamReader::Bind(
+        HttpRequest.ToSharedRef(), [State, HandleEvent](const uint8* Data, int32 Num)
+        {
+            State->SSEParser.Feed(Data, Num, HandleEvent);
+        });
+
+    HttpRequest->OnProcessRequestComplete().BindLambda(
+        [State, StreamReader, HandleEvent, ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess) {
+            UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+            if (!bSuccess || !Response.IsValid())
+            {
+                ResponseCallback(TEXT(""), TEXT("Request failed"), false);
+                UE_LOG(LogGenAI, Error, TEXT("Request failed, check your internet connection."));
+                return;
+            }
+
+            if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+            {
+                // Errors are returned as a regular JSON body instead of an event stream
+                const FString ErrorBody = StreamReader->GetBodyPrefix(Response);
+                UE_LOG(LogGenAI, Error, TEXT("Streamed request failed, Response code: %d, %s"), Response->GetResponseCode(), *ErrorBody);
+                ResponseCallback(TEXT(""), ErrorBody, false);
+                return;
+            }
+
+            StreamReader->Flush(Response);
+            State->SSEParser.Flush(HandleEvent);
+
+            if (!State->Refusal.IsEmpty())
+            {
+                ResponseCallback(TEXT(""), State->Refusal, false);
+                return;
+            }
+            if (!State->JsonParser.IsComplete())
+            {
+                UE_LOG(LogGenAI, Warning, TEXT("Structured output stream ended before the JSON document was complete"));
+                ResponseCallback(State->Content, TEXT("Incomplete JSON document"), false);
+                return;
+            }
+            ResponseCallback(State->Content, TEXT(""), true);
+        });
+
+    HttpRequest->ProcessRequest();
+}
+
+TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> UGenOAIStructuredOpService::CreateHttpRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings,
+                                                                                          const TSharedPtr<FJsonObject>& SchemaObject, FString& OutError,
+                                                                                          bool bStream)
 {
     FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
     if (ApiKey.IsEmpty())
     {
-        ResponseCallback(TEXT(""), TEXT("API key not set"), false);
+        OutError = TEXT("API key not set");
         UE_LOG(LogGenAI, Error, TEXT("API key not set"));
-        return;
+        return nullptr;
     }
 
     // Create JSON payload
@@ -59,23 +295,37 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
     TSharedPtr<FJsonObject> ResponseFormat = MakeShareable(new FJsonObject());
     ResponseFormat->SetStringField(TEXT("type"), TEXT("json_schema"));
 
-    // Nested object for the actual schema
-    TSharedPtr<FJsonObject> SchemaObject = MakeShareable(new FJsonObject());
     // Create a root object for the json_schema
     TSharedPtr<FJsonObject> RootSchemaObject = MakeShareable(new FJsonObject());
     RootSchemaObject->SetStringField(TEXT("name"), StructuredChatSettings.Name);
-    
-    TSharedRef<TJsonReader<>> SchemaReader = TJsonReaderFactory<>::Create(StructuredChatSettings.SchemaJson);
-    if (!FJsonSerializer::Deserialize(SchemaReader, SchemaObject) || !SchemaObject.IsValid())
+
+    if (SchemaObject.IsValid())
     {
-        UE_LOG(LogGenAI, Error, TEXT("Failed to parse schema JSON: %s"), *StructuredChatSettings.SchemaJson);
-        return;
+        // Generated schemas follow the strict mode rules, so let the API enforce them
+        RootSchemaObject->SetObjectField(TEXT("schema"), SchemaObject);
+        RootSchemaObject->SetBoolField(TEXT("strict"), true);
+    }
+    else
+    {
+        // Nested object for the actual schema
+        TSharedPtr<FJsonObject> ParsedSchemaObject = MakeShareable(new FJsonObject());
+        TSharedRef<TJsonReader<>> SchemaReader = TJsonReaderFactory<>::Create(StructuredChatSettings.SchemaJson);
+        if (!FJsonSerializer::Deserialize(SchemaReader, ParsedSchemaObject) || !ParsedSchemaObject.IsValid())
+        {
+            UE_LOG(LogGenAI, Error, TEXT("Failed to parse schema JSON: %s"), *StructuredChatSettings.SchemaJson);
+            OutError = TEXT("Failed to parse schema JSON");
+            return nullptr;
+        }
+        RootSchemaObject->SetObjectField(TEXT("schema"), ParsedSchemaObject);
     }
-    RootSchemaObject->SetObjectField(TEXT("schema"), SchemaObject);
 
     ResponseFormat->SetObjectField(TEXT("json_schema"), RootSchemaObject);
     JsonPayload->SetObjectField(TEXT("response_format"), ResponseFormat);
     JsonPayload->SetNumberField(TEXT("max_completion_tokens"), StructuredChatSettings.ChatSettings.MaxTokens);
+    if (bStream)
+    {
+        JsonPayload->SetBoolField(TEXT("stream"), true);
+    }
     //set messages field, and append "Generate Response in JSON only." to the prompt
     TArray<TSharedPtr<FJsonValue>> MessagesArray;
     for (const FGenChatMessage& Message : StructuredChatSettings.ChatSettings.Messages)
@@ -90,7 +340,7 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
             // todo, we can move this outside this scope, but that doesnt guarantee the callee will append the message
             JsonMessage->SetStringField(TEXT("content"), Message.Content + TEXT(" Generate Response in JSON only. Use proper JSON formatting and avoid introducing line breaks inside string values."));
         }
-        
+
         MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
     }
     JsonPayload->SetArrayField(TEXT("messages"), MessagesArray);
@@ -106,30 +356,57 @@ void UGenOAIStructuredOpService::MakeRequest(const FGenOAIStructuredChatSettings
     HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
     HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
     HttpRequest->SetContentAsString(PayloadString);
-    
-	//UE_LOG(LogGenAIVerbose, Log, TEXT("Sending chat request... Payload: %s"), *PayloadString);
 
-    HttpRequest->OnProcessRequestComplete().BindLambda([ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess) {
-        if (!bSuccess || !Response.IsValid())
-        {
-            ResponseCallback(TEXT(""), TEXT("Request failed"), false);
-            UE_LOG(LogGenAI, Error, TEXT("Request failed, check your internet connection."));
-            return;
-        }
-        ProcessResponse(Response->GetContentAsString(), ResponseCallback);
-    });
+	//UE_LOG(LogGenAIVerbose, Log, TEXT("Sending chat request... Payload: %s"), *PayloadString);
 
-    HttpRequest->ProcessRequest();
+    return HttpRequest;
 }
 
 
 /**
  * \brief this function's rules are set according to the openAI refusal and content documentation for structured chat
  * link: https://platform.openai.com/docs/guides/structured-outputs?lang=python&context=ex4#json-mode
- * \param ResponseStr 
- * \param ResponseCallback 
+ * \param ResponseStr
+ * \param ResponseCallback
  */
 void UGenOAIStructuredOpService::ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+    FString Content;
+    FString Error;
+    if (ExtractMessageContent(ResponseStr, Content, Error))
+    {
+        ResponseCallback(Content, TEXT(""), true);
+        //UE_LOG(LogGenAIVerbose, Log, TEXT("Chat response: %s"), *Content);
+        return;
+    }
+    ResponseCallback(TEXT(""), Error, false);
+}
+
+TSharedPtr<FStructOnScope> UGenOAIStructuredOpService::DecodeTypedResponse(const FString& ResponseStr, const UScriptStruct* ResponseStruct, FString& OutError)
+{
+    // The envelope is only scanned up to the content string, no JSON object tree is built for it or the content
+    FString Content;
+    if (!FGenJsonStructReader::FindString(ResponseStr, {TEXT("choices"), TEXT("0"), TEXT("message"), TEXT("content")}, Content))
+    {
+        if (!FGenJsonStructReader::FindString(ResponseStr, {TEXT("choices"), TEXT("0"), TEXT("message"), TEXT("refusal")}, OutError))
+        {
+            UE_LOG(LogGenAI, Error, TEXT("Unexpected JSON structure: %s"), *ResponseStr);
+            OutError = TEXT("Unexpected JSON structure");
+        }
+        return nullptr;
+    }
+
+    TSharedPtr<FStructOnScope> Result = MakeShared<FStructOnScope>(ResponseStruct);
+    FString ReadError;
+    if (!FGenJsonStructReader::ReadStruct(Content, ResponseStruct, Result->GetStructMemory(), ReadError))
+    {
+        OutError = FString::Printf(TEXT("Failed to convert response into %s: %s"), *ResponseStruct->GetName(), *ReadError);
+        return nullptr;
+    }
+    return Result;
+}
+
+bool UGenOAIStructuredOpService::ExtractMessageContent(const FString& ResponseStr, FString& OutContent, FString& OutError)
 {
     TSharedPtr<FJsonObject> JsonObject;
     TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
@@ -144,19 +421,15 @@ void UGenOAIStructuredOpService::ProcessResponse(const FString& ResponseStr, con
                 {
                     if (const TSharedPtr<FJsonObject> MessageObject = FirstChoice->GetObjectField(TEXT("message")); MessageObject.IsValid())
                     {
-                        if (MessageObject->HasField(TEXT("content")))
+                        // content is null when the model refuses, so only accept it as a string
+                        if (MessageObject->TryGetStringField(TEXT("content"), OutContent))
                         {
-                            FString Content = MessageObject->GetStringField(TEXT("content"));
-                            ResponseCallback(Content, TEXT(""), true);
-						    //UE_LOG(LogGenAIVerbose, Log, TEXT("Chat response: %s"), *Content);
-                            return;
+                            return true;
                         }
-                        else if (MessageObject->HasField(TEXT("refusal")))
+                        else if (MessageObject->TryGetStringField(TEXT("refusal"), OutError))
                         {
-                            const FString Refusal = MessageObject->GetStringField(TEXT("refusal"));
-                            ResponseCallback(TEXT(""), Refusal, false);
-						    //UE_LOG(LogGenAIVerbose, Log, TEXT("Chat response: %s"), *Refusal);
-                            return;
+						    //UE_LOG(LogGenAIVerbose, Log, TEXT("Chat response: %s"), *OutError);
+                            return false;
                         }
                     }
                 }
@@ -165,15 +438,12 @@ void UGenOAIStructuredOpService::ProcessResponse(const FString& ResponseStr, con
 
         // Log unexpected JSON structure
         UE_LOG(LogGenAI, Error, TEXT("Unexpected JSON structure: %s"), *ResponseStr);
-        ResponseCallback(TEXT(""), TEXT("Unexpected JSON structure"), false);
-    }
-    else
-    {
-        // Log JSON parsing failure
-        UE_LOG(LogGenAI, Error, TEXT("Failed to parse JSON: %s"), *ResponseStr);
-        ResponseCallback(TEXT(""), TEXT("Failed to parse JSON"), false);
+        OutError = TEXT("Unexpected JSON structure");
+        return false;
     }
-}
-
-
 
+    // Log JSON parsing failure
+    UE_LOG(LogGenAI, Error, TEXT("Failed to parse JSON: %s"), *ResponseStr);
+    OutError = TEXT("Failed to parse JSON");
+    return false;
+}
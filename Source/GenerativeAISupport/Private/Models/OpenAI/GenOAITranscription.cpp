@@ -0,0 +1,210 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Models/OpenAI/GenOAITranscription.h"
+
+#include "Http.h"
+#include "Data/GenAIOrgs.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	constexpr int32 WavHeaderSize = 44;
+
+	void AppendString(TArray<uint8>& Body, const FString& String)
+	{
+		const FTCHARToUTF8 Converted(*String);
+		Body.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	void AppendFormField(TArray<uint8>& Body, const FString& Boundary, const TCHAR* Name, const FString& Value)
+	{
+		AppendString(Body, FString::Printf(TEXT("--%s\r\nContent-Disposition: form-data; name=\"%s\"\r\n\r\n%s\r\n"), *Boundary, Name, *Value));
+	}
+
+	void WriteUInt32(uint8* Dest, uint32 Value)
+	{
+		Dest[0] = Value & 0xFF;
+		Dest[1] = (Value >> 8) & 0xFF;
+		Dest[2] = (Value >> 16) & 0xFF;
+		Dest[3] = (Value >> 24) & 0xFF;
+	}
+
+	void WriteUInt16(uint8* Dest, uint16 Value)
+	{
+		Dest[0] = Value & 0xFF;
+		Dest[1] = (Value >> 8) & 0xFF;
+	}
+
+	void WriteWavHeader(uint8* Dest, uint32 DataSize, int32 SampleRate, int32 NumChannels)
+	{
+		FMemory::Memcpy(Dest, "RIFF", 4);
+		WriteUInt32(Dest + 4, 36 + DataSize);
+		FMemory::Memcpy(Dest + 8, "WAVEfmt ", 8);
+		WriteUInt32(Dest + 16, 16);
+		WriteUInt16(Dest + 20, 1); // PCM
+		WriteUInt16(Dest + 22, NumChannels);
+		WriteUInt32(Dest + 24, SampleRate);
+		WriteUInt32(Dest + 28, SampleRate * NumChannels * sizeof(int16));
+		WriteUInt16(Dest + 32, NumChannels * sizeof(int16));
+		WriteUInt16(Dest + 34, 16);
+		FMemory::Memcpy(Dest + 36, "data", 4);
+		WriteUInt32(Dest + 40, DataSize);
+	}
+}
+
+FGenOAIBufferedTranscription::FGenOAIBufferedTranscription(const FGenOAITranscriptionSettings& InSettings)
+	: Settings(InSettings)
+	, Boundary(FString::Printf(TEXT("GenAIBoundary%s"), *FGuid::NewGuid().ToString(EGuidFormats::Digits)))
+{
+	// About 30 seconds of 16 kHz mono audio, grows as needed
+	Body.Reserve(1024 * 1024);
+
+	AppendFormField(Body, Boundary, TEXT("model"), Settings.Model);
+	AppendFormField(Body, Boundary, TEXT("response_format"), TEXT("json"));
+	if (!Settings.Language.IsEmpty())
+	{
+		AppendFormField(Body, Boundary, TEXT("language"), Settings.Language);
+	}
+	if (!Settings.Prompt.IsEmpty())
+	{
+		AppendFormField(Body, Boundary, TEXT("prompt"), Settings.Prompt);
+	}
+	AppendString(Body, FString::Printf(
+		TEXT("--%s\r\nContent-Disposition: form-data; name=\"file\"; filename=\"audio.wav\"\r\nContent-Type: audio/wav\r\n\r\n"), *Boundary));
+
+	// Sizes are unknown until Finish
+	WavHeaderOffset = Body.AddZeroed(WavHeaderSize);
+}
+
+void FGenOAIBufferedTranscription::AppendPCM(const int16* Samples, int32 NumSamples)
+{
+	FScopeLock Lock(&BodyLock);
+	if (bFinished)
+	{
+		return;
+	}
+	Body.Append(reinterpret_cast<const uint8*>(Samples), NumSamples * sizeof(int16));
+}
+
+int32 FGenOAIBufferedTranscription::GetNumSamples() const
+{
+	FScopeLock Lock(&BodyLock);
+	return (Body.Num() - WavHeaderOffset - WavHeaderSize) / sizeof(int16);
+}
+
+void FGenOAIBufferedTranscription::Finish(const TFunction<void(const FString&, const FString&, bool)>& OnComplete)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::OpenAI);
+	if (ApiKey.IsEmpty() && Settings.EndpointOverride.IsEmpty())
+	{
+		OnComplete(TEXT(""), TEXT("API key not set"), false);
+		return;
+	}
+
+	TArray<uint8> FinalBody;
+	{
+		FScopeLock Lock(&BodyLock);
+		if (bFinished)
+		{
+			OnComplete(TEXT(""), TEXT("Transcription upload was already sent"), false);
+			return;
+		}
+		bFinished = true;
+
+		const uint32 DataSize = Body.Num() - WavHeaderOffset - WavHeaderSize;
+		WriteWavHeader(Body.GetData() + WavHeaderOffset, DataSize, Settings.SampleRate, Settings.NumChannels);
+		AppendString(Body, FString::Printf(TEXT("\r\n--%s--\r\n"), *Boundary));
+		FinalBody = MoveTemp(Body);
+	}
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(Settings.EndpointOverride.IsEmpty() ? TEXT("https://api.openai.com/v1/audio/transcriptions") : *Settings.EndpointOverride);
+	HttpRequest->SetHeader(TEXT("Content-Type"), FString::Printf(TEXT("multipart/form-data; boundary=%s"), *Boundary));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContent(MoveTemp(FinalBody));
+
+	const double UploadStartTime = FPlatformTime::Seconds();
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[OnComplete, UploadStartTime](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::OpenAI, Request, Response);
+			UE_LOG(LogGenPerformance, Display, TEXT("Transcription request took: %f ms"), (FPlatformTime::Seconds() - UploadStartTime) * 1000.0);
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Transcription request failed, Response code: %d"),
+				       Response.IsValid() ? Response->GetResponseCode() : -1);
+				OnComplete(TEXT(""), TEXT("Request failed"), false);
+				return;
+			}
+
+			TSharedPtr<FJsonObject> JsonObject;
+			const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Response->GetContentAsString());
+			if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+			{
+				OnComplete(TEXT(""), TEXT("Failed to parse JSON"), false);
+				return;
+			}
+
+			FString Text;
+			if (JsonObject->TryGetStringField(TEXT("text"), Text))
+			{
+				OnComplete(Text, TEXT(""), true);
+				return;
+			}
+
+			FString Error = TEXT("Unexpected JSON structure");
+			const TSharedPtr<FJsonObject>* ErrorObject;
+			if (JsonObject->TryGetObjectField(TEXT("error"), ErrorObject))
+			{
+				(*ErrorObject)->TryGetStringField(TEXT("message"), Error);
+			}
+			OnComplete(TEXT(""), Error, false);
+		});
+
+	HttpRequest->ProcessRequest();
+}
+
+void UGenOAITranscription::RequestTranscription(const FGenOAITranscriptionSettings& TranscriptionSettings, const TArray<uint8>& PCMData,
+                                                const FOnTranscriptionResponse& OnComplete)
+{
+	const TSharedRef<FGenOAIBufferedTranscription, ESPMode::ThreadSafe> Upload = BeginBufferedTranscription(TranscriptionSettings);
+	Upload->AppendPCM(reinterpret_cast<const int16*>(PCMData.GetData()), PCMData.Num() / sizeof(int16));
+	Upload->Finish([OnComplete](const FString& Text, const FString& Error, bool Success)
+	{
+		if (OnComplete.IsBound())
+		{
+			OnComplete.Execute(Text, Error, Success);
+		}
+	});
+}
+
+TSharedRef<FGenOAIBufferedTranscription, ESPMode::ThreadSafe> UGenOAITranscription::BeginBufferedTranscription(const FGenOAITranscriptionSettings& TranscriptionSettings)
+{
+	return MakeShared<FGenOAIBufferedTranscription, ESPMode::ThreadSafe>(TranscriptionSettings);
+}
+
+UGenOAITranscription* UGenOAITranscription::RequestOpenAITranscription(UObject* WorldContextObject, const FGenOAITranscriptionSettings& TranscriptionSettings,
+                                                                       const TArray<uint8>& PCMData)
+{
+	UGenOAITranscription* AsyncAction = NewObject<UGenOAITranscription>();
+	AsyncAction->TranscriptionSettings = TranscriptionSettings;
+	AsyncAction->PCMData = PCMData;
+	return AsyncAction;
+}
+
+void UGenOAITranscription::Activate()
+{
+	const TSharedRef<FGenOAIBufferedTranscription, ESPMode::ThreadSafe> Upload = BeginBufferedTranscription(TranscriptionSettings);
+	Upload->AppendPCM(reinterpret_cast<const int16*>(PCMData.GetData()), PCMData.Num() / sizeof(int16));
+	PCMData.Empty();
+	Upload->Finish([this](const FString& Text, const FString& Error, bool Success)
+	{
+		OnComplete.Broadcast(Text, Error, Success);
+		Cancel();
+	});
+}
@@ -0,0 +1,230 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Models/XAI/GenGrokChat.h"
+
+#include "Http.h"
+#include "Data/GenAIOrgs.h"
+#include "Secure/GenSecureKey.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenSSEParser.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tools/GenToolRegistry.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenHttpStream.h"
+
+void UGenGrokChat::SendChatRequest(const FGenGrokChatSettings& ChatSettings, const FOnGrokChatCompletionResponse& OnComplete,
+                                   const FOnGrokChatDelta& OnDelta)
+{
+	MakeRequest(ChatSettings,
+	            [OnDelta](const FString& Delta)
+	            {
+		            OnDelta.ExecuteIfBound(Delta);
+	            },
+	            [OnComplete](const FString& Response, const FString& Error, bool Success)
+	            {
+		            if (OnComplete.IsBound())
+		            {
+			            OnComplete.Execute(Response, Error, Success);
+		            }
+	            });
+}
+
+UGenGrokChat* UGenGrokChat::RequestGrokChat(UObject* WorldContextObject, const FGenGrokChatSettings& ChatSettings)
+{
+	UGenGrokChat* AsyncAction = NewObject<UGenGrokChat>();
+	AsyncAction->ChatSettings = ChatSettings;
+	return AsyncAction;
+}
+
+void UGenGrokChat::Activate()
+{
+	MakeRequest(ChatSettings,
+	            [this](const FString& Delta)
+	            {
+		            OnDelta.Broadcast(Delta);
+	            },
+	            [this](const FString& Response, const FString& Error, bool Success)
+	            {
+		            OnComplete.Broadcast(Response, Error, Success);
+		            Cancel();
+	            });
+}
+
+void UGenGrokChat::MakeRequest(const FGenGrokChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+                               const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+	const FString ApiKey = UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs::XAI);
+	if (ApiKey.IsEmpty() && ChatSettings.EndpointOverride.IsEmpty())
+	{
+		ResponseCallback(TEXT(""), TEXT("xAI API key not set"), false);
+		return;
+	}
+
+	// Streamed tool calls arrive as argument fragments, the tool loop only runs on complete responses
+	if (ChatSettings.bStreamResponse && ChatSettings.Tools.Num() > 0)
+	{
+		ResponseCallback(TEXT(""), TEXT("Grok tools are not supported with bStreamResponse"), false);
+		return;
+	}
+
+	const bool bStream = ChatSettings.bStreamResponse;
+	const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+	JsonPayload->SetStringField(TEXT("model"), ChatSettings.Model);
+	JsonPayload->SetNumberField(TEXT("max_tokens"), ChatSettings.MaxTokens);
+	JsonPayload->SetNumberField(TEXT("temperature"), ChatSettings.Temperature);
+	JsonPayload->SetBoolField(TEXT("stream"), bStream);
+	JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages(ChatSettings.Messages, EGenToolFormat::OpenAI));
+	FGenToolCallCodec::WriteTools(JsonPayload, ChatSettings.Tools, ChatSettings.ToolChoice, EGenToolFormat::OpenAI);
+
+	FString PayloadString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+	FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+
+	const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+	HttpRequest->SetTimeout(180.0f);
+	HttpRequest->SetVerb(TEXT("POST"));
+	HttpRequest->SetURL(ChatSettings.EndpointOverride.IsEmpty() ? TEXT("https://api.x.ai/v1/chat/completions") : *ChatSettings.EndpointOverride);
+	HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+	HttpRequest->SetHeader(TEXT("Authorization"), FString::Printf(TEXT("Bearer %s"), *ApiKey));
+	HttpRequest->SetContentAsString(PayloadString);
+
+	// Shared between the progress and completion callbacks
+	struct FStreamState
+	{
+		FGenSSEParser SSEParser;
+		FString Content;
+		double StartTime = 0.0;
+		bool bReceivedDelta = false;
+	};
+	const TSharedRef<FStreamState, ESPMode::ThreadSafe> State = MakeShared<FStreamState, ESPMode::ThreadSafe>();
+	State->StartTime = FPlatformTime::Seconds();
+
+	auto HandleEvent = [State, DeltaCallback](const FString& EventName, const FString& Data)
+	{
+		if (Data == TEXT("[DONE]"))
+		{
+			return;
+		}
+
+		TSharedPtr<FJsonObject> ChunkObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Data);
+		if (!FJsonSerializer::Deserialize(Reader, ChunkObject) || !ChunkObject.IsValid())
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Failed to parse Grok stream chunk: %s"), *Data);
+			return;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* Choices;
+		if (!ChunkObject->TryGetArrayField(TEXT("choices"), Choices) || Choices->Num() == 0)
+		{
+			return;
+		}
+
+		const TSharedPtr<FJsonObject>* Delta;
+		const TSharedPtr<FJsonObject> FirstChoice = (*Choices)[0]->AsObject();
+		FString Text;
+		if (!FirstChoice.IsValid() || !FirstChoice->TryGetObjectField(TEXT("delta"), Delta) ||
+			!(*Delta)->TryGetStringField(TEXT("content"), Text) || Text.IsEmpty())
+		{
+			return;
+		}
+
+		if (!State->bReceivedDelta)
+		{
+			State->bReceivedDelta = true;
+			UE_LOG(LogGenPerformance, Display, TEXT("Grok time to first token: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+		}
+		State->Content.Append(Text);
+		DeltaCallback(Text);
+	};
+
+	TSharedPtr<FGenHttpStreamReader, ESPMode::ThreadSafe> StreamReader;
+	if (bStream)
+	{
+		StreamReader = FGenHttpStreamReader::Bind(HttpRequest, [State, HandleEvent](const uint8* Data, int32 Num)
+		{
+			State->SSEParser.Feed(Data, Num, HandleEvent);
+		});
+	}
+
+	HttpRequest->OnProcessRequestComplete().BindLambda(
+		[ChatSettings, State, StreamReader, HandleEvent, DeltaCallback, ResponseCallback](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs::XAI, Request, Response);
+			if (!bSuccess || !Response.IsValid())
+			{
+				UE_LOG(LogGenAI, Error, TEXT("Grok request failed, Response code: %d"), Response.IsValid() ? Response->GetResponseCode() : -1);
+				ResponseCallback(TEXT(""), TEXT("Request failed"), false);
+				return;
+			}
+
+			if (!EHttpResponseCodes::IsOk(Response->GetResponseCode()))
+			{
+				// Errors are returned as a regular JSON body, also for streamed requests
+				const FString ErrorBody = StreamReader.IsValid() ? StreamReader->GetBodyPrefix(Response) : Response->GetContentAsString();
+				UE_LOG(LogGenAI, Error, TEXT("Grok request failed, Response code: %d, %s"), Response->GetResponseCode(), *ErrorBody);
+				ResponseCallback(TEXT(""), ErrorBody, false);
+				return;
+			}
+
+			if (!StreamReader.IsValid())
+			{
+				UE_LOG(LogGenPerformance, Display, TEXT("Grok request took: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+				ProcessResponse(Response->GetContentAsString(), ChatSettings, DeltaCallback, ResponseCallback);
+				return;
+			}
+
+			StreamReader->Flush(Response);
+			State->SSEParser.Flush(HandleEvent);
+			UE_LOG(LogGenPerformance, Display, TEXT("Grok stream took: %f ms"), (FPlatformTime::Seconds() - State->StartTime) * 1000.0);
+			ResponseCallback(State->Content, TEXT(""), true);
+		});
+
+	HttpRequest->ProcessRequest();
+}
+
+void UGenGrokChat::ProcessResponse(const FString& ResponseStr, const FGenGrokChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+                                   const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback)
+{
+	TSharedPtr<FJsonObject> JsonObject;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(ResponseStr);
+	if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Choices;
+		if (JsonObject->TryGetArrayField(TEXT("choices"), Choices) && Choices->Num() > 0)
+		{
+			const TSharedPtr<FJsonObject>* Message;
+			const TSharedPtr<FJsonObject> FirstChoice = (*Choices)[0]->AsObject();
+			if (FirstChoice.IsValid() && FirstChoice->TryGetObjectField(TEXT("message"), Message))
+			{
+				FString Content;
+				(*Message)->TryGetStringField(TEXT("content"), Content);
+
+				if (TArray<FGenToolCall> ToolCalls; FGenToolCallCodec::ReadOpenAIToolCalls(*Message, ToolCalls))
+				{
+					if (ChatSettings.MaxToolRoundTrips <= 0)
+					{
+						ResponseCallback(TEXT(""), TEXT("Tool call limit reached"), false);
+						return;
+					}
+
+					FGenGrokChatSettings NextSettings = ChatSettings;
+					NextSettings.MaxToolRoundTrips--;
+					FGenToolRegistry::Get().ExecuteToolCalls(ToolCalls,
+						[NextSettings, Content, ToolCalls, DeltaCallback, ResponseCallback](const TArray<FGenToolResult>& Results) mutable
+						{
+							FGenToolCallCodec::AppendToolRound(NextSettings.Messages, Content, ToolCalls, Results);
+							MakeRequest(NextSettings, DeltaCallback, ResponseCallback);
+						});
+					return;
+				}
+
+				ResponseCallback(Content, TEXT(""), true);
+				return;
+			}
+		}
+	}
+
+	ResponseCallback(TEXT(""), TEXT("Invalid response"), false);
+}
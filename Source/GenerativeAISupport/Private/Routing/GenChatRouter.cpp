@@ -0,0 +1,210 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Routing/GenChatRouter.h"
+
+#include "Data/Anthropic/GenClaudeChatStructs.h"
+#include "Models/Anthropic/GenClaudeChat.h"
+#include "Models/DeepSeek/GenDSeekChat.h"
+#include "Models/Google/GenGeminiChat.h"
+#include "Models/OpenAI/GenOAIChat.h"
+#include "Models/XAI/GenGrokChat.h"
+#include "Routing/GenProviderHealth.h"
+#include "Secure/GenSecureKey.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenUtils.h"
+
+namespace
+{
+	// API model names of the providers that take a model enum. Kept explicit, enum display names are editor only metadata
+	const TMap<FString, EClaudeModels>& GetClaudeModels()
+	{
+		static const TMap<FString, EClaudeModels> Models = {
+			{TEXT("claude-3-7-sonnet-latest"), EClaudeModels::Claude_3_7_Sonnet},
+			{TEXT("claude-3-5-sonnet"), EClaudeModels::Claude_3_5_Sonnet},
+			{TEXT("claude-3-5-haiku-latest"), EClaudeModels::Claude_3_5_Haiku},
+			{TEXT("claude-3-opus-latest"), EClaudeModels::Claude_3_Opus},
+		};
+		return Models;
+	}
+
+	const TMap<FString, EDeepSeekModels>& GetDeepSeekModels()
+	{
+		static const TMap<FString, EDeepSeekModels> Models = {
+			{TEXT("deepseek-chat"), EDeepSeekModels::Chat},
+			{TEXT("deepseek-reasoner"), EDeepSeekModels::Reasoner},
+		};
+		return Models;
+	}
+
+	template <typename EnumType>
+	bool FindModelEnum(const TMap<FString, EnumType>& Models, const FString& Model, EnumType& OutValue)
+	{
+		if (const EnumType* Found = Models.Find(Model))
+		{
+			OutValue = *Found;
+			return true;
+		}
+		return false;
+	}
+}
+
+void UGenChatRouter::SendChatRequest(const FGenRouterSettings& RouterSettings, const FOnRoutedChatResponse& OnComplete)
+{
+	MakeRequest(RouterSettings, TSet<int32>(), 0,
+	            [OnComplete](const FString& Response, const FString& Error, bool Success, const FGenRouterCandidate& Endpoint)
+	            {
+		            if (OnComplete.IsBound())
+		            {
+			            OnComplete.Execute(Response, Error, Success, Endpoint);
+		            }
+	            });
+}
+
+UGenChatRouter* UGenChatRouter::RequestRoutedChat(UObject* WorldContextObject, const FGenRouterSettings& RouterSettings)
+{
+	UGenChatRouter* AsyncAction = NewObject<UGenChatRouter>();
+	AsyncAction->RouterSettings = RouterSettings;
+	return AsyncAction;
+}
+
+TArray<FGenEndpointHealthStats> UGenChatRouter::GetEndpointHealth()
+{
+	return FGenProviderHealth::Get().GetStats();
+}
+
+void UGenChatRouter::Activate()
+{
+	MakeRequest(RouterSettings, TSet<int32>(), 0,
+	            [this](const FString& Response, const FString& Error, bool Success, const FGenRouterCandidate& Endpoint)
+	            {
+		            OnComplete.Broadcast(Response, Error, Success, Endpoint);
+		            Cancel();
+	            });
+}
+
+void UGenChatRouter::MakeRequest(const FGenRouterSettings& RouterSettings, const TSet<int32>& TriedCandidates, int32 NumAttempts,
+                                 const TFunction<void(const FString&, const FString&, bool, const FGenRouterCandidate&)>& ResponseCallback)
+{
+	TSet<int32> Tried = TriedCandidates;
+	FString ConfigError;
+	while (true)
+	{
+		const int32 Index = FGenProviderHealth::Get().SelectCandidate(RouterSettings.Candidates, RouterSettings.MaxCostPer1KTokens, Tried);
+		if (Index == INDEX_NONE)
+		{
+			ResponseCallback(TEXT(""), ConfigError.IsEmpty() ? TEXT("No router candidate within the cost ceiling") : ConfigError, false,
+			                 FGenRouterCandidate());
+			return;
+		}
+		Tried.Add(Index);
+
+		const FGenRouterCandidate Candidate = RouterSettings.Candidates[Index];
+		const double StartTime = FPlatformTime::Seconds();
+		const bool bDispatched = Dispatch(Candidate, RouterSettings,
+			[RouterSettings, Tried, NumAttempts, Candidate, StartTime, ResponseCallback](const FString& Response, const FString& Error, bool Success)
+			{
+				const double Latency = FPlatformTime::Seconds() - StartTime;
+				FGenProviderHealth::Get().RecordResult(Candidate, Latency, Success);
+				UE_LOG(LogGenPerformance, Display, TEXT("Routed request to %s/%s took: %f ms (%s)"),
+				       *UGenUtils::GetEnumDisplayName(StaticEnum<EGenAIOrgs>(), static_cast<int32>(Candidate.Provider)), *Candidate.Model,
+				       Latency * 1000.0, Success ? TEXT("ok") : TEXT("failed"));
+
+				if (!Success && NumAttempts + 1 < RouterSettings.MaxAttempts && Tried.Num() < RouterSettings.Candidates.Num())
+				{
+					UE_LOG(LogGenAI, Warning, TEXT("Routed request to %s failed, trying the next endpoint: %s"), *Candidate.Model, *Error);
+					MakeRequest(RouterSettings, Tried, NumAttempts + 1, ResponseCallback);
+					return;
+				}
+				ResponseCallback(Response, Error, Success, Candidate);
+			}, ConfigError);
+		if (bDispatched)
+		{
+			return;
+		}
+
+		// Not the endpoint's fault, so it is skipped without touching its health
+		UE_LOG(LogGenAI, Error, TEXT("Router candidate %s is misconfigured, skipping it: %s"), *Candidate.Model, *ConfigError);
+	}
+}
+
+bool UGenChatRouter::Dispatch(const FGenRouterCandidate& Candidate, const FGenRouterSettings& RouterSettings,
+                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback, FString& OutConfigError)
+{
+	// DeepSeek has no endpoint override, the key is always needed there
+	const bool bNeedsApiKey = Candidate.EndpointOverride.IsEmpty() || Candidate.Provider == EGenAIOrgs::DeepSeek;
+	if (bNeedsApiKey && UGenSecureKey::GetGenerativeAIApiKey(Candidate.Provider).IsEmpty())
+	{
+		OutConfigError = FString::Printf(TEXT("API key not set for %s"),
+		                                 *UGenUtils::GetEnumDisplayName(StaticEnum<EGenAIOrgs>(), static_cast<int32>(Candidate.Provider)));
+		return false;
+	}
+
+	switch (Candidate.Provider)
+	{
+	case EGenAIOrgs::OpenAI:
+		{
+			FGenChatSettings ChatSettings;
+			ChatSettings.Model = Candidate.Model;
+			ChatSettings.MaxTokens = RouterSettings.MaxTokens;
+			ChatSettings.Temperature = RouterSettings.Temperature;
+			ChatSettings.Messages = RouterSettings.Messages;
+			ChatSettings.EndpointOverride = Candidate.EndpointOverride;
+			UGenOAIChat::SendChatRequest(ChatSettings, FOnChatCompletionResponse::CreateLambda(ResponseCallback));
+			return true;
+		}
+	case EGenAIOrgs::Anthropic:
+		{
+			FGenClaudeChatSettings ChatSettings;
+			if (!FindModelEnum(GetClaudeModels(), Candidate.Model, ChatSettings.Model))
+			{
+				break;
+			}
+			ChatSettings.MaxTokens = RouterSettings.MaxTokens;
+			ChatSettings.Temperature = RouterSettings.Temperature;
+			ChatSettings.Messages = RouterSettings.Messages;
+			ChatSettings.EndpointOverride = Candidate.EndpointOverride;
+			UGenClaudeChat::SendChatRequest(ChatSettings, FOnClaudeChatCompletionResponse::CreateLambda(ResponseCallback));
+			return true;
+		}
+	case EGenAIOrgs::DeepSeek:
+		{
+			FGenDSeekChatSettings ChatSettings;
+			if (!FindModelEnum(GetDeepSeekModels(), Candidate.Model, ChatSettings.Model))
+			{
+				break;
+			}
+			ChatSettings.MaxTokens = RouterSettings.MaxTokens;
+			ChatSettings.Temperature = RouterSettings.Temperature;
+			ChatSettings.Messages = RouterSettings.Messages;
+			UGenDSeekChat::SendChatRequest(ChatSettings, FOnDSeekChatCompletionResponse::CreateLambda(ResponseCallback));
+			return true;
+		}
+	case EGenAIOrgs::Google:
+		{
+			FGenGeminiChatSettings ChatSettings;
+			ChatSettings.Model = Candidate.Model;
+			ChatSettings.MaxTokens = RouterSettings.MaxTokens;
+			ChatSettings.Temperature = RouterSettings.Temperature;
+			ChatSettings.Messages = RouterSettings.Messages;
+			ChatSettings.EndpointOverride = Candidate.EndpointOverride;
+			UGenGeminiChat::SendChatRequest(ChatSettings, FOnGeminiChatCompletionResponse::CreateLambda(ResponseCallback));
+			return true;
+		}
+	case EGenAIOrgs::XAI:
+		{
+			FGenGrokChatSettings ChatSettings;
+			ChatSettings.Model = Candidate.Model;
+			ChatSettings.MaxTokens = RouterSettings.MaxTokens;
+			ChatSettings.Temperature = RouterSettings.Temperature;
+			ChatSettings.Messages = RouterSettings.Messages;
+			ChatSettings.EndpointOverride = Candidate.EndpointOverride;
+			UGenGrokChat::SendChatRequest(ChatSettings, FOnGrokChatCompletionResponse::CreateLambda(ResponseCallback));
+			return true;
+		}
+	default:
+		break;
+	}
+
+	OutConfigError = FString::Printf(TEXT("Model %s is not supported by the router"), *Candidate.Model);
+	return false;
+}
@@ -0,0 +1,185 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Routing/GenProviderHealth.h"
+
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenUtils.h"
+
+FGenProviderHealth& FGenProviderHealth::Get()
+{
+	static FGenProviderHealth Instance;
+	return Instance;
+}
+
+void FGenProviderHealth::RecordResult(const FGenRouterCandidate& Candidate, double LatencySeconds, bool bSuccess)
+{
+	FScopeLock ScopeLock(&Lock);
+	const double Now = FPlatformTime::Seconds();
+
+	FEndpoint& Endpoint = Endpoints.FindOrAdd(MakeKey(Candidate.Provider, Candidate.Model));
+	Endpoint.Provider = Candidate.Provider;
+	Endpoint.Model = Candidate.Model;
+	Endpoint.NumRequests++;
+	Endpoint.ErrorRate += ErrorAlpha * ((bSuccess ? 0.0 : 1.0) - Endpoint.ErrorRate);
+
+	if (!bSuccess)
+	{
+		Endpoint.ConsecutiveFailures++;
+		const bool bFailing = Endpoint.ConsecutiveFailures >= FailuresToDegrade ||
+			(Endpoint.NumRequests >= FailuresToDegrade * 2 && Endpoint.ErrorRate > ErrorRateToDegrade);
+		if (Endpoint.State == EGenEndpointState::Probing || (Endpoint.State == EGenEndpointState::Healthy && bFailing))
+		{
+			Degrade(Endpoint, Now);
+		}
+		return;
+	}
+
+	// Latency is only tracked for successful requests, failures are covered by the error rate
+	if (Endpoint.LatencySamples.Num() < MaxLatencySamples)
+	{
+		Endpoint.LatencySamples.Add(LatencySeconds);
+	}
+	else
+	{
+		Endpoint.LatencySamples[Endpoint.NextSample] = LatencySeconds;
+	}
+	Endpoint.NextSample = (Endpoint.NextSample + 1) % MaxLatencySamples;
+	Endpoint.EwmaLatency = Endpoint.LatencySamples.Num() == 1
+		                       ? LatencySeconds
+		                       : Endpoint.EwmaLatency + LatencyAlpha * (LatencySeconds - Endpoint.EwmaLatency);
+	Endpoint.ConsecutiveFailures = 0;
+
+	if (Endpoint.State == EGenEndpointState::Probing)
+	{
+		Endpoint.ProbeShare *= 2.0f;
+		if (Endpoint.ProbeShare >= 1.0f)
+		{
+			Endpoint.State = EGenEndpointState::Healthy;
+			Endpoint.Cooldown = InitialCooldownSeconds;
+			UE_LOG(LogGenAI, Log, TEXT("Router endpoint %s/%s is healthy again"),
+			       *UGenUtils::GetEnumDisplayName(StaticEnum<EGenAIOrgs>(), static_cast<int32>(Endpoint.Provider)), *Endpoint.Model);
+		}
+	}
+}
+
+int32 FGenProviderHealth::SelectCandidate(const TArray<FGenRouterCandidate>& Candidates, float MaxCostPer1KTokens, const TSet<int32>& Excluded)
+{
+	FScopeLock ScopeLock(&Lock);
+	const double Now = FPlatformTime::Seconds();
+
+	int32 BestIndex = INDEX_NONE;
+	double BestScore = TNumericLimits<double>::Max();
+
+	// Used when every endpoint is drained, the one that becomes available first is still better than failing
+	int32 FallbackIndex = INDEX_NONE;
+	double FallbackTime = TNumericLimits<double>::Max();
+
+	for (int32 i = 0; i < Candidates.Num(); ++i)
+	{
+		const FGenRouterCandidate& Candidate = Candidates[i];
+		if (Excluded.Contains(i) || (MaxCostPer1KTokens > 0.0f && Candidate.CostPer1KTokens > MaxCostPer1KTokens))
+		{
+			continue;
+		}
+
+		double Score = 0.0;
+		if (FEndpoint* Endpoint = Endpoints.Find(MakeKey(Candidate.Provider, Candidate.Model)))
+		{
+			if (Endpoint->State == EGenEndpointState::Degraded)
+			{
+				if (Now < Endpoint->RetryTime)
+				{
+					if (Endpoint->RetryTime < FallbackTime)
+					{
+						FallbackTime = Endpoint->RetryTime;
+						FallbackIndex = i;
+					}
+					continue;
+				}
+				Endpoint->State = EGenEndpointState::Probing;
+				Endpoint->ProbeShare = InitialProbeShare;
+			}
+
+			if (Endpoint->State == EGenEndpointState::Probing && FMath::FRand() >= Endpoint->ProbeShare)
+			{
+				if (Now < FallbackTime)
+				{
+					FallbackTime = Now;
+					FallbackIndex = i;
+				}
+				continue;
+			}
+
+			Score = Endpoint->GetExpectedLatency() * (1.0 + 4.0 * Endpoint->ErrorRate);
+		}
+
+		if (Score < BestScore)
+		{
+			BestScore = Score;
+			BestIndex = i;
+		}
+	}
+
+	return BestIndex != INDEX_NONE ? BestIndex : FallbackIndex;
+}
+
+TArray<FGenEndpointHealthStats> FGenProviderHealth::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+
+	TArray<FGenEndpointHealthStats> Stats;
+	Stats.Reserve(Endpoints.Num());
+	for (const TPair<FString, FEndpoint>& Pair : Endpoints)
+	{
+		const FEndpoint& Endpoint = Pair.Value;
+		FGenEndpointHealthStats& Entry = Stats.AddDefaulted_GetRef();
+		Entry.Provider = Endpoint.Provider;
+		Entry.Model = Endpoint.Model;
+		Entry.State = Endpoint.State;
+		Entry.EwmaLatencyMs = Endpoint.EwmaLatency * 1000.0;
+		Entry.P50LatencyMs = Endpoint.GetPercentile(0.5f) * 1000.0f;
+		Entry.P95LatencyMs = Endpoint.GetPercentile(0.95f) * 1000.0f;
+		Entry.ErrorRate = Endpoint.ErrorRate;
+		Entry.NumRequests = Endpoint.NumRequests;
+	}
+	return Stats;
+}
+
+void FGenProviderHealth::Reset()
+{
+	FScopeLock ScopeLock(&Lock);
+	Endpoints.Reset();
+}
+
+FString FGenProviderHealth::MakeKey(EGenAIOrgs Provider, const FString& Model)
+{
+	return FString::Printf(TEXT("%d/%s"), static_cast<int32>(Provider), *Model);
+}
+
+void FGenProviderHealth::Degrade(FEndpoint& Endpoint, double Now)
+{
+	Endpoint.State = EGenEndpointState::Degraded;
+	Endpoint.RetryTime = Now + Endpoint.Cooldown;
+	UE_LOG(LogGenAI, Warning, TEXT("Router endpoint %s/%s degraded, error rate %.2f, retrying in %.0f s"),
+	       *UGenUtils::GetEnumDisplayName(StaticEnum<EGenAIOrgs>(), static_cast<int32>(Endpoint.Provider)), *Endpoint.Model,
+	       Endpoint.ErrorRate, Endpoint.Cooldown);
+	Endpoint.Cooldown = FMath::Min(Endpoint.Cooldown * 2.0, MaxCooldownSeconds);
+}
+
+double FGenProviderHealth::FEndpoint::GetExpectedLatency() const
+{
+	return LatencySamples.Num() >= MinSamplesForPercentiles ? GetPercentile(0.95f) : EwmaLatency;
+}
+
+float FGenProviderHealth::FEndpoint::GetPercentile(float Percentile) const
+{
+	if (LatencySamples.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	TArray<float> Sorted = LatencySamples;
+	Sorted.Sort();
+	const int32 Index = FMath::Clamp(FMath::CeilToInt(Percentile * Sorted.Num()) - 1, 0, Sorted.Num() - 1);
+	return Sorted[Index];
+}
@@ -3,65 +3,423 @@
 #include "Secure/GenSecureKey.h"
 #include "Data/GenAIOrgs.h"
 #include "Modules/ModuleManager.h"
+#include "Utilities/GenGlobalDefinitions.h"
 
-// Static variables for storing API key and environment usage flag
-TMap<EGenAIOrgs, FString> UGenSecureKey::APIKeys;
-bool UGenSecureKey::bUseApiKeyFromEnv = true;
+#include <atomic>
 
-void UGenSecureKey::SetGenAIApiKeyRuntime(EGenAIOrgs Org, const FString& APIKey)
+namespace
 {
-    APIKeys.Add(Org, APIKey);
-}
+	constexpr int32 NumOrgs = static_cast<int32>(EGenAIOrgs::Unknown) + 1;
 
-FString UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs Org)
-{
-	if (bUseApiKeyFromEnv)
+	// Longest cooldown for a key that keeps getting 429s without a Retry-After header
+	constexpr double MaxKeyCooldownSeconds = 60.0;
+
+	// Rate limit state of one key in a pool, updated from any thread without locking
+	struct FKeySlot
+	{
+		FString Key;
+
+		// Requests left in the current rate limit window, counted down locally between responses
+		std::atomic<int32> RemainingRequests{MAX_int32};
+
+		// FPlatformTime::Seconds() until which the key is only used if every key is cooling down
+		std::atomic<double> CooldownUntil{0.0};
+
+		std::atomic<int32> ConsecutiveRateLimits{0};
+	};
+
+	// The key pools are immutable once published, a reader always sees a complete set of keys
+	struct FResolvedKeyTable
+	{
+		TArray<TUniquePtr<FKeySlot>> Pools[NumOrgs];
+
+		// Round-robin start position, so keys with the same headroom take turns
+		mutable std::atomic<uint32> Cursors[NumOrgs] = {};
+
+		// Readers currently using the table, a writer only recycles it at zero
+		mutable std::atomic<int32> Readers{0};
+
+		FKeySlot* FindSlot(int32 Index, const FString& Key) const
+		{
+			for (const TUniquePtr<FKeySlot>& Slot : Pools[Index])
+			{
+				if (Slot->Key == Key)
+				{
+					return Slot.Get();
+				}
+			}
+			return nullptr;
+		}
+
+		// Overwrites the key text before the slots are freed, so replaced keys do not linger in memory
+		void Wipe()
+		{
+			for (int32 Index = 0; Index < NumOrgs; ++Index)
+			{
+				for (const TUniquePtr<FKeySlot>& Slot : Pools[Index])
+				{
+					TArray<TCHAR>& Chars = Slot->Key.GetCharArray();
+					FPlatformMemory::Memzero(Chars.GetData(), Chars.Num() * sizeof(TCHAR));
+				}
+				Pools[Index].Empty();
+				Cursors[Index].store(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	// Tables are recycled in a fixed ring instead of being freed, a reader holding a stale pointer never touches freed memory
+	constexpr int32 NumKeyTables = 4;
+	FResolvedKeyTable KeyTables[NumKeyTables];
+
+	// All accesses are sequentially consistent, FKeyTableReadScope relies on it to see a writer's switch to another table
+	std::atomic<const FResolvedKeyTable*> ResolvedKeys{nullptr};
+
+	// Serializes writers, readers never take it once the first table is published
+	FCriticalSection WriteLock;
+
+	// Pins the published table for the lifetime of the scope, so no writer recycles it while it is read
+	class FKeyTableReadScope
+	{
+	public:
+		FKeyTableReadScope()
+		{
+			while ((Table = ResolvedKeys.load()) != nullptr)
+			{
+				Table->Readers.fetch_add(1);
+
+				// Still published after pinning, so no writer can have picked it for reuse
+				if (ResolvedKeys.load() == Table)
+				{
+					return;
+				}
+				Table->Readers.fetch_sub(1);
+			}
+		}
+
+		~FKeyTableReadScope()
+		{
+			if (Table)
+			{
+				Table->Readers.fetch_sub(1);
+			}
+		}
+
+		const FResolvedKeyTable* Get() const { return Table; }
+
+	private:
+		const FResolvedKeyTable* Table = nullptr;
+	};
+
+	// A table that is neither published nor read, called with the write lock held
+	FResolvedKeyTable& AcquireFreeTable(const FResolvedKeyTable* PublishedTable)
+	{
+		while (true)
+		{
+			for (FResolvedKeyTable& Table : KeyTables)
+			{
+				if (&Table != PublishedTable && Table.Readers.load() == 0)
+				{
+					Table.Wipe();
+					return Table;
+				}
+			}
+
+			// Readers only pin a table for a single lookup
+			FPlatformProcess::YieldThread();
+		}
+	}
+
+	const TCHAR* GetEnvironmentVariableName(EGenAIOrgs Org)
 	{
-		// Determine the appropriate environment variable key for the organization
-		FString EnvKey;
 		switch (Org)
 		{
 		case EGenAIOrgs::OpenAI:
-			EnvKey = TEXT("PS_OPENAIAPIKEY");
-			break;
+			return TEXT("PS_OPENAIAPIKEY");
 		case EGenAIOrgs::DeepSeek:
-			EnvKey = TEXT("PS_DEEPSEEKAPIKEY");
-			break;
+			return TEXT("PS_DEEPSEEKAPIKEY");
 		case EGenAIOrgs::Anthropic:
-			EnvKey = TEXT("PS_ANTHROPICAPIKEY");
-			break;
+			return TEXT("PS_ANTHROPICAPIKEY");
 		case EGenAIOrgs::Meta:
-			EnvKey = TEXT("PS_METAAPIKEY");
-			break;
+			return TEXT("PS_METAAPIKEY");
 		case EGenAIOrgs::Google:
-			EnvKey = TEXT("PS_GOOGLEAPIKEY");
-			break;
+			return TEXT("PS_GOOGLEAPIKEY");
 		case EGenAIOrgs::XAI:
-			EnvKey = TEXT("PS_XAIAPIKEY");
-			break;
+			return TEXT("PS_XAIAPIKEY");
 		default:
-			return TEXT("");
+			return nullptr;
 		}
+	}
 
-		// Check the environment variable
-		FString KeyFromEnv = GetEnvironmentVariable(EnvKey);
-		if (!KeyFromEnv.IsEmpty())
+	// Parses "20", "1.5s", "250ms" or "6m0s" style durations into seconds
+	bool ParseDuration(const FString& Value, double& OutSeconds)
+	{
+		OutSeconds = 0.0;
+		int32 i = 0;
+		bool bParsedAny = false;
+		while (i < Value.Len())
 		{
-			return KeyFromEnv;
+			const int32 NumberStart = i;
+			while (i < Value.Len() && (FChar::IsDigit(Value[i]) || Value[i] == TEXT('.')))
+			{
+				++i;
+			}
+			if (i == NumberStart)
+			{
+				return false;
+			}
+			const double Number = FCString::Atod(*Value.Mid(NumberStart, i - NumberStart));
+
+			const int32 UnitStart = i;
+			while (i < Value.Len() && FChar::IsAlpha(Value[i]))
+			{
+				++i;
+			}
+			const FString Unit = Value.Mid(UnitStart, i - UnitStart);
+			if (Unit.IsEmpty() || Unit == TEXT("s"))
+			{
+				OutSeconds += Number;
+			}
+			else if (Unit == TEXT("ms"))
+			{
+				OutSeconds += Number / 1000.0;
+			}
+			else if (Unit == TEXT("m"))
+			{
+				OutSeconds += Number * 60.0;
+			}
+			else if (Unit == TEXT("h"))
+			{
+				OutSeconds += Number * 3600.0;
+			}
+			else
+			{
+				return false;
+			}
+			bParsedAny = true;
 		}
+		return bParsedAny;
 	}
 
-	// Return the stored key from the map
-	return APIKeys.Contains(Org) ? APIKeys[Org] : TEXT("");
+	// Seconds until the request window resets, OpenAI and xAI send a duration, Anthropic an RFC 3339 timestamp
+	bool ParseResetTime(const FHttpResponsePtr& Response, double& OutSeconds)
+	{
+		if (ParseDuration(Response->GetHeader(TEXT("x-ratelimit-reset-requests")), OutSeconds))
+		{
+			return true;
+		}
+
+		FDateTime ResetTime;
+		if (!FDateTime::ParseIso8601(*Response->GetHeader(TEXT("anthropic-ratelimit-requests-reset")), ResetTime))
+		{
+			return false;
+		}
+		OutSeconds = FMath::Max((ResetTime - FDateTime::UtcNow()).GetTotalSeconds(), 0.0);
+		return true;
+	}
+
+	FString GetRequestApiKey(const FHttpRequestPtr& Request)
+	{
+		FString Key = Request->GetHeader(TEXT("Authorization"));
+		if (Key.RemoveFromStart(TEXT("Bearer ")))
+		{
+			return Key;
+		}
+		Key = Request->GetHeader(TEXT("x-api-key"));
+		return Key.IsEmpty() ? Request->GetHeader(TEXT("x-goog-api-key")) : Key;
+	}
+}
+
+// Static variables for storing API key and environment usage flag
+TMap<EGenAIOrgs, TArray<FString>> UGenSecureKey::APIKeys;
+bool UGenSecureKey::bUseApiKeyFromEnv = true;
+
+void UGenSecureKey::SetGenAIApiKeyRuntime(EGenAIOrgs Org, const FString& APIKey)
+{
+	FScopeLock ScopeLock(&WriteLock);
+	APIKeys.Add(Org, {APIKey});
+	PublishResolvedKeys();
+}
+
+void UGenSecureKey::SetGenAIApiKeyPoolRuntime(EGenAIOrgs Org, const TArray<FString>& InAPIKeys)
+{
+	FScopeLock ScopeLock(&WriteLock);
+	APIKeys.Add(Org, InAPIKeys);
+	PublishResolvedKeys();
+}
+
+FString UGenSecureKey::GetGenerativeAIApiKey(EGenAIOrgs Org)
+{
+	if (!ResolvedKeys.load())
+	{
+		// Normally populated at module startup
+		RefreshApiKeys();
+	}
+
+	const FKeyTableReadScope ReadScope;
+	const FResolvedKeyTable* Table = ReadScope.Get();
+
+	const int32 Index = static_cast<int32>(Org);
+	if (!Table || Index >= NumOrgs || Table->Pools[Index].Num() == 0)
+	{
+		return FString();
+	}
+
+	const TArray<TUniquePtr<FKeySlot>>& Pool = Table->Pools[Index];
+	if (Pool.Num() == 1)
+	{
+		return Pool[0]->Key;
+	}
+
+	// Least loaded key that is not cooling down, the rotating start position breaks ties
+	const double Now = FPlatformTime::Seconds();
+	const uint32 Start = Table->Cursors[Index].fetch_add(1, std::memory_order_relaxed);
+	FKeySlot* Best = nullptr;
+	FKeySlot* FirstAvailable = nullptr;
+	for (int32 i = 0; i < Pool.Num(); ++i)
+	{
+		FKeySlot* Slot = Pool[(Start + i) % Pool.Num()].Get();
+		const double CooldownUntil = Slot->CooldownUntil.load(std::memory_order_relaxed);
+		if (CooldownUntil > Now)
+		{
+			if (!FirstAvailable || CooldownUntil < FirstAvailable->CooldownUntil.load(std::memory_order_relaxed))
+			{
+				FirstAvailable = Slot;
+			}
+			continue;
+		}
+		if (!Best || Slot->RemainingRequests.load(std::memory_order_relaxed) > Best->RemainingRequests.load(std::memory_order_relaxed))
+		{
+			Best = Slot;
+		}
+	}
+
+	if (!Best)
+	{
+		Best = FirstAvailable;
+	}
+	Best->RemainingRequests.fetch_sub(1, std::memory_order_relaxed);
+	return Best->Key;
+}
+
+void UGenSecureKey::RefreshApiKeys()
+{
+	FScopeLock ScopeLock(&WriteLock);
+	PublishResolvedKeys();
+}
+
+void UGenSecureKey::ReportApiKeyResponse(EGenAIOrgs Org, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response)
+{
+	const FKeyTableReadScope ReadScope;
+	const FResolvedKeyTable* Table = ReadScope.Get();
+	const int32 Index = static_cast<int32>(Org);
+	if (!Table || Index >= NumOrgs || Table->Pools[Index].Num() < 2 || !Request.IsValid() || !Response.IsValid())
+	{
+		return;
+	}
+
+	FKeySlot* Slot = Table->FindSlot(Index, GetRequestApiKey(Request));
+	if (!Slot)
+	{
+		// The key was rotated out while the request was in flight
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	if (Response->GetResponseCode() == EHttpResponseCodes::TooManyRequests)
+	{
+		const int32 Strikes = Slot->ConsecutiveRateLimits.fetch_add(1, std::memory_order_relaxed) + 1;
+		double Cooldown;
+		if (!ParseDuration(Response->GetHeader(TEXT("retry-after")), Cooldown))
+		{
+			Cooldown = FMath::Min(FMath::Pow(2.0, Strikes - 1), MaxKeyCooldownSeconds);
+		}
+		Slot->RemainingRequests.store(0, std::memory_order_relaxed);
+		Slot->CooldownUntil.store(Now + Cooldown, std::memory_order_relaxed);
+		UE_LOG(LogGenAI, Warning, TEXT("API key ...%s was rate limited, cooling down for %.1f s"), *Slot->Key.Right(4), Cooldown);
+		return;
+	}
+	Slot->ConsecutiveRateLimits.store(0, std::memory_order_relaxed);
+
+	// OpenAI and xAI style headers, then Anthropic
+	FString Remaining = Response->GetHeader(TEXT("x-ratelimit-remaining-requests"));
+	if (Remaining.IsEmpty())
+	{
+		Remaining = Response->GetHeader(TEXT("anthropic-ratelimit-requests-remaining"));
+	}
+	if (Remaining.IsEmpty())
+	{
+		return;
+	}
+
+	const int32 RemainingRequests = FCString::Atoi(*Remaining);
+	Slot->RemainingRequests.store(RemainingRequests, std::memory_order_relaxed);
+
+	double ResetSeconds;
+	if (RemainingRequests <= 0 && ParseResetTime(Response, ResetSeconds))
+	{
+		Slot->CooldownUntil.store(Now + ResetSeconds, std::memory_order_relaxed);
+	}
+}
+
+void UGenSecureKey::PublishResolvedKeys()
+{
+	// The published table is never recycled by this writer, so it can be read without pinning
+	const FResolvedKeyTable* PreviousTable = ResolvedKeys.load();
+	FResolvedKeyTable* Table = &AcquireFreeTable(PreviousTable);
+	for (int32 Index = 0; Index < NumOrgs; ++Index)
+	{
+		const EGenAIOrgs Org = static_cast<EGenAIOrgs>(Index);
+
+		// The environment variable takes priority over the stored keys
+		TArray<FString> Keys;
+		const TCHAR* EnvKey = GetEnvironmentVariableName(Org);
+		if (bUseApiKeyFromEnv && EnvKey)
+		{
+			GetEnvironmentVariable(EnvKey).ParseIntoArray(Keys, TEXT(","), true);
+		}
+		if (Keys.Num() == 0)
+		{
+			if (const TArray<FString>* StoredKeys = APIKeys.Find(Org))
+			{
+				Keys = *StoredKeys;
+			}
+		}
+
+		for (FString& Key : Keys)
+		{
+			Key.TrimStartAndEndInline();
+			if (Key.IsEmpty() || Table->FindSlot(Index, Key))
+			{
+				continue;
+			}
+
+			TUniquePtr<FKeySlot> Slot = MakeUnique<FKeySlot>();
+			Slot->Key = Key;
+
+			// Keys that stay in the pool keep their rate limit state
+			if (const FKeySlot* PreviousSlot = PreviousTable ? PreviousTable->FindSlot(Index, Key) : nullptr)
+			{
+				Slot->RemainingRequests.store(PreviousSlot->RemainingRequests.load());
+				Slot->CooldownUntil.store(PreviousSlot->CooldownUntil.load());
+				Slot->ConsecutiveRateLimits.store(PreviousSlot->ConsecutiveRateLimits.load());
+			}
+			Table->Pools[Index].Add(MoveTemp(Slot));
+		}
+	}
+
+	ResolvedKeys.store(Table);
 }
 
 void UGenSecureKey::SetUseApiKeyFromEnvironmentVars(bool bUseEnvVariable)
 {
+	FScopeLock ScopeLock(&WriteLock);
 	bUseApiKeyFromEnv = bUseEnvVariable;
+	PublishResolvedKeys();
 }
 
 bool UGenSecureKey::GetUseApiKeyFromEnvironmentVars()
 {
+	FScopeLock ScopeLock(&WriteLock);
 	return bUseApiKeyFromEnv;
 }
 
@@ -78,4 +436,4 @@ FString UGenSecureKey::GetEnvironmentVariable(FString key)
 	result = FLinuxPlatformMisc::GetEnvironmentVariable(*key);
 #endif
 	return result;
-}
\ No newline at end of file
+}
@@ -0,0 +1,268 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Serialize/GenJsonSchemaBuilder.h"
+
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+TSharedPtr<FJsonObject> FGenJsonSchemaBuilder::BuildStructSchema(const UStruct* Struct, bool bAllowObjectPaths)
+{
+	if (!Struct)
+	{
+		return nullptr;
+	}
+
+	// Structured outputs are decoded off the game thread, which is only safe for plain data
+	if (!bAllowObjectPaths && HasObjectReferences(Struct))
+	{
+		UE_LOG(LogGenAI, Error, TEXT("%s holds object references, only plain data structs can be used for structured outputs"),
+		       *Struct->GetName());
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> Schema = MakeShareable(new FJsonObject());
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+
+	TSharedPtr<FJsonObject> Properties = MakeShareable(new FJsonObject());
+	TArray<TSharedPtr<FJsonValue>> Required;
+
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		const FProperty* Property = *It;
+		TSharedPtr<FJsonObject> PropertySchema = BuildPropertySchema(Property, bAllowObjectPaths);
+		if (!PropertySchema.IsValid())
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Skipping unsupported property %s in schema for %s"),
+			       *Property->GetName(), *Struct->GetName());
+			continue;
+		}
+
+		// Authored name matches what FJsonObjectConverter looks up when deserializing
+		const FString PropertyName = Property->GetAuthoredName();
+		Properties->SetObjectField(PropertyName, PropertySchema);
+		Required.Add(MakeShareable(new FJsonValueString(PropertyName)));
+	}
+
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetArrayField(TEXT("required"), Required);
+	Schema->SetBoolField(TEXT("additionalProperties"), false);
+	return Schema;
+}
+
+TSharedPtr<FJsonObject> FGenJsonSchemaBuilder::BuildFunctionParamsSchema(const UFunction* Function)
+{
+	if (!Function)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> Schema = MakeShareable(new FJsonObject());
+	Schema->SetStringField(TEXT("type"), TEXT("object"));
+
+	TSharedPtr<FJsonObject> Properties = MakeShareable(new FJsonObject());
+	TArray<TSharedPtr<FJsonValue>> Required;
+
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		const FProperty* Property = *It;
+		if (!IsInputParameter(Property))
+		{
+			continue;
+		}
+
+		// Tools run on the game thread, so object parameters can be passed as paths
+		TSharedPtr<FJsonObject> PropertySchema = BuildPropertySchema(Property, true);
+		if (!PropertySchema.IsValid())
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Skipping unsupported parameter %s in schema for %s"),
+			       *Property->GetName(), *Function->GetName());
+			continue;
+		}
+
+		Properties->SetObjectField(Property->GetAuthoredName(), PropertySchema);
+		Required.Add(MakeShareable(new FJsonValueString(Property->GetAuthoredName())));
+	}
+
+	Schema->SetObjectField(TEXT("properties"), Properties);
+	Schema->SetArrayField(TEXT("required"), Required);
+	Schema->SetBoolField(TEXT("additionalProperties"), false);
+	return Schema;
+}
+
+bool FGenJsonSchemaBuilder::IsInputParameter(const FProperty* Property)
+{
+	if (!Property || !Property->HasAnyPropertyFlags(CPF_Parm) || Property->HasAnyPropertyFlags(CPF_ReturnParm))
+	{
+		return false;
+	}
+
+	// Non-const references are flagged as out parameters as well, only pure outputs are skipped
+	return !Property->HasAnyPropertyFlags(CPF_OutParm) || Property->HasAnyPropertyFlags(CPF_ReferenceParm);
+}
+
+FString FGenJsonSchemaBuilder::BuildStructSchemaString(const UStruct* Struct)
+{
+	const TSharedPtr<FJsonObject> Schema = BuildStructSchema(Struct);
+	if (!Schema.IsValid())
+	{
+		return TEXT("");
+	}
+
+	FString SchemaString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&SchemaString);
+	FJsonSerializer::Serialize(Schema.ToSharedRef(), Writer);
+	return SchemaString;
+}
+
+TSharedPtr<FJsonObject> FGenJsonSchemaBuilder::BuildPropertySchema(const FProperty* Property, bool bAllowObjectPaths)
+{
+	if (!Property)
+	{
+		return nullptr;
+	}
+
+	TSharedPtr<FJsonObject> Schema;
+
+	if (CastField<FBoolProperty>(Property))
+	{
+		Schema = MakeShareable(new FJsonObject());
+		Schema->SetStringField(TEXT("type"), TEXT("boolean"));
+	}
+	else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+	{
+		Schema = BuildEnumSchema(EnumProperty->GetEnum());
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+	{
+		if (const UEnum* Enum = NumericProperty->GetIntPropertyEnum())
+		{
+			Schema = BuildEnumSchema(Enum);
+		}
+		else
+		{
+			Schema = MakeShareable(new FJsonObject());
+			Schema->SetStringField(TEXT("type"), NumericProperty->IsInteger() ? TEXT("integer") : TEXT("number"));
+		}
+	}
+	else if (CastField<FStrProperty>(Property) || CastField<FNameProperty>(Property) || CastField<FTextProperty>(Property))
+	{
+		Schema = MakeShareable(new FJsonObject());
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		const TSharedPtr<FJsonObject> ItemSchema = BuildPropertySchema(ArrayProperty->Inner, bAllowObjectPaths);
+		if (ItemSchema.IsValid())
+		{
+			Schema = MakeShareable(new FJsonObject());
+			Schema->SetStringField(TEXT("type"), TEXT("array"));
+			Schema->SetObjectField(TEXT("items"), ItemSchema);
+		}
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		const TSharedPtr<FJsonObject> ItemSchema = BuildPropertySchema(SetProperty->ElementProp, bAllowObjectPaths);
+		if (ItemSchema.IsValid())
+		{
+			Schema = MakeShareable(new FJsonObject());
+			Schema->SetStringField(TEXT("type"), TEXT("array"));
+			Schema->SetObjectField(TEXT("items"), ItemSchema);
+		}
+	}
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		Schema = BuildStructSchema(StructProperty->Struct, bAllowObjectPaths);
+	}
+	else if (bAllowObjectPaths && CastField<FObjectPropertyBase>(Property))
+	{
+		// Object references are exchanged as asset/object paths
+		Schema = MakeShareable(new FJsonObject());
+		Schema->SetStringField(TEXT("type"), TEXT("string"));
+	}
+
+	// Maps are not representable in strict mode (they would need open additionalProperties), so they are left out
+
+#if WITH_EDITORONLY_DATA
+	if (Schema.IsValid() && Property->HasMetaData(TEXT("ToolTip")))
+	{
+		Schema->SetStringField(TEXT("description"), Property->GetMetaData(TEXT("ToolTip")));
+	}
+#endif
+
+	return Schema;
+}
+
+bool FGenJsonSchemaBuilder::HasObjectReferences(const FProperty* Property)
+{
+	if (!Property)
+	{
+		return false;
+	}
+	if (CastField<FObjectPropertyBase>(Property) || CastField<FInterfaceProperty>(Property) ||
+		CastField<FDelegateProperty>(Property) || CastField<FMulticastDelegateProperty>(Property))
+	{
+		return true;
+	}
+	if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+	{
+		return HasObjectReferences(ArrayProperty->Inner);
+	}
+	if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+	{
+		return HasObjectReferences(SetProperty->ElementProp);
+	}
+	if (const FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+	{
+		return HasObjectReferences(MapProperty->KeyProp) || HasObjectReferences(MapProperty->ValueProp);
+	}
+	if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+	{
+		return HasObjectReferences(StructProperty->Struct);
+	}
+	return false;
+}
+
+bool FGenJsonSchemaBuilder::HasObjectReferences(const UStruct* Struct)
+{
+	if (!Struct)
+	{
+		return false;
+	}
+	for (TFieldIterator<FProperty> It(Struct); It; ++It)
+	{
+		if (HasObjectReferences(*It))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+TSharedPtr<FJsonObject> FGenJsonSchemaBuilder::BuildEnumSchema(const UEnum* Enum)
+{
+	TSharedPtr<FJsonObject> Schema = MakeShareable(new FJsonObject());
+	Schema->SetStringField(TEXT("type"), TEXT("string"));
+	if (!Enum)
+	{
+		return Schema;
+	}
+
+	// FJsonObjectConverter reads enums back from their short names, skip the generated _MAX entry
+	TArray<TSharedPtr<FJsonValue>> Values;
+	for (int32 Index = 0; Index < Enum->NumEnums() - 1; ++Index)
+	{
+#if WITH_EDITORONLY_DATA
+		if (Enum->HasMetaData(TEXT("Hidden"), Index))
+		{
+			continue;
+		}
+#endif
+		Values.Add(MakeShareable(new FJsonValueString(Enum->GetNameStringByIndex(Index))));
+	}
+	Schema->SetArrayField(TEXT("enum"), Values);
+	return Schema;
+}
@@ -0,0 +1,332 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Serialize/GenJsonStreamParser.h"
+
+#include "Utilities/GenGlobalDefinitions.h"
+
+FGenJsonStreamParser::FGenJsonStreamParser(FOnElement InOnElement, TArray<FString> InElementPath)
+	: OnElement(MoveTemp(InOnElement))
+	, ElementPath(MoveTemp(InElementPath))
+{
+}
+
+void FGenJsonStreamParser::Feed(const FString& Chunk)
+{
+	Feed(*Chunk, Chunk.Len());
+}
+
+void FGenJsonStreamParser::Feed(const TCHAR* Chunk, int32 Len)
+{
+	for (int32 i = 0; i < Len && State != EState::Error; ++i)
+	{
+		ProcessChar(Chunk[i]);
+	}
+}
+
+void FGenJsonStreamParser::Reset()
+{
+	State = EState::Start;
+	Containers.Reset();
+	NestDepth = 0;
+	bInString = false;
+	bEscape = false;
+	bCaptureValue = false;
+	Key.Reset();
+	Value.Reset();
+	ElementIndex = 0;
+}
+
+FString FGenJsonStreamParser::UnescapeString(const FString& Escaped)
+{
+	FString Result;
+	Result.Reserve(Escaped.Len());
+	for (int32 i = 0; i < Escaped.Len(); ++i)
+	{
+		const TCHAR C = Escaped[i];
+		if (C != TEXT('\\') || i + 1 >= Escaped.Len())
+		{
+			Result.AppendChar(C);
+			continue;
+		}
+
+		const TCHAR Escape = Escaped[++i];
+		switch (Escape)
+		{
+		case TEXT('b'): Result.AppendChar(TEXT('\b')); break;
+		case TEXT('f'): Result.AppendChar(TEXT('\f')); break;
+		case TEXT('n'): Result.AppendChar(TEXT('\n')); break;
+		case TEXT('r'): Result.AppendChar(TEXT('\r')); break;
+		case TEXT('t'): Result.AppendChar(TEXT('\t')); break;
+		case TEXT('u'):
+			{
+				if (i + 4 >= Escaped.Len() || !FChar::IsHexDigit(Escaped[i + 1]) || !FChar::IsHexDigit(Escaped[i + 2]) ||
+					!FChar::IsHexDigit(Escaped[i + 3]) || !FChar::IsHexDigit(Escaped[i + 4]))
+				{
+					// Malformed escape, kept as is
+					Result.AppendChar(TEXT('\\'));
+					Result.AppendChar(Escape);
+					break;
+				}
+				uint32 CodeUnit = 0;
+				for (int32 Digit = 1; Digit <= 4; ++Digit)
+				{
+					CodeUnit = (CodeUnit << 4) | FParse::HexDigit(Escaped[i + Digit]);
+				}
+				i += 4;
+
+				// Surrogate pairs are combined where TCHAR holds full code points
+				if (sizeof(TCHAR) == 4 && CodeUnit >= 0xD800 && CodeUnit <= 0xDBFF && i + 6 < Escaped.Len() &&
+					Escaped[i + 1] == TEXT('\\') && Escaped[i + 2] == TEXT('u'))
+				{
+					uint32 Low = 0;
+					for (int32 Digit = 3; Digit <= 6; ++Digit)
+					{
+						Low = (Low << 4) | FParse::HexDigit(Escaped[i + Digit]);
+					}
+					if (Low >= 0xDC00 && Low <= 0xDFFF)
+					{
+						CodeUnit = 0x10000 + ((CodeUnit - 0xD800) << 10) + (Low - 0xDC00);
+						i += 6;
+					}
+				}
+				Result.AppendChar(static_cast<TCHAR>(CodeUnit));
+				break;
+			}
+		default:
+			// \" \\ \/
+			Result.AppendChar(Escape);
+			break;
+		}
+	}
+	return Result;
+}
+
+void FGenJsonStreamParser::ProcessChar(TCHAR C)
+{
+	switch (State)
+	{
+	case EState::Start:
+		if (FChar::IsWhitespace(C)) return;
+		if (C == TEXT('{'))
+		{
+			Containers.Add(TEXT('}'));
+			State = EState::ExpectKey;
+		}
+		else if (C == TEXT('['))
+		{
+			Containers.Add(TEXT(']'));
+			State = EState::ExpectValue;
+		}
+		else
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Streamed structured output does not start with an object or array"));
+			State = EState::Error;
+		}
+		return;
+
+	case EState::ExpectKey:
+		if (FChar::IsWhitespace(C)) return;
+		if (C == TEXT('"'))
+		{
+			Key.Reset();
+			State = EState::InKey;
+		}
+		else if (C == Containers.Last())
+		{
+			CloseContainer();
+		}
+		else
+		{
+			State = EState::Error;
+		}
+		return;
+
+	case EState::InKey:
+		// The raw key is kept until it closes, then unescaped as a whole
+		if (bEscape)
+		{
+			Key.AppendChar(C);
+			bEscape = false;
+		}
+		else if (C == TEXT('\\'))
+		{
+			Key.AppendChar(C);
+			bEscape = true;
+		}
+		else if (C == TEXT('"'))
+		{
+			if (Key.Contains(TEXT("\\")))
+			{
+				Key = UnescapeString(Key);
+			}
+			State = EState::ExpectColon;
+		}
+		else
+		{
+			Key.AppendChar(C);
+		}
+		return;
+
+	case EState::ExpectColon:
+		if (FChar::IsWhitespace(C)) return;
+		State = C == TEXT(':') ? EState::ExpectValue : EState::Error;
+		return;
+
+	case EState::ExpectValue:
+		if (FChar::IsWhitespace(C)) return;
+		if (C == Containers.Last())
+		{
+			// Empty container
+			CloseContainer();
+			return;
+		}
+		StartValue(C);
+		return;
+
+	case EState::InValue:
+		if (bInString)
+		{
+			if (bCaptureValue)
+			{
+				Value.AppendChar(C);
+			}
+			if (bEscape)
+			{
+				bEscape = false;
+			}
+			else if (C == TEXT('\\'))
+			{
+				bEscape = true;
+			}
+			else if (C == TEXT('"'))
+			{
+				bInString = false;
+				if (NestDepth == 0)
+				{
+					// String element is complete
+					EndValue();
+					State = EState::AfterValue;
+				}
+			}
+			return;
+		}
+
+		if (NestDepth > 0)
+		{
+			if (bCaptureValue)
+			{
+				Value.AppendChar(C);
+			}
+			if (C == TEXT('"'))
+			{
+				bInString = true;
+			}
+			else if (C == TEXT('{') || C == TEXT('['))
+			{
+				++NestDepth;
+			}
+			else if (C == TEXT('}') || C == TEXT(']'))
+			{
+				if (--NestDepth == 0)
+				{
+					EndValue();
+					State = EState::AfterValue;
+				}
+			}
+			return;
+		}
+
+		// Numbers, booleans and null end at the next separator
+		if (C == TEXT(','))
+		{
+			EndValue();
+			OnValueSeparator();
+		}
+		else if (C == Containers.Last())
+		{
+			EndValue();
+			CloseContainer();
+		}
+		else if (FChar::IsWhitespace(C))
+		{
+			EndValue();
+			State = EState::AfterValue;
+		}
+		else if (bCaptureValue)
+		{
+			Value.AppendChar(C);
+		}
+		return;
+
+	case EState::AfterValue:
+		if (FChar::IsWhitespace(C)) return;
+		if (C == TEXT(','))
+		{
+			OnValueSeparator();
+		}
+		else if (C == Containers.Last())
+		{
+			CloseContainer();
+		}
+		else
+		{
+			State = EState::Error;
+		}
+		return;
+
+	case EState::Done:
+	case EState::Error:
+	default:
+		return;
+	}
+}
+
+void FGenJsonStreamParser::StartValue(TCHAR C)
+{
+	// The next container on the path is entered instead of being read as a value
+	const int32 Level = Containers.Num() - 1;
+	if (Level < ElementPath.Num() && IsInObject() && Key == ElementPath[Level] && (C == TEXT('{') || C == TEXT('[')))
+	{
+		Containers.Add(C == TEXT('{') ? TEXT('}') : TEXT(']'));
+		State = C == TEXT('{') ? EState::ExpectKey : EState::ExpectValue;
+		return;
+	}
+
+	bCaptureValue = IsElementLevel();
+	Value.Reset();
+	if (bCaptureValue)
+	{
+		Value.AppendChar(C);
+	}
+	NestDepth = (C == TEXT('{') || C == TEXT('[')) ? 1 : 0;
+	bInString = C == TEXT('"');
+	State = EState::InValue;
+}
+
+void FGenJsonStreamParser::EndValue()
+{
+	if (!bCaptureValue)
+	{
+		return;
+	}
+
+	if (OnElement)
+	{
+		OnElement(IsInObject() ? Key : FString(), ElementIndex, Value);
+	}
+	++ElementIndex;
+	Value.Reset();
+	bCaptureValue = false;
+}
+
+void FGenJsonStreamParser::CloseContainer()
+{
+	Containers.Pop(EAllowShrinking::No);
+	// A closed container on the path is a complete value of its parent
+	State = Containers.Num() == 0 ? EState::Done : EState::AfterValue;
+}
+
+void FGenJsonStreamParser::OnValueSeparator()
+{
+	State = IsInObject() ? EState::ExpectKey : EState::ExpectValue;
+}
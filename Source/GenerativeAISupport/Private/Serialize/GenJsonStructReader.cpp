@@ -0,0 +1,275 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Serialize/GenJsonStructReader.h"
+
+#include "Serialization/JsonReader.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/TextProperty.h"
+#include "UObject/UnrealType.h"
+
+namespace
+{
+	using FReader = TJsonReader<TCHAR>;
+
+	bool ReadValue(FReader& Reader, EJsonNotation Notation, const FProperty* Property, void* ValuePtr, FString& OutError);
+
+	// Skips the value whose first token was just read
+	bool SkipValue(FReader& Reader, EJsonNotation Notation)
+	{
+		if (Notation == EJsonNotation::ObjectStart)
+		{
+			return Reader.SkipObject();
+		}
+		if (Notation == EJsonNotation::ArrayStart)
+		{
+			return Reader.SkipArray();
+		}
+		return Notation != EJsonNotation::Error;
+	}
+
+	const FProperty* FindPropertyByAuthoredName(const UStruct* Struct, const FString& Name)
+	{
+		for (TFieldIterator<FProperty> It(Struct); It; ++It)
+		{
+			if (It->GetAuthoredName() == Name)
+			{
+				return *It;
+			}
+		}
+		return nullptr;
+	}
+
+	// Called after the ObjectStart token of the struct
+	bool ReadObject(FReader& Reader, const UStruct* Struct, void* StructMemory, FString& OutError)
+	{
+		EJsonNotation Notation;
+		while (Reader.ReadNext(Notation))
+		{
+			if (Notation == EJsonNotation::ObjectEnd)
+			{
+				return true;
+			}
+
+			const FProperty* Property = FindPropertyByAuthoredName(Struct, Reader.GetIdentifier());
+			if (!Property)
+			{
+				if (!SkipValue(Reader, Notation))
+				{
+					break;
+				}
+				continue;
+			}
+
+			if (!ReadValue(Reader, Notation, Property, Property->ContainerPtrToValuePtr<void>(StructMemory), OutError))
+			{
+				return false;
+			}
+		}
+
+		if (OutError.IsEmpty())
+		{
+			OutError = Reader.GetErrorMessage().IsEmpty() ? TEXT("Unexpected end of JSON") : Reader.GetErrorMessage();
+		}
+		return false;
+	}
+
+	bool ReadEnum(FReader& Reader, EJsonNotation Notation, const UEnum* Enum, const FNumericProperty* UnderlyingProperty, void* ValuePtr,
+	              FString& OutError)
+	{
+		int64 EnumValue = INDEX_NONE;
+		if (Notation == EJsonNotation::String)
+		{
+			// Same lookup as FJsonObjectConverter, short names as generated by the schema builder
+			EnumValue = Enum->GetValueByNameString(Reader.GetValueAsString());
+		}
+		else if (Notation == EJsonNotation::Number)
+		{
+			EnumValue = static_cast<int64>(Reader.GetValueAsNumber());
+		}
+
+		if (EnumValue == INDEX_NONE)
+		{
+			OutError = FString::Printf(TEXT("Invalid value for enum %s"), *Enum->GetName());
+			return false;
+		}
+		UnderlyingProperty->SetIntPropertyValue(ValuePtr, EnumValue);
+		return true;
+	}
+
+	bool ReadValue(FReader& Reader, EJsonNotation Notation, const FProperty* Property, void* ValuePtr, FString& OutError)
+	{
+		// Null keeps the default, like a missing field
+		if (Notation == EJsonNotation::Null)
+		{
+			return true;
+		}
+
+		if (const FBoolProperty* BoolProperty = CastField<FBoolProperty>(Property))
+		{
+			if (Notation == EJsonNotation::Boolean)
+			{
+				BoolProperty->SetPropertyValue(ValuePtr, Reader.GetValueAsBoolean());
+				return true;
+			}
+		}
+		else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(Property))
+		{
+			return ReadEnum(Reader, Notation, EnumProperty->GetEnum(), EnumProperty->GetUnderlyingProperty(), ValuePtr, OutError);
+		}
+		else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (const UEnum* Enum = NumericProperty->GetIntPropertyEnum())
+			{
+				return ReadEnum(Reader, Notation, Enum, NumericProperty, ValuePtr, OutError);
+			}
+			if (Notation == EJsonNotation::Number)
+			{
+				if (NumericProperty->IsFloatingPoint())
+				{
+					NumericProperty->SetFloatingPointPropertyValue(ValuePtr, Reader.GetValueAsNumber());
+				}
+				else
+				{
+					NumericProperty->SetIntPropertyValue(ValuePtr, static_cast<int64>(Reader.GetValueAsNumber()));
+				}
+				return true;
+			}
+		}
+		else if (const FStrProperty* StrProperty = CastField<FStrProperty>(Property))
+		{
+			if (Notation == EJsonNotation::String)
+			{
+				StrProperty->SetPropertyValue(ValuePtr, Reader.GetValueAsString());
+				return true;
+			}
+		}
+		else if (const FNameProperty* NameProperty = CastField<FNameProperty>(Property))
+		{
+			if (Notation == EJsonNotation::String)
+			{
+				NameProperty->SetPropertyValue(ValuePtr, FName(*Reader.GetValueAsString()));
+				return true;
+			}
+		}
+		else if (const FTextProperty* TextProperty = CastField<FTextProperty>(Property))
+		{
+			if (Notation == EJsonNotation::String)
+			{
+				TextProperty->SetPropertyValue(ValuePtr, FText::FromString(Reader.GetValueAsString()));
+				return true;
+			}
+		}
+		else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			if (Notation == EJsonNotation::ArrayStart)
+			{
+				FScriptArrayHelper Helper(ArrayProperty, ValuePtr);
+				Helper.EmptyValues();
+				EJsonNotation ElementNotation = EJsonNotation::Error;
+				while (Reader.ReadNext(ElementNotation) && ElementNotation != EJsonNotation::ArrayEnd)
+				{
+					const int32 Index = Helper.AddValue();
+					if (!ReadValue(Reader, ElementNotation, ArrayProperty->Inner, Helper.GetRawPtr(Index), OutError))
+					{
+						return false;
+					}
+				}
+				return ElementNotation == EJsonNotation::ArrayEnd;
+			}
+		}
+		else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+		{
+			if (Notation == EJsonNotation::ArrayStart)
+			{
+				FScriptSetHelper Helper(SetProperty, ValuePtr);
+				Helper.EmptyElements();
+				EJsonNotation ElementNotation = EJsonNotation::Error;
+				while (Reader.ReadNext(ElementNotation) && ElementNotation != EJsonNotation::ArrayEnd)
+				{
+					const int32 Index = Helper.AddDefaultValue_Invalid_NeedsRehash();
+					if (!ReadValue(Reader, ElementNotation, SetProperty->ElementProp, Helper.GetElementPtr(Index), OutError))
+					{
+						return false;
+					}
+				}
+				Helper.Rehash();
+				return ElementNotation == EJsonNotation::ArrayEnd;
+			}
+		}
+		else if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (Notation == EJsonNotation::ObjectStart)
+			{
+				return ReadObject(Reader, StructProperty->Struct, ValuePtr, OutError);
+			}
+		}
+		else
+		{
+			OutError = FString::Printf(TEXT("Property %s has an unsupported type"), *Property->GetAuthoredName());
+			return false;
+		}
+
+		OutError = FString::Printf(TEXT("Unexpected JSON type for property %s"), *Property->GetAuthoredName());
+		return false;
+	}
+}
+
+bool FGenJsonStructReader::ReadStruct(const FString& Json, const UStruct* Struct, void* StructMemory, FString& OutError)
+{
+	const TSharedRef<FReader> Reader = TJsonReaderFactory<TCHAR>::Create(Json);
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation) || Notation != EJsonNotation::ObjectStart)
+	{
+		OutError = TEXT("Expected a JSON object");
+		return false;
+	}
+	return ReadObject(*Reader, Struct, StructMemory, OutError);
+}
+
+bool FGenJsonStructReader::FindString(const FString& Json, const TArray<FString>& Path, FString& OutValue)
+{
+	const TSharedRef<FReader> Reader = TJsonReaderFactory<TCHAR>::Create(Json);
+	EJsonNotation Notation;
+	if (!Reader->ReadNext(Notation))
+	{
+		return false;
+	}
+
+	for (const FString& Segment : Path)
+	{
+		if (Notation != EJsonNotation::ObjectStart && Notation != EJsonNotation::ArrayStart)
+		{
+			return false;
+		}
+
+		// Members or elements before the one on the path are skipped without being parsed into values
+		const bool bObject = Notation == EJsonNotation::ObjectStart;
+		const EJsonNotation EndNotation = bObject ? EJsonNotation::ObjectEnd : EJsonNotation::ArrayEnd;
+		const int32 TargetIndex = bObject ? INDEX_NONE : FCString::Atoi(*Segment);
+		int32 Index = 0;
+		bool bFound = false;
+		while (Reader->ReadNext(Notation) && Notation != EndNotation)
+		{
+			if (bObject ? Reader->GetIdentifier() == Segment : Index++ == TargetIndex)
+			{
+				bFound = true;
+				break;
+			}
+			if (!SkipValue(*Reader, Notation))
+			{
+				return false;
+			}
+		}
+		if (!bFound)
+		{
+			return false;
+		}
+	}
+
+	if (Notation != EJsonNotation::String)
+	{
+		return false;
+	}
+	OutValue = Reader->GetValueAsString();
+	return true;
+}
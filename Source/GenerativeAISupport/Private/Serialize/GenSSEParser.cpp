@@ -0,0 +1,96 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Serialize/GenSSEParser.h"
+
+void FGenSSEParser::Feed(const uint8* Bytes, int32 Num, FOnEvent OnEvent)
+{
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const uint8 Byte = Bytes[i];
+		if (Byte != '\n')
+		{
+			PendingLine.Add(Byte);
+			continue;
+		}
+
+		// Lines are split on '\n' only, so multi-byte UTF-8 sequences are never cut in half
+		if (PendingLine.Num() > 0 && PendingLine.Last() == '\r')
+		{
+			PendingLine.Pop(EAllowShrinking::No);
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(PendingLine.GetData()), PendingLine.Num());
+		ProcessLine(FString(Converted.Length(), Converted.Get()), OnEvent);
+		PendingLine.Reset();
+	}
+}
+
+void FGenSSEParser::Flush(FOnEvent OnEvent)
+{
+	if (PendingLine.Num() > 0)
+	{
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(PendingLine.GetData()), PendingLine.Num());
+		ProcessLine(FString(Converted.Length(), Converted.Get()), OnEvent);
+		PendingLine.Reset();
+	}
+	DispatchEvent(OnEvent);
+}
+
+void FGenSSEParser::Reset()
+{
+	PendingLine.Reset();
+	EventName.Reset();
+	EventData.Reset();
+	bHasData = false;
+}
+
+void FGenSSEParser::ProcessLine(const FString& Line, FOnEvent OnEvent)
+{
+	// A blank line terminates the current event
+	if (Line.IsEmpty())
+	{
+		DispatchEvent(OnEvent);
+		return;
+	}
+
+	// Comment lines (keep-alives)
+	if (Line[0] == TEXT(':'))
+	{
+		return;
+	}
+
+	FString Field = Line;
+	FString FieldValue;
+	int32 ColonIndex;
+	if (Line.FindChar(TEXT(':'), ColonIndex))
+	{
+		Field = Line.Left(ColonIndex);
+		FieldValue = Line.Mid(ColonIndex + 1);
+		FieldValue.RemoveFromStart(TEXT(" "));
+	}
+
+	if (Field == TEXT("data"))
+	{
+		if (bHasData)
+		{
+			EventData.AppendChar(TEXT('\n'));
+		}
+		EventData.Append(FieldValue);
+		bHasData = true;
+	}
+	else if (Field == TEXT("event"))
+	{
+		EventName = FieldValue;
+	}
+}
+
+void FGenSSEParser::DispatchEvent(FOnEvent OnEvent)
+{
+	if (bHasData)
+	{
+		OnEvent(EventName, EventData);
+	}
+	EventName.Reset();
+	EventData.Reset();
+	bHasData = false;
+}
@@ -0,0 +1,346 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Serialize/GenToolCallCodec.h"
+
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenImageUtils.h"
+
+TArray<TSharedPtr<FJsonValue>> FGenToolCallCodec::WriteMessages(const TArray<FGenChatMessage>& Messages, EGenToolFormat Format,
+                                                                 FGenImageAttachments* OutImages)
+{
+	TArray<TSharedPtr<FJsonValue>> MessagesArray;
+	MessagesArray.Reserve(Messages.Num());
+
+	if (Format != EGenToolFormat::Anthropic)
+	{
+		for (const FGenChatMessage& Message : Messages)
+		{
+			MessagesArray.Add(MakeShareable(new FJsonValueObject(WriteOpenAIMessage(Message, OutImages))));
+		}
+		return MessagesArray;
+	}
+
+	// Anthropic expects all results of one round in a single user message
+	TArray<TSharedPtr<FJsonValue>> PendingResults;
+	auto FlushResults = [&MessagesArray, &PendingResults]()
+	{
+		if (PendingResults.Num() > 0)
+		{
+			TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
+			JsonMessage->SetStringField(TEXT("role"), TEXT("user"));
+			JsonMessage->SetArrayField(TEXT("content"), PendingResults);
+			MessagesArray.Add(MakeShareable(new FJsonValueObject(JsonMessage)));
+			PendingResults.Reset();
+		}
+	};
+
+	for (const FGenChatMessage& Message : Messages)
+	{
+		if (Message.Role == TEXT("tool"))
+		{
+			TSharedPtr<FJsonObject> ResultBlock = MakeShareable(new FJsonObject());
+			ResultBlock->SetStringField(TEXT("type"), TEXT("tool_result"));
+			ResultBlock->SetStringField(TEXT("tool_use_id"), Message.ToolCallId);
+			ResultBlock->SetStringField(TEXT("content"), Message.Content);
+			if (Message.bToolError)
+			{
+				ResultBlock->SetBoolField(TEXT("is_error"), true);
+			}
+			PendingResults.Add(MakeShareable(new FJsonValueObject(ResultBlock)));
+			continue;
+		}
+
+		FlushResults();
+		if (Message.ToolCalls.Num() > 0)
+		{
+			MessagesArray.Add(MakeShareable(new FJsonValueObject(WriteAnthropicAssistantMessage(Message))));
+		}
+		else
+		{
+			MessagesArray.Add(MakeShareable(new FJsonValueObject(WriteAnthropicMessage(Message, OutImages))));
+		}
+	}
+	FlushResults();
+
+	return MessagesArray;
+}
+
+void FGenToolCallCodec::WriteTools(const TSharedPtr<FJsonObject>& JsonPayload, const TArray<FString>& ToolNames, const FString& ToolChoice,
+                                   EGenToolFormat Format)
+{
+	if (ToolNames.Num() == 0)
+	{
+		return;
+	}
+
+	const TArray<TSharedPtr<FJsonValue>> ToolsArray = FGenToolRegistry::Get().BuildToolsJson(ToolNames, Format);
+	if (ToolsArray.Num() == 0)
+	{
+		return;
+	}
+	JsonPayload->SetArrayField(TEXT("tools"), ToolsArray);
+
+	if (ToolChoice.IsEmpty())
+	{
+		return;
+	}
+
+	const bool bNamedTool = ToolChoice != TEXT("auto") && ToolChoice != TEXT("none") && ToolChoice != TEXT("required");
+	if (Format == EGenToolFormat::Anthropic)
+	{
+		TSharedPtr<FJsonObject> ChoiceObject = MakeShareable(new FJsonObject());
+		if (bNamedTool)
+		{
+			ChoiceObject->SetStringField(TEXT("type"), TEXT("tool"));
+			ChoiceObject->SetStringField(TEXT("name"), ToolChoice);
+		}
+		else
+		{
+			ChoiceObject->SetStringField(TEXT("type"), ToolChoice == TEXT("required") ? TEXT("any") : *ToolChoice);
+		}
+		JsonPayload->SetObjectField(TEXT("tool_choice"), ChoiceObject);
+	}
+	else if (bNamedTool)
+	{
+		TSharedPtr<FJsonObject> FunctionObject = MakeShareable(new FJsonObject());
+		FunctionObject->SetStringField(TEXT("name"), ToolChoice);
+
+		TSharedPtr<FJsonObject> ChoiceObject = MakeShareable(new FJsonObject());
+		ChoiceObject->SetStringField(TEXT("type"), TEXT("function"));
+		ChoiceObject->SetObjectField(TEXT("function"), FunctionObject);
+		JsonPayload->SetObjectField(TEXT("tool_choice"), ChoiceObject);
+	}
+	else
+	{
+		JsonPayload->SetStringField(TEXT("tool_choice"), ToolChoice);
+	}
+}
+
+bool FGenToolCallCodec::ReadOpenAIToolCalls(const TSharedPtr<FJsonObject>& MessageObject, TArray<FGenToolCall>& OutCalls)
+{
+	const TArray<TSharedPtr<FJsonValue>>* ToolCallsArray;
+	if (!MessageObject.IsValid() || !MessageObject->TryGetArrayField(TEXT("tool_calls"), ToolCallsArray))
+	{
+		return false;
+	}
+
+	for (const TSharedPtr<FJsonValue>& ToolCallValue : *ToolCallsArray)
+	{
+		const TSharedPtr<FJsonObject>* ToolCallObject;
+		const TSharedPtr<FJsonObject>* FunctionObject;
+		if (!ToolCallValue->TryGetObject(ToolCallObject) || !(*ToolCallObject)->TryGetObjectField(TEXT("function"), FunctionObject))
+		{
+			continue;
+		}
+
+		FGenToolCall Call;
+		(*ToolCallObject)->TryGetStringField(TEXT("id"), Call.Id);
+		(*FunctionObject)->TryGetStringField(TEXT("name"), Call.Name);
+		(*FunctionObject)->TryGetStringField(TEXT("arguments"), Call.ArgumentsJson);
+		OutCalls.Add(MoveTemp(Call));
+	}
+	return OutCalls.Num() > 0;
+}
+
+bool FGenToolCallCodec::ReadAnthropicContent(const TArray<TSharedPtr<FJsonValue>>& ContentArray, FString& OutText, TArray<FGenToolCall>& OutCalls)
+{
+	for (const TSharedPtr<FJsonValue>& BlockValue : ContentArray)
+	{
+		const TSharedPtr<FJsonObject>* BlockObject;
+		if (!BlockValue->TryGetObject(BlockObject))
+		{
+			continue;
+		}
+
+		const FString Type = (*BlockObject)->GetStringField(TEXT("type"));
+		if (Type == TEXT("text"))
+		{
+			OutText += (*BlockObject)->GetStringField(TEXT("text"));
+		}
+		else if (Type == TEXT("tool_use"))
+		{
+			FGenToolCall Call;
+			(*BlockObject)->TryGetStringField(TEXT("id"), Call.Id);
+			(*BlockObject)->TryGetStringField(TEXT("name"), Call.Name);
+
+			// Input arrives as an object, it is kept as a string like the OpenAI arguments
+			const TSharedPtr<FJsonObject>* InputObject;
+			if ((*BlockObject)->TryGetObjectField(TEXT("input"), InputObject))
+			{
+				const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Call.ArgumentsJson);
+				FJsonSerializer::Serialize(InputObject->ToSharedRef(), Writer);
+			}
+			OutCalls.Add(MoveTemp(Call));
+		}
+	}
+	return OutCalls.Num() > 0;
+}
+
+void FGenToolCallCodec::AppendToolRound(TArray<FGenChatMessage>& Messages, const FString& AssistantText,
+                                        const TArray<FGenToolCall>& Calls, const TArray<FGenToolResult>& Results)
+{
+	FGenChatMessage& AssistantMessage = Messages.AddDefaulted_GetRef();
+	AssistantMessage.Role = TEXT("assistant");
+	AssistantMessage.Content = AssistantText;
+	AssistantMessage.ToolCalls = Calls;
+
+	for (const FGenToolResult& Result : Results)
+	{
+		FGenChatMessage& ToolMessage = Messages.AddDefaulted_GetRef();
+		ToolMessage.Role = TEXT("tool");
+		ToolMessage.ToolCallId = Result.ToolCallId;
+		ToolMessage.Content = Result.bSuccess ? Result.Output : FString::Printf(TEXT("Error: %s"), *Result.Output);
+		ToolMessage.bToolError = !Result.bSuccess;
+	}
+}
+
+TSharedPtr<FJsonObject> FGenToolCallCodec::WriteOpenAIMessage(const FGenChatMessage& Message, FGenImageAttachments* OutImages)
+{
+	TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
+	JsonMessage->SetStringField(TEXT("role"), Message.Role);
+
+	if (Message.Images.Num() > 0 && OutImages)
+	{
+		TArray<TSharedPtr<FJsonValue>> ContentParts;
+		if (!Message.Content.IsEmpty())
+		{
+			TSharedPtr<FJsonObject> TextPart = MakeShareable(new FJsonObject());
+			TextPart->SetStringField(TEXT("type"), TEXT("text"));
+			TextPart->SetStringField(TEXT("text"), Message.Content);
+			ContentParts.Add(MakeShareable(new FJsonValueObject(TextPart)));
+		}
+
+		for (const FGenChatImage& Image : Message.Images)
+		{
+			TSharedPtr<FJsonObject> ImageUrl = MakeShareable(new FJsonObject());
+			ImageUrl->SetStringField(TEXT("url"), OutImages->MakePlaceholder(OutImages->Add(Image), EGenImagePlaceholder::DataUrl));
+			if (!Image.Detail.IsEmpty())
+			{
+				ImageUrl->SetStringField(TEXT("detail"), Image.Detail);
+			}
+
+			TSharedPtr<FJsonObject> ImagePart = MakeShareable(new FJsonObject());
+			ImagePart->SetStringField(TEXT("type"), TEXT("image_url"));
+			ImagePart->SetObjectField(TEXT("image_url"), ImageUrl);
+			ContentParts.Add(MakeShareable(new FJsonValueObject(ImagePart)));
+		}
+
+		JsonMessage->SetArrayField(TEXT("content"), ContentParts);
+		return JsonMessage;
+	}
+	if (Message.Images.Num() > 0)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Image attachments are not supported by this request and were dropped"));
+	}
+
+	if (Message.ToolCalls.Num() > 0)
+	{
+		TArray<TSharedPtr<FJsonValue>> ToolCallsArray;
+		for (const FGenToolCall& Call : Message.ToolCalls)
+		{
+			TSharedPtr<FJsonObject> FunctionObject = MakeShareable(new FJsonObject());
+			FunctionObject->SetStringField(TEXT("name"), Call.Name);
+			FunctionObject->SetStringField(TEXT("arguments"), Call.ArgumentsJson.IsEmpty() ? TEXT("{}") : *Call.ArgumentsJson);
+
+			TSharedPtr<FJsonObject> ToolCallObject = MakeShareable(new FJsonObject());
+			ToolCallObject->SetStringField(TEXT("id"), Call.Id);
+			ToolCallObject->SetStringField(TEXT("type"), TEXT("function"));
+			ToolCallObject->SetObjectField(TEXT("function"), FunctionObject);
+			ToolCallsArray.Add(MakeShareable(new FJsonValueObject(ToolCallObject)));
+		}
+		JsonMessage->SetArrayField(TEXT("tool_calls"), ToolCallsArray);
+
+		if (Message.Content.IsEmpty())
+		{
+			JsonMessage->SetField(TEXT("content"), MakeShareable(new FJsonValueNull()));
+			return JsonMessage;
+		}
+	}
+
+	if (Message.Role == TEXT("tool"))
+	{
+		JsonMessage->SetStringField(TEXT("tool_call_id"), Message.ToolCallId);
+	}
+	JsonMessage->SetStringField(TEXT("content"), Message.Content);
+	return JsonMessage;
+}
+
+TSharedPtr<FJsonObject> FGenToolCallCodec::WriteAnthropicMessage(const FGenChatMessage& Message, FGenImageAttachments* OutImages)
+{
+	TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
+	JsonMessage->SetStringField(TEXT("role"), Message.Role);
+
+	if (Message.Images.Num() == 0 || !OutImages)
+	{
+		if (Message.Images.Num() > 0)
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Image attachments are not supported by this request and were dropped"));
+		}
+		JsonMessage->SetStringField(TEXT("content"), Message.Content);
+		return JsonMessage;
+	}
+
+	// Images go before the text, as recommended by Anthropic
+	TArray<TSharedPtr<FJsonValue>> ContentArray;
+	for (const FGenChatImage& Image : Message.Images)
+	{
+		const int32 ImageIndex = OutImages->Add(Image);
+
+		TSharedPtr<FJsonObject> SourceObject = MakeShareable(new FJsonObject());
+		SourceObject->SetStringField(TEXT("type"), TEXT("base64"));
+		SourceObject->SetStringField(TEXT("media_type"), OutImages->MakePlaceholder(ImageIndex, EGenImagePlaceholder::MimeType));
+		SourceObject->SetStringField(TEXT("data"), OutImages->MakePlaceholder(ImageIndex, EGenImagePlaceholder::Data));
+
+		TSharedPtr<FJsonObject> ImageBlock = MakeShareable(new FJsonObject());
+		ImageBlock->SetStringField(TEXT("type"), TEXT("image"));
+		ImageBlock->SetObjectField(TEXT("source"), SourceObject);
+		ContentArray.Add(MakeShareable(new FJsonValueObject(ImageBlock)));
+	}
+
+	if (!Message.Content.IsEmpty())
+	{
+		TSharedPtr<FJsonObject> TextBlock = MakeShareable(new FJsonObject());
+		TextBlock->SetStringField(TEXT("type"), TEXT("text"));
+		TextBlock->SetStringField(TEXT("text"), Message.Content);
+		ContentArray.Add(MakeShareable(new FJsonValueObject(TextBlock)));
+	}
+
+	JsonMessage->SetArrayField(TEXT("content"), ContentArray);
+	return JsonMessage;
+}
+
+TSharedPtr<FJsonObject> FGenToolCallCodec::WriteAnthropicAssistantMessage(const FGenChatMessage& Message)
+{
+	TArray<TSharedPtr<FJsonValue>> ContentArray;
+	if (!Message.Content.IsEmpty())
+	{
+		TSharedPtr<FJsonObject> TextBlock = MakeShareable(new FJsonObject());
+		TextBlock->SetStringField(TEXT("type"), TEXT("text"));
+		TextBlock->SetStringField(TEXT("text"), Message.Content);
+		ContentArray.Add(MakeShareable(new FJsonValueObject(TextBlock)));
+	}
+
+	for (const FGenToolCall& Call : Message.ToolCalls)
+	{
+		TSharedPtr<FJsonObject> InputObject;
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Call.ArgumentsJson);
+		if (!FJsonSerializer::Deserialize(Reader, InputObject) || !InputObject.IsValid())
+		{
+			InputObject = MakeShareable(new FJsonObject());
+		}
+
+		TSharedPtr<FJsonObject> ToolUseBlock = MakeShareable(new FJsonObject());
+		ToolUseBlock->SetStringField(TEXT("type"), TEXT("tool_use"));
+		ToolUseBlock->SetStringField(TEXT("id"), Call.Id);
+		ToolUseBlock->SetStringField(TEXT("name"), Call.Name);
+		ToolUseBlock->SetObjectField(TEXT("input"), InputObject);
+		ContentArray.Add(MakeShareable(new FJsonValueObject(ToolUseBlock)));
+	}
+
+	TSharedPtr<FJsonObject> JsonMessage = MakeShareable(new FJsonObject());
+	JsonMessage->SetStringField(TEXT("role"), TEXT("assistant"));
+	JsonMessage->SetArrayField(TEXT("content"), ContentArray);
+	return JsonMessage;
+}
@@ -0,0 +1,176 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Agents/GenAgentRunner.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tests/GenMockHttpServer.h"
+#include "Tools/GenToolRegistry.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	// Outcome of an agent run against the mock server
+	struct FMockAgentRun
+	{
+		TSharedPtr<FGenMockHttpServer> Server;
+		TArray<FGenAgentStepInfo> Steps;
+		TArray<FGenChatMessage> Messages;
+		FString Response;
+		FString Error;
+		bool bSuccess = false;
+	};
+
+	// OpenAI response with one mock_echo call, or the final answer once RequestIndex reaches NumToolRounds
+	FString MakeScriptedResponse(const int32 RequestIndex, const int32 NumToolRounds)
+	{
+		if (RequestIndex >= NumToolRounds)
+		{
+			return TEXT(R"({"choices":[{"message":{"role":"assistant","content":"done"}}],"usage":{"total_tokens":10}})");
+		}
+		return FString::Printf(TEXT(R"({"choices":[{"message":{"role":"assistant","content":null,"tool_calls":[)"
+			R"({"id":"call_%d","type":"function","function":{"name":"mock_echo","arguments":"{\"step\":%d}"}}]}}],"usage":{"total_tokens":10}})"),
+			RequestIndex, RequestIndex);
+	}
+
+	// Starts an OpenAI agent run against a scripted mock, bDone is set when it finishes
+	void StartScriptedRun(const TSharedRef<FMockAgentRun>& Run, const TSharedRef<bool>& bDone, const uint32 Port, const int32 NumToolRounds,
+	                      const TArray<FGenChatImage>& Images)
+	{
+		Run->Server = FGenMockHttpServer::Start(Port, TEXT("/v1/chat/completions"), [NumToolRounds](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+		{
+			return MakeScriptedResponse(RequestIndex, NumToolRounds);
+		});
+
+		// A tool output of realistic size, so the history grows like in a real run
+		const FString EchoOutput = FString::Printf(TEXT("{\"text\":\"%s\"}"), *FString::ChrN(2048, TEXT('x')));
+		FGenToolRegistry::Get().RegisterNativeTool(TEXT("mock_echo"), TEXT("Echoes a fixed text"), nullptr,
+			[EchoOutput](const TSharedPtr<FJsonObject>& Arguments, FString& OutError)
+			{
+				return EchoOutput;
+			}, true);
+
+		FGenChatMessage UserMessage;
+		UserMessage.Role = TEXT("user");
+		UserMessage.Content = TEXT("Run the scripted task");
+		UserMessage.Images = Images;
+
+		FGenAgentSettings AgentSettings;
+		AgentSettings.Model = TEXT("mock-model");
+		AgentSettings.EndpointOverride = Run->Server->GetUrl();
+		AgentSettings.Messages.Add(UserMessage);
+		AgentSettings.Tools.Add(TEXT("mock_echo"));
+		AgentSettings.MaxSteps = NumToolRounds + 1;
+
+		const TSharedRef<TWeakObjectPtr<UGenAgentRunner>> WeakRunner = MakeShared<TWeakObjectPtr<UGenAgentRunner>>();
+		*WeakRunner = UGenAgentRunner::RunAgent(AgentSettings,
+			FOnAgentComplete::CreateLambda([Run, bDone, WeakRunner](const FString& Response, const FString& Error, bool bSuccess)
+			{
+				Run->Response = Response;
+				Run->Error = Error;
+				Run->bSuccess = bSuccess;
+				if (const UGenAgentRunner* Runner = WeakRunner->Get())
+				{
+					Run->Messages = Runner->GetMessages();
+				}
+				FGenToolRegistry::Get().UnregisterTool(TEXT("mock_echo"));
+				*bDone = true;
+			}),
+			FOnAgentStep::CreateLambda([Run](const FGenAgentStepInfo& Step)
+			{
+				Run->Steps.Add(Step);
+			}));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAgentRunnerImagesTest, "GenerativeAISupport.Agents.ImageAttachments",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenAgentRunnerImagesTest::RunTest(const FString& Parameters)
+{
+	FGenChatImage Image;
+	Image.Width = 4;
+	Image.Height = 4;
+	Image.Pixels.Init(FColor::Red, 16);
+
+	const TSharedRef<FMockAgentRun> Run = MakeShared<FMockAgentRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	StartScriptedRun(Run, bDone, 18733, 1, {Image});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		TestTrue(TEXT("Run succeeds"), Run->bSuccess);
+		if (TestEqual(TEXT("One request per step"), Run->Server->RequestBodies.Num(), 2))
+		{
+			// The incrementally encoded history keeps the image of the first message on every step
+			for (const FString& Body : Run->Server->RequestBodies)
+			{
+				TestTrue(TEXT("Image data is sent"), Body.Contains(TEXT("\"url\":\"data:image/jpeg;base64,")));
+				TestFalse(TEXT("No unresolved image reference"), Body.Contains(TEXT("GENIMG")));
+			}
+		}
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAgentLoopBenchmark, "GenerativeAISupport.Performance.AgentLoop",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGenAgentLoopBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumToolRounds = 40;
+	const TSharedRef<FMockAgentRun> Run = MakeShared<FMockAgentRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	const double RunStartTime = FPlatformTime::Seconds();
+	StartScriptedRun(Run, bDone, 18734, NumToolRounds, {});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone, 120.0));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run, RunStartTime]()
+	{
+		const double RunMs = (FPlatformTime::Seconds() - RunStartTime) * 1000.0;
+		TestTrue(TEXT("Run succeeds"), Run->bSuccess);
+		TestEqual(TEXT("Final answer"), Run->Response, FString(TEXT("done")));
+		TestEqual(TEXT("Every scripted round is a step"), Run->Steps.Num(), NumToolRounds + 1);
+
+		double IncrementalEncodeMs = 0.0;
+		double RequestMs = 0.0;
+		for (const FGenAgentStepInfo& Step : Run->Steps)
+		{
+			IncrementalEncodeMs += Step.EncodeMs;
+			RequestMs += Step.RequestMs;
+		}
+
+		// Same history rebuilt from scratch on every step, as a non-incremental loop would do
+		double RebuildEncodeMs = 0.0;
+		int32 MessageCount = 1;
+		for (int32 StepIndex = 0; StepIndex < Run->Steps.Num() && MessageCount <= Run->Messages.Num(); ++StepIndex, MessageCount += 2)
+		{
+			const TArray<FGenChatMessage> History(Run->Messages.GetData(), MessageCount);
+			const double EncodeStartTime = FPlatformTime::Seconds();
+			const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+			JsonPayload->SetStringField(TEXT("model"), TEXT("mock-model"));
+			FGenToolCallCodec::WriteTools(JsonPayload, {TEXT("mock_echo")}, TEXT(""), EGenToolFormat::OpenAI);
+			JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages(History, EGenToolFormat::OpenAI));
+			FString PayloadString;
+			const auto Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&PayloadString);
+			FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+			RebuildEncodeMs += (FPlatformTime::Seconds() - EncodeStartTime) * 1000.0;
+		}
+
+		UE_LOG(LogGenPerformance, Display,
+		       TEXT("Agent loop of %d steps took: %f ms (requests %f ms), incremental encoding: %f ms, full rebuild per step: %f ms"),
+		       Run->Steps.Num(), RunMs, RequestMs, IncrementalEncodeMs, RebuildEncodeMs);
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,167 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Models/OpenAI/GenOAISpeech.h"
+#include "Models/OpenAI/GenOAITranscription.h"
+#include "Tests/GenMockHttpServer.h"
+#include "UObject/StrongObjectPtr.h"
+
+namespace
+{
+	// Outcome of an audio request against the mock server
+	struct FAudioRun
+	{
+		TSharedPtr<FGenMockHttpServer> Server;
+		FString Text;
+		FString Error;
+		bool bSuccess = false;
+		bool bStarted = false;
+	};
+
+	int32 ReadInt32(const uint8* Source)
+	{
+		return Source[0] | (Source[1] << 8) | (Source[2] << 16) | (Source[3] << 24);
+	}
+
+	int32 FindBytes(const TArray<uint8>& Data, const FString& Text)
+	{
+		const FTCHARToUTF8 Converted(*Text);
+		const int32 Length = Converted.Length();
+		for (int32 Index = 0; Index + Length <= Data.Num(); ++Index)
+		{
+			if (FMemory::Memcmp(Data.GetData() + Index, Converted.Get(), Length) == 0)
+			{
+				return Index;
+			}
+		}
+		return INDEX_NONE;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAudioTranscriptionTest, "GenerativeAISupport.Audio.BufferedTranscription",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenAudioTranscriptionTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FAudioRun> Run = MakeShared<FAudioRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->Server = FGenMockHttpServer::Start(18737, TEXT("/v1/audio/transcriptions"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		return FString(TEXT(R"({"text":"hello there"})"));
+	});
+
+	FGenOAITranscriptionSettings Settings;
+	Settings.Language = TEXT("en");
+	Settings.EndpointOverride = Run->Server->GetUrl();
+
+	// Three capture chunks, appended the way a microphone callback would
+	TArray<int16> Chunk;
+	Chunk.Init(0x1234, 1600);
+	const TSharedRef<FGenOAIBufferedTranscription, ESPMode::ThreadSafe> Upload = UGenOAITranscription::BeginBufferedTranscription(Settings);
+	for (int32 ChunkIndex = 0; ChunkIndex < 3; ++ChunkIndex)
+	{
+		Upload->AppendPCM(Chunk.GetData(), Chunk.Num());
+	}
+	TestEqual(TEXT("Samples are buffered"), Upload->GetNumSamples(), 3 * Chunk.Num());
+
+	Upload->Finish([Run, bDone](const FString& Text, const FString& Error, bool Success)
+	{
+		Run->Text = Text;
+		Run->Error = Error;
+		Run->bSuccess = Success;
+		*bDone = true;
+	});
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run, Upload, NumSamples = 3 * Chunk.Num()]()
+	{
+		TestTrue(TEXT("Request succeeds"), Run->bSuccess);
+		TestEqual(TEXT("Transcribed text"), Run->Text, FString(TEXT("hello there")));
+		if (TestEqual(TEXT("The upload is sent in one request"), Run->Server->RawRequestBodies.Num(), 1))
+		{
+			const TArray<uint8>& Body = Run->Server->RawRequestBodies[0];
+			TestTrue(TEXT("Model field"), FindBytes(Body, TEXT("name=\"model\"\r\n\r\nwhisper-1\r\n")) != INDEX_NONE);
+			TestTrue(TEXT("Language field"), FindBytes(Body, TEXT("name=\"language\"\r\n\r\nen\r\n")) != INDEX_NONE);
+
+			const int32 WavOffset = FindBytes(Body, TEXT("RIFF"));
+			if (TestTrue(TEXT("WAV file part"), WavOffset != INDEX_NONE && WavOffset + 44 <= Body.Num()))
+			{
+				const int32 DataSize = NumSamples * sizeof(int16);
+				TestEqual(TEXT("Patched RIFF size"), ReadInt32(Body.GetData() + WavOffset + 4), 36 + DataSize);
+				TestEqual(TEXT("Patched data size"), ReadInt32(Body.GetData() + WavOffset + 40), DataSize);
+				TestEqual(TEXT("Sample rate"), ReadInt32(Body.GetData() + WavOffset + 24), 16000);
+
+				// The closing boundary follows the samples directly
+				const int32 ClosingOffset = WavOffset + 44 + DataSize;
+				TestTrue(TEXT("Closing boundary"), ClosingOffset + 4 <= Body.Num() && FMemory::Memcmp(Body.GetData() + ClosingOffset, "\r\n--", 4) == 0);
+				TestTrue(TEXT("Body ends the form"), FMemory::Memcmp(Body.GetData() + Body.Num() - 4, "--\r\n", 4) == 0);
+			}
+		}
+
+		// A second Finish must not send the body again
+		Upload->Finish([this](const FString& Text, const FString& Error, bool Success)
+		{
+			TestFalse(TEXT("Finish only sends once"), Success);
+		});
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAudioSpeechTest, "GenerativeAISupport.Audio.StreamedSpeech",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenAudioSpeechTest::RunTest(const FString& Parameters)
+{
+	// One second of 24 kHz PCM, large enough to arrive in several chunks
+	TArray<uint8> CannedAudio;
+	CannedAudio.SetNumUninitialized(UGenOAISpeech::SampleRate * sizeof(int16));
+	for (int32 Index = 0; Index < CannedAudio.Num(); ++Index)
+	{
+		CannedAudio[Index] = static_cast<uint8>(Index * 7);
+	}
+
+	const TSharedRef<FAudioRun> Run = MakeShared<FAudioRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->Server = FGenMockHttpServer::StartBinary(18738, TEXT("/v1/audio/speech"), TEXT("audio/pcm"), CannedAudio);
+
+	FGenOAISpeechSettings Settings;
+	Settings.Input = TEXT("Welcome back, commander.");
+	Settings.EndpointOverride = Run->Server->GetUrl();
+
+	const TStrongObjectPtr<USoundWaveProcedural> Sound(UGenOAISpeech::RequestSpeech(Settings,
+		FOnSpeechStarted::CreateLambda([Run](USoundWaveProcedural* StartedSound)
+		{
+			Run->bStarted = StartedSound != nullptr;
+		}),
+		FOnSpeechResponse::CreateLambda([Run, bDone](USoundWaveProcedural* CompletedSound, const FString& Error, bool Success)
+		{
+			Run->Error = Error;
+			Run->bSuccess = Success;
+			*bDone = true;
+		})));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run, Sound, NumBytes = CannedAudio.Num()]()
+	{
+		TestTrue(TEXT("Request succeeds"), Run->bSuccess);
+		TestTrue(TEXT("Playback could start before completion"), Run->bStarted);
+		if (TestTrue(TEXT("Sound wave is created"), Sound.IsValid()))
+		{
+			TestEqual(TEXT("Every byte is queued"), Sound->GetAvailableAudioByteCount(), NumBytes);
+		}
+		if (TestEqual(TEXT("One request"), Run->Server->RequestBodies.Num(), 1))
+		{
+			TestTrue(TEXT("Raw PCM is requested"), Run->Server->RequestBodies[0].Contains(TEXT("\"response_format\":\"pcm\"")));
+		}
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+#endif
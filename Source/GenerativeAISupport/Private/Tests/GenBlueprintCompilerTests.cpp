@@ -0,0 +1,143 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Components/SceneComponent.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraphSchema_K2.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_CustomEvent.h"
+#include "K2Node_DynamicCast.h"
+#include "MCP/GenBlueprintCompiler.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	UBlueprint* CreateChild(UBlueprint* Parent, const FString& Name)
+	{
+		const FString UniqueName = FString::Printf(TEXT("%s_%s"), *Name, *FGuid::NewGuid().ToString());
+		UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Temp/GenerativeAISupportTests/%s"), *UniqueName));
+		return FKismetEditorUtilities::CreateBlueprint(Parent->GeneratedClass, Package, FName(*UniqueName), BPTYPE_Normal,
+		                                               UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	}
+
+	// A cast to the class of Target makes Blueprint reference it
+	void AddCast(UBlueprint* Blueprint, UBlueprint* Target)
+	{
+		FGraphNodeCreator<UK2Node_DynamicCast> NodeCreator(*Blueprint->UbergraphPages[0]);
+		UK2Node_DynamicCast* Cast = NodeCreator.CreateNode(false);
+		Cast->TargetType = Target->GeneratedClass;
+		NodeCreator.Finalize();
+	}
+
+	// An event calling a scene component function on self, which an actor is not, so the target has to be connected
+	void AddUnconnectedTarget(UBlueprint* Blueprint)
+	{
+		UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+		FGraphNodeCreator<UK2Node_CustomEvent> EventCreator(*EventGraph);
+		UK2Node_CustomEvent* Event = EventCreator.CreateNode(false);
+		Event->CustomFunctionName = TEXT("BrokenEvent");
+		EventCreator.Finalize();
+
+		FGraphNodeCreator<UK2Node_CallFunction> CallCreator(*EventGraph);
+		UK2Node_CallFunction* Call = CallCreator.CreateNode(false);
+		Call->SetFromFunction(USceneComponent::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(USceneComponent, SetVisibility)));
+		Call->NodePosX = 300;
+		CallCreator.Finalize();
+
+		Event->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output)->MakeLinkTo(Call->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input));
+	}
+
+	FString GetNames(const TArray<UBlueprint*>& Blueprints)
+	{
+		TArray<FString> Names;
+		for (const UBlueprint* Blueprint : Blueprints)
+		{
+			Names.Add(Blueprint->GetName());
+		}
+		return FString::Join(Names, TEXT(", "));
+	}
+
+	TSharedPtr<FJsonObject> FindResult(const TSharedPtr<FJsonObject>& Response, const UBlueprint* Blueprint)
+	{
+		for (const TSharedPtr<FJsonValue>& Result : Response->GetArrayField(TEXT("blueprints")))
+		{
+			if (Result->AsObject()->GetStringField(TEXT("blueprint_path")) == Blueprint->GetPathName())
+			{
+				return Result->AsObject();
+			}
+		}
+		return MakeShareable(new FJsonObject());
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenBlueprintCompilerTest, "GenerativeAISupport.MCP.BlueprintCompiler",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenBlueprintCompilerTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Parent = FGenTestBlueprint::Create(TEXT("BP_CompilerParent"));
+	UBlueprint* Child = CreateChild(Parent, TEXT("BP_CompilerChild"));
+	UBlueprint* First = FGenTestBlueprint::Create(TEXT("BP_CompilerCycleFirst"));
+	UBlueprint* Second = FGenTestBlueprint::Create(TEXT("BP_CompilerCycleSecond"));
+	UBlueprint* Unrelated = FGenTestBlueprint::Create(TEXT("BP_CompilerUnrelated"));
+	UBlueprint* Broken = FGenTestBlueprint::Create(TEXT("BP_CompilerBroken"));
+	if (!TestNotNull(TEXT("Child Blueprint"), Child))
+	{
+		for (UBlueprint* Blueprint : {Parent, First, Second, Unrelated, Broken})
+		{
+			FGenTestBlueprint::Destroy(Blueprint);
+		}
+		return false;
+	}
+
+	// A child comes after its parent whatever the given order
+	TestEqual(TEXT("Parent before child"), GetNames(FGenBlueprintCompiler::SortByDependencies({Child, Parent})), GetNames({Parent, Child}));
+	TestEqual(TEXT("Parent stays before child"), GetNames(FGenBlueprintCompiler::SortByDependencies({Parent, Child})), GetNames({Parent, Child}));
+
+	// Blueprints that reference each other come after the ones that are ready and keep the given order
+	AddCast(First, Second);
+	AddCast(Second, First);
+	TestEqual(TEXT("Cycle keeps the given order"), GetNames(FGenBlueprintCompiler::SortByDependencies({First, Second, Unrelated})),
+	          GetNames({Unrelated, First, Second}));
+	TestEqual(TEXT("Reversed cycle keeps the given order"), GetNames(FGenBlueprintCompiler::SortByDependencies({Second, First, Unrelated})),
+	          GetNames({Unrelated, Second, First}));
+
+	// The batched compile reports the results in compile order
+	TSharedPtr<FJsonObject> Response = FGenBlueprintCompiler::Compile({Child, Parent});
+	TestTrue(TEXT("Parent and child compile"), Response->GetBoolField(TEXT("success")));
+	const TArray<TSharedPtr<FJsonValue>>& Results = Response->GetArrayField(TEXT("blueprints"));
+	if (TestEqual(TEXT("One result per Blueprint"), Results.Num(), 2))
+	{
+		TestEqual(TEXT("Parent is compiled first"), Results[0]->AsObject()->GetStringField(TEXT("blueprint_path")), Parent->GetPathName());
+	}
+
+	// A broken Blueprint fails on its own, the errors stay with it
+	AddUnconnectedTarget(Broken);
+	AddExpectedError(TEXT("must have a connection"), EAutomationExpectedErrorFlags::Contains, 0);
+	Response = FGenBlueprintCompiler::Compile({Broken, Unrelated});
+	TestEqual(TEXT("Batched mode"), Response->GetStringField(TEXT("mode")), FString(TEXT("batched")));
+	TestFalse(TEXT("The batch reports the failure"), Response->GetBoolField(TEXT("success")));
+	TestTrue(TEXT("The batch counts the errors"), Response->GetNumberField(TEXT("errors")) > 0);
+
+	const TSharedPtr<FJsonObject> BrokenResult = FindResult(Response, Broken);
+	TestFalse(TEXT("Broken Blueprint fails"), BrokenResult->GetBoolField(TEXT("success")));
+	TestEqual(TEXT("Broken Blueprint status"), BrokenResult->GetStringField(TEXT("status")), FString(TEXT("error")));
+	TestTrue(TEXT("Broken Blueprint has errors"), BrokenResult->GetArrayField(TEXT("errors")).Num() > 0);
+
+	const TSharedPtr<FJsonObject> UnrelatedResult = FindResult(Response, Unrelated);
+	TestTrue(TEXT("Other Blueprint compiles"), UnrelatedResult->GetBoolField(TEXT("success")));
+	TestEqual(TEXT("Other Blueprint has no errors"), UnrelatedResult->GetArrayField(TEXT("errors")).Num(), 0);
+
+	for (UBlueprint* Blueprint : {Child, Parent, First, Second, Unrelated, Broken})
+	{
+		FGenTestBlueprint::Destroy(Blueprint);
+	}
+	return true;
+}
+
+#endif
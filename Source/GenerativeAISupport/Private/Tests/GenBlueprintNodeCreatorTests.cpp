@@ -0,0 +1,152 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "K2Node.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "ScopedTransaction.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	// Add notifications sent by the graph, and the nodes they carried
+	struct FAddNotifications
+	{
+		int32 NumActions = 0;
+		TArray<const UEdGraphNode*> Nodes;
+	};
+
+	FDelegateHandle ListenForAddedNodes(UEdGraph* Graph, const TSharedRef<FAddNotifications>& Notifications)
+	{
+		return Graph->AddOnGraphChangedHandler(FOnGraphChanged::FDelegate::CreateLambda([Notifications](const FEdGraphEditAction& Action)
+		{
+			if (Action.Action & GRAPHACTION_AddNode)
+			{
+				++Notifications->NumActions;
+				Notifications->Nodes.Append(Action.Nodes.Array());
+			}
+		}));
+	}
+
+	TSharedPtr<FJsonValue> MakeBulkNode(const FString& RefId, const FString& NodeType, double X)
+	{
+		const TSharedPtr<FJsonObject> Node = MakeShareable(new FJsonObject());
+		Node->SetStringField(TEXT("id"), RefId);
+		Node->SetStringField(TEXT("node_type"), NodeType);
+		Node->SetArrayField(TEXT("node_position"), {MakeShareable(new FJsonValueNumber(X)), MakeShareable(new FJsonValueNumber(0.0))});
+		return MakeShareable(new FJsonValueObject(Node));
+	}
+
+	UEdGraphNode* FindNodeByGuid(const UEdGraph* Graph, const FString& NodeGuid)
+	{
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node && Node->NodeGuid.ToString() == NodeGuid)
+			{
+				return Node;
+			}
+		}
+		return nullptr;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAddNodeUndoTest, "GenerativeAISupport.MCP.AddNodeUndo",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenAddNodeUndoTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_AddNodeUndo"));
+	UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+	const int32 InitialNodeCount = EventGraph->Nodes.Num();
+	const TSharedRef<FAddNotifications> Notifications = MakeShared<FAddNotifications>();
+	const FDelegateHandle Handle = ListenForAddedNodes(EventGraph, Notifications);
+
+	FString NodeGuid;
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Add node test")));
+		NodeGuid = UGenBlueprintNodeCreator::AddNode(Blueprint->GetPathName(), TEXT("EventGraph"), TEXT("Branch"), 100.0f, 0.0f,
+		                                             FString(), false);
+	}
+
+	const UEdGraphNode* Node = FindNodeByGuid(EventGraph, NodeGuid);
+	if (TestNotNull(TEXT("Node is in the graph"), Node))
+	{
+		TestTrue(TEXT("Node is transactional"), Node->HasAnyFlags(RF_Transactional));
+		TestEqual(TEXT("One add notification"), Notifications->NumActions, 1);
+		TestTrue(TEXT("The notification carries the node"), Notifications->Nodes.Contains(Node));
+	}
+
+	TestTrue(TEXT("Undo"), GEditor->UndoTransaction());
+	TestNull(TEXT("Undo removes the node"), FindNodeByGuid(EventGraph, NodeGuid));
+	TestEqual(TEXT("Graph is back to its initial nodes"), EventGraph->Nodes.Num(), InitialNodeCount);
+
+	EventGraph->RemoveOnGraphChangedHandler(Handle);
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenAddNodesBulkUndoTest, "GenerativeAISupport.MCP.AddNodesBulkUndo",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenAddNodesBulkUndoTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_AddNodesBulkUndo"));
+	UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+	const int32 InitialNodeCount = EventGraph->Nodes.Num();
+	const TSharedRef<FAddNotifications> Notifications = MakeShared<FAddNotifications>();
+	const FDelegateHandle Handle = ListenForAddedNodes(EventGraph, Notifications);
+
+	// Indexed before the nodes are added, they must reach it through the notification rather than a rebuild
+	FGenNodeGuidIndex::Get().FindGraph(Blueprint, EventGraph->GraphGuid);
+	const int32 RebuildCount = FGenNodeGuidIndex::Get().GetRebuildCount();
+
+	TArray<TSharedPtr<FJsonValue>> Results;
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Add nodes bulk test")));
+		FString Error;
+		Results = UGenBlueprintNodeCreator::AddNodesToGraph(Blueprint->GetPathName(), TEXT("EventGraph"), {
+			MakeBulkNode(TEXT("branch"), TEXT("Branch"), 100.0),
+			MakeBulkNode(TEXT("print"), TEXT("PrintString"), 300.0),
+		}, Error);
+		TestTrue(TEXT("No error"), Error.IsEmpty());
+	}
+
+	TArray<FString> NodeGuids;
+	for (const TSharedPtr<FJsonValue>& Result : Results)
+	{
+		NodeGuids.Add(Result->AsObject()->GetStringField(TEXT("node_guid")));
+	}
+	TestEqual(TEXT("Every node is created"), NodeGuids.Num(), 2);
+	TestEqual(TEXT("One add notification for the batch"), Notifications->NumActions, 1);
+	TestEqual(TEXT("The notification carries every node"), Notifications->Nodes.Num(), NodeGuids.Num());
+	for (const FString& NodeGuid : NodeGuids)
+	{
+		const UEdGraphNode* Node = FindNodeByGuid(EventGraph, NodeGuid);
+		if (TestNotNull(TEXT("Node is in the graph"), Node))
+		{
+			TestTrue(TEXT("Node is transactional"), Node->HasAnyFlags(RF_Transactional));
+			TestTrue(TEXT("Node is announced"), Notifications->Nodes.Contains(Node));
+			FGuid Guid;
+			FGuid::Parse(NodeGuid, Guid);
+			TestTrue(TEXT("GUID index finds the node"), FGenNodeGuidIndex::Get().FindNode(Blueprint, Guid) == Node);
+		}
+	}
+	TestEqual(TEXT("GUID index is not rebuilt"), FGenNodeGuidIndex::Get().GetRebuildCount(), RebuildCount);
+
+	TestTrue(TEXT("Undo"), GEditor->UndoTransaction());
+	for (const FString& NodeGuid : NodeGuids)
+	{
+		TestNull(TEXT("Undo removes the node"), FindNodeByGuid(EventGraph, NodeGuid));
+	}
+	TestEqual(TEXT("Graph is back to its initial nodes"), EventGraph->Nodes.Num(), InitialNodeCount);
+
+	EventGraph->RemoveOnGraphChangedHandler(Handle);
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+#endif
@@ -0,0 +1,125 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "MCP/GenCommandBatch.h"
+#include "ScopedTransaction.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	// Handshakes echo their message, so they show what a reference resolved to without touching any asset
+	TSharedPtr<FJsonValue> MakeHandshake(const FString& Id, const FString& Message)
+	{
+		const TSharedPtr<FJsonObject> Operation = MakeShareable(new FJsonObject());
+		if (!Id.IsEmpty())
+		{
+			Operation->SetStringField(TEXT("id"), Id);
+		}
+		Operation->SetStringField(TEXT("type"), TEXT("handshake"));
+		Operation->SetStringField(TEXT("message"), Message);
+		return MakeShareable(new FJsonValueObject(Operation));
+	}
+
+	TSharedPtr<FJsonObject> RunBatch(const TArray<TSharedPtr<FJsonValue>>& Operations)
+	{
+		const TSharedPtr<FJsonObject> Batch = MakeShareable(new FJsonObject());
+		Batch->SetArrayField(TEXT("operations"), Operations);
+		Batch->SetBoolField(TEXT("compile"), false);
+		Batch->SetBoolField(TEXT("stop_on_error"), false);
+		return FGenCommandBatch::Execute(Batch);
+	}
+
+	FString GetResultField(const TSharedPtr<FJsonObject>& Response, int32 Index, const FString& Field)
+	{
+		const TArray<TSharedPtr<FJsonValue>> Results = Response->GetArrayField(TEXT("results"));
+		return Results.IsValidIndex(Index) ? Results[Index]->AsObject()->GetStringField(Field) : FString();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenBatchReferenceTest, "GenerativeAISupport.MCP.BatchReferences",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenBatchReferenceTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FJsonObject> Response = RunBatch({
+		MakeHandshake(TEXT("first"), TEXT("hi")),
+		MakeHandshake(FString(), TEXT("${first.message}")),
+		MakeHandshake(FString(), TEXT("$5")),
+		MakeHandshake(FString(), TEXT("$first.message")),
+		MakeHandshake(FString(), TEXT("print(f\"${first.message}\")")),
+		MakeHandshake(FString(), TEXT("$${first.message}")),
+	});
+
+	TestTrue(TEXT("Batch succeeds"), Response->GetBoolField(TEXT("success")));
+	TestEqual(TEXT("Plain message"), GetResultField(Response, 0, TEXT("message")), FString(TEXT("Received: hi")));
+	TestEqual(TEXT("Whole reference is replaced"), GetResultField(Response, 1, TEXT("message")), FString(TEXT("Received: Received: hi")));
+	TestEqual(TEXT("Literal dollar amounts pass through"), GetResultField(Response, 2, TEXT("message")), FString(TEXT("Received: $5")));
+	TestEqual(TEXT("The old $ prefix is a literal"), GetResultField(Response, 3, TEXT("message")), FString(TEXT("Received: $first.message")));
+	TestEqual(TEXT("Embedded braces are not references"), GetResultField(Response, 4, TEXT("message")), FString(TEXT("Received: print(f\"${first.message}\")")));
+	TestEqual(TEXT("$${ escapes a reference"), GetResultField(Response, 5, TEXT("message")), FString(TEXT("Received: ${first.message}")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenBatchUnresolvedReferenceTest, "GenerativeAISupport.MCP.BatchUnresolvedReferences",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenBatchUnresolvedReferenceTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FJsonObject> Response = RunBatch({
+		MakeHandshake(TEXT("first"), TEXT("hi")),
+		MakeHandshake(FString(), TEXT("${missing.message}")),
+		MakeHandshake(FString(), TEXT("${first.no_such_field}")),
+		MakeHandshake(FString(), TEXT("${first.message}")),
+	});
+
+	TestFalse(TEXT("Batch fails"), Response->GetBoolField(TEXT("success")));
+	TestEqual(TEXT("First failing operation"), static_cast<int32>(Response->GetNumberField(TEXT("failed_operation"))), 1);
+	TestEqual(TEXT("Unknown id"), GetResultField(Response, 1, TEXT("error")), FString(TEXT("Unknown operation id in reference ${missing.message}")));
+	TestEqual(TEXT("Unknown field"), GetResultField(Response, 2, TEXT("error")), FString(TEXT("Could not resolve reference ${first.no_such_field}")));
+	TestEqual(TEXT("Later operations still run"), GetResultField(Response, 3, TEXT("message")), FString(TEXT("Received: Received: hi")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenBatchRollbackTest, "GenerativeAISupport.MCP.BatchRollback",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenBatchRollbackTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_BatchRollback"));
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Edit before the batch")));
+		Blueprint->Modify();
+		Blueprint->BlueprintDescription = TEXT("Edited");
+	}
+
+	// The first operation fails before anything is recorded, the undo would hit the edit above
+	const TSharedPtr<FJsonObject> Batch = MakeShareable(new FJsonObject());
+	Batch->SetArrayField(TEXT("operations"), {MakeHandshake(FString(), TEXT("${missing.message}"))});
+	Batch->SetBoolField(TEXT("compile"), false);
+	Batch->SetBoolField(TEXT("rollback_on_error"), true);
+	const TSharedPtr<FJsonObject> Response = FGenCommandBatch::Execute(Batch);
+
+	TestFalse(TEXT("Batch fails"), Response->GetBoolField(TEXT("success")));
+	TestFalse(TEXT("Nothing to roll back"), Response->GetBoolField(TEXT("rolled_back")));
+	TestEqual(TEXT("The earlier edit is kept"), Blueprint->BlueprintDescription, FString(TEXT("Edited")));
+
+	// A batch that changed the Blueprint is undone, the earlier edit stays
+	const TSharedPtr<FJsonObject> Operation = MakeHandshake(FString(), TEXT("hi"))->AsObject();
+	Operation->SetStringField(TEXT("blueprint_path"), Blueprint->GetPathName());
+	Batch->SetArrayField(TEXT("operations"), {
+		MakeShareable(new FJsonValueObject(Operation)),
+		MakeHandshake(FString(), TEXT("${missing.message}")),
+	});
+	TestTrue(TEXT("Recorded batch is rolled back"), FGenCommandBatch::Execute(Batch)->GetBoolField(TEXT("rolled_back")));
+	TestEqual(TEXT("The earlier edit survives the rollback"), Blueprint->BlueprintDescription, FString(TEXT("Edited")));
+
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+#endif
@@ -0,0 +1,104 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GenerativeAISupportSettings.h"
+#include "MCP/GenCommandExecutor.h"
+#include "Tests/GenMockHttpServer.h"
+
+namespace
+{
+	constexpr int32 NumPumpedCommands = 200;
+	constexpr int32 NumUnbudgetedCommands = 3;
+
+	// Frames in which the queued commands ran, filled on the game thread
+	struct FPumpRun
+	{
+		TArray<uint64> Frames;
+		int32 NumSucceeded = 0;
+		float SavedBudgetMs = 0.0f;
+	};
+
+	void EnqueueHandshakes(const TSharedRef<FPumpRun>& Run, int32 NumCommands, const TSharedRef<bool>& bDone)
+	{
+		for (int32 Index = 0; Index < NumCommands; ++Index)
+		{
+			const TSharedPtr<FJsonObject> Command = MakeShareable(new FJsonObject());
+			Command->SetStringField(TEXT("type"), TEXT("handshake"));
+			Command->SetStringField(TEXT("message"), FString::FromInt(Index));
+			FGenCommandExecutor::Get().Enqueue(Command, [Run, NumCommands, bDone](const TSharedPtr<FJsonObject>& Response)
+			{
+				Run->Frames.Add(GFrameCounter);
+				Run->NumSucceeded += Response.IsValid() && Response->GetBoolField(TEXT("success")) ? 1 : 0;
+				*bDone = Run->Frames.Num() == NumCommands;
+			});
+		}
+	}
+
+	int32 CountFrames(const TArray<uint64>& Frames)
+	{
+		TSet<uint64> Distinct;
+		Distinct.Append(Frames);
+		return Distinct.Num();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenCommandPumpBudgetTest, "GenerativeAISupport.MCP.CommandPumpBudget",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenCommandPumpBudgetTest::RunTest(const FString& Parameters)
+{
+	UGenerativeAISupportSettings* Settings = GetMutableDefault<UGenerativeAISupportSettings>();
+	const TSharedRef<FPumpRun> Run = MakeShared<FPumpRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->SavedBudgetMs = Settings->CommandFrameBudgetMs;
+
+	// A handshake takes microseconds, a generous budget drains the whole burst in a frame or two
+	Settings->CommandFrameBudgetMs = 100.0f;
+	FGenCommandExecutor::Get().ResetStats();
+	const double EnqueueStart = FPlatformTime::Seconds();
+	EnqueueHandshakes(Run, NumPumpedCommands, bDone);
+	TestEqual(TEXT("Nothing runs before the next tick"), Run->Frames.Num(), 0);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run, EnqueueStart]()
+	{
+		const double ElapsedSeconds = FPlatformTime::Seconds() - EnqueueStart;
+		const FGenCommandPumpStats Stats = FGenCommandExecutor::Get().GetStats();
+		TestEqual(TEXT("Every command succeeds"), Run->NumSucceeded, NumPumpedCommands);
+		TestTrue(TEXT("The burst is drained in a few frames"), CountFrames(Run->Frames) <= 2);
+		TestEqual(TEXT("Queue is empty"), Stats.QueueDepth, 0);
+		TestTrue(TEXT("Peak depth sees the burst"), Stats.PeakQueueDepth >= NumPumpedCommands);
+		TestTrue(TEXT("Executed commands are counted"), Stats.CommandsExecuted >= NumPumpedCommands);
+		TestTrue(TEXT("Wait time is measured"), Stats.AverageWaitMs >= 0.0 && Stats.MaxWaitMs >= Stats.AverageWaitMs);
+		TestTrue(TEXT("Throughput is measured"), Stats.CommandsPerSecond > 0.0);
+		AddInfo(FString::Printf(TEXT("%d handshakes in %.2f ms, pump rate %.0f commands/s, max wait %.2f ms"),
+		                        NumPumpedCommands, ElapsedSeconds * 1000.0, Stats.CommandsPerSecond, Stats.MaxWaitMs));
+		return true;
+	}));
+
+	// Without a budget the pump still makes progress, one command per frame
+	const TSharedRef<FPumpRun> UnbudgetedRun = MakeShared<FPumpRun>();
+	const TSharedRef<bool> bUnbudgetedDone = MakeShared<bool>(false);
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([Settings, UnbudgetedRun, bUnbudgetedDone]()
+	{
+		Settings->CommandFrameBudgetMs = 0.0f;
+		EnqueueHandshakes(UnbudgetedRun, NumUnbudgetedCommands, bUnbudgetedDone);
+		return true;
+	}));
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bUnbudgetedDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Settings, Run, UnbudgetedRun]()
+	{
+		Settings->CommandFrameBudgetMs = Run->SavedBudgetMs;
+		TestEqual(TEXT("Every unbudgeted command succeeds"), UnbudgetedRun->NumSucceeded, NumUnbudgetedCommands);
+		TestEqual(TEXT("One command per frame"), CountFrames(UnbudgetedRun->Frames), NumUnbudgetedCommands);
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,274 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "MCP/GenCommandServer.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+namespace
+{
+	constexpr int32 CommandServerTestPort = 18743;
+
+	TArray<uint8> MakeHeader(uint32 Length)
+	{
+		return {static_cast<uint8>(Length >> 24), static_cast<uint8>(Length >> 16), static_cast<uint8>(Length >> 8), static_cast<uint8>(Length)};
+	}
+
+	// Blocking read of one frame, false when the connection closed or nothing arrived in time
+	bool ReadResponse(FSocket& Socket, TSharedPtr<FJsonObject>& OutResponse)
+	{
+		TArray<uint8> Buffer;
+		int32 PayloadSize = 0;
+		while (FGenCommandServer::DecodeFrame(Buffer.GetData(), Buffer.Num(), PayloadSize) == FGenCommandServer::EFrameStatus::Incomplete)
+		{
+			if (!Socket.Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5)))
+			{
+				return false;
+			}
+			// One byte at a time, so nothing of the next frame is consumed
+			uint8 Byte;
+			int32 BytesRead = 0;
+			if (!Socket.Recv(&Byte, 1, BytesRead) || BytesRead == 0)
+			{
+				return false;
+			}
+			Buffer.Add(Byte);
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + 4), PayloadSize);
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+		return FJsonSerializer::Deserialize(Reader, OutResponse) && OutResponse.IsValid();
+	}
+
+	// Reads one frame in large chunks, never past its end
+	bool ReadLargeResponse(FSocket& Socket, TSharedPtr<FJsonObject>& OutResponse)
+	{
+		TArray<uint8> Buffer;
+		Buffer.SetNumUninitialized(4);
+		int32 Received = 0;
+		int32 PayloadSize = 0;
+		while (Received < Buffer.Num())
+		{
+			if (!Socket.Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromSeconds(5)))
+			{
+				return false;
+			}
+			int32 BytesRead = 0;
+			if (!Socket.Recv(Buffer.GetData() + Received, Buffer.Num() - Received, BytesRead) || BytesRead == 0)
+			{
+				return false;
+			}
+			Received += BytesRead;
+			if (Received == 4 && Buffer.Num() == 4)
+			{
+				if (FGenCommandServer::DecodeFrame(Buffer.GetData(), 4, PayloadSize) == FGenCommandServer::EFrameStatus::TooLarge)
+				{
+					return false;
+				}
+				Buffer.SetNumUninitialized(4 + PayloadSize);
+			}
+		}
+
+		const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Buffer.GetData() + 4), PayloadSize);
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FString(Converted.Length(), Converted.Get()));
+		return FJsonSerializer::Deserialize(Reader, OutResponse) && OutResponse.IsValid();
+	}
+
+	bool SendAll(FSocket& Socket, const TArray<uint8>& Data)
+	{
+		int32 BytesSent = 0;
+		return Socket.Send(Data.GetData(), Data.Num(), BytesSent) && BytesSent == Data.Num();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenCommandFrameCodecTest, "GenerativeAISupport.MCP.FrameCodec",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenCommandFrameCodecTest::RunTest(const FString& Parameters)
+{
+	using EFrameStatus = FGenCommandServer::EFrameStatus;
+
+	const FString Json = TEXT("{\"type\":\"handshake\",\"message\":\"h\u00e9llo\"}");
+	const TArray<uint8> Frame = FGenCommandServer::MakeFrame(Json);
+	const int32 Utf8Length = FTCHARToUTF8(*Json).Length();
+	TestEqual(TEXT("Header plus UTF-8 payload"), Frame.Num(), 4 + Utf8Length);
+
+	int32 PayloadSize = -1;
+	TestTrue(TEXT("Whole frame"), FGenCommandServer::DecodeFrame(Frame.GetData(), Frame.Num(), PayloadSize) == EFrameStatus::Complete);
+	TestEqual(TEXT("Payload size"), PayloadSize, Utf8Length);
+
+	PayloadSize = -1;
+	TestTrue(TEXT("Partial header"), FGenCommandServer::DecodeFrame(Frame.GetData(), 3, PayloadSize) == EFrameStatus::Incomplete);
+	TestEqual(TEXT("Size is unknown without the header"), PayloadSize, -1);
+
+	TestTrue(TEXT("Partial payload"), FGenCommandServer::DecodeFrame(Frame.GetData(), Frame.Num() - 1, PayloadSize) == EFrameStatus::Incomplete);
+	TestEqual(TEXT("Size is known once the header is complete"), PayloadSize, Utf8Length);
+
+	// Only the header has arrived, the frame must be refused before its payload is read
+	const TArray<uint8> Oversized = MakeHeader(static_cast<uint32>(FGenCommandServer::MaxFrameSize) + 1);
+	TestTrue(TEXT("Oversized header"), FGenCommandServer::DecodeFrame(Oversized.GetData(), Oversized.Num(), PayloadSize) == EFrameStatus::TooLarge);
+	const TArray<uint8> Huge = MakeHeader(0xFFFFFFFFu);
+	TestTrue(TEXT("Lengths above int32"), FGenCommandServer::DecodeFrame(Huge.GetData(), Huge.Num(), PayloadSize) == EFrameStatus::TooLarge);
+	TestTrue(TEXT("Reported size stays positive"), PayloadSize > 0);
+
+	const TArray<uint8> Largest = MakeHeader(static_cast<uint32>(FGenCommandServer::MaxFrameSize));
+	TestTrue(TEXT("MaxFrameSize itself is accepted"), FGenCommandServer::DecodeFrame(Largest.GetData(), Largest.Num(), PayloadSize) == EFrameStatus::Incomplete);
+
+	const TArray<uint8> Empty = MakeHeader(0);
+	TestTrue(TEXT("Empty payload"), FGenCommandServer::DecodeFrame(Empty.GetData(), Empty.Num(), PayloadSize) == EFrameStatus::Complete);
+	TestEqual(TEXT("Empty payload size"), PayloadSize, 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenCommandRequestIdTest, "GenerativeAISupport.MCP.RequestIdRecovery",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenCommandRequestIdTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FJsonValue> NumberId = FGenCommandServer::FindRequestId(TEXT("{\"type\":\"x\",\"params\":{\"a\":,\"request_id\": 7}"));
+	if (TestTrue(TEXT("Numeric id"), NumberId.IsValid() && NumberId->Type == EJson::Number))
+	{
+		TestEqual(TEXT("Numeric id value"), static_cast<int32>(NumberId->AsNumber()), 7);
+	}
+
+	const TSharedPtr<FJsonValue> StringId = FGenCommandServer::FindRequestId(TEXT("{\"type\":\"x\" \"request_id\":\"ab\\\"c\"}"));
+	if (TestTrue(TEXT("String id"), StringId.IsValid() && StringId->Type == EJson::String))
+	{
+		TestEqual(TEXT("Escapes are decoded"), StringId->AsString(), FString(TEXT("ab\"c")));
+	}
+
+	const TSharedPtr<FJsonValue> LastId = FGenCommandServer::FindRequestId(TEXT("{\"params\":{\"request_id\":1},\"type\":,\"request_id\":2}"));
+	if (TestTrue(TEXT("Last id"), LastId.IsValid()))
+	{
+		TestEqual(TEXT("The last occurrence wins"), static_cast<int32>(LastId->AsNumber()), 2);
+	}
+
+	TestFalse(TEXT("No id"), FGenCommandServer::FindRequestId(TEXT("{\"type\":\"x\"")).IsValid());
+	TestFalse(TEXT("Truncated string id"), FGenCommandServer::FindRequestId(TEXT("{\"request_id\":\"ab")).IsValid());
+	TestFalse(TEXT("Truncated number id"), FGenCommandServer::FindRequestId(TEXT("{\"request_id\":-")).IsValid());
+	TestFalse(TEXT("Other id types"), FGenCommandServer::FindRequestId(TEXT("{\"request_id\":null,")).IsValid());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenCommandServerInvalidJsonTest, "GenerativeAISupport.MCP.InvalidJson",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenCommandServerInvalidJsonTest::RunTest(const FString& Parameters)
+{
+	FGenCommandServer& Server = FGenCommandServer::Get();
+	if (Server.IsRunning())
+	{
+		AddInfo(TEXT("Skipped, the native command server is already running"));
+		return true;
+	}
+	if (!TestTrue(TEXT("Server starts"), Server.Start(CommandServerTestPort)))
+	{
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("GenCommandServerTest"), false);
+	const TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetIp(FIPv4Address(127, 0, 0, 1).Value);
+	Address->SetPort(CommandServerTestPort);
+
+	if (TestTrue(TEXT("Client connects"), Socket->Connect(*Address)))
+	{
+		// Pipelined in one write, handshake runs inline on the I/O thread so the game thread is not needed
+		TArray<uint8> Batch = FGenCommandServer::MakeFrame(TEXT("{\"type\":\"handshake\",\"message\":\"hi\",\"request_id\":1}"));
+		Batch.Append(FGenCommandServer::MakeFrame(TEXT("{\"type\":\"handshake\",\"message\":,\"request_id\":\"two\"}")));
+		TestTrue(TEXT("Batch sent"), SendAll(*Socket, Batch));
+
+		TSharedPtr<FJsonObject> Response;
+		if (TestTrue(TEXT("Handshake response"), ReadResponse(*Socket, Response)))
+		{
+			TestTrue(TEXT("Handshake succeeds"), Response->GetBoolField(TEXT("success")));
+			TestEqual(TEXT("Handshake id"), static_cast<int32>(Response->GetNumberField(TEXT("request_id"))), 1);
+		}
+		if (TestTrue(TEXT("Invalid JSON response"), ReadResponse(*Socket, Response)))
+		{
+			TestFalse(TEXT("Invalid JSON fails"), Response->GetBoolField(TEXT("success")));
+			TestEqual(TEXT("Error"), Response->GetStringField(TEXT("error")), FString(TEXT("Invalid JSON format")));
+			TestEqual(TEXT("The recovered id is echoed"), Response->GetStringField(TEXT("request_id")), FString(TEXT("two")));
+		}
+
+		// Nothing identifies this one, the server closes the connection so the client fails every pending request
+		AddExpectedError(TEXT("invalid JSON without a request_id"), EAutomationExpectedErrorFlags::Contains, 1);
+		TestTrue(TEXT("Anonymous invalid JSON sent"), SendAll(*Socket, FGenCommandServer::MakeFrame(TEXT("{\"type\":"))));
+		TestFalse(TEXT("Connection is closed"), ReadResponse(*Socket, Response));
+	}
+
+	Socket->Close();
+	SocketSubsystem->DestroySocket(Socket);
+	Server.Shutdown();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenCommandServerSlowReaderTest, "GenerativeAISupport.MCP.SlowReader",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenCommandServerSlowReaderTest::RunTest(const FString& Parameters)
+{
+	// Several times the socket buffers, so the server runs into a full send buffer
+	constexpr int32 MessageSize = 8 * 1024 * 1024;
+
+	FGenCommandServer& Server = FGenCommandServer::Get();
+	if (Server.IsRunning())
+	{
+		AddInfo(TEXT("Skipped, the native command server is already running"));
+		return true;
+	}
+	if (!TestTrue(TEXT("Server starts"), Server.Start(CommandServerTestPort)))
+	{
+		return false;
+	}
+
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+	FSocket* Socket = SocketSubsystem->CreateSocket(NAME_Stream, TEXT("GenCommandServerTest"), false);
+	int32 ReceiveBufferSize = 0;
+	Socket->SetReceiveBufferSize(64 * 1024, ReceiveBufferSize);
+	const TSharedRef<FInternetAddr> Address = SocketSubsystem->CreateInternetAddr();
+	Address->SetIp(FIPv4Address(127, 0, 0, 1).Value);
+	Address->SetPort(CommandServerTestPort);
+
+	if (TestTrue(TEXT("Client connects"), Socket->Connect(*Address)))
+	{
+		const FString Message = FString::ChrN(MessageSize, TEXT('x'));
+		TestTrue(TEXT("Large request sent"), SendAll(*Socket, FGenCommandServer::MakeFrame(
+			FString::Printf(TEXT("{\"type\":\"handshake\",\"message\":\"%s\",\"request_id\":1}"), *Message))));
+
+		// Not reading while the server writes the echo, its sends fail with EWOULDBLOCK until the client catches up
+		FPlatformProcess::Sleep(2.0f);
+
+		TSharedPtr<FJsonObject> Response;
+		if (TestTrue(TEXT("Large response arrives"), ReadLargeResponse(*Socket, Response)))
+		{
+			TestEqual(TEXT("Large response id"), static_cast<int32>(Response->GetNumberField(TEXT("request_id"))), 1);
+			TestEqual(TEXT("Whole message is echoed"), Response->GetStringField(TEXT("message")).Len(), MessageSize + 10);
+		}
+
+		// The connection survived the full send buffer
+		TestTrue(TEXT("Next request sent"), SendAll(*Socket, FGenCommandServer::MakeFrame(
+			TEXT("{\"type\":\"handshake\",\"message\":\"hi\",\"request_id\":2}"))));
+		if (TestTrue(TEXT("Next response arrives"), ReadResponse(*Socket, Response)))
+		{
+			TestEqual(TEXT("Next response id"), static_cast<int32>(Response->GetNumberField(TEXT("request_id"))), 2);
+		}
+	}
+
+	Socket->Close();
+	SocketSubsystem->DestroySocket(Socket);
+	Server.Shutdown();
+	return true;
+}
+
+#endif
@@ -0,0 +1,187 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Dom/JsonObject.h"
+#include "EdGraphSchema_K2.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenBlueprintUtils.h"
+#include "ScopedTransaction.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Tests/GenTestBlueprint.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	TSharedPtr<FJsonObject> ParseResponse(const FString& Json)
+	{
+		TSharedPtr<FJsonObject> Response;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Response);
+		return Response.IsValid() ? Response : MakeShareable(new FJsonObject());
+	}
+
+	UEdGraphNode* AddBranch(UBlueprint* Blueprint, float X)
+	{
+		FGuid NodeGuid;
+		FGuid::Parse(UGenBlueprintNodeCreator::AddNode(Blueprint->GetPathName(), TEXT("EventGraph"), TEXT("Branch"), X, 0.0f,
+		                                               FString(), false), NodeGuid);
+		return FGenNodeGuidIndex::Get().FindNode(Blueprint, NodeGuid);
+	}
+
+	TSharedPtr<FJsonValue> MakeJsonObjectValue(const TMap<FString, FString>& Fields)
+	{
+		const TSharedPtr<FJsonObject> Object = MakeShareable(new FJsonObject());
+		for (const TPair<FString, FString>& Field : Fields)
+		{
+			Object->SetStringField(Field.Key, Field.Value);
+		}
+		return MakeShareable(new FJsonValueObject(Object));
+	}
+
+	struct FWiringRun
+	{
+		int32 Connected = 0;
+		double MicrosecondsPerConnection = 0.0;
+		int32 Rebuilds = 0;
+		int32 GraphSyncs = 0;
+	};
+
+	// Chains NodeCount PrintString nodes in the event graph with one bulk connect
+	FWiringRun WireChain(int32 NodeCount)
+	{
+		UBlueprint* Blueprint = FGenTestBlueprint::Create(FString::Printf(TEXT("BP_WiringScaling_%d"), NodeCount));
+		TArray<TSharedPtr<FJsonValue>> Nodes;
+		for (int32 Index = 0; Index < NodeCount; ++Index)
+		{
+			const TSharedPtr<FJsonObject> Node = MakeShareable(new FJsonObject());
+			Node->SetStringField(TEXT("id"), FString::Printf(TEXT("n%d"), Index));
+			Node->SetStringField(TEXT("node_type"), TEXT("PrintString"));
+			Node->SetArrayField(TEXT("node_position"), {MakeShareable(new FJsonValueNumber((Index % 20) * 300.0)),
+			                                            MakeShareable(new FJsonValueNumber((Index / 20) * 200.0))});
+			Nodes.Add(MakeShareable(new FJsonValueObject(Node)));
+		}
+		FString Error;
+		const TArray<TSharedPtr<FJsonValue>> Created = UGenBlueprintNodeCreator::AddNodesToGraph(Blueprint->GetPathName(), TEXT("EventGraph"), Nodes, Error);
+
+		TArray<TSharedPtr<FJsonValue>> Connections;
+		for (int32 Index = 0; Index + 1 < Created.Num(); ++Index)
+		{
+			Connections.Add(MakeJsonObjectValue({
+				{TEXT("source_node_id"), Created[Index]->AsObject()->GetStringField(TEXT("node_guid"))},
+				{TEXT("source_pin"), UEdGraphSchema_K2::PN_Then.ToString()},
+				{TEXT("target_node_id"), Created[Index + 1]->AsObject()->GetStringField(TEXT("node_guid"))},
+				{TEXT("target_pin"), UEdGraphSchema_K2::PN_Execute.ToString()},
+			}));
+		}
+
+		FGenNodeGuidIndex& NodeIndex = FGenNodeGuidIndex::Get();
+		const int32 RebuildCount = NodeIndex.GetRebuildCount();
+		const int32 GraphSyncCount = NodeIndex.GetGraphSyncCount();
+		const TSharedPtr<FJsonObject> Response = UGenBlueprintUtils::ConnectNodesInGraph(Blueprint->GetPathName(), TEXT("EventGraph"), Connections);
+
+		FWiringRun Run;
+		Run.Connected = static_cast<int32>(Response->GetNumberField(TEXT("successful_connections")));
+		Run.MicrosecondsPerConnection = Response->GetNumberField(TEXT("average_connection_ms")) * 1000.0;
+		Run.Rebuilds = NodeIndex.GetRebuildCount() - RebuildCount;
+		Run.GraphSyncs = NodeIndex.GetGraphSyncCount() - GraphSyncCount;
+		FGenTestBlueprint::Destroy(Blueprint);
+		return Run;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenConnectNodesUndoTest, "GenerativeAISupport.MCP.ConnectNodesUndo",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenConnectNodesUndoTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_ConnectNodesUndo"));
+	UEdGraphNode* Source = AddBranch(Blueprint, 0.0f);
+	UEdGraphNode* Target = AddBranch(Blueprint, 300.0f);
+	if (!TestNotNull(TEXT("Source node"), Source) || !TestNotNull(TEXT("Target node"), Target))
+	{
+		FGenTestBlueprint::Destroy(Blueprint);
+		return false;
+	}
+
+	TSharedPtr<FJsonObject> Response;
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("Connect nodes test")));
+		Response = ParseResponse(UGenBlueprintUtils::ConnectNodes(Blueprint->GetPathName(), TEXT("EventGraph"),
+		                                                          Source->NodeGuid.ToString(), UEdGraphSchema_K2::PN_Then.ToString(),
+		                                                          Target->NodeGuid.ToString(), UEdGraphSchema_K2::PN_Execute.ToString()));
+	}
+
+	UEdGraphPin* SourcePin = Source->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+	UEdGraphPin* TargetPin = Target->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+	if (TestTrue(TEXT("Connected"), Response->GetBoolField(TEXT("success"))) && TestNotNull(TEXT("Source pin"), SourcePin) &&
+		TestNotNull(TEXT("Target pin"), TargetPin))
+	{
+		TestTrue(TEXT("Source is linked"), SourcePin->LinkedTo.Contains(TargetPin));
+		TestTrue(TEXT("Target is linked"), TargetPin->LinkedTo.Contains(SourcePin));
+
+		// Undo has to restore both pins, a link left on either one points into a graph that no longer has it
+		TestTrue(TEXT("Undo"), GEditor->UndoTransaction());
+		SourcePin = Source->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+		TargetPin = Target->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input);
+		TestEqual(TEXT("Undo unlinks the source"), SourcePin ? SourcePin->LinkedTo.Num() : -1, 0);
+		TestEqual(TEXT("Undo unlinks the target"), TargetPin ? TargetPin->LinkedTo.Num() : -1, 0);
+	}
+
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenConnectNodesErrorsTest, "GenerativeAISupport.MCP.ConnectNodesErrors",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenConnectNodesErrorsTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_ConnectNodesErrors"));
+	const FString NodeGuid = FGuid::NewGuid().ToString();
+
+	TSharedPtr<FJsonObject> Response = ParseResponse(UGenBlueprintUtils::ConnectNodes(
+		Blueprint->GetPathName(), TEXT("not-a-guid"), NodeGuid, TEXT("then"), NodeGuid, TEXT("execute")));
+	TestEqual(TEXT("Malformed function GUID"), Response->GetStringField(TEXT("error")), FString(TEXT("Invalid function GUID")));
+
+	Response = ParseResponse(UGenBlueprintUtils::ConnectNodes(
+		Blueprint->GetPathName(), FGuid::NewGuid().ToString(), NodeGuid, TEXT("then"), NodeGuid, TEXT("execute")));
+	TestEqual(TEXT("Unknown function graph"), Response->GetStringField(TEXT("error")), FString(TEXT("Could not find function graph")));
+
+	Response = UGenBlueprintUtils::ConnectNodesInGraph(Blueprint->GetPathName(), TEXT("not-a-guid"), {});
+	TestEqual(TEXT("Bulk connections report it too"), Response->GetStringField(TEXT("error")), FString(TEXT("Invalid function GUID")));
+
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenWiringScalingBenchmark, "GenerativeAISupport.MCP.WiringScaling",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGenWiringScalingBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 SmallGraph = 250;
+	constexpr int32 LargeGraph = 2000;
+
+	const FWiringRun Small = WireChain(SmallGraph);
+	const FWiringRun Large = WireChain(LargeGraph);
+	TestEqual(TEXT("Small chain is wired"), Small.Connected, SmallGraph - 1);
+	TestEqual(TEXT("Large chain is wired"), Large.Connected, LargeGraph - 1);
+
+	// Every lookup is a hit in a graph that is in step, wiring never re-reads the graph per connection
+	TestEqual(TEXT("No rebuild while wiring"), Large.Rebuilds, 0);
+	TestTrue(TEXT("At most one graph re-read while wiring"), Large.GraphSyncs <= 1);
+
+	// Linear wiring keeps the cost per connection flat, a scan per lookup would grow it with the graph (8x here)
+	const double Growth = Small.MicrosecondsPerConnection > 0.0 ? Large.MicrosecondsPerConnection / Small.MicrosecondsPerConnection : 1.0;
+	UE_LOG(LogGenPerformance, Display, TEXT("Wiring %d nodes took: %f us per connection, %d nodes: %f us per connection (%.2fx)"),
+	       SmallGraph, Small.MicrosecondsPerConnection, LargeGraph, Large.MicrosecondsPerConnection, Growth);
+	TestTrue(TEXT("Cost per connection does not grow with the graph"), Growth < 3.0);
+	return true;
+}
+
+#endif
@@ -0,0 +1,121 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "GenerativeAISupportSettings.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenBlueprintUtils.h"
+#include "MCP/GenCommandBatch.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	// Long enough that the idle flush never runs while a test is checking what is pending
+	constexpr float TestIdleDelaySeconds = 60.0f;
+
+	// Restores the compile idle delay of the plugin settings when the test ends
+	struct FScopedIdleDelay
+	{
+		float PreviousDelay;
+
+		explicit FScopedIdleDelay(float Delay)
+		{
+			UGenerativeAISupportSettings* Settings = GetMutableDefault<UGenerativeAISupportSettings>();
+			PreviousDelay = Settings->CompileIdleDelaySeconds;
+			Settings->CompileIdleDelaySeconds = Delay;
+		}
+
+		~FScopedIdleDelay()
+		{
+			GetMutableDefault<UGenerativeAISupportSettings>()->CompileIdleDelaySeconds = PreviousDelay;
+		}
+	};
+
+	TSharedPtr<FJsonValue> MakeHandshake(const FString& BlueprintPath, const FString& Message)
+	{
+		const TSharedPtr<FJsonObject> Operation = MakeShareable(new FJsonObject());
+		Operation->SetStringField(TEXT("type"), TEXT("handshake"));
+		Operation->SetStringField(TEXT("blueprint_path"), BlueprintPath);
+		Operation->SetStringField(TEXT("message"), Message);
+		return MakeShareable(new FJsonValueObject(Operation));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenEditSessionPendingTest, "GenerativeAISupport.MCP.EditSessionPending",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenEditSessionPendingTest::RunTest(const FString& Parameters)
+{
+	const FScopedIdleDelay IdleDelay(TestIdleDelaySeconds);
+	FGenEditSession& Session = FGenEditSession::Get();
+	UBlueprint* Queued = FGenTestBlueprint::Create(TEXT("BP_EditSessionQueued"));
+	UBlueprint* Edited = FGenTestBlueprint::Create(TEXT("BP_EditSessionEdited"));
+
+	// A session only hands out the Blueprints edited while it was open
+	Session.RequestCompile(Queued);
+	Session.BeginSession();
+	Session.RequestStructuralModification(Edited);
+	const TArray<UBlueprint*> Taken = Session.EndSessionAndTakePending();
+	TestEqual(TEXT("One Blueprint taken"), Taken.Num(), 1);
+	TestTrue(TEXT("The session's edit is taken"), Taken.Contains(Edited));
+	TestFalse(TEXT("The earlier compile is not taken"), Taken.Contains(Queued));
+	TestEqual(TEXT("The earlier compile stays pending"), Session.Flush(Queued), 1);
+
+	// A rolled back batch drops its own edits only
+	Session.RequestCompile(Queued);
+	const TSharedPtr<FJsonObject> Batch = MakeShareable(new FJsonObject());
+	Batch->SetArrayField(TEXT("operations"), {
+		MakeHandshake(Edited->GetPathName(), TEXT("hi")),
+		MakeHandshake(Edited->GetPathName(), TEXT("${missing.message}")),
+	});
+	Batch->SetBoolField(TEXT("compile"), false);
+	Batch->SetBoolField(TEXT("rollback_on_error"), true);
+	const TSharedPtr<FJsonObject> Response = FGenCommandBatch::Execute(Batch);
+	TestTrue(TEXT("Batch is rolled back"), Response->GetBoolField(TEXT("rolled_back")));
+	TestEqual(TEXT("The compile queued before the batch survives the rollback"), Session.Flush(Queued), 1);
+
+	FGenTestBlueprint::Destroy(Queued);
+	FGenTestBlueprint::Destroy(Edited);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenEditSessionSkeletonTest, "GenerativeAISupport.MCP.EditSessionSkeleton",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenEditSessionSkeletonTest::RunTest(const FString& Parameters)
+{
+	const FScopedIdleDelay IdleDelay(TestIdleDelaySeconds);
+	FGenEditSession& Session = FGenEditSession::Get();
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_EditSessionSkeleton"));
+	const FString BlueprintPath = Blueprint->GetPathName();
+
+	Session.BeginSession();
+	const FString FunctionGuid = UGenBlueprintUtils::AddFunction(BlueprintPath, TEXT("GetScore"),
+	                                                             TEXT("[{\"name\": \"Bonus\", \"type\": \"int\"}]"), TEXT("[]"));
+	TestFalse(TEXT("Function is added"), FunctionGuid.IsEmpty());
+
+	// The next node sees the new signature although the compile waits for the session to end
+	const int32 CompilesBefore = static_cast<int32>(Session.GetStats()->GetNumberField(TEXT("compiles")));
+	TestFalse(TEXT("Node is added"), UGenBlueprintNodeCreator::AddNode(BlueprintPath, TEXT("EventGraph"), TEXT("Branch"), 0.0f, 0.0f,
+	                                                                   FString(), false).IsEmpty());
+	const UFunction* Function = Blueprint->SkeletonGeneratedClass
+		                            ? Blueprint->SkeletonGeneratedClass->FindFunctionByName(TEXT("GetScore"))
+		                            : nullptr;
+	if (TestNotNull(TEXT("Skeleton has the function"), Function))
+	{
+		TestNotNull(TEXT("Skeleton has the parameter"), Function->FindPropertyByName(TEXT("Bonus")));
+	}
+	TestEqual(TEXT("Nothing is compiled yet"), static_cast<int32>(Session.GetStats()->GetNumberField(TEXT("compiles"))), CompilesBefore);
+
+	const TArray<UBlueprint*> Taken = Session.EndSessionAndTakePending();
+	TestTrue(TEXT("The compile is still handed out"), Taken.Contains(Blueprint));
+
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+#endif
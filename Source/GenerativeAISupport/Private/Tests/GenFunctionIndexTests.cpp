@@ -0,0 +1,129 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "MCP/GenFunctionIndex.h"
+
+namespace
+{
+	FString FindBestMatch(const FString& NodeType, const FGenFunctionIndex::FScoreWeights& Weights)
+	{
+		FGenFunctionIndex& Index = FGenFunctionIndex::Get();
+		TArray<FGenFunctionMatch> Matches;
+		Index.FindMatches(NodeType, Weights, 1, Matches);
+		return Matches.Num() > 0 ? Index.GetDisplayName(Matches[0].Index) : FString();
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenFunctionIndexNamesTest, "GenerativeAISupport.MCP.FunctionIndex.Names",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenFunctionIndexNamesTest::RunTest(const FString& Parameters)
+{
+	TArray<FString> Tokens;
+	FGenFunctionIndex::Tokenize(TEXT("K2_GetActorLocation"), Tokens);
+	TestEqual(TEXT("Underscores and camel case"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("k2 get actor location")));
+	FGenFunctionIndex::Tokenize(TEXT("GetAIController"), Tokens);
+	TestEqual(TEXT("Acronyms stay together"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("get ai controller")));
+	FGenFunctionIndex::Tokenize(TEXT("Add_IntInt"), Tokens);
+	TestEqual(TEXT("Tokens are unique"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("add int")));
+	FGenFunctionIndex::Tokenize(TEXT("Vector2DToVector"), Tokens);
+	TestEqual(TEXT("Digits end a word"), FString::Join(Tokens, TEXT(" ")), FString(TEXT("vector2 d to vector")));
+
+	TestEqual(TEXT("K2 prefix is dropped"), FGenFunctionIndex::NormalizeName(TEXT("K2_GetActorLocation")), FString(TEXT("getactorlocation")));
+	TestEqual(TEXT("Node titles normalize like names"), FGenFunctionIndex::NormalizeName(TEXT("Get Actor Location")), FString(TEXT("getactorlocation")));
+	TestEqual(TEXT("A bare K2 is kept"), FGenFunctionIndex::NormalizeName(TEXT("K2")), FString(TEXT("k2")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenFunctionIndexLookupTest, "GenerativeAISupport.MCP.FunctionIndex.Lookup",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenFunctionIndexLookupTest::RunTest(const FString& Parameters)
+{
+	FGenFunctionIndex& Index = FGenFunctionIndex::Get();
+	TestTrue(TEXT("Catalog holds the engine libraries"), Index.Num() > 1000);
+
+	const FGenFunctionIndex::FScoreWeights& Weights = FGenFunctionIndex::CreationWeights;
+	TestEqual(TEXT("Function name"), FindBestMatch(TEXT("PrintString"), Weights), FString(TEXT("KismetSystemLibrary.PrintString")));
+	TestEqual(TEXT("K2 prefixed functions by their plain name"), FindBestMatch(TEXT("GetActorLocation"), Weights), FString(TEXT("Actor.K2_GetActorLocation")));
+	TestEqual(TEXT("Node title"), FindBestMatch(TEXT("Get Actor Location"), Weights), FString(TEXT("Actor.K2_GetActorLocation")));
+	TestEqual(TEXT("Suggestion format with a class hint"), FindBestMatch(TEXT("KismetMathLibrary.Add_IntInt"), Weights), FString(TEXT("KismetMathLibrary.Add_IntInt")));
+
+	// BlueprintInternalUseOnly functions are wrapped by dedicated nodes and never offered directly
+	TArray<FGenFunctionMatch> Matches;
+	Index.FindMatches(TEXT("BeginDeferredActorSpawnFromClass"), Weights, 0, Matches);
+	for (const FGenFunctionMatch& Match : Matches)
+	{
+		TestNotEqual(TEXT("Hidden functions are skipped"), Index.GetDisplayName(Match.Index), FString(TEXT("GameplayStatics.BeginDeferredActorSpawnFromClass")));
+	}
+
+	Index.FindMatches(TEXT("Add"), FGenFunctionIndex::SuggestionWeights, 5, Matches);
+	TestTrue(TEXT("MaxResults limits the matches"), Matches.Num() <= 5);
+	for (int32 MatchIndex = 1; MatchIndex < Matches.Num(); ++MatchIndex)
+	{
+		TestTrue(TEXT("Best matches first"), Matches[MatchIndex - 1].Score >= Matches[MatchIndex].Score);
+	}
+
+	Index.FindMatches(TEXT("__"), Weights, 0, Matches);
+	TestEqual(TEXT("Names without alphanumerics match nothing"), Matches.Num(), 0);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenFunctionIndexFuzzyTest, "GenerativeAISupport.MCP.FunctionIndex.FuzzyScoring",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenFunctionIndexFuzzyTest::RunTest(const FString& Parameters)
+{
+	TestEqual(TEXT("Missing letter"), FGenFunctionIndex::EditDistance(TEXT("printstrng"), TEXT("printstring"), 2), 1);
+	TestEqual(TEXT("Transposition is one edit"), FGenFunctionIndex::EditDistance(TEXT("pirntstring"), TEXT("printstring"), 2), 1);
+	TestEqual(TEXT("Identical"), FGenFunctionIndex::EditDistance(TEXT("delay"), TEXT("delay"), 2), 0);
+	TestEqual(TEXT("Capped at MaxDistance + 1"), FGenFunctionIndex::EditDistance(TEXT("abc"), TEXT("xyzxyz"), 1), 2);
+	TestEqual(TEXT("Capped when the rows drift apart"), FGenFunctionIndex::EditDistance(TEXT("abcdef"), TEXT("uvwxyz"), 2), 3);
+
+	FGenFunctionIndex& Index = FGenFunctionIndex::Get();
+	const FGenFunctionIndex::FScoreWeights& Weights = FGenFunctionIndex::CreationWeights;
+	TArray<FGenFunctionMatch> Matches;
+
+	Index.FindMatches(TEXT("PrintStrng"), Weights, 10, Matches);
+	if (TestTrue(TEXT("Typo matches"), Matches.Num() > 0))
+	{
+		TestEqual(TEXT("Typo resolves to the intended function"), Index.GetDisplayName(Matches[0].Index), FString(TEXT("KismetSystemLibrary.PrintString")));
+		TestTrue(TEXT("Typo is a near miss"), Matches[0].bNearMiss);
+		TestFalse(TEXT("Typos are not learned"), FGenFunctionIndex::IsConfidentResolution(Matches, Weights));
+	}
+
+	Index.FindMatches(TEXT("PrintString"), Weights, 10, Matches);
+	if (TestTrue(TEXT("Exact name matches"), Matches.Num() > 0))
+	{
+		TestFalse(TEXT("Exact names are not near misses"), Matches[0].bNearMiss);
+		TestTrue(TEXT("Exact names outscore their typos"), Matches[0].Score >= Weights.Exact);
+	}
+
+	// Three edits away, more than an eight letter name tolerates
+	Index.FindMatches(TEXT("PrntStrg"), Weights, 10, Matches);
+	for (const FGenFunctionMatch& Match : Matches)
+	{
+		if (Index.GetDisplayName(Match.Index) == TEXT("KismetSystemLibrary.PrintString"))
+		{
+			TestFalse(TEXT("Too many edits for a near miss"), Match.bNearMiss);
+		}
+	}
+
+	// Learning policy on scripted rankings
+	TestFalse(TEXT("Nothing to learn"), FGenFunctionIndex::IsConfidentResolution({}, Weights));
+	TestTrue(TEXT("Unique exact-level match"), FGenFunctionIndex::IsConfidentResolution({{0, Weights.Exact + 20, false}}, Weights));
+	TestFalse(TEXT("Near miss"), FGenFunctionIndex::IsConfidentResolution({{0, Weights.Exact + 20, true}}, Weights));
+	TestFalse(TEXT("Below an exact name"), FGenFunctionIndex::IsConfidentResolution({{0, Weights.Exact - 1, false}}, Weights));
+	TestFalse(TEXT("Runner-up within one edit"), FGenFunctionIndex::IsConfidentResolution(
+		{{0, Weights.Exact + 20, false}, {1, Weights.Exact + 20 - Weights.Typo, false}}, Weights));
+	TestTrue(TEXT("Clear lead"), FGenFunctionIndex::IsConfidentResolution(
+		{{0, Weights.Exact + 20, false}, {1, Weights.Exact - Weights.Typo, false}}, Weights));
+	return true;
+}
+
+#endif
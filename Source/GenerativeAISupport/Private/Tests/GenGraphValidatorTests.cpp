@@ -0,0 +1,100 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "EdGraphSchema_K2.h"
+#include "K2Node_IfThenElse.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "MCP/GenGraphValidator.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	UEdGraphNode* AddBranch(UBlueprint* Blueprint, float X)
+	{
+		FGuid NodeGuid;
+		FGuid::Parse(UGenBlueprintNodeCreator::AddNode(Blueprint->GetPathName(), TEXT("EventGraph"), TEXT("Branch"), X, 0.0f,
+		                                               FString(), false), NodeGuid);
+		return FGenNodeGuidIndex::Get().FindNode(Blueprint, NodeGuid);
+	}
+
+	int32 CountDiagnostics(const TSharedPtr<FJsonObject>& Validation, const FString& Code)
+	{
+		int32 Count = 0;
+		for (const TSharedPtr<FJsonValue>& Diagnostic : Validation->GetArrayField(TEXT("diagnostics")))
+		{
+			Count += Diagnostic->AsObject()->GetStringField(TEXT("code")) == Code ? 1 : 0;
+		}
+		return Count;
+	}
+
+	int32 GetFixed(const TSharedPtr<FJsonObject>& Validation)
+	{
+		return static_cast<int32>(Validation->GetNumberField(TEXT("fixed")));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenGraphValidatorTest, "GenerativeAISupport.MCP.GraphValidator",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenGraphValidatorTest::RunTest(const FString& Parameters)
+{
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_GraphValidator"));
+	UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+	UEdGraphNode* First = AddBranch(Blueprint, 0.0f);
+	UEdGraphNode* Second = AddBranch(Blueprint, 300.0f);
+	UEdGraphNode* Source = AddBranch(Blueprint, -300.0f);
+	if (!TestNotNull(TEXT("First node"), First) || !TestNotNull(TEXT("Second node"), Second) || !TestNotNull(TEXT("Source node"), Source))
+	{
+		FGenTestBlueprint::Destroy(Blueprint);
+		return false;
+	}
+
+	// Exec output linked twice
+	UEdGraphPin* SourceThen = Source->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+	SourceThen->MakeLinkTo(First->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input));
+	SourceThen->MakeLinkTo(Second->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input));
+
+	// Two outputs linked to each other
+	UEdGraphPin* FirstThen = First->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+	UEdGraphPin* SecondThen = Second->FindPin(UEdGraphSchema_K2::PN_Then, EGPD_Output);
+	FirstThen->MakeLinkTo(SecondThen);
+
+	// Link to a node that is not in the graph
+	UK2Node_IfThenElse* Stray = NewObject<UK2Node_IfThenElse>(EventGraph);
+	Stray->AllocateDefaultPins();
+	UEdGraphPin* FirstElse = First->FindPin(UEdGraphSchema_K2::PN_Else, EGPD_Output);
+	FirstElse->MakeLinkTo(Stray->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input));
+
+	TSharedPtr<FJsonObject> Validation = FGenGraphValidator::Validate(Blueprint);
+	TestEqual(TEXT("Output to output link is reported once"), CountDiagnostics(Validation, TEXT("direction_mismatch")), 1);
+	TestEqual(TEXT("Doubled exec link"), CountDiagnostics(Validation, TEXT("multiple_exec_links")), 1);
+	TestEqual(TEXT("Dangling link"), CountDiagnostics(Validation, TEXT("dangling_link")), 1);
+	TestEqual(TEXT("Validating alone fixes nothing"), GetFixed(Validation), 0);
+	TestEqual(TEXT("Exec links are untouched"), SourceThen->LinkedTo.Num(), 2);
+	TestEqual(TEXT("Broken links are untouched"), FirstElse->LinkedTo.Num(), 1);
+
+	// The compile repair only drops extra exec links
+	Validation = FGenGraphValidator::Validate(Blueprint, EGenGraphFix::ExecLinks);
+	TestEqual(TEXT("One link fixed"), GetFixed(Validation), 1);
+	TestEqual(TEXT("Exec output keeps its first link"), SourceThen->LinkedTo.Num(), 1);
+	TestEqual(TEXT("Dropped link is gone from both pins"), Second->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input)->LinkedTo.Num(), 0);
+	TestEqual(TEXT("Dangling link is kept"), FirstElse->LinkedTo.Num(), 1);
+	TestTrue(TEXT("Output to output link is kept"), FirstThen->LinkedTo.Contains(SecondThen));
+
+	Validation = FGenGraphValidator::Validate(Blueprint, EGenGraphFix::All);
+	TestEqual(TEXT("Dangling link fixed"), GetFixed(Validation), 1);
+	TestEqual(TEXT("Dangling link is removed"), FirstElse->LinkedTo.Num(), 0);
+	TestEqual(TEXT("Dangling link is removed from the stray pin"), Stray->FindPin(UEdGraphSchema_K2::PN_Execute, EGPD_Input)->LinkedTo.Num(), 0);
+	TestEqual(TEXT("Output to output link is still reported once"), CountDiagnostics(Validation, TEXT("direction_mismatch")), 1);
+
+	FirstThen->BreakLinkTo(SecondThen);
+	FGenTestBlueprint::Destroy(Blueprint);
+	return true;
+}
+
+#endif
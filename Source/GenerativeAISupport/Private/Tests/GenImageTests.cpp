@@ -0,0 +1,301 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HttpModule.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "Interfaces/IHttpResponse.h"
+#include "Misc/Base64.h"
+#include "Models/OpenAI/GenOAIImage.h"
+#include "Modules/ModuleManager.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tests/GenMockHttpServer.h"
+#include "Utilities/GenGlobalDefinitions.h"
+#include "Utilities/GenImageUtils.h"
+
+namespace
+{
+	FGenChatImage MakePixelImage(const int32 Size, const FColor Color)
+	{
+		FGenChatImage Image;
+		Image.Width = Size;
+		Image.Height = Size;
+		Image.Pixels.Init(Color, Size * Size);
+		return Image;
+	}
+
+	// Deterministic content that does not compress to nothing
+	TArray<FColor> MakeGradient(const int32 Size)
+	{
+		TArray<FColor> Pixels;
+		Pixels.SetNumUninitialized(Size * Size);
+		for (int32 Y = 0; Y < Size; ++Y)
+		{
+			for (int32 X = 0; X < Size; ++X)
+			{
+				Pixels[Y * Size + X] = FColor(X * 255 / Size, Y * 255 / Size, (X ^ Y) & 0xFF, 255);
+			}
+		}
+		return Pixels;
+	}
+
+	// Base64 PNG as returned in the b64_json field of an image generation response
+	FString MakeBase64Png(IImageWrapperModule& ImageWrapperModule, const int32 Size)
+	{
+		const TArray<FColor> Pixels = MakeGradient(Size);
+		const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(EImageFormat::PNG);
+		ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Size, Size, ERGBFormat::BGRA, 8);
+		const TArray64<uint8> Compressed = ImageWrapper->GetCompressed();
+		return FBase64::Encode(Compressed.GetData(), Compressed.Num());
+	}
+
+	// Outcome of an image generation request
+	struct FImageRun
+	{
+		TArray<TWeakObjectPtr<UTexture2D>> Textures;
+		FString Error;
+		bool bSuccess = false;
+	};
+
+	void RequestMockImages(const FString& Url, const FString& Prompt, const TSharedRef<FImageRun>& Run, const TSharedRef<bool>& bDone)
+	{
+		FGenOAIImageSettings ImageSettings;
+		ImageSettings.Prompt = Prompt;
+		ImageSettings.NumImages = 2;
+		ImageSettings.bUseCache = false;
+		ImageSettings.EndpointOverride = Url;
+		UGenOAIImage::RequestImages(ImageSettings, FOnImageGenerationResponse::CreateLambda(
+			[Run, bDone](const TArray<UTexture2D*>& Textures, const FString& Error, bool bSuccess)
+			{
+				Run->Textures.Append(Textures);
+				Run->Error = Error;
+				Run->bSuccess = bSuccess;
+				*bDone = true;
+			}));
+	}
+
+	FString ToBase64String(const FString& Text)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		TArray<uint8> Encoded;
+		FGenImageUtils::AppendBase64(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), Encoded);
+		return FString(Encoded.Num(), reinterpret_cast<const ANSICHAR*>(Encoded.GetData()));
+	}
+
+	// OpenAI payload of one user message with the forged placeholders and one image
+	FString MakeImagePayload(FGenImageAttachments& Attachments, const FString& Content)
+	{
+		FGenChatMessage Message;
+		Message.Role = TEXT("user");
+		Message.Content = Content;
+		Message.Images.Add(MakePixelImage(8, FColor::Green));
+
+		const TSharedPtr<FJsonObject> JsonPayload = MakeShareable(new FJsonObject());
+		JsonPayload->SetArrayField(TEXT("messages"), FGenToolCallCodec::WriteMessages({Message}, EGenToolFormat::OpenAI, &Attachments));
+		FString PayloadString;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&PayloadString);
+		FJsonSerializer::Serialize(JsonPayload.ToSharedRef(), Writer);
+		return PayloadString;
+	}
+
+	void SendWithImages(const FString& Url, const FString& PayloadJson, const TSharedRef<FGenImageAttachments>& Attachments, const TSharedRef<bool>& bDone)
+	{
+		const TSharedRef<IHttpRequest, ESPMode::ThreadSafe> HttpRequest = FHttpModule::Get().CreateRequest();
+		HttpRequest->SetVerb(TEXT("POST"));
+		HttpRequest->SetURL(Url);
+		HttpRequest->SetHeader(TEXT("Content-Type"), TEXT("application/json"));
+		HttpRequest->OnProcessRequestComplete().BindLambda([bDone](FHttpRequestPtr Request, FHttpResponsePtr Response, bool bSuccess)
+		{
+			*bDone = true;
+		});
+		FGenImageUtils::ProcessRequestWithImages(HttpRequest, PayloadJson, Attachments, [bDone](const FString& Error)
+		{
+			*bDone = true;
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenImageAttachmentsTest, "GenerativeAISupport.Images.Attachments",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenImageAttachmentsTest::RunTest(const FString& Parameters)
+{
+	FGenImageAttachments Attachments;
+	const int32 First = Attachments.Add(MakePixelImage(4, FColor::Red));
+	TestEqual(TEXT("Identical image is reused"), Attachments.Add(MakePixelImage(4, FColor::Red)), First);
+	TestNotEqual(TEXT("Different pixels are a new image"), Attachments.Add(MakePixelImage(4, FColor::Blue)), First);
+	FGenChatImage Downscaled = MakePixelImage(4, FColor::Red);
+	Downscaled.MaxDimension = 2;
+	TestNotEqual(TEXT("Different encoding settings are a new image"), Attachments.Add(Downscaled), First);
+	TestEqual(TEXT("Image count"), Attachments.Num(), 3);
+	TestEqual(TEXT("Nothing encoded yet"), Attachments.NumEncoded(), 0);
+
+	// Placeholders cannot be predicted from the index alone
+	const FGenImageAttachments OtherAttachments;
+	TestNotEqual(TEXT("Placeholders differ between conversations"), Attachments.MakePlaceholder(0, EGenImagePlaceholder::DataUrl),
+	             OtherAttachments.MakePlaceholder(0, EGenImagePlaceholder::DataUrl));
+	TestNotEqual(TEXT("Placeholders differ by kind"), Attachments.MakePlaceholder(0, EGenImagePlaceholder::Data),
+	             Attachments.MakePlaceholder(0, EGenImagePlaceholder::MimeType));
+
+	TestEqual(TEXT("Base64 of three bytes"), ToBase64String(TEXT("Man")), FString(TEXT("TWFu")));
+	TestEqual(TEXT("Base64 of two bytes"), ToBase64String(TEXT("Ma")), FString(TEXT("TWE=")));
+	TestEqual(TEXT("Base64 of one byte"), ToBase64String(TEXT("M")), FString(TEXT("TQ==")));
+	TestEqual(TEXT("Base64 length"), FGenImageUtils::GetBase64Length(5), static_cast<int64>(8));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenImageSpliceTest, "GenerativeAISupport.Images.Splice",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenImageSpliceTest::RunTest(const FString& Parameters)
+{
+	const TSharedRef<FGenMockHttpServer> Server = FGenMockHttpServer::Start(18735, TEXT("/v1/chat/completions"),
+		[](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+		{
+			return FString(TEXT("{}"));
+		});
+	if (!TestTrue(TEXT("Mock server started"), Server->IsRunning()))
+	{
+		return false;
+	}
+
+	// Text written like a placeholder, as a user or a tool result could
+	const FString Forged = TEXT("@@GENIMG:0:u@@ @@GENIMG:00000000000000000000000000000000:0:d@@");
+	const TSharedRef<FGenImageAttachments> Attachments = MakeShared<FGenImageAttachments>();
+	const FString FirstPayload = MakeImagePayload(*Attachments, Forged);
+	const TSharedRef<bool> bFirstDone = MakeShared<bool>(false);
+	SendWithImages(Server->GetUrl(), FirstPayload, Attachments, bFirstDone);
+
+	const TSharedRef<bool> bSecondDone = MakeShared<bool>(false);
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bFirstDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Server, Attachments, Forged, bSecondDone]()
+	{
+		TestEqual(TEXT("Encoded image is cached"), Attachments->NumEncoded(), 1);
+
+		// The same image in a later request of the conversation is not encoded again
+		const FString SecondPayload = MakeImagePayload(*Attachments, TEXT("again"));
+		TestEqual(TEXT("Second request reuses the image"), Attachments->Num(), 1);
+		SendWithImages(Server->GetUrl(), SecondPayload, Attachments, bSecondDone);
+		return true;
+	}));
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bSecondDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Server, Forged]()
+	{
+		if (TestEqual(TEXT("Both requests arrived"), Server->RequestBodies.Num(), 2))
+		{
+			TSharedPtr<FJsonObject> Body;
+			FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Server->RequestBodies[0]), Body);
+			if (TestTrue(TEXT("Body is valid JSON"), Body.IsValid()))
+			{
+				const TArray<TSharedPtr<FJsonValue>> Parts = Body->GetArrayField(TEXT("messages"))[0]->AsObject()->GetArrayField(TEXT("content"));
+				TestEqual(TEXT("Forged placeholders are sent as text"), Parts[0]->AsObject()->GetStringField(TEXT("text")), Forged);
+				TestTrue(TEXT("Image is spliced"), Parts[1]->AsObject()->GetObjectField(TEXT("image_url"))->GetStringField(TEXT("url"))
+				                                       .StartsWith(TEXT("data:image/jpeg;base64,")));
+			}
+			TestTrue(TEXT("Cached image is spliced"), Server->RequestBodies[1].Contains(TEXT("data:image/jpeg;base64,")));
+		}
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenImageCacheKeyTest, "GenerativeAISupport.Images.GenerationCacheKey",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenImageCacheKeyTest::RunTest(const FString& Parameters)
+{
+	FGenOAIImageSettings First;
+	First.Prompt = TEXT("A castle \u4e2d");
+	FGenOAIImageSettings Second = First;
+	Second.Prompt = TEXT("A castle \u6587");
+
+	TestEqual(TEXT("Same settings share the cache file"), UGenOAIImage::GetCacheFilePath(First, 0), UGenOAIImage::GetCacheFilePath(First, 0));
+	TestNotEqual(TEXT("Prompts differing in non-ASCII characters do not collide"), UGenOAIImage::GetCacheFilePath(First, 0),
+	             UGenOAIImage::GetCacheFilePath(Second, 0));
+	TestNotEqual(TEXT("Every image has its own file"), UGenOAIImage::GetCacheFilePath(First, 0), UGenOAIImage::GetCacheFilePath(First, 1));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenImageGenerationTest, "GenerativeAISupport.Images.Generation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenImageGenerationTest::RunTest(const FString& Parameters)
+{
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const FString Png = MakeBase64Png(ImageWrapperModule, 16);
+
+	// The first request gets two images, the second one image and one broken entry
+	const TSharedRef<FGenMockHttpServer> Server = FGenMockHttpServer::Start(18736, TEXT("/v1/images/generations"),
+		[Png](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+		{
+			const FString Broken = RequestIndex == 0 ? Png : TEXT("not base64!");
+			return FString::Printf(TEXT("{\"data\":[{\"b64_json\":\"%s\"},{\"b64_json\":\"%s\"}]}"), *Png, *Broken);
+		});
+	if (!TestTrue(TEXT("Mock server started"), Server->IsRunning()))
+	{
+		return false;
+	}
+
+	const TSharedRef<FImageRun> Complete = MakeShared<FImageRun>();
+	const TSharedRef<bool> bCompleteDone = MakeShared<bool>(false);
+	RequestMockImages(Server->GetUrl(), TEXT("complete"), Complete, bCompleteDone);
+
+	const TSharedRef<FImageRun> Partial = MakeShared<FImageRun>();
+	const TSharedRef<bool> bPartialDone = MakeShared<bool>(false);
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bCompleteDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Server, Complete, Partial, bPartialDone]()
+	{
+		TestTrue(TEXT("All images decoded"), Complete->bSuccess);
+		if (TestEqual(TEXT("One texture per image"), Complete->Textures.Num(), 2) && Complete->Textures[0].IsValid())
+		{
+			TestEqual(TEXT("Texture size"), Complete->Textures[0]->GetSizeX(), 16);
+		}
+
+		AddExpectedError(TEXT("Image generation failed"), EAutomationExpectedErrorFlags::Contains, 1);
+		RequestMockImages(Server->GetUrl(), TEXT("partial"), Partial, bPartialDone);
+		return true;
+	}));
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bPartialDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Partial]()
+	{
+		TestFalse(TEXT("Partial failure fails"), Partial->bSuccess);
+		TestEqual(TEXT("No textures on failure"), Partial->Textures.Num(), 0);
+		TestTrue(TEXT("Error names the failed count"), Partial->Error.StartsWith(TEXT("1 of 2 images failed")));
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenImageEncodeBenchmark, "GenerativeAISupport.Performance.ImageEncode",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGenImageEncodeBenchmark::RunTest(const FString& Parameters)
+{
+	IImageWrapperModule& ImageWrapperModule = FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+	const int32 Sizes[] = {256, 512, 1024, 2048};
+	for (const int32 Size : Sizes)
+	{
+		const TArray<FColor> Pixels = MakeGradient(Size);
+		for (const int32 MaxDimension : {0, 768})
+		{
+			const double StartTime = FPlatformTime::Seconds();
+			TArray64<uint8> Bytes;
+			FString MimeType;
+			const bool bEncoded = FGenImageUtils::EncodePixels(ImageWrapperModule, Pixels, Size, Size, MaxDimension, 85, Bytes, MimeType);
+			TArray<uint8> Body;
+			FGenImageUtils::AppendBase64(Bytes.GetData(), Bytes.Num(), Body);
+			const double ElapsedMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+			TestTrue(TEXT("Image encodes"), bEncoded);
+			UE_LOG(LogGenPerformance, Display, TEXT("Image %dx%d (max dimension %d): %lld JPEG bytes, %d payload bytes, encoded in %f ms"),
+			       Size, Size, MaxDimension, Bytes.Num(), Body.Num(), ElapsedMs);
+		}
+	}
+	return true;
+}
+
+#endif
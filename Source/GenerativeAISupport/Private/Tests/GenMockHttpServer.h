@@ -0,0 +1,140 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "HttpRouteHandle.h"
+#include "HttpServerModule.h"
+#include "HttpServerRequest.h"
+#include "HttpServerResponse.h"
+#include "IHttpRouter.h"
+#include "Misc/AutomationTest.h"
+
+/**
+ * Local HTTP endpoint for the automation tests, the handler scripts the API responses.
+ * Requests are answered on the game thread while the HTTP server module ticks, so tests using it are latent.
+ */
+class FGenMockHttpServer : public TSharedFromThis<FGenMockHttpServer>
+{
+public:
+	// Receives the request body and the number of earlier requests, returns the response body
+	using FHandler = TFunction<FString(const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)>;
+
+	static TSharedRef<FGenMockHttpServer> Start(uint32 Port, const FString& Path, FHandler Handler)
+	{
+		return Bind(Port, Path, [Handler = MoveTemp(Handler)](const FString& Body, int32 RequestIndex)
+		{
+			EHttpServerResponseCodes Code = EHttpServerResponseCodes::Ok;
+			const FString ResponseBody = Handler(Body, RequestIndex, Code);
+			TUniquePtr<FHttpServerResponse> Response = FHttpServerResponse::Create(ResponseBody, TEXT("application/json"));
+			Response->Code = Code;
+			return Response;
+		});
+	}
+
+	// Answers every request with the same binary body, e.g. canned audio
+	static TSharedRef<FGenMockHttpServer> StartBinary(uint32 Port, const FString& Path, const FString& ContentType, const TArray<uint8>& ResponseBody)
+	{
+		return Bind(Port, Path, [ContentType, ResponseBody](const FString& Body, int32 RequestIndex)
+		{
+			TArray<uint8> ResponseBytes = ResponseBody;
+			return FHttpServerResponse::Create(MoveTemp(ResponseBytes), ContentType);
+		});
+	}
+
+	~FGenMockHttpServer()
+	{
+		if (Router.IsValid() && RouteHandle.IsValid())
+		{
+			Router->UnbindRoute(RouteHandle);
+		}
+	}
+
+	bool IsRunning() const { return RouteHandle.IsValid(); }
+
+	const FString& GetUrl() const { return Url; }
+
+	// Bodies of the requests received so far, in order
+	TArray<FString> RequestBodies;
+
+	// Same bodies as received, for binary uploads
+	TArray<TArray<uint8>> RawRequestBodies;
+
+private:
+	using FResponder = TFunction<TUniquePtr<FHttpServerResponse>(const FString& Body, int32 RequestIndex)>;
+
+	FGenMockHttpServer() = default;
+
+	static TSharedRef<FGenMockHttpServer> Bind(uint32 Port, const FString& Path, FResponder Responder)
+	{
+		TSharedRef<FGenMockHttpServer> Server = MakeShareable(new FGenMockHttpServer());
+		Server->Url = FString::Printf(TEXT("http://127.0.0.1:%u%s"), Port, *Path);
+		Server->Router = FHttpServerModule::Get().GetHttpRouter(Port, true);
+		if (Server->Router.IsValid())
+		{
+			const TWeakPtr<FGenMockHttpServer> WeakServer = Server;
+			Server->RouteHandle = Server->Router->BindRoute(FHttpPath(Path), EHttpServerRequestVerbs::VERB_POST,
+				FHttpRequestHandler::CreateLambda([WeakServer, Responder = MoveTemp(Responder)](const FHttpServerRequest& Request, const FHttpResultCallback& OnComplete)
+				{
+					const TSharedPtr<FGenMockHttpServer> Pinned = WeakServer.Pin();
+					if (!Pinned.IsValid())
+					{
+						return false;
+					}
+
+					const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(Request.Body.GetData()), Request.Body.Num());
+					const FString Body(Converted.Length(), Converted.Get());
+					TUniquePtr<FHttpServerResponse> Response = Responder(Body, Pinned->RequestBodies.Num());
+					Pinned->RequestBodies.Add(Body);
+					Pinned->RawRequestBodies.Add(Request.Body);
+					OnComplete(MoveTemp(Response));
+					return true;
+				}));
+			FHttpServerModule::Get().StartAllListeners();
+		}
+		return Server;
+	}
+
+	FString Url;
+	TSharedPtr<IHttpRouter> Router;
+	FHttpRouteHandle RouteHandle;
+};
+
+/**
+ * Waits until bDone is set by the code under test, fails the running test after TimeoutSeconds
+ */
+class FGenWaitForFlagLatentCommand : public IAutomationLatentCommand
+{
+public:
+	FGenWaitForFlagLatentCommand(const TSharedRef<bool>& InDone, double InTimeoutSeconds = 30.0)
+		: Done(InDone)
+		, TimeoutSeconds(InTimeoutSeconds)
+	{
+	}
+
+	virtual bool Update() override
+	{
+		if (*Done)
+		{
+			return true;
+		}
+		if (GetCurrentRunTime() > TimeoutSeconds)
+		{
+			if (FAutomationTestBase* Test = FAutomationTestFramework::Get().GetCurrentTest())
+			{
+				Test->AddError(TEXT("Timed out waiting for the mock request to finish"));
+			}
+			return true;
+		}
+		return false;
+	}
+
+private:
+	TSharedRef<bool> Done;
+	double TimeoutSeconds;
+};
+
+#endif
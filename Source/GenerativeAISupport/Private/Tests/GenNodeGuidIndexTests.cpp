@@ -0,0 +1,99 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "K2Node_IfThenElse.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "MCP/GenBlueprintNodeCreator.h"
+#include "ScopedTransaction.h"
+#include "Tests/GenTestBlueprint.h"
+
+namespace
+{
+	UEdGraphNode* AddBranch(UBlueprint* Blueprint)
+	{
+		const FScopedTransaction Transaction(FText::FromString(TEXT("GUID index test")));
+		FGuid NodeGuid;
+		FGuid::Parse(UGenBlueprintNodeCreator::AddNode(Blueprint->GetPathName(), TEXT("EventGraph"), TEXT("Branch"), 0.0f, 0.0f,
+		                                               FString(), false), NodeGuid);
+		return FGenNodeGuidIndex::Get().FindNode(Blueprint, NodeGuid);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenNodeGuidIndexTest, "GenerativeAISupport.MCP.NodeGuidIndex",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenNodeGuidIndexTest::RunTest(const FString& Parameters)
+{
+	FGenNodeGuidIndex& Index = FGenNodeGuidIndex::Get();
+	UBlueprint* Blueprint = FGenTestBlueprint::Create(TEXT("BP_NodeGuidIndex"));
+	UBlueprint* OtherBlueprint = FGenTestBlueprint::Create(TEXT("BP_NodeGuidIndexOther"));
+	UEdGraph* EventGraph = Blueprint->UbergraphPages[0];
+	TestTrue(TEXT("Graph lookup"), Index.FindGraph(Blueprint, EventGraph->GraphGuid) == EventGraph);
+	TestNull(TEXT("Graphs of other Blueprints"), Index.FindGraph(OtherBlueprint, EventGraph->GraphGuid));
+
+	// Added nodes reach the index through the add notification
+	const int32 RebuildCount = Index.GetRebuildCount();
+	UEdGraphNode* Node = AddBranch(Blueprint);
+	if (!TestNotNull(TEXT("Added node is found"), Node))
+	{
+		FGenTestBlueprint::Destroy(Blueprint);
+		FGenTestBlueprint::Destroy(OtherBlueprint);
+		return false;
+	}
+	const FGuid NodeGuid = Node->NodeGuid;
+	const int32 GraphSyncCount = Index.GetGraphSyncCount();
+	for (int32 Lookup = 0; Lookup < 100; ++Lookup)
+	{
+		Index.FindNode(Blueprint, NodeGuid);
+	}
+	TestEqual(TEXT("Hits do not rebuild"), Index.GetRebuildCount(), RebuildCount);
+	TestEqual(TEXT("Hits do not re-read the graph"), Index.GetGraphSyncCount(), GraphSyncCount);
+	TestNull(TEXT("Nodes of other Blueprints"), Index.FindNode(OtherBlueprint, NodeGuid));
+
+	// Undo removes the node from the graph but keeps its outer, the index must not hand it out
+	TestTrue(TEXT("Undo"), GEditor->UndoTransaction());
+	TestFalse(TEXT("Undo removed the node"), EventGraph->Nodes.Contains(Node));
+	TestNull(TEXT("Undone node is not found"), Index.FindNode(Blueprint, NodeGuid));
+	TestTrue(TEXT("Redo"), GEditor->RedoTransaction());
+	TestTrue(TEXT("Redone node is found again"), Index.FindNode(Blueprint, NodeGuid) == Node);
+
+	FBlueprintEditorUtils::RemoveNode(Blueprint, Node, true);
+	TestNull(TEXT("Removed node is not found"), Index.FindNode(Blueprint, NodeGuid));
+
+	// Edits that bypass the add and remove notifications change the node count of the graph
+	UEdGraphNode* Reported = AddBranch(Blueprint);
+	if (TestNotNull(TEXT("Second node is found"), Reported))
+	{
+		const FGuid ReportedGuid = Reported->NodeGuid;
+		EventGraph->Nodes.Remove(Reported);
+		TestNull(TEXT("Silently removed node is not found"), Index.FindNode(Blueprint, ReportedGuid));
+
+		UK2Node_IfThenElse* Unreported = NewObject<UK2Node_IfThenElse>(EventGraph);
+		Unreported->CreateNewGuid();
+		EventGraph->Nodes.Add(Unreported);
+		TestTrue(TEXT("Silently added node is found"), Index.FindNode(Blueprint, Unreported->NodeGuid) == Unreported);
+
+		// Swapping nodes keeps the count, a generic notification (as undo sends) has the graph re-read
+		EventGraph->Nodes.Remove(Unreported);
+		EventGraph->Nodes.Add(Reported);
+		EventGraph->NotifyGraphChanged();
+		TestNull(TEXT("Swapped out node is not found"), Index.FindNode(Blueprint, Unreported->NodeGuid));
+		TestTrue(TEXT("Swapped in node is found"), Index.FindNode(Blueprint, ReportedGuid) == Reported);
+	}
+
+	const int32 MissSyncCount = Index.GetGraphSyncCount();
+	TestNull(TEXT("Unknown GUID"), Index.FindNode(Blueprint, FGuid::NewGuid()));
+	TestEqual(TEXT("Misses in graphs that are in step cost no re-read"), Index.GetGraphSyncCount(), MissSyncCount);
+	TestNull(TEXT("Invalid GUID"), Index.FindNode(Blueprint, FGuid()));
+
+	FGenTestBlueprint::Destroy(Blueprint);
+	FGenTestBlueprint::Destroy(OtherBlueprint);
+	return true;
+}
+
+#endif
@@ -0,0 +1,143 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Models/Google/GenGeminiChat.h"
+#include "Models/XAI/GenGrokChat.h"
+#include "Tests/GenMockHttpServer.h"
+#include "Tools/GenToolRegistry.h"
+
+namespace
+{
+	// Outcome of a chat request run against the mock server
+	struct FProviderChatRun
+	{
+		TSharedPtr<FGenMockHttpServer> Server;
+		FString Response;
+		FString Error;
+		TArray<FString> Deltas;
+		bool bSuccess = false;
+	};
+
+	FGenChatMessage MakeUserMessage(const FString& Content)
+	{
+		FGenChatMessage Message;
+		Message.Role = TEXT("user");
+		Message.Content = Content;
+		return Message;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenGeminiSafetyStopTest, "GenerativeAISupport.Providers.Gemini.SafetyStop",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenGeminiSafetyStopTest::RunTest(const FString& Parameters)
+{
+	// Text arrives before the candidate is stopped, the request must still fail
+	const TSharedRef<FProviderChatRun> Run = MakeShared<FProviderChatRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->Server = FGenMockHttpServer::Start(18739, TEXT("/v1beta/models/mock:streamGenerateContent"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		return FString(TEXT("data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\"Once upon\"}],\"role\":\"model\"}}]}\r\n\r\n"
+			"data: {\"candidates\":[{\"content\":{\"parts\":[{\"text\":\" a time\"}],\"role\":\"model\"},\"finishReason\":\"SAFETY\"}]}\r\n\r\n"));
+	});
+
+	FGenGeminiChatSettings ChatSettings;
+	ChatSettings.Model = TEXT("mock");
+	ChatSettings.bStreamResponse = true;
+	ChatSettings.EndpointOverride = Run->Server->GetUrl();
+	ChatSettings.Messages.Add(MakeUserMessage(TEXT("Tell a story")));
+
+	AddExpectedError(TEXT("Gemini response failed"), EAutomationExpectedErrorFlags::Contains, 0);
+	UGenGeminiChat::SendChatRequest(ChatSettings,
+		FOnGeminiChatCompletionResponse::CreateLambda([Run, bDone](const FString& Response, const FString& Error, bool bSuccess)
+		{
+			Run->Response = Response;
+			Run->Error = Error;
+			Run->bSuccess = bSuccess;
+			*bDone = true;
+		}),
+		FOnGeminiChatDelta::CreateLambda([Run](const FString& Delta)
+		{
+			Run->Deltas.Add(Delta);
+		}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		TestFalse(TEXT("A SAFETY stop fails the request"), Run->bSuccess);
+		TestEqual(TEXT("Stop reason is reported"), Run->Error, FString(TEXT("Response stopped: SAFETY")));
+		TestEqual(TEXT("Partial text is passed on"), Run->Response, FString(TEXT("Once upon a time")));
+		TestEqual(TEXT("Deltas before the stop"), Run->Deltas.Num(), 2);
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenGrokToolLoopTest, "GenerativeAISupport.Providers.Grok.ToolLoop",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenGrokToolLoopTest::RunTest(const FString& Parameters)
+{
+	FGenToolRegistry::Get().RegisterNativeTool(TEXT("mock_add"), TEXT("Adds two numbers"), nullptr,
+		[](const TSharedPtr<FJsonObject>& Arguments, FString& OutError)
+		{
+			return FString::Printf(TEXT("{\"sum\":%d}"), static_cast<int32>(Arguments->GetNumberField(TEXT("a")) + Arguments->GetNumberField(TEXT("b"))));
+		}, true);
+
+	const TSharedRef<FProviderChatRun> Run = MakeShared<FProviderChatRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->Server = FGenMockHttpServer::Start(18740, TEXT("/v1/chat/completions"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		if (RequestIndex == 0)
+		{
+			return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":null,"tool_calls":[)"
+				R"({"id":"call_1","type":"function","function":{"name":"mock_add","arguments":"{\"a\":2,\"b\":3}"}}]}}]})"));
+		}
+		return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":"The sum is 5"}}]})"));
+	});
+
+	FGenGrokChatSettings ChatSettings;
+	ChatSettings.EndpointOverride = Run->Server->GetUrl();
+	ChatSettings.Messages.Add(MakeUserMessage(TEXT("Add 2 and 3")));
+	ChatSettings.Tools.Add(TEXT("mock_add"));
+
+	UGenGrokChat::SendChatRequest(ChatSettings, FOnGrokChatCompletionResponse::CreateLambda([Run, bDone](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		Run->Response = Response;
+		Run->Error = Error;
+		Run->bSuccess = bSuccess;
+		*bDone = true;
+	}));
+
+	// Streamed responses cannot carry the tool loop, that combination is refused up front
+	ChatSettings.bStreamResponse = true;
+	bool bStreamRejected = false;
+	UGenGrokChat::SendChatRequest(ChatSettings, FOnGrokChatCompletionResponse::CreateLambda([&bStreamRejected](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		bStreamRejected = !bSuccess && !Error.IsEmpty();
+	}));
+	TestTrue(TEXT("Tools with streaming are rejected"), bStreamRejected);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		FGenToolRegistry::Get().UnregisterTool(TEXT("mock_add"));
+		TestTrue(TEXT("Run succeeds"), Run->bSuccess);
+		TestEqual(TEXT("Final answer"), Run->Response, FString(TEXT("The sum is 5")));
+		if (TestEqual(TEXT("One request per round"), Run->Server->RequestBodies.Num(), 2))
+		{
+			TestTrue(TEXT("Tools are declared"), Run->Server->RequestBodies[0].Contains(TEXT("\"name\":\"mock_add\"")));
+			TestTrue(TEXT("Tool result is sent back"), Run->Server->RequestBodies[1].Contains(TEXT("\"tool_call_id\":\"call_1\"")));
+			TestTrue(TEXT("Tool output"), Run->Server->RequestBodies[1].Contains(TEXT("{\\\"sum\\\":5}")));
+		}
+		Run->Server.Reset();
+		return true;
+	}));
+	return true;
+}
+
+#endif
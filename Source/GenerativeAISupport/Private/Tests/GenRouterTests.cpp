@@ -0,0 +1,172 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Routing/GenChatRouter.h"
+#include "Routing/GenProviderHealth.h"
+#include "Tests/GenMockHttpServer.h"
+
+namespace
+{
+	constexpr int32 NumRoutedRequests = 4;
+
+	FGenRouterCandidate MakeCandidate(EGenAIOrgs Provider, const FString& Model, const FString& EndpointOverride = FString())
+	{
+		FGenRouterCandidate Candidate;
+		Candidate.Provider = Provider;
+		Candidate.Model = Model;
+		Candidate.EndpointOverride = EndpointOverride;
+		return Candidate;
+	}
+
+	const FGenEndpointHealthStats* FindStats(const TArray<FGenEndpointHealthStats>& Stats, const FString& Model)
+	{
+		return Stats.FindByPredicate([&Model](const FGenEndpointHealthStats& Entry) { return Entry.Model == Model; });
+	}
+
+	// Outcome of a series of routed requests against the mock servers
+	struct FRouterRun
+	{
+		TSharedPtr<FGenMockHttpServer> FailingServer;
+		TSharedPtr<FGenMockHttpServer> HealthyServer;
+		TArray<FGenRouterCandidate> Endpoints;
+		TArray<bool> Results;
+	};
+
+	// Sends the requests one after the other, bDone is set after the last one
+	void SendRoutedRequests(const FGenRouterSettings& RouterSettings, const TSharedRef<FRouterRun>& Run, int32 Remaining, const TSharedRef<bool>& bDone)
+	{
+		UGenChatRouter::SendChatRequest(RouterSettings, FOnRoutedChatResponse::CreateLambda(
+			[RouterSettings, Run, Remaining, bDone](const FString& Response, const FString& Error, bool bSuccess, const FGenRouterCandidate& Endpoint)
+			{
+				Run->Endpoints.Add(Endpoint);
+				Run->Results.Add(bSuccess);
+				if (Remaining > 1)
+				{
+					SendRoutedRequests(RouterSettings, Run, Remaining - 1, bDone);
+					return;
+				}
+				*bDone = true;
+			}));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenProviderHealthTest, "GenerativeAISupport.Router.ProviderHealth",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenProviderHealthTest::RunTest(const FString& Parameters)
+{
+	FGenProviderHealth& Health = FGenProviderHealth::Get();
+	Health.Reset();
+
+	const TArray<FGenRouterCandidate> Candidates = {
+		MakeCandidate(EGenAIOrgs::OpenAI, TEXT("mock-slow")),
+		MakeCandidate(EGenAIOrgs::OpenAI, TEXT("mock-fast")),
+	};
+	TestEqual(TEXT("Unmeasured endpoints come first, in order"), Health.SelectCandidate(Candidates, 0.0f, {}), 0);
+
+	for (int32 i = 0; i < 4; ++i)
+	{
+		Health.RecordResult(Candidates[0], 0.8, true);
+		Health.RecordResult(Candidates[1], 0.2, true);
+	}
+	TestEqual(TEXT("Lower latency wins"), Health.SelectCandidate(Candidates, 0.0f, {}), 1);
+	TestEqual(TEXT("Excluded endpoints are skipped"), Health.SelectCandidate(Candidates, 0.0f, {1}), 0);
+
+	TArray<FGenRouterCandidate> PricedCandidates = Candidates;
+	PricedCandidates[1].CostPer1KTokens = 2.0f;
+	TestEqual(TEXT("Cost ceiling"), Health.SelectCandidate(PricedCandidates, 1.0f, {}), 0);
+
+	for (int32 i = 0; i < FGenProviderHealth::FailuresToDegrade; ++i)
+	{
+		Health.RecordResult(Candidates[1], 0.2, false);
+	}
+	const TArray<FGenEndpointHealthStats> Stats = Health.GetStats();
+	if (const FGenEndpointHealthStats* FastStats = FindStats(Stats, TEXT("mock-fast")); TestNotNull(TEXT("Stats of the failing endpoint"), FastStats))
+	{
+		TestTrue(TEXT("Consecutive failures drain the endpoint"), FastStats->State == EGenEndpointState::Degraded);
+		TestTrue(TEXT("Error rate rises"), FastStats->ErrorRate > 0.0f);
+	}
+	TestEqual(TEXT("Drained endpoints get no traffic"), Health.SelectCandidate(Candidates, 0.0f, {}), 0);
+	TestEqual(TEXT("A drained endpoint is still the last resort"), Health.SelectCandidate(Candidates, 0.0f, {0}), 1);
+
+	Health.Reset();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenRouterSimulationTest, "GenerativeAISupport.Router.MockSimulation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenRouterSimulationTest::RunTest(const FString& Parameters)
+{
+	FGenProviderHealth::Get().Reset();
+
+	const TSharedRef<FRouterRun> Run = MakeShared<FRouterRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+	Run->FailingServer = FGenMockHttpServer::Start(18741, TEXT("/v1/chat/completions"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		OutCode = EHttpServerResponseCodes::ServerError;
+		return FString(TEXT(R"({"error":{"message":"overloaded"}})"));
+	});
+	Run->HealthyServer = FGenMockHttpServer::Start(18742, TEXT("/v1/chat/completions"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":"ok"}}]})"));
+	});
+
+	FGenRouterSettings RouterSettings;
+	RouterSettings.Temperature = 0.25f;
+	RouterSettings.MaxAttempts = 2;
+	FGenChatMessage& Message = RouterSettings.Messages.AddDefaulted_GetRef();
+	Message.Role = TEXT("user");
+	Message.Content = TEXT("Name three medieval weapons.");
+
+	// The unknown model is a configuration error, it must neither use up an attempt nor show up in the health stats
+	RouterSettings.Candidates.Add(MakeCandidate(EGenAIOrgs::Anthropic, TEXT("claude-unknown"), Run->HealthyServer->GetUrl()));
+	RouterSettings.Candidates.Add(MakeCandidate(EGenAIOrgs::OpenAI, TEXT("mock-failing"), Run->FailingServer->GetUrl()));
+	RouterSettings.Candidates.Add(MakeCandidate(EGenAIOrgs::OpenAI, TEXT("mock-healthy"), Run->HealthyServer->GetUrl()));
+
+	AddExpectedError(TEXT("is misconfigured"), EAutomationExpectedErrorFlags::Contains, NumRoutedRequests);
+	AddExpectedError(TEXT("Unexpected JSON structure"), EAutomationExpectedErrorFlags::Contains, 0);
+	SendRoutedRequests(RouterSettings, Run, NumRoutedRequests, bDone);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		TestEqual(TEXT("Every request is answered"), Run->Results.Num(), NumRoutedRequests);
+		for (int32 i = 0; i < Run->Results.Num(); ++i)
+		{
+			TestTrue(TEXT("Failed requests fall back"), Run->Results[i]);
+			TestEqual(TEXT("Answered by the healthy endpoint"), Run->Endpoints[i].Model, FString(TEXT("mock-healthy")));
+		}
+
+		// The failing endpoint is tried until it is drained, then the healthy one is used directly
+		TestEqual(TEXT("Failing endpoint requests"), Run->FailingServer->RequestBodies.Num(), FGenProviderHealth::FailuresToDegrade);
+		TestEqual(TEXT("Healthy endpoint requests"), Run->HealthyServer->RequestBodies.Num(), NumRoutedRequests);
+		for (const FString& Body : Run->HealthyServer->RequestBodies)
+		{
+			TestTrue(TEXT("Temperature is sent to OpenAI"), Body.Contains(TEXT("\"temperature\":0.25")));
+		}
+
+		const TArray<FGenEndpointHealthStats> Stats = UGenChatRouter::GetEndpointHealth();
+		TestNull(TEXT("Configuration errors are not tracked"), FindStats(Stats, TEXT("claude-unknown")));
+		if (const FGenEndpointHealthStats* FailingStats = FindStats(Stats, TEXT("mock-failing")); TestNotNull(TEXT("Failing endpoint stats"), FailingStats))
+		{
+			TestTrue(TEXT("Failing endpoint is drained"), FailingStats->State == EGenEndpointState::Degraded);
+		}
+		if (const FGenEndpointHealthStats* HealthyStats = FindStats(Stats, TEXT("mock-healthy")); TestNotNull(TEXT("Healthy endpoint stats"), HealthyStats))
+		{
+			TestEqual(TEXT("Healthy endpoint has no errors"), HealthyStats->ErrorRate, 0.0f);
+			TestEqual(TEXT("Healthy endpoint requests are tracked"), HealthyStats->NumRequests, NumRoutedRequests);
+		}
+
+		FGenProviderHealth::Get().Reset();
+		Run->FailingServer.Reset();
+		Run->HealthyServer.Reset();
+		return true;
+	}));
+	return true;
+}
+
+#endif
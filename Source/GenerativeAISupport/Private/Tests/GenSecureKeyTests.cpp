@@ -0,0 +1,70 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "Data/GenAIOrgs.h"
+#include "Secure/GenSecureKey.h"
+
+#include <atomic>
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenSecureKeyRotationTest, "GenerativeAISupport.Secure.KeyRotation",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenSecureKeyRotationTest::RunTest(const FString& Parameters)
+{
+	// Meta keys are not used by any service, so the rotation does not disturb other requests
+	const EGenAIOrgs Org = EGenAIOrgs::Meta;
+	if (!UGenSecureKey::GetEnvironmentVariable(TEXT("PS_METAAPIKEY")).IsEmpty())
+	{
+		AddInfo(TEXT("Skipped, PS_METAAPIKEY overrides the stored keys"));
+		return true;
+	}
+
+	const TArray<FString> PoolA = {TEXT("mock-key-a1"), TEXT("mock-key-a2")};
+	const TArray<FString> PoolB = {TEXT("mock-key-b1"), TEXT("mock-key-b2"), TEXT("mock-key-b3")};
+	UGenSecureKey::SetGenAIApiKeyPoolRuntime(Org, PoolA);
+
+	// Readers keep resolving keys on the thread pool while the pool is swapped far more often than the table ring is long
+	std::atomic<bool> bStop{false};
+	std::atomic<int32> NumReads{0};
+	std::atomic<int32> NumInvalidReads{0};
+	TArray<TFuture<void>> Readers;
+	for (int32 ReaderIndex = 0; ReaderIndex < 4; ++ReaderIndex)
+	{
+		Readers.Add(Async(EAsyncExecution::ThreadPool, [&bStop, &NumReads, &NumInvalidReads, &PoolA, &PoolB, Org]()
+		{
+			while (!bStop.load())
+			{
+				const FString Key = UGenSecureKey::GetGenerativeAIApiKey(Org);
+				if (!PoolA.Contains(Key) && !PoolB.Contains(Key))
+				{
+					NumInvalidReads.fetch_add(1);
+				}
+				NumReads.fetch_add(1);
+			}
+		}));
+	}
+
+	for (int32 Rotation = 0; Rotation < 1000; ++Rotation)
+	{
+		UGenSecureKey::SetGenAIApiKeyPoolRuntime(Org, Rotation % 2 == 0 ? PoolB : PoolA);
+	}
+	bStop.store(true);
+	for (TFuture<void>& Reader : Readers)
+	{
+		Reader.Wait();
+	}
+
+	TestTrue(TEXT("Keys were read during the rotation"), NumReads.load() > 0);
+	TestEqual(TEXT("Every read returns a complete key of a published pool"), NumInvalidReads.load(), 0);
+	TestTrue(TEXT("The last published pool is used"), PoolA.Contains(UGenSecureKey::GetGenerativeAIApiKey(Org)));
+
+	UGenSecureKey::SetGenAIApiKeyPoolRuntime(Org, {});
+	TestTrue(TEXT("Cleared pool"), UGenSecureKey::GetGenerativeAIApiKey(Org).IsEmpty());
+	return true;
+}
+
+#endif
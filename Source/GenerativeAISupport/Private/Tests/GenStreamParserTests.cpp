@@ -0,0 +1,157 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Serialize/GenJsonStreamParser.h"
+#include "Serialize/GenSSEParser.h"
+
+namespace
+{
+	struct FStreamedElement
+	{
+		FString Key;
+		int32 Index;
+		FString Json;
+	};
+
+	// Feeds Json in chunks of ChunkSize characters, so every split position is exercised across the tests
+	TArray<FStreamedElement> StreamJson(const FString& Json, const int32 ChunkSize, const TArray<FString>& ElementPath, bool& bOutComplete)
+	{
+		TArray<FStreamedElement> Elements;
+		FGenJsonStreamParser Parser([&Elements](const FString& Key, int32 Index, const FString& ValueJson)
+		{
+			Elements.Add({Key, Index, ValueJson});
+		}, ElementPath);
+		for (int32 Start = 0; Start < Json.Len(); Start += ChunkSize)
+		{
+			Parser.Feed(Json.Mid(Start, ChunkSize));
+		}
+		bOutComplete = Parser.IsComplete();
+		return Elements;
+	}
+
+	void FeedSSE(FGenSSEParser& Parser, const FString& Text, TArray<TPair<FString, FString>>& OutEvents)
+	{
+		const FTCHARToUTF8 Utf8(*Text);
+		Parser.Feed(reinterpret_cast<const uint8*>(Utf8.Get()), Utf8.Length(), [&OutEvents](const FString& EventName, const FString& Data)
+		{
+			OutEvents.Emplace(EventName, Data);
+		});
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenJsonStreamParserRootTest, "GenerativeAISupport.Serialize.JsonStreamParser.Root",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenJsonStreamParserRootTest::RunTest(const FString& Parameters)
+{
+	const FString Json = TEXT(R"( [ {"a":"x]\"}"}, [1,[2]] ,"s,]" , 12.5,true,null ] )");
+	for (int32 ChunkSize = 1; ChunkSize <= Json.Len(); ++ChunkSize)
+	{
+		bool bComplete = false;
+		const TArray<FStreamedElement> Elements = StreamJson(Json, ChunkSize, {}, bComplete);
+		TestTrue(TEXT("Root array completes"), bComplete);
+		if (!TestEqual(FString::Printf(TEXT("Element count with chunks of %d"), ChunkSize), Elements.Num(), 6))
+		{
+			return false;
+		}
+		TestEqual(TEXT("Object element"), Elements[0].Json, FString(TEXT(R"({"a":"x]\"}"})")));
+		TestEqual(TEXT("Nested array element"), Elements[1].Json, FString(TEXT("[1,[2]]")));
+		TestEqual(TEXT("String element"), Elements[2].Json, FString(TEXT(R"("s,]")")));
+		TestEqual(TEXT("Number element"), Elements[3].Json, FString(TEXT("12.5")));
+		TestEqual(TEXT("Null element"), Elements[5].Json, FString(TEXT("null")));
+		TestEqual(TEXT("Array elements have no key"), Elements[4].Key, FString());
+		TestEqual(TEXT("Indices count up"), Elements[5].Index, 5);
+	}
+
+	bool bComplete = false;
+	const TArray<FStreamedElement> Fields = StreamJson(TEXT(R"({"a\n\u00e9":1,"b":{"c":[]}})"), 3, {}, bComplete);
+	TestTrue(TEXT("Root object completes"), bComplete);
+	if (TestEqual(TEXT("Field count"), Fields.Num(), 2))
+	{
+		TestEqual(TEXT("Escaped key is decoded"), Fields[0].Key, FString(TEXT("a\n\u00e9")));
+		TestEqual(TEXT("Object field"), Fields[1].Json, FString(TEXT(R"({"c":[]})")));
+	}
+
+	StreamJson(TEXT(R"({"a":[1,2)"), 4, {}, bComplete);
+	TestFalse(TEXT("Truncated document is not complete"), bComplete);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenJsonStreamParserPathTest, "GenerativeAISupport.Serialize.JsonStreamParser.ElementPath",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenJsonStreamParserPathTest::RunTest(const FString& Parameters)
+{
+	// Strict structured outputs always have an object root, the array is one of its fields
+	const FString Json = TEXT(R"({"title":"t","items":{"skip":[{"x":1}]},"level":{"items":[{"id":1},{"id":2,"tags":["a","]"]},3]},"after":[4]})");
+	for (int32 ChunkSize = 1; ChunkSize <= Json.Len(); ChunkSize += 7)
+	{
+		bool bComplete = false;
+		const TArray<FStreamedElement> Elements = StreamJson(Json, ChunkSize, {TEXT("level"), TEXT("items")}, bComplete);
+		TestTrue(TEXT("Document completes"), bComplete);
+		if (!TestEqual(FString::Printf(TEXT("Element count with chunks of %d"), ChunkSize), Elements.Num(), 3))
+		{
+			return false;
+		}
+		TestEqual(TEXT("First element"), Elements[0].Json, FString(TEXT(R"({"id":1})")));
+		TestEqual(TEXT("Second element"), Elements[1].Json, FString(TEXT(R"({"id":2,"tags":["a","]"]})")));
+		TestEqual(TEXT("Scalar element"), Elements[2].Json, FString(TEXT("3")));
+	}
+
+	bool bComplete = false;
+	const TArray<FStreamedElement> Fields = StreamJson(TEXT(R"({"data":{"a":1,"b":"2"}})"), 5, {TEXT("data")}, bComplete);
+	if (TestEqual(TEXT("Object at path streams its fields"), Fields.Num(), 2))
+	{
+		TestEqual(TEXT("Field key"), Fields[1].Key, FString(TEXT("b")));
+	}
+
+	const TArray<FStreamedElement> Missing = StreamJson(TEXT(R"({"other":[1,2]})"), 5, {TEXT("items")}, bComplete);
+	TestEqual(TEXT("Nothing off the path is emitted"), Missing.Num(), 0);
+	TestTrue(TEXT("Document without the path still completes"), bComplete);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenSSEParserTest, "GenerativeAISupport.Serialize.SSEParser",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenSSEParserTest::RunTest(const FString& Parameters)
+{
+	const FString Stream = TEXT(": keep-alive\r\nevent: delta\r\ndata: {\"t\":\"\u00e9\u4e2d\"}\r\n\r\ndata: line1\ndata:line2\n\ndata: tail");
+	const FTCHARToUTF8 Utf8(*Stream);
+
+	// Byte by byte, so multi-byte UTF-8 sequences and CRLF pairs are split across chunks
+	FGenSSEParser Parser;
+	TArray<TPair<FString, FString>> Events;
+	for (int32 Index = 0; Index < Utf8.Length(); ++Index)
+	{
+		Parser.Feed(reinterpret_cast<const uint8*>(Utf8.Get()) + Index, 1, [&Events](const FString& EventName, const FString& Data)
+		{
+			Events.Emplace(EventName, Data);
+		});
+	}
+	TestEqual(TEXT("Unterminated event waits"), Events.Num(), 2);
+	Parser.Flush([&Events](const FString& EventName, const FString& Data)
+	{
+		Events.Emplace(EventName, Data);
+	});
+
+	if (TestEqual(TEXT("Event count"), Events.Num(), 3))
+	{
+		TestEqual(TEXT("Event name"), Events[0].Key, FString(TEXT("delta")));
+		TestEqual(TEXT("UTF-8 data"), Events[0].Value, FString(TEXT("{\"t\":\"\u00e9\u4e2d\"}")));
+		TestEqual(TEXT("Name is reset"), Events[1].Key, FString());
+		TestEqual(TEXT("Data lines are joined"), Events[1].Value, FString(TEXT("line1\nline2")));
+		TestEqual(TEXT("Flushed event"), Events[2].Value, FString(TEXT("tail")));
+	}
+
+	FGenSSEParser ChunkParser;
+	TArray<TPair<FString, FString>> ChunkEvents;
+	FeedSSE(ChunkParser, TEXT("data: a\n\ndata: b\n\n"), ChunkEvents);
+	TestEqual(TEXT("Several events in one chunk"), ChunkEvents.Num(), 2);
+	return true;
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "JsonObjectConverter.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Models/OpenAI/GenOAIStructuredOpService.h"
+#include "Serialize/GenJsonSchemaBuilder.h"
+#include "Serialize/GenJsonStructReader.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	// Chat completion envelope around Content, escaped the way the API returns it
+	FString MakeChatCompletion(const FString& Content)
+	{
+		const TSharedPtr<FJsonObject> Message = MakeShareable(new FJsonObject());
+		Message->SetStringField(TEXT("role"), TEXT("assistant"));
+		Message->SetStringField(TEXT("content"), Content);
+		const TSharedPtr<FJsonObject> Choice = MakeShareable(new FJsonObject());
+		Choice->SetNumberField(TEXT("index"), 0);
+		Choice->SetObjectField(TEXT("message"), Message);
+		const TSharedPtr<FJsonObject> Usage = MakeShareable(new FJsonObject());
+		Usage->SetNumberField(TEXT("total_tokens"), 42);
+		const TSharedPtr<FJsonObject> Envelope = MakeShareable(new FJsonObject());
+		Envelope->SetStringField(TEXT("id"), TEXT("chatcmpl-test"));
+		Envelope->SetObjectField(TEXT("usage"), Usage);
+		TArray<TSharedPtr<FJsonValue>> Choices;
+		Choices.Add(MakeShareable(new FJsonValueObject(Choice)));
+		Envelope->SetArrayField(TEXT("choices"), Choices);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		FJsonSerializer::Serialize(Envelope.ToSharedRef(), Writer);
+		return Json;
+	}
+
+	FString MakeResponseContent(const int32 NumChoices)
+	{
+		FResponse Response;
+		Response.error = TEXT("none");
+		for (int32 Index = 0; Index < NumChoices; ++Index)
+		{
+			FChoice& Choice = Response.choices.AddDefaulted_GetRef();
+			Choice.message.role = TEXT("assistant");
+			Choice.message.content = FString::Printf(TEXT("Answer \"%d\" with some text \u00e9\u4e2d"), Index);
+		}
+		FString Json;
+		FJsonObjectConverter::UStructToJsonObjectString(Response, Json, 0, 0, 0, nullptr, false);
+		return Json;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenJsonSchemaBuilderTest, "GenerativeAISupport.Serialize.SchemaBuilder",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenJsonSchemaBuilderTest::RunTest(const FString& Parameters)
+{
+	const TSharedPtr<FJsonObject> Schema = FGenJsonSchemaBuilder::BuildStructSchema(FResponse::StaticStruct());
+	if (!TestTrue(TEXT("Plain data struct builds a schema"), Schema.IsValid()))
+	{
+		return false;
+	}
+	TestEqual(TEXT("Root type"), Schema->GetStringField(TEXT("type")), TEXT("object"));
+	TestFalse(TEXT("No additional properties"), Schema->GetBoolField(TEXT("additionalProperties")));
+	TestEqual(TEXT("All properties required"), Schema->GetArrayField(TEXT("required")).Num(), 2);
+
+	const TSharedPtr<FJsonObject> Choices = Schema->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("choices"));
+	TestEqual(TEXT("Array type"), Choices->GetStringField(TEXT("type")), TEXT("array"));
+	const TSharedPtr<FJsonObject> Message = Choices->GetObjectField(TEXT("items"))->GetObjectField(TEXT("properties"))->GetObjectField(TEXT("message"));
+	TestEqual(TEXT("Nested struct type"), Message->GetStringField(TEXT("type")), TEXT("object"));
+
+	// FGenChatImage holds a texture, so chat messages are not plain data
+	AddExpectedError(TEXT("only plain data structs"), EAutomationExpectedErrorFlags::Contains, 1);
+	TestTrue(TEXT("Object references detected"), FGenJsonSchemaBuilder::HasObjectReferences(FGenChatMessage::StaticStruct()));
+	TestFalse(TEXT("Object references rejected"), FGenJsonSchemaBuilder::BuildStructSchema(FGenChatMessage::StaticStruct()).IsValid());
+	TestTrue(TEXT("Object paths allowed for tools"), FGenJsonSchemaBuilder::BuildStructSchema(FGenChatMessage::StaticStruct(), true).IsValid());
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenJsonStructReaderTest, "GenerativeAISupport.Serialize.StructReader",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenJsonStructReaderTest::RunTest(const FString& Parameters)
+{
+	FResponse Response;
+	FString Error;
+	const FString Json = TEXT(R"({"unknown":{"nested":[1,{"a":null}]},"error":"e\u00e9","choices":[{"message":{"role":"r","content":"c\"1"}},{"message":null}]})");
+	TestTrue(TEXT("Reads struct"), FGenJsonStructReader::ReadStruct(Json, FResponse::StaticStruct(), &Response, Error));
+	TestEqual(TEXT("Escaped string"), Response.error, FString(TEXT("e\u00e9")));
+	TestEqual(TEXT("Array size"), Response.choices.Num(), 2);
+	if (Response.choices.Num() == 2)
+	{
+		TestEqual(TEXT("Nested field"), Response.choices[0].message.content, FString(TEXT("c\"1")));
+		TestTrue(TEXT("Null keeps default"), Response.choices[1].message.role.IsEmpty());
+	}
+
+	TestFalse(TEXT("Wrong type fails"), FGenJsonStructReader::ReadStruct(TEXT(R"({"error":5})"), FResponse::StaticStruct(), &Response, Error));
+	TestFalse(TEXT("Truncated JSON fails"), FGenJsonStructReader::ReadStruct(TEXT(R"({"choices":[{"message":)"), FResponse::StaticStruct(), &Response, Error));
+
+	FString Value;
+	TestTrue(TEXT("Finds by path"), FGenJsonStructReader::FindString(Json, {TEXT("choices"), TEXT("0"), TEXT("message"), TEXT("role")}, Value));
+	TestEqual(TEXT("Found value"), Value, FString(TEXT("r")));
+	TestFalse(TEXT("Missing index"), FGenJsonStructReader::FindString(Json, {TEXT("choices"), TEXT("2")}, Value));
+	TestFalse(TEXT("Not a string"), FGenJsonStructReader::FindString(Json, {TEXT("choices")}, Value));
+
+	FString DecodeError;
+	const TSharedPtr<FStructOnScope> Decoded = UGenOAIStructuredOpService::DecodeTypedResponse(MakeChatCompletion(MakeResponseContent(3)),
+	                                                                                         FResponse::StaticStruct(), DecodeError);
+	if (TestTrue(TEXT("Decodes chat completion"), Decoded.IsValid()))
+	{
+		const FResponse* DecodedResponse = reinterpret_cast<const FResponse*>(Decoded->GetStructMemory());
+		TestEqual(TEXT("Decoded choices"), DecodedResponse->choices.Num(), 3);
+	}
+
+	const FString Refusal = TEXT(R"({"choices":[{"message":{"content":null,"refusal":"No"}}]})");
+	TestFalse(TEXT("Refusal fails"), UGenOAIStructuredOpService::DecodeTypedResponse(Refusal, FResponse::StaticStruct(), DecodeError).IsValid());
+	TestEqual(TEXT("Refusal is the error"), DecodeError, FString(TEXT("No")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenStructuredOutputDecodeBenchmark, "GenerativeAISupport.Performance.StructuredOutputDecode",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FGenStructuredOutputDecodeBenchmark::RunTest(const FString& Parameters)
+{
+	constexpr int32 Iterations = 20;
+	const FString ResponseStr = MakeChatCompletion(MakeResponseContent(5000));
+
+	// Previous decode: envelope tree, content tree, then JsonObjectToUStruct
+	const double DomStart = FPlatformTime::Seconds();
+	int32 DomChoices = 0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		TSharedPtr<FJsonObject> Envelope;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(ResponseStr), Envelope);
+		const FString Content = Envelope->GetArrayField(TEXT("choices"))[0]->AsObject()->GetObjectField(TEXT("message"))->GetStringField(TEXT("content"));
+		TSharedPtr<FJsonObject> ContentObject;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Content), ContentObject);
+		FResponse Response;
+		FJsonObjectConverter::JsonObjectToUStruct(ContentObject.ToSharedRef(), &Response);
+		DomChoices = Response.choices.Num();
+	}
+	const double DomMs = (FPlatformTime::Seconds() - DomStart) * 1000.0 / Iterations;
+
+	const double StreamStart = FPlatformTime::Seconds();
+	int32 StreamChoices = 0;
+	for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+	{
+		FString Error;
+		const TSharedPtr<FStructOnScope> Result = UGenOAIStructuredOpService::DecodeTypedResponse(ResponseStr, FResponse::StaticStruct(), Error);
+		StreamChoices = Result.IsValid() ? reinterpret_cast<const FResponse*>(Result->GetStructMemory())->choices.Num() : 0;
+	}
+	const double StreamMs = (FPlatformTime::Seconds() - StreamStart) * 1000.0 / Iterations;
+
+	UE_LOG(LogGenPerformance, Display, TEXT("Structured output decode of %d bytes, JSON object trees took: %f ms, token reader took: %f ms"),
+	       ResponseStr.Len(), DomMs, StreamMs);
+	TestEqual(TEXT("Both decodes read the same data"), StreamChoices, DomChoices);
+	return true;
+}
+
+#endif
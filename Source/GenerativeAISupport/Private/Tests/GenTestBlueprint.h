@@ -0,0 +1,53 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Editor.h"
+#include "Engine/Blueprint.h"
+#include "Engine/BlueprintGeneratedClass.h"
+#include "GameFramework/Actor.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "MCP/GenEditSession.h"
+#include "MCP/GenNodeGuidIndex.h"
+#include "Subsystems/AssetEditorSubsystem.h"
+#include "UObject/Package.h"
+
+/**
+ * Actor Blueprints for the MCP automation tests. They live in memory under /Temp, so the commands
+ * resolve them by path like saved assets while nothing is written to the project.
+ */
+class FGenTestBlueprint
+{
+public:
+	static UBlueprint* Create(const FString& Name)
+	{
+		const FString UniqueName = FString::Printf(TEXT("%s_%s"), *Name, *FGuid::NewGuid().ToString());
+		UPackage* Package = CreatePackage(*FString::Printf(TEXT("/Temp/GenerativeAISupportTests/%s"), *UniqueName));
+		return FKismetEditorUtilities::CreateBlueprint(AActor::StaticClass(), Package, FName(*UniqueName), BPTYPE_Normal,
+		                                               UBlueprint::StaticClass(), UBlueprintGeneratedClass::StaticClass());
+	}
+
+	// Applies what the commands left pending and lets the Blueprint be garbage collected
+	static void Destroy(UBlueprint* Blueprint)
+	{
+		if (!Blueprint)
+		{
+			return;
+		}
+		FGenEditSession::Get().Flush(Blueprint);
+		FGenNodeGuidIndex::Get().Invalidate(Blueprint);
+		if (GEditor)
+		{
+			GEditor->GetEditorSubsystem<UAssetEditorSubsystem>()->CloseAllEditorsForAsset(Blueprint);
+		}
+		Blueprint->ClearFlags(RF_Public | RF_Standalone);
+	}
+};
+
+#endif
@@ -0,0 +1,314 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Async/Async.h"
+#include "Models/Anthropic/GenClaudeChat.h"
+#include "Models/OpenAI/GenOAIChat.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenToolCallCodec.h"
+#include "Tests/GenMockHttpServer.h"
+#include "Tools/GenToolLibrary.h"
+#include "Tools/GenToolRegistry.h"
+
+namespace
+{
+	TSharedPtr<FJsonObject> ParseObject(const FString& Json)
+	{
+		TSharedPtr<FJsonObject> Object;
+		FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Json), Object);
+		return Object;
+	}
+
+	FGenChatMessage MakeUserMessage(const FString& Content)
+	{
+		FGenChatMessage Message;
+		Message.Role = TEXT("user");
+		Message.Content = Content;
+		return Message;
+	}
+
+	FGenToolCall MakeCall(const FString& Id, const FString& Name, const FString& ArgumentsJson)
+	{
+		FGenToolCall Call;
+		Call.Id = Id;
+		Call.Name = Name;
+		Call.ArgumentsJson = ArgumentsJson;
+		return Call;
+	}
+
+	// mock_add sums a and b on the thread pool, mock_fail always fails on the game thread
+	void RegisterMockTools()
+	{
+		FGenToolRegistry::Get().RegisterNativeTool(TEXT("mock_add"), TEXT("Adds two numbers"), nullptr,
+			[](const TSharedPtr<FJsonObject>& Arguments, FString& OutError)
+			{
+				return FString::Printf(TEXT("{\"sum\":%d}"), static_cast<int32>(Arguments->GetNumberField(TEXT("a")) + Arguments->GetNumberField(TEXT("b"))));
+			}, true);
+		FGenToolRegistry::Get().RegisterNativeTool(TEXT("mock_fail"), TEXT("Always fails"), nullptr,
+			[](const TSharedPtr<FJsonObject>& Arguments, FString& OutError)
+			{
+				OutError = TEXT("mock failure");
+				return FString();
+			});
+	}
+
+	void UnregisterMockTools()
+	{
+		FGenToolRegistry::Get().UnregisterTool(TEXT("mock_add"));
+		FGenToolRegistry::Get().UnregisterTool(TEXT("mock_fail"));
+	}
+
+	// Outcome of a chat request run against the mock server
+	struct FMockChatRun
+	{
+		TSharedPtr<FGenMockHttpServer> Server;
+		FString Response;
+		FString Error;
+		bool bSuccess = false;
+	};
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenToolCallCodecTest, "GenerativeAISupport.Tools.ToolCallCodec",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenToolCallCodecTest::RunTest(const FString& Parameters)
+{
+	TArray<FGenChatMessage> Messages;
+	Messages.Add(MakeUserMessage(TEXT("Add things")));
+
+	const TArray<FGenToolCall> Calls = {MakeCall(TEXT("call_1"), TEXT("mock_add"), TEXT("{\"a\":1}")), MakeCall(TEXT("call_2"), TEXT("mock_fail"), TEXT(""))};
+	TArray<FGenToolResult> Results;
+	Results.SetNum(2);
+	Results[0].ToolCallId = TEXT("call_1");
+	Results[0].Output = TEXT("{\"sum\":1}");
+	Results[0].bSuccess = true;
+	Results[1].ToolCallId = TEXT("call_2");
+	Results[1].Output = TEXT("mock failure");
+	FGenToolCallCodec::AppendToolRound(Messages, TEXT("Working"), Calls, Results);
+	TestEqual(TEXT("Assistant and one message per result"), Messages.Num(), 4);
+	TestTrue(TEXT("Failed result is flagged"), Messages[3].bToolError);
+
+	// OpenAI: tool_calls on the assistant message, one "tool" message per result
+	const TArray<TSharedPtr<FJsonValue>> OpenAIMessages = FGenToolCallCodec::WriteMessages(Messages, EGenToolFormat::OpenAI);
+	if (TestEqual(TEXT("OpenAI message count"), OpenAIMessages.Num(), 4))
+	{
+		const TArray<TSharedPtr<FJsonValue>> ToolCalls = OpenAIMessages[1]->AsObject()->GetArrayField(TEXT("tool_calls"));
+		TestEqual(TEXT("OpenAI tool calls"), ToolCalls.Num(), 2);
+		TestEqual(TEXT("Empty arguments become an object"),
+		          ToolCalls[1]->AsObject()->GetObjectField(TEXT("function"))->GetStringField(TEXT("arguments")), FString(TEXT("{}")));
+		TestEqual(TEXT("Tool message references the call"), OpenAIMessages[3]->AsObject()->GetStringField(TEXT("tool_call_id")), FString(TEXT("call_2")));
+		TestEqual(TEXT("Error text"), OpenAIMessages[3]->AsObject()->GetStringField(TEXT("content")), FString(TEXT("Error: mock failure")));
+	}
+
+	// Anthropic: tool_use blocks, all results of the round in one user message, failures marked is_error
+	const TArray<TSharedPtr<FJsonValue>> AnthropicMessages = FGenToolCallCodec::WriteMessages(Messages, EGenToolFormat::Anthropic);
+	if (TestEqual(TEXT("Anthropic message count"), AnthropicMessages.Num(), 3))
+	{
+		const TArray<TSharedPtr<FJsonValue>> AssistantBlocks = AnthropicMessages[1]->AsObject()->GetArrayField(TEXT("content"));
+		TestEqual(TEXT("Text and tool_use blocks"), AssistantBlocks.Num(), 3);
+		TestEqual(TEXT("tool_use input is an object"), AssistantBlocks[1]->AsObject()->GetObjectField(TEXT("input"))->GetNumberField(TEXT("a")), 1.0);
+
+		const TSharedPtr<FJsonObject> ResultMessage = AnthropicMessages[2]->AsObject();
+		TestEqual(TEXT("Results are sent by the user"), ResultMessage->GetStringField(TEXT("role")), FString(TEXT("user")));
+		const TArray<TSharedPtr<FJsonValue>> ResultBlocks = ResultMessage->GetArrayField(TEXT("content"));
+		if (TestEqual(TEXT("One tool_result per call"), ResultBlocks.Num(), 2))
+		{
+			TestFalse(TEXT("Success is not an error"), ResultBlocks[0]->AsObject()->HasField(TEXT("is_error")));
+			TestTrue(TEXT("Failure is an error"), ResultBlocks[1]->AsObject()->GetBoolField(TEXT("is_error")));
+		}
+	}
+
+	// Reading the provider responses back
+	TArray<FGenToolCall> ReadCalls;
+	const TSharedPtr<FJsonObject> OpenAIResponse = ParseObject(
+		TEXT(R"({"content":null,"tool_calls":[{"id":"c1","type":"function","function":{"name":"mock_add","arguments":"{\"a\":2}"}}]})"));
+	TestTrue(TEXT("OpenAI tool calls are read"), FGenToolCallCodec::ReadOpenAIToolCalls(OpenAIResponse, ReadCalls));
+	if (TestEqual(TEXT("One OpenAI call"), ReadCalls.Num(), 1))
+	{
+		TestEqual(TEXT("OpenAI arguments"), ReadCalls[0].ArgumentsJson, FString(TEXT("{\"a\":2}")));
+	}
+
+	ReadCalls.Reset();
+	FString Text;
+	const TSharedPtr<FJsonObject> AnthropicResponse = ParseObject(
+		TEXT(R"({"content":[{"type":"text","text":"Let me"},{"type":"tool_use","id":"t1","name":"mock_add","input":{"a":3}}]})"));
+	TestTrue(TEXT("Anthropic tool calls are read"), FGenToolCallCodec::ReadAnthropicContent(AnthropicResponse->GetArrayField(TEXT("content")), Text, ReadCalls));
+	TestEqual(TEXT("Anthropic text"), Text, FString(TEXT("Let me")));
+	if (TestEqual(TEXT("One Anthropic call"), ReadCalls.Num(), 1))
+	{
+		TestEqual(TEXT("Anthropic input as arguments"), ParseObject(ReadCalls[0].ArgumentsJson)->GetNumberField(TEXT("a")), 3.0);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenToolRegistryThreadingTest, "GenerativeAISupport.Tools.RegistryThreading",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenToolRegistryThreadingTest::RunTest(const FString& Parameters)
+{
+	FGenToolRegistry& Registry = FGenToolRegistry::Get();
+	RegisterMockTools();
+	const UFunction* Function = UGenToolLibrary::StaticClass()->FindFunctionByName(GET_FUNCTION_NAME_CHECKED(UGenToolLibrary, GetRegisteredToolNames));
+	TestTrue(TEXT("UFUNCTION registers"), Registry.RegisterFunction(const_cast<UFunction*>(Function), TEXT("mock_tool_names")));
+
+	const FGenToolResult Sum = Registry.ExecuteToolCall(MakeCall(TEXT("1"), TEXT("mock_add"), TEXT("{\"a\":2,\"b\":5}")));
+	TestTrue(TEXT("Native tool succeeds"), Sum.bSuccess);
+	TestEqual(TEXT("Native tool output"), Sum.Output, FString(TEXT("{\"sum\":7}")));
+	TestFalse(TEXT("Unknown tool fails"), Registry.ExecuteToolCall(MakeCall(TEXT("2"), TEXT("mock_missing"), TEXT(""))).bSuccess);
+	TestFalse(TEXT("Invalid arguments fail"), Registry.ExecuteToolCall(MakeCall(TEXT("3"), TEXT("mock_add"), TEXT("[1]"))).bSuccess);
+
+	const FGenToolResult GameThreadResult = Registry.ExecuteToolCall(MakeCall(TEXT("4"), TEXT("mock_tool_names"), TEXT("")));
+	TestTrue(TEXT("UFUNCTION runs on the game thread"), GameThreadResult.bSuccess && GameThreadResult.Output.Contains(TEXT("mock_add")));
+
+	// Off the game thread the class default object must not be touched
+	TFuture<FGenToolResult> PoolResult = Async(EAsyncExecution::ThreadPool, [&Registry]()
+	{
+		return Registry.ExecuteToolCall(MakeCall(TEXT("5"), TEXT("mock_tool_names"), TEXT("")));
+	});
+	const FGenToolResult OffThreadResult = PoolResult.Get();
+	TestFalse(TEXT("UFUNCTION is refused off the game thread"), OffThreadResult.bSuccess);
+
+	Registry.UnregisterTool(TEXT("mock_tool_names"));
+	UnregisterMockTools();
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenToolLoopOpenAITest, "GenerativeAISupport.Tools.MultiStepLoop.OpenAI",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenToolLoopOpenAITest::RunTest(const FString& Parameters)
+{
+	RegisterMockTools();
+	const TSharedRef<FMockChatRun> Run = MakeShared<FMockChatRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+
+	// Two tool rounds (the first with two parallel calls), then the answer
+	Run->Server = FGenMockHttpServer::Start(18731, TEXT("/v1/chat/completions"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		if (RequestIndex == 0)
+		{
+			return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":null,"tool_calls":[)"
+				R"({"id":"call_1","type":"function","function":{"name":"mock_add","arguments":"{\"a\":1,\"b\":2}"}},)"
+				R"({"id":"call_2","type":"function","function":{"name":"mock_fail","arguments":"{}"}}]}}]})"));
+		}
+		if (RequestIndex == 1)
+		{
+			return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":null,"tool_calls":[)"
+				R"({"id":"call_3","type":"function","function":{"name":"mock_add","arguments":"{\"a\":3,\"b\":4}"}}]}}]})"));
+		}
+		return FString(TEXT(R"({"choices":[{"message":{"role":"assistant","content":"done"}}]})"));
+	});
+	if (!TestTrue(TEXT("Mock server started"), Run->Server->IsRunning()))
+	{
+		UnregisterMockTools();
+		return false;
+	}
+
+	FGenChatSettings ChatSettings;
+	ChatSettings.Model = TEXT("mock-model");
+	ChatSettings.EndpointOverride = Run->Server->GetUrl();
+	ChatSettings.Messages.Add(MakeUserMessage(TEXT("Add 1 and 2")));
+	ChatSettings.Tools = {TEXT("mock_add"), TEXT("mock_fail")};
+	UGenOAIChat::SendChatRequest(ChatSettings, FOnChatCompletionResponse::CreateLambda([Run, bDone](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		Run->Response = Response;
+		Run->Error = Error;
+		Run->bSuccess = bSuccess;
+		*bDone = true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		TestTrue(TEXT("Loop succeeds"), Run->bSuccess);
+		TestEqual(TEXT("Final answer"), Run->Response, FString(TEXT("done")));
+		if (TestEqual(TEXT("One request per round"), Run->Server->RequestBodies.Num(), 3))
+		{
+			const TArray<TSharedPtr<FJsonValue>> Second = ParseObject(Run->Server->RequestBodies[1])->GetArrayField(TEXT("messages"));
+			if (TestEqual(TEXT("User, assistant and two results"), Second.Num(), 4))
+			{
+				TestEqual(TEXT("Result of the pool tool"), Second[2]->AsObject()->GetStringField(TEXT("content")), FString(TEXT("{\"sum\":3}")));
+				TestEqual(TEXT("Results keep the call order"), Second[3]->AsObject()->GetStringField(TEXT("tool_call_id")), FString(TEXT("call_2")));
+				TestTrue(TEXT("Failure is sent back"), Second[3]->AsObject()->GetStringField(TEXT("content")).Contains(TEXT("mock failure")));
+			}
+			const TArray<TSharedPtr<FJsonValue>> Third = ParseObject(Run->Server->RequestBodies[2])->GetArrayField(TEXT("messages"));
+			if (TestEqual(TEXT("History grows by one round"), Third.Num(), 6))
+			{
+				TestEqual(TEXT("Second round result"), Third[5]->AsObject()->GetStringField(TEXT("content")), FString(TEXT("{\"sum\":7}")));
+			}
+		}
+		Run->Server.Reset();
+		UnregisterMockTools();
+		return true;
+	}));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FGenToolLoopAnthropicTest, "GenerativeAISupport.Tools.MultiStepLoop.Anthropic",
+                                 EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FGenToolLoopAnthropicTest::RunTest(const FString& Parameters)
+{
+	RegisterMockTools();
+	const TSharedRef<FMockChatRun> Run = MakeShared<FMockChatRun>();
+	const TSharedRef<bool> bDone = MakeShared<bool>(false);
+
+	Run->Server = FGenMockHttpServer::Start(18732, TEXT("/v1/messages"), [](const FString& Body, int32 RequestIndex, EHttpServerResponseCodes& OutCode)
+	{
+		if (RequestIndex == 0)
+		{
+			return FString(TEXT(R"({"content":[{"type":"text","text":"Calling"},)"
+				R"({"type":"tool_use","id":"tu_1","name":"mock_add","input":{"a":1,"b":2}},)"
+				R"({"type":"tool_use","id":"tu_2","name":"mock_fail","input":{}}],"stop_reason":"tool_use"})"));
+		}
+		return FString(TEXT(R"({"content":[{"type":"text","text":"done"}],"stop_reason":"end_turn"})"));
+	});
+	if (!TestTrue(TEXT("Mock server started"), Run->Server->IsRunning()))
+	{
+		UnregisterMockTools();
+		return false;
+	}
+
+	FGenClaudeChatSettings ChatSettings;
+	ChatSettings.EndpointOverride = Run->Server->GetUrl();
+	ChatSettings.Messages.Add(MakeUserMessage(TEXT("Add 1 and 2")));
+	ChatSettings.Tools = {TEXT("mock_add"), TEXT("mock_fail")};
+	UGenClaudeChat::SendChatRequest(ChatSettings, FOnClaudeChatCompletionResponse::CreateLambda([Run, bDone](const FString& Response, const FString& Error, bool bSuccess)
+	{
+		Run->Response = Response;
+		Run->Error = Error;
+		Run->bSuccess = bSuccess;
+		*bDone = true;
+	}));
+
+	ADD_LATENT_AUTOMATION_COMMAND(FGenWaitForFlagLatentCommand(bDone));
+	ADD_LATENT_AUTOMATION_COMMAND(FFunctionLatentCommand([this, Run]()
+	{
+		TestTrue(TEXT("Loop succeeds"), Run->bSuccess);
+		TestEqual(TEXT("Final answer"), Run->Response, FString(TEXT("done")));
+		if (TestEqual(TEXT("One request per round"), Run->Server->RequestBodies.Num(), 2))
+		{
+			const TArray<TSharedPtr<FJsonValue>> Messages = ParseObject(Run->Server->RequestBodies[1])->GetArrayField(TEXT("messages"));
+			if (TestEqual(TEXT("User, assistant and one result message"), Messages.Num(), 3))
+			{
+				const TArray<TSharedPtr<FJsonValue>> Blocks = Messages[2]->AsObject()->GetArrayField(TEXT("content"));
+				if (TestEqual(TEXT("Both results in one message"), Blocks.Num(), 2))
+				{
+					TestEqual(TEXT("Result id"), Blocks[1]->AsObject()->GetStringField(TEXT("tool_use_id")), FString(TEXT("tu_2")));
+					TestTrue(TEXT("Failed result is_error"), Blocks[1]->AsObject()->GetBoolField(TEXT("is_error")));
+					TestFalse(TEXT("Successful result has no is_error"), Blocks[0]->AsObject()->HasField(TEXT("is_error")));
+				}
+			}
+		}
+		Run->Server.Reset();
+		UnregisterMockTools();
+		return true;
+	}));
+	return true;
+}
+
+#endif
@@ -0,0 +1,25 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Tools/GenToolLibrary.h"
+
+#include "Tools/GenToolRegistry.h"
+
+int32 UGenToolLibrary::RegisterToolsFromClass(TSubclassOf<UBlueprintFunctionLibrary> LibraryClass)
+{
+	return FGenToolRegistry::Get().RegisterClassFunctions(LibraryClass.Get());
+}
+
+int32 UGenToolLibrary::RegisterEditorUtilityTools()
+{
+	return FGenToolRegistry::Get().RegisterEditorUtilityTools();
+}
+
+void UGenToolLibrary::UnregisterTool(const FString& ToolName)
+{
+	FGenToolRegistry::Get().UnregisterTool(ToolName);
+}
+
+TArray<FString> UGenToolLibrary::GetRegisteredToolNames()
+{
+	return FGenToolRegistry::Get().GetToolNames();
+}
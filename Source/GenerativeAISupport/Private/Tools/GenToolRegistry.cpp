@@ -0,0 +1,366 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Tools/GenToolRegistry.h"
+
+#include "Async/Async.h"
+#include "JsonObjectConverter.h"
+#include "MCP/GenActorUtils.h"
+#include "MCP/GenBlueprintUtils.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialize/GenJsonSchemaBuilder.h"
+#include "UObject/StructOnScope.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	// Shared by the workers of one ExecuteToolCalls batch, every worker writes only its own slot
+	struct FToolCallBatch
+	{
+		TArray<FGenToolResult> Results;
+		FThreadSafeCounter Remaining;
+		TFunction<void(const TArray<FGenToolResult>&)> OnComplete;
+	};
+
+	void FinishToolCall(const TSharedRef<FToolCallBatch, ESPMode::ThreadSafe>& Batch, int32 Index, FGenToolResult&& Result)
+	{
+		Batch->Results[Index] = MoveTemp(Result);
+		if (Batch->Remaining.Decrement() == 0)
+		{
+			// Always deferred, so the continuation never runs inside the dispatch loop
+			AsyncTask(ENamedThreads::GameThread, [Batch]()
+			{
+				Batch->OnComplete(Batch->Results);
+			});
+		}
+	}
+
+	FGenToolResult MakeErrorResult(const FGenToolCall& Call, const FString& Error)
+	{
+		FGenToolResult Result;
+		Result.ToolCallId = Call.Id;
+		Result.Name = Call.Name;
+		Result.Output = Error;
+		Result.bSuccess = false;
+		return Result;
+	}
+}
+
+FGenToolRegistry& FGenToolRegistry::Get()
+{
+	static FGenToolRegistry Registry;
+	return Registry;
+}
+
+bool FGenToolRegistry::RegisterFunction(UFunction* Function, const FString& ToolName)
+{
+	if (!Function || !Function->HasAnyFunctionFlags(FUNC_Static))
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Only static functions can be registered as tools: %s"),
+		       Function ? *Function->GetName() : TEXT("null"));
+		return false;
+	}
+
+	FToolEntry Entry;
+	Entry.Function = Function;
+	Entry.ParametersSchema = FGenJsonSchemaBuilder::BuildFunctionParamsSchema(Function);
+#if WITH_EDITOR
+	Entry.Description = Function->GetToolTipText().ToString();
+#endif
+	if (Entry.Description.IsEmpty())
+	{
+		Entry.Description = Function->GetName();
+	}
+
+	const FString Name = ToolName.IsEmpty() ? Function->GetName() : ToolName;
+	FWriteScopeLock WriteLock(ToolsLock);
+	Tools.Add(Name, MoveTemp(Entry));
+	return true;
+}
+
+int32 FGenToolRegistry::RegisterClassFunctions(const UClass* Class, const FString& NamePrefix)
+{
+	if (!Class)
+	{
+		return 0;
+	}
+
+	int32 NumRegistered = 0;
+	for (TFieldIterator<UFunction> It(Class, EFieldIteratorFlags::ExcludeSuper); It; ++It)
+	{
+		UFunction* Function = *It;
+		if (Function->HasAllFunctionFlags(FUNC_Static | FUNC_BlueprintCallable) &&
+			RegisterFunction(Function, NamePrefix + Function->GetName()))
+		{
+			++NumRegistered;
+		}
+	}
+	return NumRegistered;
+}
+
+int32 FGenToolRegistry::RegisterEditorUtilityTools()
+{
+	return RegisterClassFunctions(UGenActorUtils::StaticClass()) +
+		RegisterClassFunctions(UGenBlueprintUtils::StaticClass());
+}
+
+void FGenToolRegistry::RegisterNativeTool(const FString& ToolName, const FString& Description,
+                                          const TSharedPtr<FJsonObject>& ParametersSchema, FNativeToolHandler Handler,
+                                          bool bThreadSafe)
+{
+	FToolEntry Entry;
+	Entry.Description = Description;
+	Entry.ParametersSchema = ParametersSchema;
+	Entry.Handler = MoveTemp(Handler);
+	Entry.bThreadSafe = bThreadSafe;
+
+	FWriteScopeLock WriteLock(ToolsLock);
+	Tools.Add(ToolName, MoveTemp(Entry));
+}
+
+void FGenToolRegistry::UnregisterTool(const FString& ToolName)
+{
+	FWriteScopeLock WriteLock(ToolsLock);
+	Tools.Remove(ToolName);
+}
+
+bool FGenToolRegistry::IsToolRegistered(const FString& ToolName) const
+{
+	FReadScopeLock ReadLock(ToolsLock);
+	return Tools.Contains(ToolName);
+}
+
+TArray<FString> FGenToolRegistry::GetToolNames() const
+{
+	TArray<FString> Names;
+	FReadScopeLock ReadLock(ToolsLock);
+	Tools.GetKeys(Names);
+	return Names;
+}
+
+TArray<TSharedPtr<FJsonValue>> FGenToolRegistry::BuildToolsJson(const TArray<FString>& ToolNames, EGenToolFormat Format) const
+{
+	TArray<TSharedPtr<FJsonValue>> ToolsArray;
+
+	FReadScopeLock ReadLock(ToolsLock);
+	for (const FString& ToolName : ToolNames)
+	{
+		const FToolEntry* Entry = Tools.Find(ToolName);
+		if (!Entry)
+		{
+			UE_LOG(LogGenAI, Warning, TEXT("Tool %s is not registered, it will not be sent"), *ToolName);
+			continue;
+		}
+
+		TSharedPtr<FJsonObject> Parameters = Entry->ParametersSchema;
+		if (!Parameters.IsValid())
+		{
+			Parameters = MakeShareable(new FJsonObject());
+			Parameters->SetStringField(TEXT("type"), TEXT("object"));
+			Parameters->SetObjectField(TEXT("properties"), MakeShareable(new FJsonObject()));
+		}
+
+		TSharedPtr<FJsonObject> ToolObject = MakeShareable(new FJsonObject());
+		if (Format == EGenToolFormat::Anthropic)
+		{
+			ToolObject->SetStringField(TEXT("name"), ToolName);
+			ToolObject->SetStringField(TEXT("description"), Entry->Description);
+			ToolObject->SetObjectField(TEXT("input_schema"), Parameters);
+		}
+		else
+		{
+			TSharedPtr<FJsonObject> FunctionObject = MakeShareable(new FJsonObject());
+			FunctionObject->SetStringField(TEXT("name"), ToolName);
+			FunctionObject->SetStringField(TEXT("description"), Entry->Description);
+			FunctionObject->SetObjectField(TEXT("parameters"), Parameters);
+
+			ToolObject->SetStringField(TEXT("type"), TEXT("function"));
+			ToolObject->SetObjectField(TEXT("function"), FunctionObject);
+		}
+		ToolsArray.Add(MakeShareable(new FJsonValueObject(ToolObject)));
+	}
+	return ToolsArray;
+}
+
+void FGenToolRegistry::ExecuteToolCalls(const TArray<FGenToolCall>& Calls, TFunction<void(const TArray<FGenToolResult>&)> OnComplete) const
+{
+	if (Calls.Num() == 0)
+	{
+		AsyncTask(ENamedThreads::GameThread, [OnComplete = MoveTemp(OnComplete)]()
+		{
+			OnComplete(TArray<FGenToolResult>());
+		});
+		return;
+	}
+
+	const TSharedRef<FToolCallBatch, ESPMode::ThreadSafe> Batch = MakeShared<FToolCallBatch, ESPMode::ThreadSafe>();
+	Batch->Results.SetNum(Calls.Num());
+	Batch->Remaining.Set(Calls.Num());
+	Batch->OnComplete = MoveTemp(OnComplete);
+
+	// Independent thread-safe native calls go to the thread pool right away, the rest is run in order on the game thread
+	TArray<TPair<int32, FToolEntry>> GameThreadCalls;
+	for (int32 Index = 0; Index < Calls.Num(); ++Index)
+	{
+		const FGenToolCall& Call = Calls[Index];
+
+		FToolEntry Entry;
+		if (!FindTool(Call.Name, Entry))
+		{
+			FinishToolCall(Batch, Index, MakeErrorResult(Call, FString::Printf(TEXT("Unknown tool: %s"), *Call.Name)));
+			continue;
+		}
+
+		if (Entry.bThreadSafe && Entry.Handler)
+		{
+			Async(EAsyncExecution::ThreadPool, [Batch, Index, Entry = MoveTemp(Entry), Call]()
+			{
+				FinishToolCall(Batch, Index, InvokeTool(Entry, Call));
+			});
+		}
+		else
+		{
+			GameThreadCalls.Emplace(Index, MoveTemp(Entry));
+		}
+	}
+
+	if (GameThreadCalls.Num() > 0)
+	{
+		auto RunGameThreadCalls = [Batch, Calls, GameThreadCalls = MoveTemp(GameThreadCalls)]()
+		{
+			for (const TPair<int32, FToolEntry>& Pending : GameThreadCalls)
+			{
+				FinishToolCall(Batch, Pending.Key, InvokeTool(Pending.Value, Calls[Pending.Key]));
+			}
+		};
+
+		if (IsInGameThread())
+		{
+			RunGameThreadCalls();
+		}
+		else
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(RunGameThreadCalls));
+		}
+	}
+}
+
+FGenToolResult FGenToolRegistry::ExecuteToolCall(const FGenToolCall& Call) const
+{
+	FToolEntry Entry;
+	if (!FindTool(Call.Name, Entry))
+	{
+		return MakeErrorResult(Call, FString::Printf(TEXT("Unknown tool: %s"), *Call.Name));
+	}
+	if (!Entry.Handler && !IsInGameThread())
+	{
+		return MakeErrorResult(Call, FString::Printf(TEXT("Tool %s can only run on the game thread"), *Call.Name));
+	}
+	return InvokeTool(Entry, Call);
+}
+
+bool FGenToolRegistry::FindTool(const FString& ToolName, FToolEntry& OutEntry) const
+{
+	FReadScopeLock ReadLock(ToolsLock);
+	if (const FToolEntry* Entry = Tools.Find(ToolName))
+	{
+		OutEntry = *Entry;
+		return true;
+	}
+	return false;
+}
+
+FGenToolResult FGenToolRegistry::InvokeTool(const FToolEntry& Entry, const FGenToolCall& Call)
+{
+	LOG_TIME_START(ToolStartTime);
+
+	TSharedPtr<FJsonObject> Arguments = MakeShareable(new FJsonObject());
+	if (!Call.ArgumentsJson.IsEmpty())
+	{
+		const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Call.ArgumentsJson);
+		if (!FJsonSerializer::Deserialize(Reader, Arguments) || !Arguments.IsValid())
+		{
+			return MakeErrorResult(Call, TEXT("Arguments are not a valid JSON object"));
+		}
+	}
+
+	FString Error;
+	FString Output;
+	if (Entry.Handler)
+	{
+		Output = Entry.Handler(Arguments, Error);
+	}
+	else if (UFunction* Function = Entry.Function.Get())
+	{
+		check(IsInGameThread());
+		Output = InvokeFunction(Function, Arguments, Error);
+	}
+	else
+	{
+		Error = TEXT("Tool function is no longer available");
+	}
+
+	LOG_TIME_ELAPSED(ToolStartTime, *FString::Printf(TEXT("Tool %s"), *Call.Name));
+
+	if (!Error.IsEmpty())
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("Tool %s failed: %s"), *Call.Name, *Error);
+		return MakeErrorResult(Call, Error);
+	}
+
+	FGenToolResult Result;
+	Result.ToolCallId = Call.Id;
+	Result.Name = Call.Name;
+	Result.Output = Output;
+	Result.bSuccess = true;
+	return Result;
+}
+
+FString FGenToolRegistry::InvokeFunction(UFunction* Function, const TSharedPtr<FJsonObject>& Arguments, FString& OutError)
+{
+	FStructOnScope Params(Function);
+	uint8* ParamsMemory = Params.GetStructMemory();
+
+	// Arguments are matched by parameter name, missing ones keep their default value
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (!FGenJsonSchemaBuilder::IsInputParameter(*It))
+		{
+			continue;
+		}
+
+		const TSharedPtr<FJsonValue> Value = Arguments->TryGetField(It->GetAuthoredName());
+		if (!Value.IsValid())
+		{
+			continue;
+		}
+
+		if (!FJsonObjectConverter::JsonValueToUProperty(Value, *It, It->ContainerPtrToValuePtr<void>(ParamsMemory)))
+		{
+			OutError = FString::Printf(TEXT("Invalid value for parameter %s"), *It->GetAuthoredName());
+			return TEXT("");
+		}
+	}
+
+	Function->GetOuterUClass()->GetDefaultObject()->ProcessEvent(Function, ParamsMemory);
+
+	// Return value and out parameters are sent back as one JSON object
+	const TSharedPtr<FJsonObject> Output = MakeShareable(new FJsonObject());
+	for (TFieldIterator<FProperty> It(Function); It && It->HasAnyPropertyFlags(CPF_Parm); ++It)
+	{
+		if (!It->HasAnyPropertyFlags(CPF_OutParm | CPF_ReturnParm) || It->HasAnyPropertyFlags(CPF_ConstParm))
+		{
+			continue;
+		}
+
+		if (const TSharedPtr<FJsonValue> JsonValue = FJsonObjectConverter::UPropertyToJsonValue(*It, It->ContainerPtrToValuePtr<void>(ParamsMemory)))
+		{
+			Output->SetField(It->GetAuthoredName(), JsonValue);
+		}
+	}
+
+	FString OutputString;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	FJsonSerializer::Serialize(Output.ToSharedRef(), Writer);
+	return OutputString;
+}
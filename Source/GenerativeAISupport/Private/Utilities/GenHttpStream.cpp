@@ -0,0 +1,108 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Utilities/GenHttpStream.h"
+
+#include "Serialization/Archive.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	constexpr int32 MaxBodyPrefixBytes = 64 * 1024;
+
+	// Receives the response body on the HTTP thread and hands it to the reader
+	class FGenHttpReceiveArchive : public FArchive
+	{
+	public:
+		explicit FGenHttpReceiveArchive(const TWeakPtr<FGenHttpStreamReader, ESPMode::ThreadSafe>& InReader)
+			: Reader(InReader)
+		{
+			SetIsSaving(true);
+		}
+
+		virtual void Serialize(void* V, int64 Length) override
+		{
+			if (const TSharedPtr<FGenHttpStreamReader, ESPMode::ThreadSafe> Pinned = Reader.Pin())
+			{
+				Pinned->Receive(static_cast<const uint8*>(V), Length);
+			}
+		}
+
+		virtual FString GetArchiveName() const override { return TEXT("FGenHttpReceiveArchive"); }
+
+	private:
+		TWeakPtr<FGenHttpStreamReader, ESPMode::ThreadSafe> Reader;
+	};
+}
+
+FGenHttpStreamReader::FGenHttpStreamReader(FOnData InOnData)
+	: OnData(MoveTemp(InOnData))
+{
+}
+
+TSharedRef<FGenHttpStreamReader, ESPMode::ThreadSafe> FGenHttpStreamReader::Bind(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, FOnData OnData)
+{
+	TSharedRef<FGenHttpStreamReader, ESPMode::ThreadSafe> Reader = MakeShareable(new FGenHttpStreamReader(MoveTemp(OnData)));
+	Reader->bReceiveStreamBound = Request->SetResponseBodyReceiveStream(MakeShared<FGenHttpReceiveArchive>(Reader));
+	if (!Reader->bReceiveStreamBound)
+	{
+		UE_LOG(LogGenAI, Warning, TEXT("HTTP response streaming is not supported, the body is delivered once complete"));
+	}
+
+	Request->OnRequestProgress().BindLambda([Reader](FHttpRequestPtr InRequest, int32 BytesSent, int32 BytesReceived)
+	{
+		Reader->Deliver();
+	});
+	return Reader;
+}
+
+void FGenHttpStreamReader::Receive(const uint8* Data, int64 Num)
+{
+	FScopeLock Lock(&PendingLock);
+	Pending.Append(Data, Num);
+	if (BodyPrefix.Num() < MaxBodyPrefixBytes)
+	{
+		BodyPrefix.Append(Data, FMath::Min<int64>(Num, MaxBodyPrefixBytes - BodyPrefix.Num()));
+	}
+}
+
+void FGenHttpStreamReader::Flush(const FHttpResponsePtr& Response)
+{
+	// The request is complete here, so its content is no longer written
+	if (!bReceiveStreamBound && Response.IsValid() && Delivered == 0)
+	{
+		const TArray<uint8>& Content = Response->GetContent();
+		Receive(Content.GetData(), Content.Num());
+	}
+	Deliver();
+}
+
+FString FGenHttpStreamReader::GetBodyPrefix(const FHttpResponsePtr& Response) const
+{
+	if (!bReceiveStreamBound)
+	{
+		return Response.IsValid() ? Response->GetContentAsString() : FString();
+	}
+
+	FScopeLock Lock(&PendingLock);
+	const FUTF8ToTCHAR Converted(reinterpret_cast<const ANSICHAR*>(BodyPrefix.GetData()), BodyPrefix.Num());
+	return FString(Converted.Length(), Converted.Get());
+}
+
+void FGenHttpStreamReader::Deliver()
+{
+	TArray<uint8> Chunk;
+	{
+		FScopeLock Lock(&PendingLock);
+		Chunk = MoveTemp(Pending);
+		Pending.Reset();
+	}
+
+	if (Chunk.Num() > 0)
+	{
+		Delivered += Chunk.Num();
+		if (OnData)
+		{
+			OnData(Chunk.GetData(), Chunk.Num());
+		}
+	}
+}
@@ -0,0 +1,418 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#include "Utilities/GenImageUtils.h"
+
+#include "Algo/Count.h"
+#include "Async/Async.h"
+#include "IImageWrapper.h"
+#include "IImageWrapperModule.h"
+#include "ImageUtils.h"
+#include "Engine/Texture2D.h"
+#include "Misc/FileHelper.h"
+#include "Modules/ModuleManager.h"
+#include "Utilities/GenGlobalDefinitions.h"
+
+namespace
+{
+	const TCHAR PlaceholderPrefix[] = TEXT("@@GENIMG:");
+
+	// Image data gathered on the game thread
+	struct FSourceImage
+	{
+		int32 ImageIndex = 0;
+		TArray<FColor> Pixels;
+		int32 Width = 0;
+		int32 Height = 0;
+		FString FilePath;
+		int32 MaxDimension = 0;
+		int32 JpegQuality = 0;
+	};
+
+	using FEncodedImage = FGenImageAttachments::FEncodedImage;
+
+	void AppendAnsi(const FString& String, TArray<uint8>& Out)
+	{
+		const FTCHARToUTF8 Converted(*String);
+		Out.Append(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length());
+	}
+
+	bool IsSameImage(const FGenChatImage& A, const FGenChatImage& B)
+	{
+		return A.Texture == B.Texture && A.FilePath == B.FilePath && A.Width == B.Width && A.Height == B.Height &&
+			A.MaxDimension == B.MaxDimension && A.JpegQuality == B.JpegQuality && A.Pixels.Num() == B.Pixels.Num() &&
+			(A.Pixels.Num() == 0 || FMemory::Memcmp(A.Pixels.GetData(), B.Pixels.GetData(), A.Pixels.Num() * sizeof(FColor)) == 0);
+	}
+
+	bool EncodeFile(IImageWrapperModule& ImageWrapperModule, const FSourceImage& Source, FEncodedImage& OutImage, FString& OutError)
+	{
+		TArray64<uint8> FileData;
+		if (!FFileHelper::LoadFileToArray(FileData, *Source.FilePath))
+		{
+			OutError = FString::Printf(TEXT("Failed to read image file %s"), *Source.FilePath);
+			return false;
+		}
+
+		const EImageFormat Format = ImageWrapperModule.DetectImageFormat(FileData.GetData(), FileData.Num());
+		const TSharedPtr<IImageWrapper> ImageWrapper = Format != EImageFormat::Invalid ? ImageWrapperModule.CreateImageWrapper(Format) : nullptr;
+		if (!ImageWrapper.IsValid() || !ImageWrapper->SetCompressed(FileData.GetData(), FileData.Num()))
+		{
+			OutError = FString::Printf(TEXT("Unsupported image file %s"), *Source.FilePath);
+			return false;
+		}
+
+		const int32 Width = ImageWrapper->GetWidth();
+		const int32 Height = ImageWrapper->GetHeight();
+		const bool bFitsLimit = Source.MaxDimension <= 0 || FMath::Max(Width, Height) <= Source.MaxDimension;
+		if (bFitsLimit && (Format == EImageFormat::PNG || Format == EImageFormat::JPEG))
+		{
+			// Already in a format the providers accept, send the file bytes unchanged
+			OutImage.MimeType = Format == EImageFormat::PNG ? TEXT("image/png") : TEXT("image/jpeg");
+			OutImage.Bytes = MoveTemp(FileData);
+			return true;
+		}
+
+		TArray64<uint8> RawData;
+		if (!ImageWrapper->GetRaw(ERGBFormat::BGRA, 8, RawData))
+		{
+			OutError = FString::Printf(TEXT("Failed to decode image file %s"), *Source.FilePath);
+			return false;
+		}
+
+		TArray<FColor> Pixels;
+		Pixels.SetNumUninitialized(Width * Height);
+		FMemory::Memcpy(Pixels.GetData(), RawData.GetData(), Pixels.Num() * sizeof(FColor));
+		return FGenImageUtils::EncodePixels(ImageWrapperModule, MoveTemp(Pixels), Width, Height, Source.MaxDimension,
+		                                    Source.JpegQuality, OutImage.Bytes, OutImage.MimeType);
+	}
+
+	/**
+	 * Copies the payload and replaces every placeholder of this nonce with the matching image data.
+	 * Text that merely looks like a placeholder (without the nonce) is copied unchanged.
+	 */
+	void SpliceImages(const FString& PayloadJson, const FString& Nonce, const TArray<FGenImageAttachments::FEncodedImagePtr>& EncodedImages,
+	                  TArray<uint8>& OutBody)
+	{
+		const FTCHARToUTF8 Payload(*PayloadJson);
+		const uint8* Source = reinterpret_cast<const uint8*>(Payload.Get());
+		const int32 SourceLen = Payload.Length();
+
+		const FTCHARToUTF8 PrefixUtf8(*FString::Printf(TEXT("%s%s:"), PlaceholderPrefix, *Nonce));
+		const uint8* Prefix = reinterpret_cast<const uint8*>(PrefixUtf8.Get());
+		const int32 PrefixLen = PrefixUtf8.Length();
+
+		int64 ReserveSize = SourceLen;
+		for (const FGenImageAttachments::FEncodedImagePtr& Image : EncodedImages)
+		{
+			ReserveSize += FGenImageUtils::GetBase64Length(Image->Bytes.Num()) + 64;
+		}
+		OutBody.Reset();
+		OutBody.Reserve(ReserveSize);
+
+		int32 CopyStart = 0;
+		int32 Pos = 0;
+		while (Pos <= SourceLen - PrefixLen)
+		{
+			if (Source[Pos] != '@' || FMemory::Memcmp(Source + Pos, Prefix, PrefixLen) != 0)
+			{
+				++Pos;
+				continue;
+			}
+
+			// @@GENIMG:<nonce>:<index>:<kind>@@, the kind is a single letter
+			int32 Cursor = Pos + PrefixLen;
+			int32 ImageIndex = 0;
+			while (Cursor < SourceLen && FChar::IsDigit(Source[Cursor]))
+			{
+				ImageIndex = ImageIndex * 10 + (Source[Cursor++] - '0');
+			}
+			if (Cursor + 3 >= SourceLen || Source[Cursor] != ':' || Source[Cursor + 2] != '@' || Source[Cursor + 3] != '@' ||
+				!EncodedImages.IsValidIndex(ImageIndex))
+			{
+				++Pos;
+				continue;
+			}
+			const uint8 Kind = Source[Cursor + 1];
+
+			OutBody.Append(Source + CopyStart, Pos - CopyStart);
+			const FEncodedImage& Image = *EncodedImages[ImageIndex];
+			if (Kind == 'm')
+			{
+				AppendAnsi(Image.MimeType, OutBody);
+			}
+			else
+			{
+				if (Kind == 'u')
+				{
+					AppendAnsi(FString::Printf(TEXT("data:%s;base64,"), *Image.MimeType), OutBody);
+				}
+				FGenImageUtils::AppendBase64(Image.Bytes.GetData(), Image.Bytes.Num(), OutBody);
+			}
+
+			Pos = Cursor + 4;
+			CopyStart = Pos;
+		}
+		OutBody.Append(Source + CopyStart, SourceLen - CopyStart);
+	}
+}
+
+FGenImageAttachments::FGenImageAttachments()
+	: Nonce(FGuid::NewGuid().ToString(EGuidFormats::Digits))
+{
+}
+
+int32 FGenImageAttachments::Add(const FGenChatImage& Image)
+{
+	const int32 ExistingIndex = Images.IndexOfByPredicate([&Image](const FGenChatImage& Existing)
+	{
+		return IsSameImage(Existing, Image);
+	});
+	if (ExistingIndex != INDEX_NONE)
+	{
+		return ExistingIndex;
+	}
+
+	EncodedImages.AddDefaulted();
+	return Images.Add(Image);
+}
+
+FString FGenImageAttachments::MakePlaceholder(int32 ImageIndex, EGenImagePlaceholder Kind) const
+{
+	const TCHAR KindName = Kind == EGenImagePlaceholder::DataUrl ? TEXT('u') : Kind == EGenImagePlaceholder::Data ? TEXT('d') : TEXT('m');
+	return FString::Printf(TEXT("%s%s:%d:%c@@"), PlaceholderPrefix, *Nonce, ImageIndex, KindName);
+}
+
+int32 FGenImageAttachments::NumEncoded() const
+{
+	return Algo::CountIf(EncodedImages, [](const FEncodedImagePtr& Image)
+	{
+		return Image.IsValid();
+	});
+}
+
+void FGenImageUtils::ProcessRequestWithImages(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, const FString& PayloadJson,
+                                              const TSharedRef<FGenImageAttachments>& Attachments, TFunction<void(const FString&)> OnError)
+{
+	if (!IsInGameThread())
+	{
+		AsyncTask(ENamedThreads::GameThread, [HttpRequest, PayloadJson, Attachments, OnError = MoveTemp(OnError)]() mutable
+		{
+			ProcessRequestWithImages(HttpRequest, PayloadJson, Attachments, MoveTemp(OnError));
+		});
+		return;
+	}
+
+	// Only images that no earlier request encoded are read
+	TArray<FSourceImage> Sources;
+	for (int32 Index = 0; Index < Attachments->Images.Num(); ++Index)
+	{
+		if (Attachments->EncodedImages[Index].IsValid())
+		{
+			continue;
+		}
+
+		const FGenChatImage& Image = Attachments->Images[Index];
+		FSourceImage& Source = Sources.AddDefaulted_GetRef();
+		Source.ImageIndex = Index;
+		Source.MaxDimension = Image.MaxDimension;
+		Source.JpegQuality = Image.JpegQuality;
+
+		FString Error;
+		if (Image.Texture)
+		{
+			if (!ReadTexturePixels(Image.Texture, Source.Pixels, Source.Width, Source.Height, Error))
+			{
+				OnError(Error);
+				return;
+			}
+		}
+		else if (Image.Pixels.Num() > 0)
+		{
+			if (Image.Pixels.Num() != Image.Width * Image.Height)
+			{
+				OnError(TEXT("Image pixel count does not match Width * Height"));
+				return;
+			}
+			Source.Pixels = Image.Pixels;
+			Source.Width = Image.Width;
+			Source.Height = Image.Height;
+		}
+		else if (!Image.FilePath.IsEmpty())
+		{
+			Source.FilePath = Image.FilePath;
+		}
+		else
+		{
+			OnError(TEXT("Image has no texture, pixels or file path"));
+			return;
+		}
+	}
+
+	// Module loading is only allowed on the game thread
+	IImageWrapperModule* ImageWrapperModule = &FModuleManager::LoadModuleChecked<IImageWrapperModule>(FName("ImageWrapper"));
+
+	// The worker gets its own copy of the encoded image pointers, the attachments are only updated on the game thread
+	Async(EAsyncExecution::ThreadPool, [HttpRequest, PayloadJson, Attachments, EncodedImages = Attachments->EncodedImages, Nonce = Attachments->Nonce,
+		       Sources = MoveTemp(Sources), ImageWrapperModule, OnError = MoveTemp(OnError)]() mutable
+	{
+		LOG_TIME_START(EncodeStartTime);
+
+		for (FSourceImage& Source : Sources)
+		{
+			const double ImageStartTime = FPlatformTime::Seconds();
+			const int32 SourceWidth = Source.Width;
+			const int32 SourceHeight = Source.Height;
+
+			const TSharedRef<FEncodedImage, ESPMode::ThreadSafe> EncodedImage = MakeShared<FEncodedImage, ESPMode::ThreadSafe>();
+			FString Error;
+			const bool bEncoded = Source.FilePath.IsEmpty()
+				                      ? EncodePixels(*ImageWrapperModule, MoveTemp(Source.Pixels), Source.Width, Source.Height,
+				                                     Source.MaxDimension, Source.JpegQuality, EncodedImage->Bytes, EncodedImage->MimeType)
+				                      : EncodeFile(*ImageWrapperModule, Source, *EncodedImage, Error);
+			if (!bEncoded)
+			{
+				if (Error.IsEmpty())
+				{
+					Error = TEXT("Failed to encode image");
+				}
+				AsyncTask(ENamedThreads::GameThread, [OnError = MoveTemp(OnError), Error]()
+				{
+					OnError(Error);
+				});
+				return;
+			}
+
+			UE_LOG(LogGenPerformance, Display, TEXT("Image %d (%s, %dx%d source): %lld bytes, %lld base64 bytes, encoded in %f ms"),
+			       Source.ImageIndex, *EncodedImage->MimeType, SourceWidth, SourceHeight, EncodedImage->Bytes.Num(),
+			       GetBase64Length(EncodedImage->Bytes.Num()), (FPlatformTime::Seconds() - ImageStartTime) * 1000.0);
+			EncodedImages[Source.ImageIndex] = EncodedImage;
+		}
+
+		TArray<uint8> Body;
+		SpliceImages(PayloadJson, Nonce, EncodedImages, Body);
+		LOG_TIME_ELAPSED(EncodeStartTime, *FString::Printf(TEXT("Encoding %d of %d images into a %d byte request"), Sources.Num(),
+		                                                   EncodedImages.Num(), Body.Num()));
+
+		AsyncTask(ENamedThreads::GameThread, [HttpRequest, Attachments, EncodedImages = MoveTemp(EncodedImages), Body = MoveTemp(Body)]() mutable
+		{
+			// Images added while encoding keep their empty entries
+			for (int32 Index = 0; Index < EncodedImages.Num(); ++Index)
+			{
+				if (!Attachments->EncodedImages[Index].IsValid())
+				{
+					Attachments->EncodedImages[Index] = EncodedImages[Index];
+				}
+			}
+			HttpRequest->SetContent(MoveTemp(Body));
+			HttpRequest->ProcessRequest();
+		});
+	});
+}
+
+bool FGenImageUtils::ReadTexturePixels(UTexture2D* Texture, TArray<FColor>& OutPixels, int32& OutWidth, int32& OutHeight, FString& OutError)
+{
+	if (!Texture)
+	{
+		OutError = TEXT("Texture is null");
+		return false;
+	}
+
+#if WITH_EDITORONLY_DATA
+	// Source data is always available uncompressed in the editor
+	if (Texture->Source.IsValid() && Texture->Source.GetFormat() == TSF_BGRA8)
+	{
+		TArray64<uint8> MipData;
+		if (Texture->Source.GetMipData(MipData, 0))
+		{
+			OutWidth = Texture->Source.GetSizeX();
+			OutHeight = Texture->Source.GetSizeY();
+			OutPixels.SetNumUninitialized(OutWidth * OutHeight);
+			FMemory::Memcpy(OutPixels.GetData(), MipData.GetData(), OutPixels.Num() * sizeof(FColor));
+			return true;
+		}
+	}
+#endif
+
+	FTexturePlatformData* PlatformData = Texture->GetPlatformData();
+	if (!PlatformData || PlatformData->Mips.Num() == 0 || PlatformData->PixelFormat != PF_B8G8R8A8)
+	{
+		OutError = FString::Printf(TEXT("Texture %s is not uncompressed BGRA8, use the UserInterface2D compression setting"), *Texture->GetName());
+		return false;
+	}
+
+	FTexture2DMipMap& Mip = PlatformData->Mips[0];
+	const void* MipData = Mip.BulkData.LockReadOnly();
+	if (!MipData)
+	{
+		OutError = FString::Printf(TEXT("Texture %s has no CPU data"), *Texture->GetName());
+		return false;
+	}
+
+	OutWidth = Mip.SizeX;
+	OutHeight = Mip.SizeY;
+	OutPixels.SetNumUninitialized(OutWidth * OutHeight);
+	FMemory::Memcpy(OutPixels.GetData(), MipData, OutPixels.Num() * sizeof(FColor));
+	Mip.BulkData.Unlock();
+	return true;
+}
+
+bool FGenImageUtils::EncodePixels(IImageWrapperModule& ImageWrapperModule, TArray<FColor> Pixels, int32 Width, int32 Height,
+                                  int32 MaxDimension, int32 JpegQuality, TArray64<uint8>& OutBytes, FString& OutMimeType)
+{
+	if (Width <= 0 || Height <= 0 || Pixels.Num() != Width * Height)
+	{
+		return false;
+	}
+
+	if (MaxDimension > 0 && FMath::Max(Width, Height) > MaxDimension)
+	{
+		const float Scale = static_cast<float>(MaxDimension) / FMath::Max(Width, Height);
+		const int32 NewWidth = FMath::Max(1, FMath::RoundToInt(Width * Scale));
+		const int32 NewHeight = FMath::Max(1, FMath::RoundToInt(Height * Scale));
+
+		TArray<FColor> Resized;
+		FImageUtils::ImageResize(Width, Height, Pixels, NewWidth, NewHeight, Resized, false);
+		Pixels = MoveTemp(Resized);
+		Width = NewWidth;
+		Height = NewHeight;
+	}
+
+	const bool bJpeg = JpegQuality > 0;
+	const TSharedPtr<IImageWrapper> ImageWrapper = ImageWrapperModule.CreateImageWrapper(bJpeg ? EImageFormat::JPEG : EImageFormat::PNG);
+	if (!ImageWrapper.IsValid() ||
+		!ImageWrapper->SetRaw(Pixels.GetData(), Pixels.Num() * sizeof(FColor), Width, Height, ERGBFormat::BGRA, 8))
+	{
+		return false;
+	}
+
+	OutBytes = ImageWrapper->GetCompressed(bJpeg ? FMath::Clamp(JpegQuality, 1, 100) : 0);
+	OutMimeType = bJpeg ? TEXT("image/jpeg") : TEXT("image/png");
+	return OutBytes.Num() > 0;
+}
+
+void FGenImageUtils::AppendBase64(const uint8* Data, int64 Num, TArray<uint8>& Out)
+{
+	static const uint8 Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+	const int32 Start = Out.AddUninitialized(static_cast<int32>(GetBase64Length(Num)));
+	uint8* Dest = Out.GetData() + Start;
+
+	int64 Index = 0;
+	for (; Index + 2 < Num; Index += 3)
+	{
+		const uint32 Triple = (Data[Index] << 16) | (Data[Index + 1] << 8) | Data[Index + 2];
+		*Dest++ = Alphabet[(Triple >> 18) & 0x3F];
+		*Dest++ = Alphabet[(Triple >> 12) & 0x3F];
+		*Dest++ = Alphabet[(Triple >> 6) & 0x3F];
+		*Dest++ = Alphabet[Triple & 0x3F];
+	}
+
+	if (Index < Num)
+	{
+		const bool bTwoBytes = Index + 1 < Num;
+		const uint32 Triple = (Data[Index] << 16) | (bTwoBytes ? Data[Index + 1] << 8 : 0);
+		*Dest++ = Alphabet[(Triple >> 18) & 0x3F];
+		*Dest++ = Alphabet[(Triple >> 12) & 0x3F];
+		*Dest++ = bTwoBytes ? Alphabet[(Triple >> 6) & 0x3F] : '=';
+		*Dest++ = '=';
+	}
+}
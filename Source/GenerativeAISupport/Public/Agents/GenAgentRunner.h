@@ -0,0 +1,164 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Tools/GenToolRegistry.h"
+#include "Utilities/GenImageUtils.h"
+#include "GenAgentRunner.generated.h"
+
+UENUM(BlueprintType)
+enum class EGenAgentProvider : uint8
+{
+	OpenAI      UMETA(DisplayName = "OpenAI"),
+	DeepSeek    UMETA(DisplayName = "DeepSeek"),
+	Anthropic   UMETA(DisplayName = "Anthropic")
+};
+
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenAgentSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	EGenAgentProvider Provider = EGenAgentProvider::OpenAI;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	FString Model = TEXT("gpt-4o-mini");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	TArray<FGenChatMessage> Messages;
+
+	// Names of tools registered in FGenToolRegistry that the agent may call
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	TArray<FString> Tools;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	FString ToolChoice;
+
+	// Max completion tokens of a single step
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	int32 MaxTokensPerStep = 4096;
+
+	// Model requests before the run is stopped
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	int32 MaxSteps = 10;
+
+	// Total tokens (prompt + completion) over all steps, 0 for no limit
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	int32 MaxTotalTokens = 0;
+
+	// Replaces the provider endpoint, e.g. to run against a local mock server
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Agent")
+	FString EndpointOverride;
+};
+
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenAgentStepInfo
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	int32 StepIndex = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	int32 NumToolCalls = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	int32 TotalTokens = 0;
+
+	// Time spent encoding the request payload
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	float EncodeMs = 0.f;
+
+	// Time from sending the request to the parsed response
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	float RequestMs = 0.f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Agent")
+	float ToolMs = 0.f;
+};
+
+// Native delegates
+DECLARE_DELEGATE_ThreeParams(FOnAgentComplete, const FString&, const FString&, bool);
+DECLARE_DELEGATE_OneParam(FOnAgentStep, const FGenAgentStepInfo&);
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenAgentCompleteDelegate, const FString&, Response, const FString&, Error, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenAgentStepDelegate, const FGenAgentStepInfo&, Step);
+
+/**
+ * Runs a tool calling conversation natively until the model answers without tool calls.
+ * The request payload is built incrementally: settings and tool definitions are serialized once and
+ * every step only encodes the messages appended since the previous step.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenAgentRunner : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Starts a run for native C++, keep the returned runner to cancel it
+	static UGenAgentRunner* RunAgent(const FGenAgentSettings& AgentSettings, const FOnAgentComplete& OnComplete,
+	                                 const FOnAgentStep& OnStep = FOnAgentStep());
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenAgentCompleteDelegate OnComplete;
+
+	// Blueprint async function, broadcast after every completed step
+	UPROPERTY(BlueprintAssignable)
+	FGenAgentStepDelegate OnStep;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Agent")
+	static UGenAgentRunner* RunGenAgent(UObject* WorldContextObject, const FGenAgentSettings& AgentSettings);
+
+	// Conversation including all tool rounds so far
+	const TArray<FGenChatMessage>& GetMessages() const { return AgentSettings.Messages; }
+	const TArray<FGenAgentStepInfo>& GetSteps() const { return Steps; }
+
+	virtual void Cancel() override;
+
+protected:
+	virtual void Activate() override;
+
+private:
+	void SendStep();
+	void HandleResponse(const FString& ResponseStr, double RequestStartTime);
+	void HandleToolResults(const TArray<FGenToolCall>& Calls, const FString& AssistantText, const TArray<FGenToolResult>& Results, double ToolStartTime);
+	void CompleteStep();
+	void Finish(const FString& Response, const FString& Error, bool bSuccess);
+
+	// Encodes the messages from EncodedMessageCount on and appends them to EncodedHistory
+	void EncodeNewMessages();
+	void BuildPayloadPrefix();
+
+	// Extracts text, tool calls and token usage from a provider response
+	static bool ParseResponse(const FString& ResponseStr, EGenAgentProvider Provider, FString& OutText,
+	                          TArray<FGenToolCall>& OutCalls, int32& OutTokens, FString& OutError);
+
+	FGenAgentSettings AgentSettings;
+	FOnAgentComplete NativeOnComplete;
+	FOnAgentStep NativeOnStep;
+
+	FString PayloadPrefix;
+	FString EncodedHistory;
+	int32 EncodedMessageCount = 0;
+	// Image attachments of the encoded messages, each image is encoded for the first step that sends it
+	TSharedRef<FGenImageAttachments> EncodedImages = MakeShared<FGenImageAttachments>();
+
+	TArray<FGenAgentStepInfo> Steps;
+	FGenAgentStepInfo CurrentStep;
+	FString LastText;
+	int32 TotalTokens = 0;
+	double RunStartTime = 0.0;
+
+	TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> CurrentRequest;
+	bool bStarted = false;
+	bool bFinished = false;
+	bool bRootedNative = false;
+};
@@ -37,6 +37,22 @@ struct FGenClaudeChatSettings
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API")
 	TArray<FGenChatMessage> Messages;
+
+	// Names of tools registered in FGenToolRegistry that the model may call
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API|Tools")
+	TArray<FString> Tools;
+
+	// "auto", "none", "required" or the name of a single tool, empty uses the provider default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API|Tools")
+	FString ToolChoice;
+
+	// How many times tool results are sent back automatically before giving up
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API|Tools")
+	int32 MaxToolRoundTrips = 5;
+
+	// Replaces the API endpoint, e.g. to run against a local stub (no API key needed then)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Claude API")
+	FString EndpointOverride;
 };
 
 /**
@@ -0,0 +1,101 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenAIOrgs.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "GenRouterStructs.generated.h"
+
+/**
+ * A provider/model pair the router may send a request to
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenRouterCandidate
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	EGenAIOrgs Provider = EGenAIOrgs::OpenAI;
+
+	// Model name as sent to the provider, e.g. gpt-4o-mini, claude-3-5-haiku-latest, deepseek-chat, gemini-2.0-flash
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	FString Model;
+
+	// Blended price per 1K tokens, compared against FGenRouterSettings::MaxCostPer1KTokens
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	float CostPer1KTokens = 0.0f;
+
+	// Used by every provider except DeepSeek, e.g. to run against a local stub (no API key needed then)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	FString EndpointOverride;
+};
+
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenRouterSettings
+{
+	GENERATED_BODY()
+
+	// Endpoints to choose from, the order only breaks ties
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	TArray<FGenRouterCandidate> Candidates;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	TArray<FGenChatMessage> Messages;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	int32 MaxTokens = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	float Temperature = 0.7f;
+
+	// Candidates above this price are never used, 0 disables the ceiling
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	float MaxCostPer1KTokens = 0.0f;
+
+	// Failed requests are retried on the next best endpoint until this many endpoints were tried.
+	// Misconfigured candidates (unknown model, missing API key) are skipped without counting as attempts
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GenAI|Router")
+	int32 MaxAttempts = 2;
+};
+
+UENUM(BlueprintType)
+enum class EGenEndpointState : uint8
+{
+	Healthy,
+	// Failing, receives no traffic until its cooldown ends
+	Degraded,
+	// Cooldown ended, receives a growing share of traffic until it is trusted again
+	Probing
+};
+
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenEndpointHealthStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	EGenAIOrgs Provider = EGenAIOrgs::Unknown;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	FString Model;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	EGenEndpointState State = EGenEndpointState::Healthy;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	float EwmaLatencyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	float P50LatencyMs = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	float P95LatencyMs = 0.0f;
+
+	// Exponentially weighted, 0..1
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	float ErrorRate = 0.0f;
+
+	UPROPERTY(BlueprintReadOnly, Category = "GenAI|Router")
+	int32 NumRequests = 0;
+};
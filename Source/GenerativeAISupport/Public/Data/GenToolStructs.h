@@ -0,0 +1,48 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenToolStructs.generated.h"
+
+/**
+ * A tool (function) call requested by the model
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenToolCall
+{
+	GENERATED_BODY()
+
+	// Provider assigned id, tool results must reference it
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Id;
+
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Name;
+
+	// Arguments as a JSON object string
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString ArgumentsJson;
+};
+
+/**
+ * Result of executing a tool call, sent back to the model
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenToolResult
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString ToolCallId;
+
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Name;
+
+	// Output as JSON, or the error message when bSuccess is false
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString Output;
+
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	bool bSuccess = false;
+};
@@ -0,0 +1,38 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "GenGeminiChatStructs.generated.h"
+
+/**
+ * Google Gemini chat settings. Messages use the same roles as the other providers,
+ * "assistant" is sent as "model" and "system" messages become the system instruction.
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenGeminiChatSettings
+{
+	GENERATED_BODY()
+
+	// can be gemini-2.0-flash, gemini-2.0-flash-lite, gemini-1.5-pro, ...
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	FString Model = TEXT("gemini-2.0-flash");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	int32 MaxTokens = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	float Temperature = 0.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	TArray<FGenChatMessage> Messages;
+
+	// Text is delivered through OnDelta while it is generated
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	bool bStreamResponse = false;
+
+	// Replaces the full request URL (streamed and regular requests alike), e.g. to run against a local stub
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Gemini API")
+	FString EndpointOverride;
+};
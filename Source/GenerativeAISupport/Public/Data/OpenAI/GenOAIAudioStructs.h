@@ -0,0 +1,67 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenOAIAudioStructs.generated.h"
+
+/**
+ * Speech to text settings, the audio is 16 bit signed PCM
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenOAITranscriptionSettings
+{
+	GENERATED_BODY()
+
+	// can be whisper-1, gpt-4o-transcribe or gpt-4o-mini-transcribe
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Model = TEXT("whisper-1");
+
+	// ISO-639-1 code, empty lets the model detect it
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Language;
+
+	// Optional text to guide the style or vocabulary (e.g. character names)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Prompt;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	int32 SampleRate = 16000;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	int32 NumChannels = 1;
+
+	// Replaces the API endpoint, e.g. to run against a local stub
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString EndpointOverride;
+};
+
+/**
+ * Text to speech settings, audio is streamed as 24 kHz mono 16 bit PCM
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenOAISpeechSettings
+{
+	GENERATED_BODY()
+
+	// can be tts-1, tts-1-hd or gpt-4o-mini-tts
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Model = TEXT("tts-1");
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Voice = TEXT("alloy");
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Input;
+
+	// Voice instructions, only used by gpt-4o-mini-tts
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString Instructions;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	float Speed = 1.0f;
+
+	// Replaces the API endpoint, e.g. to run against a local stub
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Audio")
+	FString EndpointOverride;
+};
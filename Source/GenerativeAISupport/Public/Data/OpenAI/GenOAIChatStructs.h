@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Data/GenToolStructs.h"
+#include "Engine/Texture2D.h"
 #include "GenOAIChatStructs.generated.h"
 
 USTRUCT(BlueprintType)
@@ -38,6 +40,46 @@ struct FResponse
 	FString error;
 };
 
+/**
+ * Image attached to a chat message. Exactly one source is used, in order: Texture, Pixels, FilePath.
+ * Images are encoded to base64 on a worker thread when the request is sent.
+ */
+USTRUCT(BlueprintType)
+struct FGenChatImage
+{
+	GENERATED_BODY()
+
+	// Read on the game thread, needs uncompressed BGRA8 data (or editor source data)
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	UTexture2D* Texture = nullptr;
+
+	// Raw BGRA pixels, Width * Height entries
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	TArray<FColor> Pixels;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	int32 Width = 0;
+
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	int32 Height = 0;
+
+	// PNG or JPEG files within MaxDimension are sent as they are, everything else is re-encoded
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	FString FilePath;
+
+	// Larger images are downscaled to fit, 0 keeps the original resolution
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	int32 MaxDimension = 1024;
+
+	// JPEG quality used for re-encoding, 0 encodes PNG instead
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	int32 JpegQuality = 85;
+
+	// OpenAI detail level: "auto", "low" or "high"
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Image")
+	FString Detail = TEXT("auto");
+};
+
 USTRUCT(BlueprintType)
 struct FGenChatMessage
 {
@@ -48,6 +90,22 @@ struct FGenChatMessage
 
 	UPROPERTY(BlueprintReadWrite, Category = "Chat")
 	FString Content;
+
+	// Tool calls requested by the assistant in this message
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	TArray<FGenToolCall> ToolCalls;
+
+	// For Role "tool", the id of the tool call this message answers
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	FString ToolCallId;
+
+	// For Role "tool", true when the tool call failed and Content holds the error
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	bool bToolError = false;
+
+	// Images sent along with Content (OpenAI and Anthropic)
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	TArray<FGenChatImage> Images;
 };
 
 USTRUCT(BlueprintType)
@@ -70,7 +128,26 @@ struct FGenChatSettings
 
 	UPROPERTY(BlueprintReadWrite, Category = "Chat")
 	FString Model; //can be gpt-4o-mini, 
-    
+
+	// Sampling temperature, negative keeps the model default (o-series models only accept the default)
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	float Temperature = -1.0f;
+
+	// Names of tools registered in FGenToolRegistry that the model may call
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Tools")
+	TArray<FString> Tools;
+
+	// "auto", "none", "required" or the name of a single tool, empty uses the provider default
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Tools")
+	FString ToolChoice;
+
+	// How many times tool results are sent back automatically before giving up
+	UPROPERTY(BlueprintReadWrite, Category = "Chat|Tools")
+	int32 MaxToolRoundTrips = 5;
+
+	// Replaces the API endpoint, e.g. to run against a local stub (no API key needed then)
+	UPROPERTY(BlueprintReadWrite, Category = "Chat")
+	FString EndpointOverride;
 };
 
 /**
@@ -95,4 +172,9 @@ struct GENERATIVEAISUPPORT_API FGenOAIStructuredChatSettings
 	// JSON schema for structured outputs
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI")
 	FString SchemaJson;
+
+	// Streaming only: dot separated keys of the array (or object) whose elements are streamed, e.g. "items" for
+	// {"items": [...]}. Empty streams the elements of the root itself.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI")
+	FString StreamElementPath;
 };
\ No newline at end of file
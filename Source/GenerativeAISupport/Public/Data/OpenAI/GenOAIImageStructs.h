@@ -0,0 +1,41 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GenOAIImageStructs.generated.h"
+
+/**
+ * Image generation settings
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenOAIImageSettings
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	FString Prompt;
+
+	// can be dall-e-3, dall-e-2 or gpt-image-1
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	FString Model = TEXT("dall-e-3");
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	FString Size = TEXT("1024x1024");
+
+	// Empty uses the model default
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	FString Quality;
+
+	// dall-e-3 only supports 1
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	int32 NumImages = 1;
+
+	// Reuses images previously generated for the same prompt and settings from Saved/GenAI/ImageCache
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	bool bUseCache = true;
+
+	// Replaces the API endpoint, e.g. to run against a local stub (no API key needed then)
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GenAI|Image")
+	FString EndpointOverride;
+};
@@ -0,0 +1,49 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "GenGrokChatStructs.generated.h"
+
+/**
+ * xAI Grok chat settings, the API follows the OpenAI chat completions format
+ */
+USTRUCT(BlueprintType)
+struct GENERATIVEAISUPPORT_API FGenGrokChatSettings
+{
+	GENERATED_BODY()
+
+	// can be grok-3, grok-3-mini, grok-2-latest, ...
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	FString Model = TEXT("grok-3-mini");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	int32 MaxTokens = 4096;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	float Temperature = 0.7f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	TArray<FGenChatMessage> Messages;
+
+	// Names of tools registered in FGenToolRegistry that the model may call
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API|Tools")
+	TArray<FString> Tools;
+
+	// "auto", "none", "required" or the name of a single tool, empty uses the provider default
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API|Tools")
+	FString ToolChoice;
+
+	// How many times tool results are sent back automatically before giving up
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API|Tools")
+	int32 MaxToolRoundTrips = 5;
+
+	// Text is delivered through OnDelta while it is generated, not supported together with Tools
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	bool bStreamResponse = false;
+
+	// Replaces the API endpoint, e.g. to run against a local stub
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Grok API")
+	FString EndpointOverride;
+};
@@ -18,6 +18,10 @@ public:
 	{
 		// Default values
 		AutoStartSocketServer = false;
+		AutoStartNativeCommandServer = false;
+		NativeCommandServerPort = 9878;
+		CommandFrameBudgetMs = 8.0f;
+		CompileIdleDelaySeconds = 0.5f;
 	}
 
 	// Name that will appear in the settings menu
@@ -26,4 +30,20 @@ public:
 	/** Whether to automatically start the socket server when the editor launches */
 	UPROPERTY(config, EditAnywhere, Category = "Socket Server", meta = (DisplayName = "Auto Start Socket Server"))
 	bool AutoStartSocketServer;
+
+	/** Whether to start the native (C++) command server when the editor launches, clients use length-prefixed JSON frames */
+	UPROPERTY(config, EditAnywhere, Category = "Socket Server", meta = (DisplayName = "Auto Start Native Command Server"))
+	bool AutoStartNativeCommandServer;
+
+	/** Port of the native command server, the Python socket server uses 9877 */
+	UPROPERTY(config, EditAnywhere, Category = "Socket Server", meta = (DisplayName = "Native Command Server Port", ClampMin = "1", ClampMax = "65535"))
+	int32 NativeCommandServerPort;
+
+	/** Game thread time per frame spent on queued native MCP commands, at least one command runs every frame */
+	UPROPERTY(config, EditAnywhere, Category = "Socket Server", meta = (DisplayName = "Command Frame Budget (ms)", ClampMin = "0.0", UIMax = "33.0"))
+	float CommandFrameBudgetMs;
+
+	/** Blueprints edited over MCP are compiled once no edit arrived for this long, 0 compiles after every edit */
+	UPROPERTY(config, EditAnywhere, Category = "Blueprint Editing", meta = (DisplayName = "Compile Idle Delay (s)", ClampMin = "0.0", UIMax = "10.0"))
+	float CompileIdleDelaySeconds;
 };
\ No newline at end of file
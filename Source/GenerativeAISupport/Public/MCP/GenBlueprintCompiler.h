@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class UBlueprint;
+
+/**
+ * Compiles many Blueprints at once. The Blueprints are ordered so that parent classes and Blueprints referenced by
+ * others in the set come first, then all of them are queued to the Kismet compilation manager and compiled and
+ * reinstanced in one pass, so a dependent is not compiled again for every Blueprint it uses. Broken links are
+ * repaired with FGenGraphValidator first, like CompileBlueprint does.
+ * The response has the status, errors and warnings of every Blueprint:
+ * {"success", "mode", "elapsed_ms", "errors", "warnings", "blueprints": [{"blueprint_path", "success", "status", "fixed_links", "errors": [...], "warnings": [...]}]}
+ */
+class GENERATIVEAISUPPORT_API FGenBlueprintCompiler
+{
+public:
+	// Sequential compiles one Blueprint after the other in the given order, the way separate compile calls did
+	static TSharedPtr<FJsonObject> Compile(const TArray<UBlueprint*>& Blueprints, bool bSequential = false);
+
+	// Dependencies within the set first, otherwise in the given order. Blueprints in a cycle keep the given order.
+	static TArray<UBlueprint*> SortByDependencies(const TArray<UBlueprint*>& Blueprints);
+
+private:
+	// Status and the compiler messages left on the nodes of the Blueprint
+	static TSharedPtr<FJsonObject> MakeBlueprintResult(UBlueprint* Blueprint);
+};
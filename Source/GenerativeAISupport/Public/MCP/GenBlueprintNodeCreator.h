@@ -8,8 +8,11 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "EdGraph/EdGraph.h"
 #include "K2Node.h"
+#include "Dom/JsonObject.h"
 #include "GenBlueprintNodeCreator.generated.h"
 
+struct FGenNodeRecipe;
+
 /**
  * 
  */
@@ -28,6 +31,14 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Nodes")
 	static FString AddNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid, const FString& NodesJson);
 
+	/**
+	 * Native bulk insertion, the Blueprint and graph are resolved once and node reconstruction, graph notifications
+	 * and the structural modification happen once for the whole batch.
+	 * Nodes use the AddNodesBulk format, returns {node_guid, ref_id} for every created node.
+	 */
+	static TArray<TSharedPtr<FJsonValue>> AddNodesToGraph(const FString& BlueprintPath, const FString& FunctionGuid,
+	                                                      const TArray<TSharedPtr<FJsonValue>>& Nodes, FString& OutError);
+
 	UFUNCTION(BlueprintCallable, Category = "Blueprint")
 	static bool DeleteNode(const FString& BlueprintPath, const FString& FunctionGuid, const FString& NodeGuid);
 
@@ -39,18 +50,40 @@ public:
 	
 	UFUNCTION(BlueprintCallable, Category = "Blueprint")
 	static FString GetNodeSuggestions(const FString& NodeType);
+
+	// Ranked function candidates for a node type as a JSON array of {name, score}, best first
+	UFUNCTION(BlueprintCallable, Category = "Blueprint")
+	static FString GetRankedNodeCandidates(const FString& NodeType, int32 MaxResults = 10);
+
+	/**
+	 * Times function lookups for the given node types, returns {functions, lookups, build_ms, average_ms, max_ms} as JSON.
+	 * With ExpectedNames (parallel to NodeTypes, "Class.Function") it also reports recall_at_1, recall_at_5 and the misses.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Blueprint")
+	static FString BenchmarkNodeLookup(const TArray<FString>& NodeTypes, const TArray<FString>& ExpectedNames, int32 Iterations = 100);
+
+	// Reloads Config/NodeTypeAliases.json (and the project override), returns {success, recipes, aliases} as JSON
+	UFUNCTION(BlueprintCallable, Category = "Blueprint")
+	static FString ReloadNodeTypeAliases();
 	
 
 
 private:
-	// Static map of friendly node names to Unreal Engine node types
-	static TMap<FString, FString> NodeTypeMap;
-    
-	// Function to initialize the map (called once)
-	static void InitNodeTypeMap();
 	// Attempts to create a node of a known type
 	static bool TryCreateKnownNodeType(UEdGraph* Graph, const FString& NodeType, UK2Node*& OutNode,
-									   const FString& PropertiesJson = TEXT(""));
+									   const TSharedPtr<FJsonObject>& Properties = nullptr);
+
+	// Creates the override event of an event recipe in the default EventGraph, replacing the existing ones
+	static bool CreateOverrideEventNode(UEdGraph* Graph, const FGenNodeRecipe& Recipe, UK2Node*& OutNode);
+
+	// Creates a transactional node in the graph and applies its pin defaults, reconstruction is left to the caller.
+	// With bNotifyGraph the node goes through UEdGraph::AddNode, otherwise the caller modifies the graph and sends
+	// the add notification. OutError holds "SUGGESTIONS:..." when the node type is unknown
+	static UK2Node* CreateNode(UEdGraph* Graph, const FString& NodeType, float NodeX, float NodeY,
+	                           const TSharedPtr<FJsonObject>& Properties, FString& OutError, bool bNotifyGraph = true);
+
+	// Brings the graph to front and marks the Blueprint structurally modified if nodes were created
+	static void FinalizeGraphChanges(UBlueprint* Blueprint, UEdGraph* Graph);
 	static UEdGraph* GetGraphFromFunctionId(UBlueprint* Blueprint, const FString& FunctionGuid);
 
 	// Attempts to create a node by searching Blueprint libraries and actor classes
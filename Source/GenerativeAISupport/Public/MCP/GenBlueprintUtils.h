@@ -7,6 +7,7 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "Engine/Blueprint.h"
 #include "K2Node.h"
+#include "Dom/JsonObject.h"
 #include "GenBlueprintUtils.generated.h"
 
 /**
@@ -94,6 +95,26 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
 	static bool CompileBlueprint(const FString& BlueprintPath);
 
+	/**
+	 * Compile several Blueprints in one pass of the compilation manager, dependencies first
+	 * 
+	 * @param BlueprintPaths - Paths to the Blueprint assets
+	 * @param bSequential - Compile them one after the other in the given order instead, to compare the timing
+	 * @return JSON string with the status, errors and warnings of every Blueprint and the compile time
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString CompileBlueprints(const TArray<FString>& BlueprintPaths, bool bSequential);
+
+	/**
+	 * Check every graph of a Blueprint for broken links, type mismatches, unconnected exec inputs and orphaned nodes
+	 * 
+	 * @param BlueprintPath - Path to the Blueprint asset
+	 * @param bFix - Remove the broken links from both pins and keep only the first link of exec outputs
+	 * @return JSON string with the diagnostics, see FGenGraphValidator
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString ValidateBlueprint(const FString& BlueprintPath, bool bFix);
+
 	/**
 	 * Spawn a Blueprint actor in the level
 	 * 
@@ -121,7 +142,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
 	static FString ConnectNodesBulk(const FString& BlueprintPath, const FString& FunctionGuid,
 	                                const FString& ConnectionsJson);
+
+	/**
+	 * Native bulk wiring, the Blueprint, graph and nodes are resolved once and the structural modification happens
+	 * once for the whole batch. Connections use the ConnectNodesBulk format, the response has the result of every
+	 * connection plus the total and per-connection time.
+	 */
+	static TSharedPtr<FJsonObject> ConnectNodesInGraph(const FString& BlueprintPath, const FString& FunctionGuid,
+	                                                   const TArray<TSharedPtr<FJsonValue>>& Connections);
 	
+	/**
+	 * Run an ordered list of MCP operations under one transaction and compile the touched Blueprints once at the end
+	 * 
+	 * @param BatchJson - JSON object with an "operations" array, see FGenCommandBatch
+	 * @return JSON string with the result of every operation and of the final compiles
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString ExecuteBatch(const FString& BatchJson);
+
+	/**
+	 * Starts an edit session, compiles and structural modifications requested by the following edits are coalesced
+	 * into one per Blueprint when the session ends. Sessions end by themselves after a minute without edits.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static void BeginEditSession();
+
+	// Ends the edit session and compiles the edited Blueprints, returns the compile metrics as JSON
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString EndEditSession();
+
+	// Applies the pending compiles of the Blueprint (all Blueprints for an empty path), returns the compile metrics as JSON
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString FlushPendingCompiles(const FString& BlueprintPath);
+
+	// Compile count and time, coalesced requests and pending Blueprints as JSON
+	UFUNCTION(BlueprintCallable, Category = "Generative AI|Blueprint Utils")
+	static FString GetCompileStats();
+
 	static bool OpenBlueprintGraph(UBlueprint* Blueprint, UEdGraph* Graph = nullptr);
 	
 	UFUNCTION(BlueprintCallable, Category = "GenBlueprintUtils")
@@ -136,4 +193,13 @@ private:
 	static UBlueprint* LoadBlueprintAsset(const FString& BlueprintPath);
 	static UClass* FindClassByName(const FString& ClassName);
 	static UFunction* FindFunctionByName(UClass* Class, const FString& FunctionName);
+
+	// "EventGraph" or the GUID of a graph of the Blueprint, OutError tells a malformed GUID from a missing graph
+	static UEdGraph* FindGraphById(UBlueprint* Blueprint, const FString& FunctionGuid, FString& OutError);
+
+	// Links the output pin of the source node to the input pin of the target node, returns {success, error, ...} without
+	// marking the Blueprint modified
+	static TSharedPtr<FJsonObject> ConnectPins(UBlueprint* Blueprint, UEdGraph* FunctionGraph,
+	                                           const FString& SourceNodeGuid, const FString& SourcePinName,
+	                                           const FString& TargetNodeGuid, const FString& TargetPinName);
 };
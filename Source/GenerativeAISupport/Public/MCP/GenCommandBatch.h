@@ -0,0 +1,33 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Runs an ordered list of MCP operations (same format as the single commands) as one unit:
+ * {"operations": [{"id": "bp", "type": "create_blueprint", ...}, ...], "compile": true, "stop_on_error": true, "rollback_on_error": false}
+ *
+ * All operations share one editor transaction, compiles requested by the operations are deferred and every
+ * touched Blueprint is compiled once at the end. An operation can use the result of an earlier one that has an "id":
+ * a string that is exactly "${bp.blueprint_path}" is replaced by that field of the result, keeping its JSON type ("$${" escapes it).
+ * Nested fields and array elements are addressed with more segments, e.g. "${nodes.nodes.BeginPlay}".
+ */
+class GENERATIVEAISUPPORT_API FGenCommandBatch
+{
+public:
+	static TSharedPtr<FJsonObject> Execute(const TSharedPtr<FJsonObject>& Batch);
+
+private:
+	static TSharedPtr<FJsonObject> RunOperation(const TSharedPtr<FJsonObject>& Operation, TSet<FString>& TouchedBlueprints,
+	                                            TArray<FString>& CompilePaths);
+
+	// Returns nullptr and sets OutError if a reference cannot be resolved
+	static TSharedPtr<FJsonValue> ResolveReferences(const TSharedPtr<FJsonValue>& Value, const TMap<FString, TSharedPtr<FJsonObject>>& Results,
+	                                                FString& OutError);
+	static TSharedPtr<FJsonValue> ResolveReference(const FString& Reference, const TMap<FString, TSharedPtr<FJsonObject>>& Results,
+	                                               FString& OutError);
+};
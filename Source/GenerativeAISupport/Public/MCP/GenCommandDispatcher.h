@@ -0,0 +1,44 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Native counterpart of the CommandDispatcher in Content/Python/unreal_socket_server.py.
+ * Maps the MCP command "type" to a handler that calls straight into UGenBlueprintUtils,
+ * UGenBlueprintNodeCreator, UGenActorUtils and UGenObjectProperties. Request and response
+ * JSON match the Python handlers, so the MCP server can talk to either bridge.
+ * Handlers run on the game thread.
+ */
+class GENERATIVEAISUPPORT_API FGenCommandDispatcher
+{
+public:
+	using FCommandHandler = TFunction<TSharedPtr<FJsonObject>(const TSharedPtr<FJsonObject>& Command)>;
+
+	static FGenCommandDispatcher& Get();
+
+	// Adds or replaces the handler of a command type, game thread only
+	void RegisterHandler(const FString& Type, FCommandHandler Handler);
+
+	// Runs the handler of the command's "type", always returns a response with a "success" field
+	TSharedPtr<FJsonObject> Dispatch(const TSharedPtr<FJsonObject>& Command) const;
+
+	// Commands that don't touch engine state and may be answered from any thread
+	static bool IsThreadSafeCommand(const FString& Type);
+
+	static TSharedPtr<FJsonObject> MakeError(const FString& Error);
+
+	// Wraps a JSON string returned by the utility classes, invalid JSON becomes an error response
+	static TSharedPtr<FJsonObject> ParseResult(const FString& ResultJson);
+
+private:
+	FGenCommandDispatcher();
+
+	void RegisterBuiltinHandlers();
+
+	TMap<FString, FCommandHandler> Handlers;
+};
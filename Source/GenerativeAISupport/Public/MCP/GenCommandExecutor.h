@@ -0,0 +1,72 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+
+struct FGenCommandPumpStats
+{
+	int32 QueueDepth = 0;
+	int32 PeakQueueDepth = 0;
+	int64 CommandsExecuted = 0;
+	double AverageWaitMs = 0.0;
+	double MaxWaitMs = 0.0;
+	double AverageExecuteMs = 0.0;
+
+	// Measured over the last window (up to one second) with queued work
+	double CommandsPerSecond = 0.0;
+};
+
+/**
+ * Game thread pump for MCP commands. Commands can be queued from any thread, every frame the pump
+ * dispatches as many of them as fit in the configured frame budget (at least one per frame).
+ */
+class GENERATIVEAISUPPORT_API FGenCommandExecutor
+{
+public:
+	using FOnCommandExecuted = TFunction<void(const TSharedPtr<FJsonObject>& Response)>;
+
+	static FGenCommandExecutor& Get();
+
+	// Thread safe, OnExecuted is called on the game thread. ReceiveTime is used for the wait time metrics
+	void Enqueue(TSharedPtr<FJsonObject> Command, FOnCommandExecuted OnExecuted, double ReceiveTime = FPlatformTime::Seconds());
+
+	// Game thread only
+	FGenCommandPumpStats GetStats() const;
+	void ResetStats();
+
+	// Drops the queued commands and stops pumping, called on module shutdown
+	void Shutdown();
+
+private:
+	struct FQueuedCommand
+	{
+		TSharedPtr<FJsonObject> Command;
+		FOnCommandExecuted OnExecuted;
+		double ReceiveTime = 0.0;
+	};
+
+	FGenCommandExecutor();
+
+	bool Tick(float DeltaTime);
+
+	TQueue<FQueuedCommand, EQueueMode::Mpsc> Queue;
+	TAtomic<int32> QueueDepth{0};
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// Metrics, only touched on the game thread
+	int32 PeakQueueDepth = 0;
+	int64 CommandsExecuted = 0;
+	double TotalWaitSeconds = 0.0;
+	double MaxWaitSeconds = 0.0;
+	double TotalExecuteSeconds = 0.0;
+	double WindowStartTime = 0.0;
+	double LastExecuteTime = 0.0;
+	int32 WindowCommands = 0;
+	double CommandsPerSecond = 0.0;
+};
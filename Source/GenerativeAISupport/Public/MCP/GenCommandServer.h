@@ -0,0 +1,103 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/Runnable.h"
+
+class FJsonValue;
+class FSocket;
+class FTcpListener;
+class FRunnableThread;
+struct FIPv4Endpoint;
+
+/**
+ * Native command server, an in-process alternative to the Python socket server (unreal_socket_server.py).
+ * Accepts any number of persistent local clients. Every message is framed as a 4-byte big-endian length followed by
+ * a UTF-8 JSON command using the same format as the Python bridge. Commands can be pipelined, responses
+ * echo the command's "request_id" since they are not guaranteed to come back in order.
+ * Socket I/O runs on a dedicated thread, commands are handed to the game thread through the lock-free queue
+ * of FGenCommandExecutor and dispatched by FGenCommandDispatcher.
+ */
+class GENERATIVEAISUPPORT_API FGenCommandServer : public FRunnable
+{
+public:
+	// The Python socket server uses 9877, both can run side by side
+	static constexpr int32 DefaultPort = 9878;
+
+	// Frames above this size are treated as a protocol error and the connection is closed
+	static constexpr int32 MaxFrameSize = 64 * 1024 * 1024;
+
+	// Bytes read from one connection per pass of the I/O thread, so a large upload does not stall the other clients
+	static constexpr int32 MaxBytesPerTick = 1024 * 1024;
+
+	enum class EFrameStatus : uint8
+	{
+		Incomplete,
+		Complete,
+		TooLarge
+	};
+
+	static FGenCommandServer& Get();
+
+	virtual ~FGenCommandServer() override;
+
+	// Listens on localhost, returns false if the port could not be bound
+	bool Start(int32 Port = DefaultPort);
+
+	void Shutdown();
+
+	bool IsRunning() const { return Thread != nullptr; }
+
+	// Appends the length prefix to a UTF-8 encoded JSON string
+	static TArray<uint8> MakeFrame(const FString& Json);
+
+	// Reads the length prefix at the start of Data. OutPayloadSize is set as soon as the header is complete,
+	// so an oversized frame is rejected before its payload is received
+	static EFrameStatus DecodeFrame(const uint8* Data, int32 Num, int32& OutPayloadSize);
+
+	// The "request_id" of a command that is not valid JSON, when that part of it is intact.
+	// Clients add the id last, so the last occurrence is used
+	static TSharedPtr<FJsonValue> FindRequestId(const FString& Json);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	struct FConnection
+	{
+		explicit FConnection(FSocket* InSocket);
+		~FConnection();
+
+		FSocket* Socket;
+		TArray<uint8> ReadBuffer;
+		TArray<uint8> WriteBuffer;
+		int32 WriteOffset = 0;
+
+		// Responses waiting to be written, filled by the game thread (and the I/O thread for inline commands)
+		TQueue<TArray<uint8>, EQueueMode::Mpsc> Outgoing;
+	};
+
+	FGenCommandServer() = default;
+
+	bool OnConnectionAccepted(FSocket* Socket, const FIPv4Endpoint& Endpoint);
+
+	// All return false once the connection should be closed, bOutActive is set when any bytes moved
+	bool ReadFrames(const TSharedPtr<FConnection, ESPMode::ThreadSafe>& Connection, bool& bOutActive);
+	bool ProcessFrames(const TSharedPtr<FConnection, ESPMode::ThreadSafe>& Connection);
+	bool WriteFrames(FConnection& Connection, bool& bOutActive);
+
+	TUniquePtr<FTcpListener> Listener;
+	FRunnableThread* Thread = nullptr;
+	FEvent* WakeEvent = nullptr;
+	TAtomic<bool> bStopping{false};
+
+	// Owned by the I/O thread
+	TArray<TSharedPtr<FConnection, ESPMode::ThreadSafe>> Connections;
+
+	TQueue<FSocket*, EQueueMode::Mpsc> AcceptedSockets;
+};
@@ -0,0 +1,91 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "Dom/JsonObject.h"
+
+class UBlueprint;
+
+/**
+ * Coalesces the compiles and structural modifications requested by MCP edits. Requests only mark the Blueprint
+ * as pending, pending Blueprints are compiled (or marked structurally modified) once each when the outermost edit
+ * session ends, or once no edit arrived for the compile idle delay of the plugin settings. With an idle delay of 0
+ * requests outside a session are applied right away. Commands that resolve functions, variables or pins on the
+ * skeleton class call UpdateSkeleton first, so they see the edits still waiting for their compile. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenEditSession
+{
+public:
+	static FGenEditSession& Get();
+
+	// Sessions nest, nothing pending is applied before the outermost one ends
+	void BeginSession();
+	// Ends the session and flushes everything pending once the outermost one ends
+	void EndSession();
+	// Ends the session without flushing, the outermost one returns the Blueprints edited during the session for the
+	// caller to compile. Edits that were pending before the session began stay pending
+	TArray<UBlueprint*> EndSessionAndTakePending();
+
+	// Session opened by an MCP client, it ends on request or after a minute without edits
+	void BeginExternalSession();
+	void EndExternalSession();
+
+	void RequestCompile(UBlueprint* Blueprint);
+	void RequestStructuralModification(UBlueprint* Blueprint);
+
+	// Regenerates the skeleton class when pending edits changed the Blueprint's structure, the compile stays pending
+	void UpdateSkeleton(UBlueprint* Blueprint);
+
+	// Applies what is pending for the Blueprint (all Blueprints when nullptr), returns the number of compiles
+	int32 Flush(UBlueprint* Blueprint = nullptr);
+
+	// Compiles right away and drops the pending requests of the Blueprint, counted in the metrics
+	void CompileNow(UBlueprint* Blueprint);
+
+	// Counts Blueprints compiled in one pass elsewhere and drops their pending requests
+	void RecordCompiles(const TArray<UBlueprint*>& Blueprints, double ElapsedMs);
+
+	// {compiles, compile_ms_total, compile_ms_max, structural_modifications, coalesced_requests, pending, in_session}
+	TSharedPtr<FJsonObject> GetStats() const;
+
+	bool IsInSession() const { return SessionDepth > 0; }
+
+	// Drops everything pending and stops the ticker, called on module shutdown
+	void Shutdown();
+
+private:
+	struct FPendingEdit
+	{
+		bool bCompile = false;
+		// The skeleton class lags behind the graphs
+		bool bStructural = false;
+	};
+
+	FGenEditSession() = default;
+
+	FPendingEdit* AddPending(UBlueprint* Blueprint);
+	void RestorePendingBeforeSession();
+	static void MergeEdit(FPendingEdit& Into, const FPendingEdit& Edit);
+	void EnsureTicker();
+	bool Tick(float DeltaTime);
+	static float GetIdleDelay();
+
+	int32 SessionDepth = 0;
+	bool bExternalSession = false;
+	TMap<TWeakObjectPtr<UBlueprint>, FPendingEdit> Pending;
+	// Edits pending when the outermost session began, kept apart so the session only hands out its own
+	TMap<TWeakObjectPtr<UBlueprint>, FPendingEdit> PendingBeforeSession;
+	double LastEditTime = 0.0;
+	FTSTicker::FDelegateHandle TickerHandle;
+
+	// Metrics since editor start, the max is the longest compile pass
+	int32 CompileCount = 0;
+	double TotalCompileMs = 0.0;
+	double MaxCompileMs = 0.0;
+	int32 StructuralModificationCount = 0;
+	int32 CoalescedRequestCount = 0;
+};
@@ -0,0 +1,164 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+
+enum class EGenFunctionFlags : uint8
+{
+	None = 0,
+	Pure = 1 << 0,
+	Static = 1 << 1,
+	Latent = 1 << 2,
+	// Deprecated or BlueprintInternalUseOnly, never offered for node creation
+	Hidden = 1 << 3,
+};
+ENUM_CLASS_FLAGS(EGenFunctionFlags);
+
+struct FGenFunctionMatch
+{
+	int32 Index = INDEX_NONE;
+	int32 Score = 0;
+	// Only matched through the edit distance, the request is a typo of the name
+	bool bNearMiss = false;
+};
+
+// One catalogued function, plain data so it can be indexed off the game thread and cached on disk
+struct FGenFunctionCatalogEntry
+{
+	FString ClassPath;
+	FString ClassName;
+	FString FunctionName;
+	// DisplayName metadata (the node title), empty when the function has none
+	FString NodeTitle;
+	EGenFunctionFlags Flags = EGenFunctionFlags::None;
+};
+
+struct FGenFunctionIndexData;
+
+/**
+ * Catalog of every BlueprintCallable function in the loaded modules that node types are resolved against.
+ * Function names and node titles are normalized (lowercase, alphanumerics only, no K2 prefix) into flat arrays
+ * with a trigram inverted index. A lookup only looks at the functions sharing enough trigrams with the request,
+ * ranks them by trigram similarity and scores the best of them with edit distance, name tokens and an optional
+ * "Class.Function" class hint. Names that resolved to a node with a confident match (see IsConfidentResolution) are
+ * remembered as learned aliases (Saved/GenAI/LearnedNodeAliases.json) and win over the fuzzy scoring afterwards.
+ *
+ * On editor start the catalog is loaded from Saved/GenAI/FunctionCatalog.bin, then refreshed in the background:
+ * the loaded classes are read in small per-frame slices on the game thread and the index is built and cached
+ * on a worker thread. Module loads and hot reloads schedule another refresh, lookups keep using the current
+ * index until the new one is ready. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenFunctionIndex
+{
+public:
+	// Weights of the name scoring, node creation and suggestions rank slightly differently
+	struct FScoreWeights
+	{
+		int32 Exact;
+		int32 Substring;
+		int32 Token;
+		int32 Prefix;
+		int32 LongNamePenalty;
+		// Subtracted from Exact per edit for near misses ("PrintStrng")
+		int32 Typo;
+	};
+
+	static const FScoreWeights CreationWeights;
+	static const FScoreWeights SuggestionWeights;
+
+	static FGenFunctionIndex& Get();
+
+	// Loads the cached catalog and starts the background refresh, called on editor startup
+	void Start();
+
+	// Stops refreshing and unregisters the reload delegates, called on module shutdown
+	void Shutdown();
+
+	// Best matches first, at most MaxResults (all when <= 0)
+	void FindMatches(const FString& NodeType, const FScoreWeights& Weights, int32 MaxResults, TArray<FGenFunctionMatch>& OutMatches);
+
+	// Remembers that NodeType resolved to the entry, later lookups of the same name rank it first
+	void RecordResolution(const FString& NodeType, int32 Index);
+
+	// True when the best of the sorted matches is safe to learn as an alias: no typo, at least an exact name's score
+	// and ahead of the runner-up by more than one edit. A learned alias wins every later lookup, so guesses are not kept
+	static bool IsConfidentResolution(const TArray<FGenFunctionMatch>& Matches, const FScoreWeights& Weights);
+
+	// Resolved on first use, nullptr when the class or function is no longer loaded
+	UFunction* GetFunction(int32 Index);
+	UClass* GetOwnerClass(int32 Index);
+
+	// "OwnerClass.FunctionName", the format suggestions are reported in
+	const FString& GetDisplayName(int32 Index) const;
+	EGenFunctionFlags GetFlags(int32 Index) const;
+	int32 Num();
+
+	// Schedules a refresh, without a running refresh (outside the editor) the index is dropped and rebuilt on the next lookup
+	void Invalidate();
+
+	// Synchronously rebuilds the index from the loaded classes
+	void Rebuild();
+
+	bool IsRefreshing() const { return bSnapshotInProgress || bBuildInFlight; }
+
+	// Splits on underscores and camel case boundaries, tokens are lowercased and unique
+	static void Tokenize(const FString& Name, TArray<FString>& OutTokens);
+
+	// Lowercase alphanumerics without a leading K2 prefix, "K2_GetActorLocation" and "Get Actor Location" become "getactorlocation"
+	static FString NormalizeName(const FString& Name);
+
+	// Optimal string alignment distance, MaxDistance + 1 once the strings are known to be further apart
+	static int32 EditDistance(const FString& A, const FString& B, int32 MaxDistance);
+
+private:
+	FGenFunctionIndex();
+
+	void EnsureBuilt();
+	void SetData(const TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe>& NewData);
+
+	bool Tick(float DeltaTime);
+	void BeginSnapshot();
+	// Catalogs the pending classes until the time budget runs out, returns true once all classes are done
+	bool ContinueSnapshot(double BudgetSeconds);
+	void FinishSnapshot();
+
+	static void AddClassFunctions(UClass* Class, TArray<FGenFunctionCatalogEntry>& OutEntries);
+	static TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> BuildIndexData(TArray<FGenFunctionCatalogEntry>&& Entries);
+	static FString GetCacheFile();
+	static FString GetAliasFile();
+	void LoadAliases();
+	static bool SaveCache(const TArray<FGenFunctionCatalogEntry>& Entries);
+	static bool LoadCache(TArray<FGenFunctionCatalogEntry>& OutEntries);
+
+	TSharedPtr<FGenFunctionIndexData, ESPMode::ThreadSafe> Data;
+
+	// Lazily resolved reflection objects, parallel to the entries of Data
+	TArray<TWeakObjectPtr<UFunction>> ResolvedFunctions;
+	TArray<TWeakObjectPtr<UClass>> ResolvedClasses;
+
+	// Shared trigram count per entry, reused between lookups and only reset for the entries touched
+	TArray<uint16> TrigramHits;
+
+	// Normalized node type -> qualified entry key ("class.function", normalized)
+	TMap<FString, FString> LearnedAliases;
+	bool bAliasesLoaded = false;
+
+	// Incremental refresh state
+	FTSTicker::FDelegateHandle TickerHandle;
+	bool bRefreshRequested = false;
+	double RefreshRequestTime = 0.0;
+	bool bSnapshotInProgress = false;
+	bool bBuildInFlight = false;
+	int32 Generation = 0;
+	double SnapshotStartTime = 0.0;
+	TArray<TWeakObjectPtr<UClass>> PendingClasses;
+	int32 NextPendingClass = 0;
+	TArray<FGenFunctionCatalogEntry> SnapshotEntries;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+};
@@ -0,0 +1,37 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class UBlueprint;
+
+// What FGenGraphValidator::Validate repairs
+enum class EGenGraphFix : uint8
+{
+	None,
+	// Exec outputs keep only their first link, the repair compiles have always done
+	ExecLinks,
+	// Also removes null, dangling and one-sided links
+	All
+};
+
+/**
+ * Checks every graph of a Blueprint (event graphs, functions, macros and collapsed graphs) in one pass over its
+ * nodes, pins and links. Reports as errors: null, dangling (the other node is not in the graph) and one-sided links,
+ * links between pins of the same direction or of incompatible types, linked orphaned pins and exec outputs with more
+ * than one link. Reports as warnings: impure nodes whose exec input is not connected and nodes without any link.
+ * Every diagnostic is {"severity", "code", "message", "graph", "graph_guid", "node", "node_guid", "pin", "linked_node_guid", "linked_pin"}.
+ *
+ * Links with both ends of the same direction are reported once. Repairs follow EGenGraphFix, broken links are removed
+ * from both pins. Fixed diagnostics have "fixed": true.
+ */
+class GENERATIVEAISUPPORT_API FGenGraphValidator
+{
+public:
+	// {"success", "blueprint_path", "graphs", "nodes", "links", "errors", "warnings", "fixed", "elapsed_ms", "diagnostics": [...]}
+	static TSharedPtr<FJsonObject> Validate(UBlueprint* Blueprint, EGenGraphFix Fix = EGenGraphFix::None);
+};
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+struct FEdGraphEditAction;
+
+/**
+ * Per Blueprint GUID -> node and GUID -> graph lookup tables for the node addressed MCP commands.
+ * Built on the first lookup into a Blueprint and kept current through the graph changed delegates of its graphs:
+ * added and removed nodes are applied to the node set of their graph as they happen, so a hit is verified in
+ * constant time. Notifications that do not say what changed (undo, redo, rollback) mark the graph, which is re-read
+ * on its next lookup, as is a graph whose node count no longer matches its set. A change of the Blueprint (graphs
+ * added or removed) rebuilds the tables on the next lookup. Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenNodeGuidIndex
+{
+public:
+	static FGenNodeGuidIndex& Get();
+
+	// Node of the Blueprint with the GUID in any of its graphs, nullptr if there is none
+	UEdGraphNode* FindNode(UBlueprint* Blueprint, const FGuid& NodeGuid);
+
+	// Graph of the Blueprint with the GUID (event graphs, functions, macros and collapsed graphs)
+	UEdGraph* FindGraph(UBlueprint* Blueprint, const FGuid& GraphGuid);
+
+	// Drops the tables of the Blueprint, they are rebuilt on the next lookup
+	void Invalidate(UBlueprint* Blueprint);
+
+	// Unregisters all delegates and drops every table, called on module shutdown
+	void Shutdown();
+
+	// Full rebuilds of a Blueprint's tables and re-reads of single graphs, for tests and benchmarks
+	int32 GetRebuildCount() const { return RebuildCount; }
+	int32 GetGraphSyncCount() const { return GraphSyncCount; }
+
+private:
+	struct FGraphEntry
+	{
+		FDelegateHandle Handle;
+		// Nodes listed by the graph, kept current by its add and remove notifications
+		TSet<FGuid> NodeGuids;
+		// Length of the graph's node list when the set was last in step with it
+		int32 NodeCount = 0;
+		// A notification did not say what changed
+		bool bDirty = false;
+	};
+
+	struct FBlueprintIndex
+	{
+		TMap<FGuid, TWeakObjectPtr<UEdGraphNode>> Nodes;
+		TMap<FGuid, TWeakObjectPtr<UEdGraph>> Graphs;
+		TMap<TWeakObjectPtr<UEdGraph>, FGraphEntry> GraphEntries;
+		FDelegateHandle ChangedHandle;
+		bool bGraphsDirty = true;
+	};
+
+	FGenNodeGuidIndex() = default;
+
+	FBlueprintIndex& GetIndex(UBlueprint* Blueprint);
+	void Rebuild(UBlueprint* Blueprint, FBlueprintIndex& Index);
+	// Re-reads the node list of one graph into the tables
+	void SyncGraph(FBlueprintIndex& Index, UEdGraph* Graph, FGraphEntry& Entry);
+	// Re-reads the graphs the notifications could not keep current, false when every graph was in step
+	bool SyncStaleGraphs(UBlueprint* Blueprint, FBlueprintIndex& Index);
+	// The indexed node for the GUID when it is valid and its graph's set, which is in step, still holds it
+	static UEdGraphNode* FindIndexedNode(const UBlueprint* Blueprint, const FBlueprintIndex& Index, const FGuid& NodeGuid);
+	static bool IsGraphInStep(const UEdGraph* Graph, const FGraphEntry& Entry);
+	// True when a graph lookup miss may be caused by changes the delegates did not report
+	static bool IsStale(const FBlueprintIndex& Index);
+	static void UnregisterDelegates(UBlueprint* Blueprint, FBlueprintIndex& Index);
+	void OnGraphChanged(const FEdGraphEditAction& Action, TWeakObjectPtr<UBlueprint> WeakBlueprint);
+
+	TMap<TWeakObjectPtr<UBlueprint>, FBlueprintIndex> Indices;
+	int32 RebuildCount = 0;
+	int32 GraphSyncCount = 0;
+};
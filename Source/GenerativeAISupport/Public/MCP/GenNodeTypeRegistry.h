@@ -0,0 +1,73 @@
+// Copyright (c) 2025 Prajwal Shetty. All rights reserved.
+// Licensed under the MIT License. See LICENSE file in the root directory of this
+// source tree or http://opensource.org/licenses/MIT.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class EGenNodeRecipeKind : uint8
+{
+	// Call of ClassName.MemberName
+	CallFunction,
+	// Plain node of the K2Node class ClassName
+	NodeClass,
+	// Override event ClassName.MemberName, replaces existing ones in the event graph
+	Event,
+	// Nodes with their own creation code in UGenBlueprintNodeCreator
+	FunctionEntry,
+	InputAction,
+	VariableGet,
+	VariableSet,
+};
+
+struct FGenNodeRecipe
+{
+	EGenNodeRecipeKind Kind = EGenNodeRecipeKind::NodeClass;
+	FName Name;
+	FString ClassName;
+	FName MemberName;
+};
+
+/**
+ * Node type aliases and node recipes, loaded from Config/NodeTypeAliases.json of the plugin with the entries of
+ * <Project>/Config/GenerativeAISupport/NodeTypeAliases.json on top. Names are compiled into FName keyed maps,
+ * so lookups are case insensitive and never allocate. In the editor the files are watched and reloaded on change.
+ * Game thread only.
+ */
+class GENERATIVEAISUPPORT_API FGenNodeTypeRegistry
+{
+public:
+	static FGenNodeTypeRegistry& Get();
+
+	/**
+	 * Resolves aliases of NodeType and returns its recipe, nullptr when there is none.
+	 * OutResolvedType is the alias target (or NodeType itself) for the generic node class and library lookups.
+	 */
+	const FGenNodeRecipe* FindRecipe(const FString& NodeType, FString& OutResolvedType);
+
+	// Rebuilds the tables from the json files, returns false (and keeps the current tables) when a file is malformed
+	bool Reload();
+
+	// Starts watching the json files for changes, called on editor startup
+	void StartWatching();
+	void StopWatching();
+
+	int32 NumRecipes() const { return Recipes.Num(); }
+	int32 NumAliases() const { return Aliases.Num(); }
+
+private:
+	FGenNodeTypeRegistry() = default;
+
+	static FString GetPluginFile();
+	static FString GetProjectFile();
+	static bool ParseFile(const FString& FilePath, TMap<FName, FGenNodeRecipe>& OutRecipes, TMap<FName, FName>& OutAliases);
+
+	bool bLoaded = false;
+
+	// Canonical name -> recipe, and alias -> alias target (a recipe name or any other node type)
+	TMap<FName, FGenNodeRecipe> Recipes;
+	TMap<FName, FName> Aliases;
+
+	TArray<TPair<FString, FDelegateHandle>> WatchHandles;
+};
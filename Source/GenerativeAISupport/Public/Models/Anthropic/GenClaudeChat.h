@@ -8,6 +8,8 @@
 #include "UObject/Object.h"
 #include "GenClaudeChat.generated.h"
 
+class FGenImageAttachments;
+
 
 
 // Delegate for C++ callbacks
@@ -40,9 +42,12 @@ private:
 	// Stores settings for request
 	FGenClaudeChatSettings ChatSettings;
 
-	// Internal request processing
-	static void MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
-	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+	// Internal request processing, tool rounds pass the image attachments of the first request so images are only encoded once
+	static void MakeRequest(const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+	                        const TSharedPtr<FGenImageAttachments>& CachedImages = nullptr);
+	// tool_use blocks in the response are executed and the results sent back until the model answers with text
+	static void ProcessResponse(const FString& ResponseStr, const FGenClaudeChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+	                            const TSharedPtr<FGenImageAttachments>& CachedImages = nullptr);
 
 protected:
 	virtual void Activate() override;
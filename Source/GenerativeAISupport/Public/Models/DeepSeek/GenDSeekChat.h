@@ -26,11 +26,27 @@ struct FGenDSeekChatSettings
 	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
 	int32 MaxTokens = 4096;
 
+	// Sampling temperature, negative keeps the model default (deepseek-reasoner ignores it)
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
+	float Temperature = -1.0f;
+
 	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
 	TArray<FGenChatMessage> Messages;
 
 	UPROPERTY(BlueprintReadWrite, Category = "GenAI")
 	bool bStreamResponse = false;
+
+	// Names of tools registered in FGenToolRegistry that the model may call
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	TArray<FString> Tools;
+
+	// "auto", "none", "required" or the name of a single tool, empty uses the provider default
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	FString ToolChoice;
+
+	// How many times tool results are sent back automatically before giving up
+	UPROPERTY(BlueprintReadWrite, Category = "GenAI|Tools")
+	int32 MaxToolRoundTrips = 5;
 };
 
 
@@ -60,7 +76,8 @@ private:
 
 	// Internal request processing
 	static void MakeRequest(const FGenDSeekChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
-	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+	// Tool calls in the response are executed and the results sent back until the model answers with text
+	static void ProcessResponse(const FString& ResponseStr, const FGenDSeekChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
 protected:
 	virtual void Activate() override;
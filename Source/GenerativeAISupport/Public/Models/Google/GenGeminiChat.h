@@ -0,0 +1,57 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/Google/GenGeminiChatStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Dom/JsonObject.h"
+#include "GenGeminiChat.generated.h"
+
+// Delegates for C++ callbacks, OnDelta receives the text generated since the last call when streaming
+DECLARE_DELEGATE_ThreeParams(FOnGeminiChatCompletionResponse, const FString&, const FString&, bool);
+DECLARE_DELEGATE_OneParam(FOnGeminiChatDelta, const FString&);
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenGeminiChatCompletionDelegate, const FString&, Response, const FString&, Error, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenGeminiChatDeltaDelegate, const FString&, Delta);
+
+/**
+ * Google Gemini chat (generateContent / streamGenerateContent)
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenGeminiChat : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++, OnComplete always receives the full response
+	static void SendChatRequest(const FGenGeminiChatSettings& ChatSettings, const FOnGeminiChatCompletionResponse& OnComplete,
+	                            const FOnGeminiChatDelta& OnDelta = FOnGeminiChatDelta());
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenGeminiChatCompletionDelegate OnComplete;
+
+	// Blueprint async function, only broadcast when bStreamResponse is set
+	UPROPERTY(BlueprintAssignable)
+	FGenGeminiChatDeltaDelegate OnDelta;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Gemini")
+	static UGenGeminiChat* RequestGeminiChat(UObject* WorldContextObject, const FGenGeminiChatSettings& ChatSettings);
+
+private:
+	FGenGeminiChatSettings ChatSettings;
+
+	static void MakeRequest(const FGenGeminiChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+	                        const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+
+	static FString BuildPayload(const FGenGeminiChatSettings& ChatSettings);
+
+	// Reads the text of the first candidate, streamed chunks have the same shape as a full response
+	static bool ReadCandidateText(const TSharedPtr<FJsonObject>& ResponseObject, FString& OutText, FString& OutError);
+
+protected:
+	virtual void Activate() override;
+};
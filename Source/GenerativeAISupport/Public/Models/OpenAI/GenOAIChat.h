@@ -9,6 +9,8 @@
 #include "Kismet/BlueprintAsyncActionBase.h"
 #include "GenOAIChat.generated.h"
 
+class FGenImageAttachments;
+
 
 // Note: this is a Regular C++ only delegate,
 // why? because for blueprint we are using a unreal latent function, which inturn uses the MULTICAST_DELEGATE below
@@ -39,9 +41,12 @@ public:
 private:
     FGenChatSettings ChatSettings;
 
-    // Shared implementation
-    static void MakeRequest(const FGenChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
-    static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+    // Shared implementation, tool rounds pass the image attachments of the first request so images are only encoded once
+    static void MakeRequest(const FGenChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                            const TSharedPtr<FGenImageAttachments>& CachedImages = nullptr);
+    // Tool calls in the response are executed and the results sent back until the model answers with text
+    static void ProcessResponse(const FString& ResponseStr, const FGenChatSettings& ChatSettings, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback,
+                                const TSharedPtr<FGenImageAttachments>& CachedImages = nullptr);
 
 protected:
     virtual void Activate() override;
@@ -0,0 +1,53 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIImageStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Engine/Texture2D.h"
+#include "GenOAIImage.generated.h"
+
+// Static delegate for native C++ usage, the textures are transient and have to be referenced to be kept alive
+DECLARE_DELEGATE_ThreeParams(FOnImageGenerationResponse, const TArray<UTexture2D*>&, const FString&, bool);
+
+// Blueprint async delegate
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenImageGenerationDelegate, const TArray<UTexture2D*>&, Textures, const FString&, Error, bool, Success);
+
+/**
+ * OpenAI image generation. Images are decoded on worker threads straight into texture platform data,
+ * the game thread only creates the texture objects. Results are cached on disk by a hash of the prompt and settings.
+ * A request either returns all requested images or none, with the error of the failed ones.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAIImage : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++
+	static void RequestImages(const FGenOAIImageSettings& ImageSettings, const FOnImageGenerationResponse& OnComplete);
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenImageGenerationDelegate OnComplete;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
+	static UGenOAIImage* RequestOpenAIImage(UObject* WorldContextObject, const FGenOAIImageSettings& ImageSettings);
+
+	// Path of the cache file for one generated image
+	static FString GetCacheFilePath(const FGenOAIImageSettings& ImageSettings, int32 ImageIndex);
+
+	// Deletes all cached images
+	UFUNCTION(BlueprintCallable, Category = "GenAI")
+	static void ClearImageCache();
+
+private:
+	FGenOAIImageSettings ImageSettings;
+
+	static void MakeRequest(const FGenOAIImageSettings& ImageSettings, const TFunction<void(const TArray<UTexture2D*>&, const FString&, bool)>& ResponseCallback);
+
+protected:
+	virtual void Activate() override;
+};
@@ -0,0 +1,60 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIAudioStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "Sound/SoundWaveProcedural.h"
+#include "GenOAISpeech.generated.h"
+
+// Static delegates for native C++ usage
+DECLARE_DELEGATE_OneParam(FOnSpeechStarted, USoundWaveProcedural*);
+DECLARE_DELEGATE_ThreeParams(FOnSpeechResponse, USoundWaveProcedural*, const FString&, bool);
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenSpeechStartedDelegate, USoundWaveProcedural*, Sound);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenSpeechCompleteDelegate, USoundWaveProcedural*, Sound, const FString&, Error, bool, Success);
+
+/**
+ * OpenAI text to speech. Audio is requested as raw PCM and queued into a USoundWaveProcedural as it downloads,
+ * OnStarted fires with the first chunk so playback can begin before synthesis has finished.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAISpeech : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Format of the "pcm" response format
+	static constexpr int32 SampleRate = 24000;
+
+	// Static function for native C++, the returned sound wave has to be referenced by the caller to stay alive
+	static USoundWaveProcedural* RequestSpeech(const FGenOAISpeechSettings& SpeechSettings, const FOnSpeechStarted& OnStarted,
+	                                           const FOnSpeechResponse& OnComplete);
+
+	// Blueprint async function, play the sound from here
+	UPROPERTY(BlueprintAssignable)
+	FGenSpeechStartedDelegate OnStarted;
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenSpeechCompleteDelegate OnComplete;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
+	static UGenOAISpeech* RequestOpenAISpeech(UObject* WorldContextObject, const FGenOAISpeechSettings& SpeechSettings);
+
+private:
+	FGenOAISpeechSettings SpeechSettings;
+
+	UPROPERTY()
+	USoundWaveProcedural* SoundWave = nullptr;
+
+	static USoundWaveProcedural* CreateSoundWave();
+	static void MakeRequest(const FGenOAISpeechSettings& SpeechSettings, USoundWaveProcedural* SoundWave, const TFunction<void()>& StartedCallback,
+	                        const TFunction<void(const FString&, bool)>& ResponseCallback);
+
+protected:
+	virtual void Activate() override;
+};
@@ -5,17 +5,28 @@
 #include "CoreMinimal.h"
 #include "Data/OpenAI/GenOAIChatStructs.h"
 #include "Engine/CancellableAsyncAction.h"
+#include "Interfaces/IHttpRequest.h"
+#include "UObject/StructOnScope.h"
 #include "GenOAIStructuredOpService.generated.h"
 
 // Static delegate for native C++ usage
 DECLARE_DELEGATE_ThreeParams(FOnSchemaResponse, const FString&, const FString&, bool);
 
+// Static delegate for typed native C++ usage, the struct instance is only valid when Success is true
+DECLARE_DELEGATE_ThreeParams(FOnTypedSchemaResponse, const TSharedPtr<FStructOnScope>&, const FString&, bool);
+
+// Static delegate for streamed elements, Key is empty for array elements
+DECLARE_DELEGATE_ThreeParams(FOnSchemaStreamElement, const FString&, int32, const FString&);
+
 // Blueprint async delegate
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenSchemaResponseDelegate, const FString&, Response, const FString&, Error, bool, Success);
 
+// Blueprint async delegate for streamed elements
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenSchemaStreamElementDelegate, const FString&, Key, int32, Index, const FString&, ElementJson);
+
 
 /**
- * 
+ *
  */
 UCLASS()
 class GENERATIVEAISUPPORT_API UGenOAIStructuredOpService : public UCancellableAsyncAction
@@ -26,6 +37,40 @@ public:
 	// Static function for native C++
 	static void RequestStructuredOutput(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaResponse& OnComplete);
 
+	/**
+	 * Typed variant for native C++. The schema is generated from the reflected properties of ResponseStruct
+	 * (SchemaJson is ignored) and the response content is deserialized into a new instance on a worker thread.
+	 * OnComplete is called on the game thread. ResponseStruct must only hold plain data (no object references),
+	 * other structs fail without sending the request.
+	 */
+	static void RequestStructuredOutputTyped(const FGenOAIStructuredChatSettings& StructuredChatSettings, const UScriptStruct* ResponseStruct, const FOnTypedSchemaResponse& OnComplete);
+
+	// Reads the message content of a chat completion response into a new ResponseStruct, nullptr on refusal or error
+	static TSharedPtr<FStructOnScope> DecodeTypedResponse(const FString& ResponseStr, const UScriptStruct* ResponseStruct, FString& OutError);
+
+	// Convenience wrapper around RequestStructuredOutputTyped for USTRUCT types
+	template <typename StructType>
+	static void RequestStructuredOutputAs(const FGenOAIStructuredChatSettings& StructuredChatSettings, TFunction<void(const StructType&, const FString&, bool)> OnComplete)
+	{
+		RequestStructuredOutputTyped(StructuredChatSettings, StructType::StaticStruct(), FOnTypedSchemaResponse::CreateLambda(
+			[OnComplete = MoveTemp(OnComplete)](const TSharedPtr<FStructOnScope>& Result, const FString& Error, bool Success)
+			{
+				if (Success && Result.IsValid())
+				{
+					OnComplete(*reinterpret_cast<const StructType*>(Result->GetStructMemory()), Error, true);
+					return;
+				}
+				OnComplete(StructType(), Error, false);
+			}));
+	}
+
+	/**
+	 * Streaming variant for native C++. The response is streamed and every element of the array (or field of the
+	 * object) at StreamElementPath is passed to OnElement as raw JSON as soon as it is complete.
+	 * OnComplete receives the full content once the stream ends.
+	 */
+	static void RequestStructuredOutputStream(const FGenOAIStructuredChatSettings& StructuredChatSettings, const FOnSchemaStreamElement& OnElement, const FOnSchemaResponse& OnComplete);
+
 	// Blueprint async function
 	UPROPERTY(BlueprintAssignable)
 	FGenSchemaResponseDelegate OnComplete;
@@ -34,15 +79,49 @@ public:
 	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
 	static UGenOAIStructuredOpService* RequestOpenAIStructuredOutput(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings);
 
+protected:
+	FGenOAIStructuredChatSettings StructuredChatSettings;
+
+	static void MakeStreamRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, int32, const FString&)>& ElementCallback,
+	                              const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+
 private:
 	FString Prompt;
 	FString SchemaJson;
-	FGenOAIStructuredChatSettings StructuredChatSettings;
 
 	static void MakeRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings, const TFunction<void(const FString&, const FString&, bool)
 	                        >& ResponseCallback);
 	static void ProcessResponse(const FString& ResponseStr, const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
 
+	// Builds the request payload and headers, SchemaObject overrides StructuredChatSettings.SchemaJson when valid
+	static TSharedPtr<IHttpRequest, ESPMode::ThreadSafe> CreateHttpRequest(const FGenOAIStructuredChatSettings& StructuredChatSettings,
+	                                                                       const TSharedPtr<FJsonObject>& SchemaObject, FString& OutError,
+	                                                                       bool bStream = false);
+
+	// Extracts the message content (or refusal) from a chat completion response
+	static bool ExtractMessageContent(const FString& ResponseStr, FString& OutContent, FString& OutError);
+
+protected:
+	virtual void Activate() override;
+};
+
+/**
+ * Streaming Blueprint node, OnElement fires for each completed element at StreamElementPath while the output
+ * streams in, then OnComplete with the full content.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAIStructuredStreamOpService : public UGenOAIStructuredOpService
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(BlueprintAssignable)
+	FGenSchemaStreamElementDelegate OnElement;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
+	static UGenOAIStructuredStreamOpService* RequestOpenAIStructuredOutputStream(UObject* WorldContextObject, const FGenOAIStructuredChatSettings& StructuredChatSettings);
+
 protected:
 	virtual void Activate() override;
-};
\ No newline at end of file
+};
@@ -0,0 +1,73 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIAudioStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "GenOAITranscription.generated.h"
+
+// Static delegate for native C++ usage
+DECLARE_DELEGATE_ThreeParams(FOnTranscriptionResponse, const FString&, const FString&, bool);
+
+// Blueprint async delegate
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenTranscriptionDelegate, const FString&, Text, const FString&, Error, bool, Success);
+
+/**
+ * Buffered transcription upload, filled while audio is being captured.
+ * PCM chunks are buffered in memory inside the multipart request body, behind a WAV header that is patched on Finish.
+ * Nothing is sent before Finish, which uploads the whole body in one request. This saves the copy into a WAV file
+ * once recording stops, not the upload time. AppendPCM can be called from the audio capture thread.
+ */
+class GENERATIVEAISUPPORT_API FGenOAIBufferedTranscription : public TSharedFromThis<FGenOAIBufferedTranscription, ESPMode::ThreadSafe>
+{
+public:
+	explicit FGenOAIBufferedTranscription(const FGenOAITranscriptionSettings& InSettings);
+
+	// Interleaved 16 bit samples
+	void AppendPCM(const int16* Samples, int32 NumSamples);
+
+	// Completes the body and sends the request, OnComplete is called on the game thread
+	void Finish(const TFunction<void(const FString&, const FString&, bool)>& OnComplete);
+
+	int32 GetNumSamples() const;
+
+private:
+	FGenOAITranscriptionSettings Settings;
+	FString Boundary;
+
+	mutable FCriticalSection BodyLock;
+	TArray<uint8> Body;
+	int32 WavHeaderOffset = 0;
+	bool bFinished = false;
+};
+
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenOAITranscription : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++, PCMData holds interleaved 16 bit samples
+	static void RequestTranscription(const FGenOAITranscriptionSettings& TranscriptionSettings, const TArray<uint8>& PCMData,
+	                                 const FOnTranscriptionResponse& OnComplete);
+
+	// Starts a buffered upload that is filled while recording, call Finish on it to send everything in one request
+	static TSharedRef<FGenOAIBufferedTranscription, ESPMode::ThreadSafe> BeginBufferedTranscription(const FGenOAITranscriptionSettings& TranscriptionSettings);
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenTranscriptionDelegate OnComplete;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI")
+	static UGenOAITranscription* RequestOpenAITranscription(UObject* WorldContextObject, const FGenOAITranscriptionSettings& TranscriptionSettings,
+	                                                        const TArray<uint8>& PCMData);
+
+private:
+	FGenOAITranscriptionSettings TranscriptionSettings;
+	TArray<uint8> PCMData;
+
+protected:
+	virtual void Activate() override;
+};
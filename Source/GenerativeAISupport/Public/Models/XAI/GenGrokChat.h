@@ -0,0 +1,53 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/XAI/GenGrokChatStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "GenGrokChat.generated.h"
+
+// Delegates for C++ callbacks, OnDelta receives the text generated since the last call when streaming
+DECLARE_DELEGATE_ThreeParams(FOnGrokChatCompletionResponse, const FString&, const FString&, bool);
+DECLARE_DELEGATE_OneParam(FOnGrokChatDelta, const FString&);
+
+// Blueprint async delegates
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FGenGrokChatCompletionDelegate, const FString&, Response, const FString&, Error, bool, Success);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGenGrokChatDeltaDelegate, const FString&, Delta);
+
+/**
+ * xAI Grok chat completions
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenGrokChat : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++, OnComplete always receives the full response
+	static void SendChatRequest(const FGenGrokChatSettings& ChatSettings, const FOnGrokChatCompletionResponse& OnComplete,
+	                            const FOnGrokChatDelta& OnDelta = FOnGrokChatDelta());
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenGrokChatCompletionDelegate OnComplete;
+
+	// Blueprint async function, only broadcast when bStreamResponse is set
+	UPROPERTY(BlueprintAssignable)
+	FGenGrokChatDeltaDelegate OnDelta;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Grok")
+	static UGenGrokChat* RequestGrokChat(UObject* WorldContextObject, const FGenGrokChatSettings& ChatSettings);
+
+private:
+	FGenGrokChatSettings ChatSettings;
+
+	static void MakeRequest(const FGenGrokChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+	                        const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+	static void ProcessResponse(const FString& ResponseStr, const FGenGrokChatSettings& ChatSettings, const TFunction<void(const FString&)>& DeltaCallback,
+	                            const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback);
+
+protected:
+	virtual void Activate() override;
+};
@@ -0,0 +1,55 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenRouterStructs.h"
+#include "Engine/CancellableAsyncAction.h"
+#include "GenChatRouter.generated.h"
+
+// Static delegate for native C++ usage, Endpoint is the candidate that produced the response (or failed last)
+DECLARE_DELEGATE_FourParams(FOnRoutedChatResponse, const FString&, const FString&, bool, const FGenRouterCandidate&);
+
+// Blueprint async delegate
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_FourParams(FGenRoutedChatDelegate, const FString&, Response, const FString&, Error, bool, Success,
+                                              const FGenRouterCandidate&, Endpoint);
+
+/**
+ * Sends a chat request to the fastest healthy provider/model among the candidates,
+ * based on the live latency and error tracking in FGenProviderHealth. Failed requests fall back to the next best endpoint.
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenChatRouter : public UCancellableAsyncAction
+{
+	GENERATED_BODY()
+
+public:
+	// Static function for native C++
+	static void SendChatRequest(const FGenRouterSettings& RouterSettings, const FOnRoutedChatResponse& OnComplete);
+
+	// Blueprint async function
+	UPROPERTY(BlueprintAssignable)
+	FGenRoutedChatDelegate OnComplete;
+
+	// Blueprint latent function
+	UFUNCTION(BlueprintCallable, meta = (BlueprintInternalUseOnly = "true", WorldContext = "WorldContextObject"), Category = "GenAI|Router")
+	static UGenChatRouter* RequestRoutedChat(UObject* WorldContextObject, const FGenRouterSettings& RouterSettings);
+
+	// Current latency and health of every endpoint the router has used
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Router")
+	static TArray<FGenEndpointHealthStats> GetEndpointHealth();
+
+private:
+	FGenRouterSettings RouterSettings;
+
+	static void MakeRequest(const FGenRouterSettings& RouterSettings, const TSet<int32>& TriedCandidates, int32 NumAttempts,
+	                        const TFunction<void(const FString&, const FString&, bool, const FGenRouterCandidate&)>& ResponseCallback);
+
+	// Sends the request through the service class of the candidate's provider.
+	// Returns false without sending when the candidate is misconfigured, those errors are not held against the endpoint
+	static bool Dispatch(const FGenRouterCandidate& Candidate, const FGenRouterSettings& RouterSettings,
+	                     const TFunction<void(const FString&, const FString&, bool)>& ResponseCallback, FString& OutConfigError);
+
+protected:
+	virtual void Activate() override;
+};
@@ -0,0 +1,68 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenRouterStructs.h"
+
+/**
+ * Process wide latency and error tracking per provider/model, used by UGenChatRouter.
+ * Latency is tracked as an EWMA plus a window of recent samples for p50/p95. Endpoints that keep failing
+ * are drained (Degraded) for a cooldown that doubles on every relapse, then probed back with a traffic share
+ * that doubles with every successful request.
+ */
+class GENERATIVEAISUPPORT_API FGenProviderHealth
+{
+public:
+	static FGenProviderHealth& Get();
+
+	void RecordResult(const FGenRouterCandidate& Candidate, double LatencySeconds, bool bSuccess);
+
+	/**
+	 * Index of the best candidate that is not excluded and within the cost ceiling, INDEX_NONE if there is none.
+	 * Endpoints are ranked by p95 latency (EWMA until enough samples exist) weighted by their error rate,
+	 * endpoints without samples are preferred so every endpoint gets measured.
+	 */
+	int32 SelectCandidate(const TArray<FGenRouterCandidate>& Candidates, float MaxCostPer1KTokens, const TSet<int32>& Excluded);
+
+	TArray<FGenEndpointHealthStats> GetStats() const;
+
+	void Reset();
+
+	static constexpr double LatencyAlpha = 0.2;
+	static constexpr double ErrorAlpha = 0.2;
+	static constexpr int32 MaxLatencySamples = 64;
+	static constexpr int32 MinSamplesForPercentiles = 8;
+	static constexpr int32 FailuresToDegrade = 3;
+	static constexpr double ErrorRateToDegrade = 0.5;
+	static constexpr double InitialCooldownSeconds = 5.0;
+	static constexpr double MaxCooldownSeconds = 120.0;
+	static constexpr float InitialProbeShare = 0.1f;
+
+private:
+	struct FEndpoint
+	{
+		EGenAIOrgs Provider = EGenAIOrgs::Unknown;
+		FString Model;
+		EGenEndpointState State = EGenEndpointState::Healthy;
+		double EwmaLatency = 0.0;
+		TArray<float> LatencySamples;
+		int32 NextSample = 0;
+		double ErrorRate = 0.0;
+		int32 NumRequests = 0;
+		int32 ConsecutiveFailures = 0;
+		double Cooldown = InitialCooldownSeconds;
+		double RetryTime = 0.0;
+		float ProbeShare = InitialProbeShare;
+
+		// Seconds, p95 once enough samples exist
+		double GetExpectedLatency() const;
+		float GetPercentile(float Percentile) const;
+	};
+
+	static FString MakeKey(EGenAIOrgs Provider, const FString& Model);
+	void Degrade(FEndpoint& Endpoint, double Now);
+
+	mutable FCriticalSection Lock;
+	TMap<FString, FEndpoint> Endpoints;
+};
@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 
 #if PLATFORM_WINDOWS
@@ -27,12 +29,15 @@ class GENERATIVEAISUPPORT_API UGenSecureKey : public UBlueprintFunctionLibrary
 	GENERATED_BODY()
 
 private:
-	// A map to store API keys by organization
-	static TMap<EGenAIOrgs, FString> APIKeys;
+	// A map to store the API key pool of each organization, only accessed by writers
+	static TMap<EGenAIOrgs, TArray<FString>> APIKeys;
 
 	// Flag to determine whether to use environment variables for API keys
 	static bool bUseApiKeyFromEnv;
 
+	// Resolves every key (environment or stored) into a new table and swaps it in, called with the write lock held
+	static void PublishResolvedKeys();
+
 public:
 	/**
 	 * Stores the API key in memory for runtime use. 
@@ -42,11 +47,36 @@ public:
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GenAI|Secure Key")
 	static void SetGenAIApiKeyRuntime(EGenAIOrgs Org, const FString& APIKey);
+
+	/**
+	 * Stores several API keys for one organization, requests are spread across them.
+	 * Environment variables can hold a pool as well, as a comma separated list.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Secure Key")
+	static void SetGenAIApiKeyPoolRuntime(EGenAIOrgs Org, const TArray<FString>& InAPIKeys);
 	
-	// Gets the API key for a specific organization
+	/**
+	 * Gets the API key for a specific organization.
+	 * Keys are resolved once into a cached table, reads are lock-free and safe from any thread.
+	 * With a key pool, the key with the most requests left in its rate limit window is returned
+	 * and keys that were rate limited are skipped until their cooldown ends.
+	 */
 	UFUNCTION(BlueprintCallable, Category = "GenAI|Secure Key")
 	static FString GetGenerativeAIApiKey(EGenAIOrgs Org);
 
+	/**
+	 * Re-reads the environment variables, e.g. after a key was rotated outside the process.
+	 * Requests that already read a key keep using it, new requests get the new one.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Secure Key")
+	static void RefreshApiKeys();
+
+	/**
+	 * Feeds the rate limit headers and 429 responses of a request back into the key pool.
+	 * The key is read from the request's auth header, does nothing for organizations with a single key.
+	 */
+	static void ReportApiKeyResponse(EGenAIOrgs Org, const FHttpRequestPtr& Request, const FHttpResponsePtr& Response);
+
 	// Set whether to use the API key from environment variables
 	UFUNCTION(BlueprintCallable, Category = "GenAI|Secure Key")
 	static void SetUseApiKeyFromEnvironmentVars(bool bUseEnvVariable);
@@ -0,0 +1,39 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Builds JSON schemas from reflected UStructs / UFunctions.
+ * Generated object schemas follow the OpenAI strict structured-output rules:
+ * every property is listed in "required" and "additionalProperties" is false.
+ * Object references are only allowed in function parameters (as object paths, resolved on the game thread),
+ * struct schemas for structured outputs are rejected when the struct holds any.
+ */
+class GENERATIVEAISUPPORT_API FGenJsonSchemaBuilder
+{
+public:
+	// Schema for all reflected properties of a struct, nullptr if it holds object references and bAllowObjectPaths is false
+	static TSharedPtr<FJsonObject> BuildStructSchema(const UStruct* Struct, bool bAllowObjectPaths = false);
+
+	// Schema for the input parameters of a function (return value and pure out parameters are left out)
+	static TSharedPtr<FJsonObject> BuildFunctionParamsSchema(const UFunction* Function);
+
+	// True for parameters the caller has to provide (by value or const/ref inputs)
+	static bool IsInputParameter(const FProperty* Property);
+
+	// Same as BuildStructSchema, serialized to a string
+	static FString BuildStructSchemaString(const UStruct* Struct);
+
+	// Schema for a single property, nullptr if the property type is not supported
+	static TSharedPtr<FJsonObject> BuildPropertySchema(const FProperty* Property, bool bAllowObjectPaths = false);
+
+	// True if the property or anything nested in it (containers, struct members) references UObjects
+	static bool HasObjectReferences(const FProperty* Property);
+	static bool HasObjectReferences(const UStruct* Struct);
+
+private:
+	static TSharedPtr<FJsonObject> BuildEnumSchema(const UEnum* Enum);
+};
@@ -0,0 +1,82 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Incremental, resumable JSON tokenizer for streamed structured outputs.
+ * Text can be fed in arbitrary chunks; every element of the array (or field of the object) at ElementPath
+ * is emitted as raw JSON as soon as it closes, so callers can start consuming before the document is complete.
+ * ElementPath lists the object keys leading to that container, e.g. {"items"} for {"items": [...]}, empty for the
+ * root itself. Values off the path are skipped, only the element currently being received is buffered.
+ */
+class GENERATIVEAISUPPORT_API FGenJsonStreamParser
+{
+public:
+	// Key is empty for array elements, Index counts emitted elements, ValueJson is the raw JSON of the element
+	using FOnElement = TFunction<void(const FString& Key, int32 Index, const FString& ValueJson)>;
+
+	explicit FGenJsonStreamParser(FOnElement InOnElement, TArray<FString> InElementPath = TArray<FString>());
+
+	// Feeds the next chunk of the document
+	void Feed(const FString& Chunk);
+	void Feed(const TCHAR* Chunk, int32 Len);
+
+	// Resets the parser so it can be reused for a new document
+	void Reset();
+
+	// Replaces \uXXXX and the other JSON escapes of a string body (without the quotes)
+	static FString UnescapeString(const FString& Escaped);
+
+	// True once the closing bracket of the root container was seen
+	bool IsComplete() const { return State == EState::Done; }
+
+	// True if the input is not a JSON object/array the parser could follow
+	bool HasError() const { return State == EState::Error; }
+
+	int32 GetNumEmitted() const { return ElementIndex; }
+
+private:
+	enum class EState : uint8
+	{
+		Start,
+		ExpectKey,
+		InKey,
+		ExpectColon,
+		ExpectValue,
+		InValue,
+		AfterValue,
+		Done,
+		Error
+	};
+
+	void ProcessChar(TCHAR C);
+	void StartValue(TCHAR C);
+	void EndValue();
+	void CloseContainer();
+	void OnValueSeparator();
+
+	// Elements are emitted from the container at the end of ElementPath
+	bool IsElementLevel() const { return Containers.Num() == ElementPath.Num() + 1; }
+	bool IsInObject() const { return Containers.Num() > 0 && Containers.Last() == TEXT('}'); }
+
+	FOnElement OnElement;
+	TArray<FString> ElementPath;
+
+	EState State = EState::Start;
+	// Closing brackets of the containers along the path that are currently open, the root first
+	TArray<TCHAR> Containers;
+
+	// Nesting depth inside the current element, 0 for scalars
+	int32 NestDepth = 0;
+	bool bInString = false;
+	bool bEscape = false;
+
+	// Only values of the element level are buffered, everything else is scanned and dropped
+	bool bCaptureValue = false;
+
+	FString Key;
+	FString Value;
+	int32 ElementIndex = 0;
+};
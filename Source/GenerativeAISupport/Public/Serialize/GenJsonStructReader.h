@@ -0,0 +1,23 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Reads JSON straight from the token stream without building FJsonObject trees.
+ * ReadStruct fills a reflected struct while the text is tokenized, FindString walks to a single field and skips
+ * everything else. Only plain data structs are supported (see FGenJsonSchemaBuilder::HasObjectReferences), so both
+ * can run on any thread.
+ */
+class GENERATIVEAISUPPORT_API FGenJsonStructReader
+{
+public:
+	// Reads a JSON object into StructMemory. Fields are matched by authored name, unknown fields are skipped and
+	// missing ones keep their current value.
+	static bool ReadStruct(const FString& Json, const UStruct* Struct, void* StructMemory, FString& OutError);
+
+	// String at Path, object keys or array indices (e.g. {"choices", "0", "message", "content"}), false if it is
+	// missing or not a string
+	static bool FindString(const FString& Json, const TArray<FString>& Path, FString& OutValue);
+};
@@ -0,0 +1,32 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Splits a server-sent events byte stream into events.
+ * Bytes can arrive in arbitrary chunks, incomplete lines are kept until the rest arrives.
+ */
+class GENERATIVEAISUPPORT_API FGenSSEParser
+{
+public:
+	// EventName is empty for unnamed events, Data holds the joined "data:" lines of the event
+	using FOnEvent = TFunctionRef<void(const FString& EventName, const FString& Data)>;
+
+	void Feed(const uint8* Bytes, int32 Num, FOnEvent OnEvent);
+
+	// Dispatches a trailing event that was not terminated by a blank line
+	void Flush(FOnEvent OnEvent);
+
+	void Reset();
+
+private:
+	void ProcessLine(const FString& Line, FOnEvent OnEvent);
+	void DispatchEvent(FOnEvent OnEvent);
+
+	TArray<uint8> PendingLine;
+	FString EventName;
+	FString EventData;
+	bool bHasData = false;
+};
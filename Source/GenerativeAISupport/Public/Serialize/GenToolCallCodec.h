@@ -0,0 +1,46 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Dom/JsonObject.h"
+#include "Tools/GenToolRegistry.h"
+
+class FGenImageAttachments;
+
+/**
+ * Converts chat history with tool calls/results to and from the provider wire formats.
+ * OpenAI and DeepSeek use "tool_calls" on assistant messages and "tool" role messages,
+ * Anthropic uses "tool_use" and "tool_result" content blocks.
+ */
+class GENERATIVEAISUPPORT_API FGenToolCallCodec
+{
+public:
+	/**
+	 * Serializes the messages into the "messages" array of the request.
+	 * Image attachments are added to OutImages and written as its placeholders,
+	 * without OutImages they are dropped.
+	 */
+	static TArray<TSharedPtr<FJsonValue>> WriteMessages(const TArray<FGenChatMessage>& Messages, EGenToolFormat Format,
+	                                                    FGenImageAttachments* OutImages = nullptr);
+
+	// Adds "tools" and "tool_choice" to the payload, does nothing when no tools are requested
+	static void WriteTools(const TSharedPtr<FJsonObject>& JsonPayload, const TArray<FString>& ToolNames, const FString& ToolChoice,
+	                       EGenToolFormat Format);
+
+	// Reads the tool calls of an OpenAI compatible response message
+	static bool ReadOpenAIToolCalls(const TSharedPtr<FJsonObject>& MessageObject, TArray<FGenToolCall>& OutCalls);
+
+	// Reads the text and tool_use blocks of an Anthropic response content array
+	static bool ReadAnthropicContent(const TArray<TSharedPtr<FJsonValue>>& ContentArray, FString& OutText, TArray<FGenToolCall>& OutCalls);
+
+	// Appends the assistant message that requested the calls followed by one "tool" message per result
+	static void AppendToolRound(TArray<FGenChatMessage>& Messages, const FString& AssistantText,
+	                            const TArray<FGenToolCall>& Calls, const TArray<FGenToolResult>& Results);
+
+private:
+	static TSharedPtr<FJsonObject> WriteOpenAIMessage(const FGenChatMessage& Message, FGenImageAttachments* OutImages);
+	static TSharedPtr<FJsonObject> WriteAnthropicMessage(const FGenChatMessage& Message, FGenImageAttachments* OutImages);
+	static TSharedPtr<FJsonObject> WriteAnthropicAssistantMessage(const FGenChatMessage& Message);
+};
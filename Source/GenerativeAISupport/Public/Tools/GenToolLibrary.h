@@ -0,0 +1,32 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "GenToolLibrary.generated.h"
+
+/**
+ * Blueprint access to the tool registry used by the chat services
+ */
+UCLASS()
+class GENERATIVEAISUPPORT_API UGenToolLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	// Registers every static BlueprintCallable function of the class as a tool, returns the number registered.
+	// The tools run on the game thread.
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Tools")
+	static int32 RegisterToolsFromClass(TSubclassOf<UBlueprintFunctionLibrary> LibraryClass);
+
+	// Registers the actor and blueprint editor utilities as tools
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Tools")
+	static int32 RegisterEditorUtilityTools();
+
+	UFUNCTION(BlueprintCallable, Category = "GenAI|Tools")
+	static void UnregisterTool(const FString& ToolName);
+
+	UFUNCTION(BlueprintPure, Category = "GenAI|Tools")
+	static TArray<FString> GetRegisteredToolNames();
+};
@@ -0,0 +1,82 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/GenToolStructs.h"
+#include "Dom/JsonObject.h"
+#include "Misc/ScopeRWLock.h"
+
+// Wire format of the tool definitions sent with a chat request
+enum class EGenToolFormat : uint8
+{
+	// OpenAI compatible {"type":"function","function":{...}}, also used by DeepSeek
+	OpenAI,
+	// Anthropic {"name","description","input_schema"}
+	Anthropic
+};
+
+/**
+ * Registry of tools the chat services can offer to a model.
+ * Tools are either reflected UFUNCTIONs (static BlueprintCallable library functions, e.g. UGenActorUtils)
+ * or native handlers. Tool calls returned by the model are dispatched through ExecuteToolCalls,
+ * native handlers registered as thread-safe run concurrently on the thread pool, everything else (including every
+ * UFUNCTION, which needs its class default object) runs on the game thread.
+ */
+class GENERATIVEAISUPPORT_API FGenToolRegistry
+{
+public:
+	// Native handler, receives the parsed arguments and returns the output as JSON (or sets OutError)
+	using FNativeToolHandler = TFunction<FString(const TSharedPtr<FJsonObject>& Arguments, FString& OutError)>;
+
+	static FGenToolRegistry& Get();
+
+	// Registers a static UFUNCTION, ToolName defaults to the function name. It always runs on the game thread.
+	bool RegisterFunction(UFunction* Function, const FString& ToolName = TEXT(""));
+
+	// Registers every static BlueprintCallable function declared on Class, returns the number registered
+	int32 RegisterClassFunctions(const UClass* Class, const FString& NamePrefix = TEXT(""));
+
+	// Registers the editor utility libraries (actor and blueprint utils), all of them run on the game thread
+	int32 RegisterEditorUtilityTools();
+
+	// Thread-safe handlers may run on any thread and must not touch UObjects
+	void RegisterNativeTool(const FString& ToolName, const FString& Description, const TSharedPtr<FJsonObject>& ParametersSchema,
+	                        FNativeToolHandler Handler, bool bThreadSafe = false);
+
+	void UnregisterTool(const FString& ToolName);
+	bool IsToolRegistered(const FString& ToolName) const;
+	TArray<FString> GetToolNames() const;
+
+	// Tool definitions for the requested names, unknown names are skipped with a warning
+	TArray<TSharedPtr<FJsonValue>> BuildToolsJson(const TArray<FString>& ToolNames, EGenToolFormat Format) const;
+
+	/**
+	 * Executes the tool calls and calls OnComplete on the game thread once all of them finished.
+	 * Results are in the same order as Calls. Unknown tools and invalid arguments produce failed results
+	 * that are sent back to the model, so it can correct itself.
+	 */
+	void ExecuteToolCalls(const TArray<FGenToolCall>& Calls, TFunction<void(const TArray<FGenToolResult>&)> OnComplete) const;
+
+	// Executes a single call on the calling thread, UFUNCTION tools fail when that is not the game thread
+	FGenToolResult ExecuteToolCall(const FGenToolCall& Call) const;
+
+private:
+	struct FToolEntry
+	{
+		FString Description;
+		TSharedPtr<FJsonObject> ParametersSchema;
+		// Either a reflected function (only resolved on the game thread) or a native handler
+		TWeakObjectPtr<UFunction> Function;
+		FNativeToolHandler Handler;
+		// Only honored for native handlers
+		bool bThreadSafe = false;
+	};
+
+	bool FindTool(const FString& ToolName, FToolEntry& OutEntry) const;
+	static FGenToolResult InvokeTool(const FToolEntry& Entry, const FGenToolCall& Call);
+	static FString InvokeFunction(UFunction* Function, const TSharedPtr<FJsonObject>& Arguments, FString& OutError);
+
+	mutable FRWLock ToolsLock;
+	TMap<FString, FToolEntry> Tools;
+};
@@ -0,0 +1,49 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Interfaces/IHttpRequest.h"
+#include "Interfaces/IHttpResponse.h"
+
+/**
+ * Delivers the body of an HTTP response incrementally while it is being received.
+ * The body is received through a stream owned by the reader: the HTTP thread hands bytes over under a lock and the
+ * request progress delegate passes them to OnData, so the response buffer is never read while it is still written.
+ * Callbacks run on the thread the HTTP module ticks its delegates on (the game thread by default).
+ * The response content stays empty while streaming, use GetBodyPrefix for error bodies.
+ */
+class GENERATIVEAISUPPORT_API FGenHttpStreamReader : public TSharedFromThis<FGenHttpStreamReader, ESPMode::ThreadSafe>
+{
+public:
+	using FOnData = TFunction<void(const uint8* Data, int32 Num)>;
+
+	static TSharedRef<FGenHttpStreamReader, ESPMode::ThreadSafe> Bind(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& Request, FOnData OnData);
+
+	// Delivers whatever arrived after the last progress update, call from OnProcessRequestComplete
+	void Flush(const FHttpResponsePtr& Response);
+
+	// Start of the body as text, enough for the JSON error responses APIs send instead of a stream
+	FString GetBodyPrefix(const FHttpResponsePtr& Response) const;
+
+	int64 GetNumBytesDelivered() const { return Delivered; }
+
+	// Called by the receive stream on the HTTP thread
+	void Receive(const uint8* Data, int64 Num);
+
+private:
+	explicit FGenHttpStreamReader(FOnData InOnData);
+
+	void Deliver();
+
+	FOnData OnData;
+	int64 Delivered = 0;
+
+	// Written on the HTTP thread, swapped out on the delivering thread
+	mutable FCriticalSection PendingLock;
+	TArray<uint8> Pending;
+	TArray<uint8> BodyPrefix;
+
+	// Set when the HTTP module does not support receive streams, the body is then delivered once complete
+	bool bReceiveStreamBound = false;
+};
@@ -0,0 +1,87 @@
+// Copyright Prajwal Shetty 2024. All rights Reserved. https://prajwalshetty.com/terms
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Data/OpenAI/GenOAIChatStructs.h"
+#include "Interfaces/IHttpRequest.h"
+
+class IImageWrapperModule;
+
+// Part of an image that a placeholder in the JSON payload stands for
+enum class EGenImagePlaceholder : uint8
+{
+	// "data:<mime>;base64,<data>"
+	DataUrl,
+	// Only the base64 data
+	Data,
+	// Only the mime type
+	MimeType
+};
+
+/**
+ * Image attachments of the messages of one conversation.
+ * The JSON payload references them by placeholders that carry a random nonce of this instance, so text in the
+ * conversation cannot forge one. Every image is encoded once, later requests with the same attachments
+ * (tool rounds, agent steps) reuse the encoded bytes.
+ */
+class GENERATIVEAISUPPORT_API FGenImageAttachments
+{
+public:
+	FGenImageAttachments();
+
+	// Adds an image and returns its index, an identical image added earlier is reused
+	int32 Add(const FGenChatImage& Image);
+
+	// Placeholder string for the JSON payload, replaced when the request body is built
+	FString MakePlaceholder(int32 ImageIndex, EGenImagePlaceholder Kind) const;
+
+	int32 Num() const { return Images.Num(); }
+
+	// Number of images whose encoded bytes are cached
+	int32 NumEncoded() const;
+
+	struct FEncodedImage
+	{
+		TArray64<uint8> Bytes;
+		FString MimeType;
+	};
+	using FEncodedImagePtr = TSharedPtr<const FEncodedImage, ESPMode::ThreadSafe>;
+
+private:
+	friend class FGenImageUtils;
+
+	FString Nonce;
+	TArray<FGenChatImage> Images;
+	// Indexed like Images, only changed on the game thread once a request encoded the image
+	TArray<FEncodedImagePtr> EncodedImages;
+};
+
+/**
+ * Image encoding for chat requests.
+ * The JSON payload is serialized with FGenImageAttachments placeholders, the images are then encoded on a worker thread
+ * and their base64 is written straight into the UTF-8 request body, so the (large) encoded images never go through FString.
+ */
+class GENERATIVEAISUPPORT_API FGenImageUtils
+{
+public:
+	/**
+	 * Encodes the images of Attachments that are not encoded yet on a worker thread, sets the spliced body on the request
+	 * and sends it from the game thread. OnError is called on the game thread if an image could not be read or encoded.
+	 * Textures are read on the game thread before dispatching, calls from other threads are forwarded there.
+	 */
+	static void ProcessRequestWithImages(const TSharedRef<IHttpRequest, ESPMode::ThreadSafe>& HttpRequest, const FString& PayloadJson,
+	                                     const TSharedRef<FGenImageAttachments>& Attachments, TFunction<void(const FString&)> OnError);
+
+	// Copies mip 0 of an uncompressed BGRA8 texture (or its editor source data)
+	static bool ReadTexturePixels(UTexture2D* Texture, TArray<FColor>& OutPixels, int32& OutWidth, int32& OutHeight, FString& OutError);
+
+	// Downscales to MaxDimension and compresses to JPEG (JpegQuality > 0) or PNG
+	static bool EncodePixels(IImageWrapperModule& ImageWrapperModule, TArray<FColor> Pixels, int32 Width, int32 Height,
+	                         int32 MaxDimension, int32 JpegQuality, TArray64<uint8>& OutBytes, FString& OutMimeType);
+
+	// Appends the base64 encoding of Data to Out without any intermediate string
+	static void AppendBase64(const uint8* Data, int64 Num, TArray<uint8>& Out);
+
+	static int64 GetBase64Length(int64 Num) { return ((Num + 2) / 3) * 4; }
+};